@@ -13,6 +13,7 @@
 
 #include "client.h"
 #include "clientdevice.h"
+#include "messagelatencymodel.h"
 #include "messagestatisticsmodel.h"
 
 #include <common/message.h>
@@ -30,6 +31,7 @@ Client::Client(QObject *parent)
     : Endpoint(parent)
     , m_clientDevice(nullptr)
     , m_statModel(new MessageStatisticsModel(this))
+    , m_latencyModel(new MessageLatencyModel(this))
     , m_initState(0)
 {
     Message::resetNegotiatedDataVersion();
@@ -41,6 +43,8 @@ Client::Client(QObject *parent)
     ObjectBroker::registerModelInternal(QStringLiteral(
                                             "com.kdab.GammaRay.MessageStatisticsModel"),
                                         m_statModel);
+    ObjectBroker::registerModelInternal(QStringLiteral("com.kdab.GammaRay.MessageLatencyModel"),
+                                        m_latencyModel);
 }
 
 Client::~Client()
@@ -70,6 +74,8 @@ void Client::connectToHost(const QUrl &url, int tryAgain)
     m_initState = 0;
 
     m_statModel->clear();
+    m_latencyModel->clear();
+    clearMessageLatencies();
     m_clientDevice = ClientDevice::create(m_serverAddress, this);
     if (!m_clientDevice) {
         emit persisitentConnectionError(tr("Unsupported transport protocol."));
@@ -95,6 +101,10 @@ void Client::disconnectFromHost()
 void Client::socketConnected()
 {
     Q_ASSERT(m_clientDevice->device());
+    // captures have to start with the connection to be replayable
+    const auto captureFile = qEnvironmentVariable("GAMMARAY_RECORD_SESSION");
+    if (!captureFile.isEmpty() && m_serverAddress.scheme() != QLatin1String("replay"))
+        startRecording(captureFile);
     setDevice(m_clientDevice->device());
 }
 
@@ -143,9 +153,12 @@ void Client::messageReceived(const Message &msg)
         case Protocol::ObjectAdded: {
             QString name;
             Protocol::ObjectAddress addr;
-            msg >> name >> addr;
+            Protocol::MethodTable methods;
+            msg >> name >> addr >> methods;
             addObjectNameAddressMapping(name, addr);
+            setMethodTable(addr, methods);
             m_statModel->addObject(addr, name);
+            m_latencyModel->addObject(addr, name);
             break;
         }
         case Protocol::ObjectRemoved: {
@@ -156,12 +169,16 @@ void Client::messageReceived(const Message &msg)
         }
         case Protocol::ObjectMapReply: {
             QVector<QPair<Protocol::ObjectAddress, QString>> objects;
-            msg >> objects;
+            QVector<QPair<Protocol::ObjectAddress, Protocol::MethodTable>> methods;
+            msg >> objects >> methods;
             for (auto it = objects.constBegin(); it != objects.constEnd(); ++it) {
                 if (it->first != endpointAddress())
                     addObjectNameAddressMapping(it->second, it->first);
                 m_statModel->addObject(it->first, it->second);
+                m_latencyModel->addObject(it->first, it->second);
             }
+            for (auto it = methods.constBegin(); it != methods.constEnd(); ++it)
+                setMethodTable(it->first, it->second);
 
             m_propertySyncer->setAddress(objectAddress(QStringLiteral(
                 "com.kdab.GammaRay.PropertySyncer")));
@@ -21,6 +21,7 @@
 
 namespace GammaRay {
 class ClientDevice;
+class MessageLatencyModel;
 class MessageStatisticsModel;
 
 /** Client-side connection endpoint. */
@@ -91,6 +92,7 @@ private:
     QUrl m_serverAddress;
     ClientDevice *m_clientDevice;
     MessageStatisticsModel *m_statModel;
+    MessageLatencyModel *m_latencyModel;
     int m_initState;
 };
 }
@@ -14,6 +14,8 @@
 #include "clientdevice.h"
 #include "tcpclientdevice.h"
 #include "localclientdevice.h"
+#include "replayclientdevice.h"
+#include "sharedmemoryclientdevice.h"
 
 #include <QDebug>
 
@@ -34,6 +36,10 @@ ClientDevice *ClientDevice::create(const QUrl &url, QObject *parent)
         device = new TcpClientDevice(parent);
     else if (url.scheme() == QLatin1String("local"))
         device = new LocalClientDevice(parent);
+    else if (url.scheme() == QLatin1String("shm"))
+        device = new SharedMemoryClientDevice(parent);
+    else if (url.scheme() == QLatin1String("replay"))
+        device = new ReplayClientDevice(parent);
 
     if (!device) {
         qWarning() << "Unsupported transport protocol:" << url.toString();
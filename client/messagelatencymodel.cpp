@@ -0,0 +1,234 @@
+/*
+  messagelatencymodel.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "messagelatencymodel.h"
+#include "messagestatisticsmodel.h"
+
+#include <common/endpoint.h>
+#include <common/objectbroker.h>
+#include <common/probecontrollerinterface.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaMethod>
+#include <QStringList>
+#include <QTimer>
+
+#include <algorithm>
+
+using namespace GammaRay;
+
+static bool entryLessThan(const MessageLatencies::Entry &lhs, const MessageLatencies::Entry &rhs)
+{
+    if (lhs.address != rhs.address)
+        return lhs.address < rhs.address;
+    if (lhs.kind != rhs.kind)
+        return lhs.kind < rhs.kind;
+    return lhs.type < rhs.type;
+}
+
+static bool sameEntry(const MessageLatencies::Entry &lhs, const MessageLatencies::Entry &rhs)
+{
+    return lhs.address == rhs.address && lhs.kind == rhs.kind && lhs.type == rhs.type;
+}
+
+static QString formatDuration(double usecs)
+{
+    if (usecs >= 10000.0)
+        return QStringLiteral("%1 ms").arg(usecs / 1000.0, 0, 'f', 1);
+    return QStringLiteral("%1 µs").arg(usecs, 0, 'f', 0);
+}
+
+MessageLatencyModel::MessageLatencyModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_refreshTimer(new QTimer(this))
+{
+    connect(m_refreshTimer, &QTimer::timeout, this, &MessageLatencyModel::refresh);
+    m_refreshTimer->start(1000);
+}
+
+MessageLatencyModel::~MessageLatencyModel() = default;
+
+void MessageLatencyModel::clear()
+{
+    beginResetModel();
+    m_objectNames.clear();
+    m_entries[ClientSide].clear();
+    m_entries[ProbeSide].clear();
+    endResetModel();
+}
+
+void MessageLatencyModel::addObject(Protocol::ObjectAddress addr, const QString &name)
+{
+    if (addr >= m_objectNames.size())
+        m_objectNames.resize(addr + 1);
+    m_objectNames[addr] = name;
+}
+
+QString MessageLatencyModel::objectName(Protocol::ObjectAddress addr) const
+{
+    const auto name = m_objectNames.value(addr);
+    return name.isEmpty() ? QString::number(addr) : name;
+}
+
+void MessageLatencyModel::refresh()
+{
+    // no need to poll the probe while nobody is looking
+    if (!isSignalConnected(QMetaMethod::fromSignal(&QAbstractItemModel::dataChanged)))
+        return;
+
+    setEntries(ClientSide, Endpoint::instance()->messageLatencies().entries());
+
+    const auto controllerName = QString::fromUtf8(qobject_interface_iid<ProbeControllerInterface *>());
+    if (!Endpoint::isConnected() || Endpoint::instance()->objectAddress(controllerName) == Protocol::InvalidObjectAddress)
+        return;
+    if (!m_probeController) {
+        m_probeController = ObjectBroker::object<ProbeControllerInterface *>();
+        connect(m_probeController.data(), &ProbeControllerInterface::messageLatenciesReceived,
+                this, &MessageLatencyModel::probeLatenciesReceived);
+    }
+    m_probeController->requestMessageLatencies();
+}
+
+void MessageLatencyModel::probeLatenciesReceived(const MessageLatencies &latencies)
+{
+    setEntries(ProbeSide, latencies.entries());
+}
+
+void MessageLatencyModel::setEntries(Side side, QVector<MessageLatencies::Entry> entries)
+{
+    std::sort(entries.begin(), entries.end(), entryLessThan);
+    auto &current = m_entries[side];
+
+    // entries only ever get added while connected, so most updates just change the numbers
+    if (entries.size() == current.size() && std::equal(entries.constBegin(), entries.constEnd(), current.constBegin(), sameEntry)) {
+        if (entries.isEmpty())
+            return;
+        current = entries;
+        const int offset = side == ProbeSide ? m_entries[ClientSide].size() : 0;
+        emit dataChanged(index(offset, CountColumn), index(offset + entries.size() - 1, MaxColumn));
+        return;
+    }
+
+    beginResetModel();
+    current = entries;
+    endResetModel();
+}
+
+QByteArray MessageLatencyModel::toJson() const
+{
+    QJsonObject doc;
+    for (int side = ClientSide; side <= ProbeSide; ++side) {
+        QJsonArray entries;
+        for (const auto &entry : m_entries[side]) {
+            auto obj = entry.histogram.toJson();
+            obj.insert(QStringLiteral("object"), objectName(entry.address));
+            obj.insert(QStringLiteral("address"), entry.address);
+            obj.insert(QStringLiteral("kind"), MessageLatencies::kindName(entry.kind));
+            obj.insert(QStringLiteral("messageType"), MessageStatisticsModel::messageTypeName(entry.type));
+            entries.push_back(obj);
+        }
+        doc.insert(side == ClientSide ? QStringLiteral("client") : QStringLiteral("probe"), entries);
+    }
+    return QJsonDocument(doc).toJson(QJsonDocument::Indented);
+}
+
+int MessageLatencyModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return ColumnCount;
+}
+
+int MessageLatencyModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_entries[ClientSide].size() + m_entries[ProbeSide].size();
+}
+
+QVariant MessageLatencyModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    const auto clientCount = m_entries[ClientSide].size();
+    const auto side = index.row() < clientCount ? ClientSide : ProbeSide;
+    const auto &entry = m_entries[side].at(side == ClientSide ? index.row() : index.row() - clientCount);
+    const auto &histogram = entry.histogram;
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case SideColumn:
+            return side == ClientSide ? tr("Client") : tr("Probe");
+        case ObjectColumn:
+            return objectName(entry.address);
+        case KindColumn:
+            return MessageLatencies::kindName(entry.kind);
+        case TypeColumn:
+            return MessageStatisticsModel::messageTypeName(entry.type);
+        case CountColumn:
+            return histogram.count();
+        case MeanColumn:
+            return formatDuration(histogram.mean());
+        case MedianColumn:
+            return formatDuration(histogram.percentile(0.5));
+        case P99Column:
+            return formatDuration(histogram.percentile(0.99));
+        case MaxColumn:
+            return formatDuration(histogram.max());
+        }
+    } else if (role == Qt::TextAlignmentRole) {
+        if (index.column() >= CountColumn)
+            return QVariant::fromValue<int>(Qt::AlignRight | Qt::AlignVCenter);
+    } else if (role == Qt::ToolTipRole) {
+        QStringList buckets;
+        for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+            if (!histogram.bucketCount(i))
+                continue;
+            const auto limit = i < LatencyHistogram::BucketCount - 1
+                ? tr("< %1").arg(formatDuration(LatencyHistogram::bucketLimit(i)))
+                : tr(">= %1").arg(formatDuration(LatencyHistogram::bucketLimit(i - 1)));
+            buckets.push_back(tr("%1: %2").arg(limit).arg(histogram.bucketCount(i)));
+        }
+        return buckets.join(QLatin1Char('\n'));
+    }
+
+    return QVariant();
+}
+
+QVariant MessageLatencyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        switch (section) {
+        case SideColumn:
+            return tr("Side");
+        case ObjectColumn:
+            return tr("Object");
+        case KindColumn:
+            return tr("Measurement");
+        case TypeColumn:
+            return tr("Message Type");
+        case CountColumn:
+            return tr("Count");
+        case MeanColumn:
+            return tr("Mean");
+        case MedianColumn:
+            return tr("Median");
+        case P99Column:
+            return tr("99th Percentile");
+        case MaxColumn:
+            return tr("Max");
+        }
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
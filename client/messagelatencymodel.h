@@ -0,0 +1,86 @@
+/*
+  messagelatencymodel.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_MESSAGELATENCYMODEL_H
+#define GAMMARAY_MESSAGELATENCYMODEL_H
+
+#include <common/messagelatency.h>
+#include <common/protocol.h>
+
+#include <QAbstractTableModel>
+#include <QPointer>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+class ProbeControllerInterface;
+
+/**
+ * Latency statistics of the GammaRay-internal communication, of both the client
+ * and the probe side. Refreshed periodically while a view is attached.
+ */
+class MessageLatencyModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column
+    {
+        SideColumn,
+        ObjectColumn,
+        KindColumn,
+        TypeColumn,
+        CountColumn,
+        MeanColumn,
+        MedianColumn,
+        P99Column,
+        MaxColumn,
+        ColumnCount
+    };
+
+    explicit MessageLatencyModel(QObject *parent = nullptr);
+    ~MessageLatencyModel() override;
+
+    void clear();
+    void addObject(Protocol::ObjectAddress addr, const QString &name);
+
+    /** All histograms of both sides, as a JSON document. */
+    Q_INVOKABLE QByteArray toJson() const;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private slots:
+    void refresh();
+    void probeLatenciesReceived(const GammaRay::MessageLatencies &latencies);
+
+private:
+    enum Side
+    {
+        ClientSide,
+        ProbeSide
+    };
+    void setEntries(Side side, QVector<MessageLatencies::Entry> entries);
+    QString objectName(Protocol::ObjectAddress addr) const;
+
+    QVector<QString> m_objectNames;
+    QVector<MessageLatencies::Entry> m_entries[2];
+    QTimer *m_refreshTimer;
+    QPointer<ProbeControllerInterface> m_probeController;
+};
+}
+
+#endif // GAMMARAY_MESSAGELATENCYMODEL_H
@@ -139,6 +139,11 @@ void MessageStatisticsModel::addMessage(Protocol::ObjectAddress addr, Protocol::
     }
 }
 
+QString MessageStatisticsModel::messageTypeName(Protocol::MessageType msgType)
+{
+    return MetaEnum::enumToString(msgType, message_type_table);
+}
+
 int MessageStatisticsModel::columnCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent);
@@ -33,6 +33,8 @@ public:
     void addObject(Protocol::ObjectAddress addr, const QString &name);
     void addMessage(Protocol::ObjectAddress addr, Protocol::MessageType msgType, int size);
 
+    static QString messageTypeName(Protocol::MessageType msgType);
+
     int columnCount(const QModelIndex &parent) const override;
     int rowCount(const QModelIndex &parent) const override;
     QVariant data(const QModelIndex &index, int role) const override;
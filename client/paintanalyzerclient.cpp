@@ -21,3 +21,8 @@ PaintAnalyzerClient::PaintAnalyzerClient(const QString &name, QObject *parent)
     : PaintAnalyzerInterface(name, parent)
 {
 }
+
+void PaintAnalyzerClient::requestRecording()
+{
+    Endpoint::instance()->invokeObject(name(), "requestRecording");
+}
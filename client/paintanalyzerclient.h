@@ -23,6 +23,9 @@ class PaintAnalyzerClient : public PaintAnalyzerInterface
     Q_INTERFACES(GammaRay::PaintAnalyzerInterface)
 public:
     explicit PaintAnalyzerClient(const QString &name, QObject *parent = nullptr);
+
+public slots:
+    void requestRecording() override;
 };
 }
 
@@ -31,3 +31,8 @@ void ProbeControllerClient::quitHost()
 {
     Endpoint::instance()->invokeObject(objectName(), "quitHost");
 }
+
+void ProbeControllerClient::requestMessageLatencies()
+{
+    Endpoint::instance()->invokeObject(objectName(), "requestMessageLatencies");
+}
@@ -26,6 +26,7 @@ public:
 
     void detachProbe() override;
     void quitHost() override;
+    void requestMessageLatencies() override;
 };
 }
 
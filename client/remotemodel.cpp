@@ -225,6 +225,7 @@ QVariant RemoteModel::requestCreationDeclarationLocation(const QModelIndex &inde
 
     Message msg(m_myAddress, Protocol::ModelCreationDeclartionLocationRequest);
     msg << Protocol::fromQModelIndex(index);
+    expectReply(msg.type());
     sendMessage(msg);
 
     QVariant declarationLoc = QVariant::fromValue(SourceLocation {});
@@ -306,6 +307,7 @@ void RemoteModel::sort(int column, Qt::SortOrder order)
 
 void RemoteModel::newMessage(const GammaRay::Message &msg)
 {
+    replyReceived(msg.type());
     if (!checkSyncBarrier(msg))
         return;
 
@@ -714,6 +716,7 @@ void RemoteModel::serverRegistered(const QString &objectName, Protocol::ObjectAd
 {
     if (m_serverObject == objectName) {
         m_myAddress = objectAddress;
+        m_pendingReplies.clear();
         connectToServer();
     }
 }
@@ -724,6 +727,7 @@ void RemoteModel::serverUnregistered(const QString &objectName,
     Q_UNUSED(objectName);
     if (m_myAddress == objectAddress) {
         m_myAddress = Protocol::InvalidObjectAddress;
+        m_pendingReplies.clear();
         clear();
     }
 }
@@ -846,6 +850,7 @@ void RemoteModel::doRequests() const
             msg << quint32(indexes.size());
             for (const auto &index : indexes)
                 msg << index;
+            expectReply(msg.type());
             sendMessage(msg);
             break;
         }
@@ -855,6 +860,7 @@ void RemoteModel::doRequests() const
             msg << quint32(indexes.size());
             for (const auto &index : indexes)
                 msg << index;
+            expectReply(msg.type());
             sendMessage(msg);
             break;
         }
@@ -874,6 +880,7 @@ void RemoteModel::requestHeaderData(Qt::Orientation orientation, int section) co
 
     Message msg(m_myAddress, Protocol::ModelHeaderRequest);
     msg << qint8(orientation) << qint32(section);
+    expectReply(msg.type());
     sendMessage(msg);
 }
 
@@ -884,6 +891,7 @@ void RemoteModel::clear()
     if (isConnected()) {
         Message msg(m_myAddress, Protocol::ModelSyncBarrier);
         msg << ++m_targetSyncBarrier;
+        expectReply(msg.type());
         sendMessage(msg);
     }
 
@@ -1093,6 +1101,49 @@ void RemoteModel::registerClient(const QString &serverObject)
             this, &RemoteModel::serverUnregistered);
 }
 
+static Protocol::MessageType requestTypeForReply(Protocol::MessageType replyType)
+{
+    switch (replyType) {
+    case Protocol::ModelRowColumnCountReply:
+        return Protocol::ModelRowColumnCountRequest;
+    case Protocol::ModelContentReply:
+        return Protocol::ModelContentRequest;
+    case Protocol::ModelHeaderReply:
+        return Protocol::ModelHeaderRequest;
+    case Protocol::ModelSyncBarrier:
+        return Protocol::ModelSyncBarrier;
+    case Protocol::ModelCreationDeclartionLocationReply:
+        return Protocol::ModelCreationDeclartionLocationRequest;
+    }
+    return Protocol::InvalidMessageType;
+}
+
+void RemoteModel::expectReply(Protocol::MessageType requestType) const
+{
+    if (m_pendingReplies.size() >= std::size_t(MaxPendingReplies))
+        m_pendingReplies.pop_front();
+    m_pendingReplies.push_back({ requestType, Endpoint::latencyTimestamp() });
+}
+
+void RemoteModel::replyReceived(Protocol::MessageType replyType)
+{
+    const auto requestType = requestTypeForReply(replyType);
+    if (requestType == Protocol::InvalidMessageType)
+        return;
+
+    // the server handles requests in order, but doesn't answer all of them (e.g. content
+    // requests for indexes that are gone by now), anything before the match got no reply
+    while (!m_pendingReplies.empty()) {
+        const auto pending = m_pendingReplies.front();
+        m_pendingReplies.pop_front();
+        if (pending.requestType == requestType) {
+            Endpoint::recordLatency(MessageLatencies::RoundTrip, m_myAddress, requestType,
+                                    Endpoint::latencyTimestamp() - pending.timestamp);
+            return;
+        }
+    }
+}
+
 void RemoteModel::sendMessage(const Message &msg) const
 {
     Endpoint::send(msg);
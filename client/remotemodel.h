@@ -29,6 +29,8 @@
 #include <QTimer>
 #include <QVector>
 
+#include <deque>
+
 namespace GammaRay {
 class Message;
 
@@ -181,6 +183,20 @@ private:
 
     qint32 m_currentSyncBarrier, m_targetSyncBarrier;
 
+    // requests waiting for their reply, for round-trip latency measurement
+    struct PendingReply
+    {
+        Protocol::MessageType requestType;
+        quint64 timestamp;
+    };
+    enum
+    {
+        MaxPendingReplies = 1024
+    };
+    mutable std::deque<PendingReply> m_pendingReplies;
+    void expectReply(Protocol::MessageType requestType) const;
+    void replyReceived(Protocol::MessageType replyType);
+
     // default data() values for empty cells
     static QVariant s_emptyDisplayValue;
     static QVariant s_emptySizeHintValue;
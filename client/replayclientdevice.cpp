@@ -0,0 +1,49 @@
+/*
+  replayclientdevice.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "replayclientdevice.h"
+
+#include <QUrlQuery>
+
+using namespace GammaRay;
+
+ReplayClientDevice::ReplayClientDevice(QObject *parent)
+    : ClientDeviceImpl<SessionReplayDevice>(parent)
+{
+    m_socket = new SessionReplayDevice(this);
+}
+
+void ReplayClientDevice::connectToHost()
+{
+    if (!m_socket->openCapture(m_serverAddress.toLocalFile())) {
+        emit persistentError(m_socket->errorString());
+        return;
+    }
+
+    const QUrlQuery query(m_serverAddress);
+    if (query.hasQueryItem(QStringLiteral("speed")))
+        m_socket->setSpeed(query.queryItemValue(QStringLiteral("speed")).toDouble());
+
+    // like with a real socket, the connection is reported from the event loop
+    QMetaObject::invokeMethod(this, "startReplay", Qt::QueuedConnection);
+}
+
+void ReplayClientDevice::disconnectFromHost()
+{
+    m_socket->disconnectFromPeer();
+}
+
+void ReplayClientDevice::startReplay()
+{
+    emit connected();
+    m_socket->start();
+}
@@ -0,0 +1,39 @@
+/*
+  replayclientdevice.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_REPLAYCLIENTDEVICE_H
+#define GAMMARAY_REPLAYCLIENTDEVICE_H
+
+#include "clientdevice.h"
+
+#include <common/sessionreplaydevice.h>
+
+namespace GammaRay {
+/**
+ * Client side of the replay:// pseudo transport, feeding a recorded session into the client.
+ * The URL path is the capture file, the optional "speed" query item sets the playback speed
+ * relative to the recording, the default being as fast as possible.
+ */
+class ReplayClientDevice : public ClientDeviceImpl<SessionReplayDevice>
+{
+    Q_OBJECT
+public:
+    explicit ReplayClientDevice(QObject *parent = nullptr);
+    void connectToHost() override;
+    void disconnectFromHost() override;
+
+private slots:
+    void startReplay();
+};
+}
+
+#endif // GAMMARAY_REPLAYCLIENTDEVICE_H
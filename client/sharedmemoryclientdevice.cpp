@@ -0,0 +1,80 @@
+/*
+  sharedmemoryclientdevice.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "sharedmemoryclientdevice.h"
+
+#include <common/sharedmemorydevice.h>
+
+#include <QLocalSocket>
+
+using namespace GammaRay;
+
+SharedMemoryClientDevice::SharedMemoryClientDevice(QObject *parent)
+    : ClientDevice(parent)
+    , m_socket(new QLocalSocket(this))
+    , m_device(nullptr)
+{
+    connect(m_socket, &QLocalSocket::connected, this, &SharedMemoryClientDevice::socketConnected);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    connect(m_socket, static_cast<void (QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error),
+            this, &SharedMemoryClientDevice::socketError);
+#else
+    connect(m_socket, &QLocalSocket::errorOccurred, this, &SharedMemoryClientDevice::socketError);
+#endif
+}
+
+void SharedMemoryClientDevice::connectToHost()
+{
+    m_socket->connectToServer(m_serverAddress.path());
+}
+
+void SharedMemoryClientDevice::disconnectFromHost()
+{
+    m_socket->disconnectFromServer();
+}
+
+QIODevice *SharedMemoryClientDevice::device() const
+{
+    return m_device;
+}
+
+void SharedMemoryClientDevice::socketConnected()
+{
+    // the socket now becomes the control channel of the shared memory device,
+    // we are connected once the server announced the segment and we attached to it
+    m_device = new SharedMemoryDevice(m_socket, this);
+    connect(m_device, &SharedMemoryDevice::attached, this, &ClientDevice::connected);
+    connect(m_device, &SharedMemoryDevice::attachFailed, this, &ClientDevice::persistentError);
+    m_device->attachSegment();
+}
+
+void SharedMemoryClientDevice::socketError()
+{
+    switch (m_socket->error()) {
+    case QLocalSocket::ConnectionRefusedError:
+    case QLocalSocket::ServerNotFoundError:
+    case QLocalSocket::SocketAccessError:
+    case QLocalSocket::SocketTimeoutError:
+    case QLocalSocket::ConnectionError:
+    case QLocalSocket::UnknownSocketError:
+        emit transientError();
+        break;
+    default:
+        if (m_tries) {
+            --m_tries;
+            emit transientError();
+        } else {
+            emit persistentError(m_socket->errorString());
+        }
+        break;
+    }
+}
@@ -0,0 +1,45 @@
+/*
+  sharedmemoryclientdevice.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SHAREDMEMORYCLIENTDEVICE_H
+#define GAMMARAY_SHAREDMEMORYCLIENTDEVICE_H
+
+#include "clientdevice.h"
+
+QT_BEGIN_NAMESPACE
+class QLocalSocket;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+class SharedMemoryDevice;
+
+/** Client side of the shm:// transport. */
+class SharedMemoryClientDevice : public ClientDevice
+{
+    Q_OBJECT
+public:
+    explicit SharedMemoryClientDevice(QObject *parent = nullptr);
+    void connectToHost() override;
+    void disconnectFromHost() override;
+    QIODevice *device() const override;
+
+private slots:
+    void socketConnected();
+    void socketError();
+
+private:
+    QLocalSocket *m_socket;
+    SharedMemoryDevice *m_device;
+};
+}
+
+#endif // GAMMARAY_SHAREDMEMORYCLIENTDEVICE_H
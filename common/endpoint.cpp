@@ -15,9 +15,13 @@
 #include "message.h"
 #include "methodargument.h"
 #include "propertysyncer.h"
+#include "sessioncapture.h"
+#include "variantwrapper.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include <QElapsedTimer>
 #include <QIODevice>
 #include <QLoggingCategory>
 // we use qCWarning, which we turn off by default, but which is not compiled out in releasebuilds
@@ -28,6 +32,47 @@ using namespace std;
 
 Endpoint *Endpoint::s_instance = nullptr;
 
+// upper limit for tracked messages in the outgoing buffer, in case the device never reports progress
+static const std::size_t MaxQueuedMessages = 4096;
+
+namespace {
+/*! Argument of a type known to both sides, serialized without QVariant framing. */
+struct ArgumentWriter
+{
+    int type;
+    const void *data;
+};
+
+struct ArgumentReader
+{
+    int type;
+    void *data;
+    bool ok;
+};
+
+QDataStream &operator<<(QDataStream &s, const ArgumentWriter &arg)
+{
+    if (!QMetaType::save(s, arg.type, arg.data))
+        s.setStatus(QDataStream::WriteFailed);
+    return s;
+}
+
+QDataStream &operator>>(QDataStream &s, ArgumentReader &arg)
+{
+    arg.ok = QMetaType::load(s, arg.type, arg.data);
+    return s;
+}
+
+bool convertArgument(QVariant &value, int type)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    return value.convert(type);
+#else
+    return value.convert(QMetaType(type));
+#endif
+}
+}
+
 Endpoint::Endpoint(QObject *parent)
     : QObject(parent)
     , m_propertySyncer(new PropertySyncer(this))
@@ -94,8 +139,81 @@ void Endpoint::sendMessage(const Message &msg)
 void Endpoint::doSendMessage(const GammaRay::Message &msg)
 {
     Q_ASSERT(msg.address() != Protocol::InvalidObjectAddress);
+    const auto bufferedBefore = m_socket->bytesToWrite();
     msg.write(m_socket);
     m_bytesWritten += msg.size();
+
+    // whatever the device couldn't write right away stays buffered until it reports bytesWritten()
+    const auto buffered = m_socket->bytesToWrite() - bufferedBefore;
+    if (buffered > 0) {
+        m_bytesQueued += buffered;
+        if (m_queuedMessages.size() >= MaxQueuedMessages)
+            m_queuedMessages.pop_front();
+        m_queuedMessages.push_back({ m_bytesQueued, latencyTimestamp(), msg.address(), msg.type() });
+    } else {
+        m_latencies.add(MessageLatencies::Queued, msg.address(), msg.type(), 0);
+    }
+    if (m_recorder)
+        m_recorder->record(SessionCapture::Outgoing, msg);
+}
+
+bool Endpoint::startRecording(const QString &fileName)
+{
+    std::unique_ptr<SessionRecorder> recorder(new SessionRecorder);
+    if (!recorder->open(fileName)) {
+        qWarning("Failed to open session capture file %s: %s", qPrintable(fileName), qPrintable(recorder->errorString()));
+        return false;
+    }
+    m_recorder = std::move(recorder);
+    return true;
+}
+
+void Endpoint::stopRecording()
+{
+    m_recorder.reset();
+}
+
+bool Endpoint::isRecording() const
+{
+    return m_recorder != nullptr;
+}
+
+const MessageLatencies &Endpoint::messageLatencies() const
+{
+    return m_latencies;
+}
+
+void Endpoint::clearMessageLatencies()
+{
+    m_latencies.clear();
+}
+
+void Endpoint::recordLatency(MessageLatencies::Kind kind, Protocol::ObjectAddress address,
+                             Protocol::MessageType type, quint64 usecs)
+{
+    if (s_instance)
+        s_instance->m_latencies.add(kind, address, type, usecs);
+}
+
+quint64 Endpoint::latencyTimestamp()
+{
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return clock.nsecsElapsed() / 1000;
+}
+
+void Endpoint::messagesWritten(qint64 bytes)
+{
+    m_bytesFlushed = std::min(m_bytesFlushed + bytes, m_bytesQueued);
+    const auto now = latencyTimestamp();
+    while (!m_queuedMessages.empty() && m_queuedMessages.front().end <= m_bytesFlushed) {
+        const auto &queued = m_queuedMessages.front();
+        m_latencies.add(MessageLatencies::Queued, queued.address, queued.type, now - queued.timestamp);
+        m_queuedMessages.pop_front();
+    }
 }
 
 void Endpoint::waitForMessagesWritten()
@@ -139,6 +257,7 @@ void Endpoint::setDevice(QIODevice *device)
     Q_ASSERT(device);
     m_socket = device;
     connect(m_socket.data(), &QIODevice::readyRead, this, &Endpoint::readyRead);
+    connect(m_socket.data(), &QIODevice::bytesWritten, this, &Endpoint::messagesWritten);
     // FIXME Use proper type for m_socket, instead of relying on runtime-connect
     // to a slot which doesn't exist in QIODevice
     connect(m_socket.data(), SIGNAL(disconnected()), SLOT(connectionClosed()));
@@ -156,6 +275,8 @@ void Endpoint::readyRead()
     while (Message::canReadMessage(m_socket.data())) {
         const auto msg = Message::readMessage(m_socket.data());
         m_bytesRead += msg.size();
+        if (m_recorder)
+            m_recorder->record(SessionCapture::Incoming, msg);
         messageReceived(msg);
     }
 }
@@ -163,8 +284,13 @@ void Endpoint::readyRead()
 void Endpoint::connectionClosed()
 {
     disconnect(m_socket.data(), &QIODevice::readyRead, this, &Endpoint::readyRead);
+    disconnect(m_socket.data(), &QIODevice::bytesWritten, this, &Endpoint::messagesWritten);
     disconnect(m_socket.data(), SIGNAL(disconnected()), this, SLOT(connectionClosed()));
     m_socket = nullptr;
+    m_queuedMessages.clear();
+    m_bytesQueued = 0;
+    m_bytesFlushed = 0;
+    stopRecording();
     emit disconnected();
 }
 
@@ -190,6 +316,8 @@ Protocol::ObjectAddress Endpoint::registerObject(const QString &name, QObject *o
 #endif
 
     obj->object = object;
+    // resolved methods refer to the local object
+    obj->methodInfos.clear();
 
     Q_ASSERT(!m_objectMap.contains(object));
     m_objectMap[object] = obj;
@@ -214,10 +342,92 @@ void Endpoint::invokeObject(const QString &objectName, const char *method,
         return;
 #endif
 
-    Message msg(obj->address, Protocol::MethodCall);
-    const QByteArray name(method);
+    const auto name = QByteArray::fromRawData(method, qstrlen(method));
     Q_ASSERT(!name.isEmpty());
-    msg << name << args;
+    const int methodId = obj->methodIds.value(qMakePair(name, int(args.size())), -1);
+    sendMethodCall(obj, methodId < 0 ? Protocol::InvalidMethodId : Protocol::MethodId(methodId), name, args);
+}
+
+void Endpoint::invokeRemoteMethod(QObject *object, int methodIndex, const QVector<int> &parameterTypes,
+                                  void **args) const
+{
+    if (!isConnected())
+        return;
+
+    ObjectInfo *obj = m_objectMap.value(object, nullptr);
+    Q_ASSERT(obj);
+    if (!obj)
+        return;
+
+    const int index = methodIndex - QObject::staticMetaObject.methodCount();
+    if (obj->exportedFrom == object->metaObject() && index >= 0 && index < obj->exportedIds.size()
+        && obj->exportedIds.at(index) >= 0) {
+        const Protocol::MethodId methodId = obj->exportedIds.at(index);
+        const auto &info = resolveMethod(obj, methodId);
+        if (info.typed && info.parameterTypes == parameterTypes) {
+            Message msg(obj->address, Protocol::MethodCall);
+            msg << methodId;
+            for (int i = 0; i < parameterTypes.size(); ++i)
+                msg << ArgumentWriter { parameterTypes.at(i), args[i + 1] };
+            send(msg);
+            return;
+        }
+    }
+
+    // not part of the method table, address it by name and send the arguments with their types
+    QVariantList v;
+    v.reserve(parameterTypes.size());
+    for (int i = 0; i < parameterTypes.size(); ++i) {
+        const int type = parameterTypes.at(i);
+        if (type == QMetaType::Void || type == QMetaType::UnknownType)
+            continue;
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+        v.push_back(QVariant(type, args[i + 1]));
+#else
+        v.push_back(QVariant(QMetaType(type), args[i + 1]));
+#endif
+    }
+    sendMethodCall(obj, Protocol::InvalidMethodId, object->metaObject()->method(methodIndex).name(), v);
+}
+
+void Endpoint::sendMethodCall(ObjectInfo *oi, Protocol::MethodId methodId, const QByteArray &method,
+                              const QVariantList &args) const
+{
+    Message msg(oi->address, Protocol::MethodCall);
+
+    if (methodId != Protocol::InvalidMethodId) {
+        const auto &info = resolveMethod(oi, methodId);
+        if (info.typed && info.parameterTypes.size() == args.size() && args.size() <= 10) {
+            QVariant converted[10];
+            const void *data[10] = {};
+            bool ok = true;
+            for (int i = 0; ok && i < args.size(); ++i) {
+                const auto type = info.parameterTypes.at(i);
+                const auto &arg = args.at(i);
+                if (type == QMetaType::QVariant) {
+                    converted[i] = arg.userType() == qMetaTypeId<VariantWrapper>() ? arg.value<VariantWrapper>().variant() : arg;
+                    data[i] = &converted[i];
+                } else if (arg.userType() == type) {
+                    data[i] = arg.constData();
+                } else {
+                    converted[i] = arg;
+                    ok = convertArgument(converted[i], type);
+                    data[i] = converted[i].constData();
+                }
+            }
+
+            if (ok) {
+                msg << methodId;
+                for (int i = 0; i < args.size(); ++i)
+                    msg << ArgumentWriter { info.parameterTypes.at(i), data[i] };
+                send(msg);
+                return;
+            }
+        }
+    }
+
+    // arguments don't match the method table entry, fall back to a call by name with type information
+    msg << Protocol::InvalidMethodId << (method.isEmpty() ? oi->methods.at(methodId).name : method) << args;
     send(msg);
 }
 
@@ -333,9 +543,17 @@ void Endpoint::dispatchMessage(const Message &msg)
 
     ObjectInfo *obj = it.value();
     if (msg.type() == Protocol::MethodCall) {
+        Protocol::MethodId methodId;
+        msg >> methodId;
         QByteArray method;
-        msg >> method;
-        if (obj->object) {
+        if (methodId == Protocol::InvalidMethodId)
+            msg >> method;
+        else if (methodId < obj->methods.size())
+            method = obj->methods.at(methodId).name;
+
+        if (obj->object && methodId != Protocol::InvalidMethodId) {
+            invokeMethodById(obj, methodId, msg);
+        } else if (obj->object) {
             Q_ASSERT(!method.isEmpty());
             QVariantList args;
             msg >> args;
@@ -368,6 +586,147 @@ QVector<QPair<Protocol::ObjectAddress, QString>> Endpoint::objectAddresses() con
     return addrs;
 }
 
+void Endpoint::invokeMethodById(ObjectInfo *oi, Protocol::MethodId methodId, const Message &msg)
+{
+    if (methodId >= oi->methods.size()) {
+        cerr << "invalid method id " << methodId << " for object " << qPrintable(oi->name)
+             << " with address " << quint64(oi->address) << endl;
+        return;
+    }
+
+    const auto &method = oi->methods.at(methodId);
+    const auto &info = resolveMethod(oi, methodId);
+    if (!info.method.isValid() || !info.typed || info.parameterTypes.size() > 10) {
+        cerr << "cannot call method " << method.name.constData() << " on object " << qPrintable(oi->name)
+             << " with address " << quint64(oi->address) << endl;
+        return;
+    }
+
+    void *data[10] = {};
+    QGenericArgument a[10] = {};
+    bool ok = true;
+    for (int i = 0; ok && i < info.parameterTypes.size(); ++i) {
+        data[i] = QMetaType::create(info.parameterTypes.at(i));
+        ArgumentReader arg = { info.parameterTypes.at(i), data[i], false };
+        msg >> arg;
+        ok = arg.ok;
+        a[i] = QGenericArgument(method.parameterTypes.at(i).constData(), data[i]);
+    }
+
+    if (ok) {
+        info.method.invoke(oi->object, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9]);
+    } else {
+        cerr << "failed to read arguments for method " << method.name.constData() << " on object "
+             << qPrintable(oi->name) << endl;
+    }
+
+    for (int i = 0; i < info.parameterTypes.size() && data[i]; ++i)
+        QMetaType::destroy(info.parameterTypes.at(i), data[i]);
+}
+
+void Endpoint::exportMethods(Protocol::ObjectAddress objectAddress)
+{
+    ObjectInfo *obj = m_addressMap.value(objectAddress, nullptr);
+    Q_ASSERT(obj);
+    Q_ASSERT(obj->object);
+    if (!obj || !obj->object)
+        return;
+
+    const QMetaObject *mo = obj->object->metaObject();
+    const int offset = QObject::staticMetaObject.methodCount();
+    obj->methods.clear();
+    obj->exportedFrom = mo;
+    obj->exportedIds.fill(-1, qMax(0, mo->methodCount() - offset));
+    for (int i = offset; i < mo->methodCount() && obj->methods.size() < Protocol::InvalidMethodId; ++i) {
+        const QMetaMethod method = mo->method(i);
+        if (method.methodType() != QMetaMethod::Signal && method.access() != QMetaMethod::Public)
+            continue;
+        obj->exportedIds[i - offset] = obj->methods.size();
+        Protocol::MethodSignature signature;
+        signature.name = method.name();
+        signature.parameterTypes = method.parameterTypes();
+        obj->methods.push_back(signature);
+    }
+    indexMethods(obj);
+}
+
+void Endpoint::setMethodTable(Protocol::ObjectAddress objectAddress, const Protocol::MethodTable &methods)
+{
+    ObjectInfo *obj = m_addressMap.value(objectAddress, nullptr);
+    Q_ASSERT(obj);
+    if (!obj)
+        return;
+
+    obj->methods = methods;
+    obj->exportedFrom = nullptr;
+    obj->exportedIds.clear();
+    indexMethods(obj);
+}
+
+Protocol::MethodTable Endpoint::methodTable(Protocol::ObjectAddress objectAddress) const
+{
+    const ObjectInfo *obj = m_addressMap.value(objectAddress, nullptr);
+    return obj ? obj->methods : Protocol::MethodTable();
+}
+
+QVector<QPair<Protocol::ObjectAddress, Protocol::MethodTable>> Endpoint::methodTables() const
+{
+    QVector<QPair<Protocol::ObjectAddress, Protocol::MethodTable>> tables;
+    for (auto it = m_addressMap.constBegin(); it != m_addressMap.constEnd(); ++it) {
+        if (!it.value()->methods.isEmpty())
+            tables.push_back(qMakePair(it.key(), it.value()->methods));
+    }
+    return tables;
+}
+
+void Endpoint::indexMethods(ObjectInfo *oi)
+{
+    oi->methodIds.clear();
+    oi->methodInfos.clear();
+    for (int i = 0; i < oi->methods.size(); ++i) {
+        const auto key = qMakePair(oi->methods.at(i).name, int(oi->methods.at(i).parameterTypes.size()));
+        auto it = oi->methodIds.find(key);
+        if (it == oi->methodIds.end())
+            oi->methodIds.insert(key, i);
+        else
+            it.value() = -1; // overloaded, needs to be called with the type information of the arguments
+    }
+}
+
+const Endpoint::MethodInfo &Endpoint::resolveMethod(ObjectInfo *oi, Protocol::MethodId methodId)
+{
+    Q_ASSERT(methodId < oi->methods.size());
+    if (oi->methodInfos.size() != oi->methods.size())
+        oi->methodInfos.resize(oi->methods.size());
+
+    auto &info = oi->methodInfos[methodId];
+    if (info.resolved)
+        return info;
+    info.resolved = true;
+
+    const auto &method = oi->methods.at(methodId);
+    info.typed = true;
+    info.parameterTypes.reserve(method.parameterTypes.size());
+    for (const auto &typeName : method.parameterTypes) {
+        const auto type = QMetaType::type(typeName);
+        if (type == QMetaType::UnknownType || type == QMetaType::Void) {
+            info.typed = false;
+            break;
+        }
+        info.parameterTypes.push_back(type);
+    }
+
+    if (oi->object) {
+        const QByteArray signature = method.name + '(' + method.parameterTypes.join(',') + ')';
+        const QMetaObject *mo = oi->object->metaObject();
+        const int index = mo->indexOfMethod(signature.constData());
+        if (index >= 0)
+            info.method = mo->method(index);
+    }
+
+    return info;
+}
+
 void Endpoint::insertObjectInfo(Endpoint::ObjectInfo *oi)
 {
     Q_ASSERT(!m_addressMap.contains(oi->address));
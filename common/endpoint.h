@@ -15,13 +15,18 @@
 #define GAMMARAY_ENDPOINT_H
 
 #include "gammaray_common_export.h"
+#include "messagelatency.h"
 #include "protocol.h"
 
+#include <QHash>
 #include <QMetaMethod>
 #include <QObject>
 #include <QPointer>
 #include <QTimer>
 
+#include <deque>
+#include <memory>
+
 #include <QLoggingCategory>
 Q_DECLARE_LOGGING_CATEGORY(networkstatistics)
 
@@ -33,6 +38,7 @@ QT_END_NAMESPACE
 namespace GammaRay {
 class Message;
 class PropertySyncer;
+class SessionRecorder;
 
 /*! Network protocol endpoint.
  *
@@ -85,6 +91,33 @@ public:
      */
     void waitForMessagesWritten();
 
+    /*!
+     * Start writing all messages sent or received by this endpoint to the capture file @p fileName.
+     * See SessionCapture for reading such a file. Captures recorded from the very beginning of
+     * a connection can be replayed into a client via a replay:// URL.
+     *
+     * @return @c false if @p fileName can't be written.
+     */
+    bool startRecording(const QString &fileName);
+    /*! Stop writing messages to the capture file. */
+    void stopRecording();
+    /*! Returns @c true if messages are currently recorded. */
+    bool isRecording() const;
+
+    /*!
+     * Latency statistics of this endpoint, see MessageLatencies.
+     * The time messages spend in the outgoing device buffer is measured here, round-trip
+     * and handling times are provided by the model and request handling code via recordLatency().
+     */
+    const MessageLatencies &messageLatencies() const;
+    /*! Discards all latency statistics collected so far. */
+    void clearMessageLatencies();
+    /*! Adds a latency sample of @p usecs microseconds, if there is an endpoint instance. */
+    static void recordLatency(MessageLatencies::Kind kind, Protocol::ObjectAddress address,
+                              Protocol::MessageType type, quint64 usecs);
+    /*! Monotonic timestamp in microseconds, for measuring latencies via recordLatency(). */
+    static quint64 latencyTimestamp();
+
     /*!
      * Returns a human-readable string describing the host program.
      */
@@ -188,6 +221,27 @@ protected:
     /*! All current object name/address pairs. */
     QVector<QPair<Protocol::ObjectAddress, QString>> objectAddresses() const;
 
+    /*! Makes the signals and public methods of the object registered at @p objectAddress callable by method id.
+     *  This is done by the endpoint owning the object, the resulting table is then sent to the other side.
+     */
+    void exportMethods(Protocol::ObjectAddress objectAddress);
+    /*! Call this when learning about the method table of the object at @p objectAddress. */
+    void setMethodTable(Protocol::ObjectAddress objectAddress, const Protocol::MethodTable &methods);
+    /*! The method table of the object at @p objectAddress. */
+    Protocol::MethodTable methodTable(Protocol::ObjectAddress objectAddress) const;
+    /*! All current non-empty method tables. */
+    QVector<QPair<Protocol::ObjectAddress, Protocol::MethodTable>> methodTables() const;
+
+    /*!
+     * Invoke the method with index @p methodIndex of the locally registered @p object on the remote side.
+     *
+     * @p parameterTypes are the meta type ids of the method parameters, @p args the arguments in
+     * qt_metacall layout, ie. starting at index 1. Unlike invokeObject() this does not need to look
+     * up the method by name, and writes the arguments without converting them to QVariants.
+     */
+    void invokeRemoteMethod(QObject *object, int methodIndex, const QVector<int> &parameterTypes,
+                            void **args) const;
+
     /*! Singleton instance. */
     static Endpoint *s_instance;
 
@@ -203,12 +257,24 @@ protected:
 
 private slots:
     void readyRead();
+    void messagesWritten(qint64 bytes);
     void doLogTransmissionRate();
     void connectionClosed();
     void slotHandlerDestroyed(QObject *obj);
     void slotObjectDestroyed(QObject *obj);
 
 private:
+    struct MethodInfo
+    {
+        // the method on the locally registered object, if it has it
+        QMetaMethod method;
+        // meta type ids of the parameters
+        QVector<int> parameterTypes;
+        // all parameter types are known, ie. arguments can be serialized without type information
+        bool typed = false;
+        bool resolved = false;
+    };
+
     struct ObjectInfo
     {
         ObjectInfo()
@@ -224,6 +290,16 @@ private:
         // custom message handling support
         QObject *receiver = nullptr;
         QMetaMethod messageHandler;
+
+        // negotiated method table, the position in there is the method id used on the wire
+        Protocol::MethodTable methods;
+        // method name and argument count -> method id, -1 for ambiguous overloads
+        QHash<QPair<QByteArray, int>, int> methodIds;
+        // lazily resolved local information for each entry in methods
+        QVector<MethodInfo> methodInfos;
+        // the meta object methods has been exported from, and the method id for each of its methods
+        const QMetaObject *exportedFrom = nullptr;
+        QVector<int> exportedIds;
     };
 
     /*! Inserts @p oi into all maps. */
@@ -231,6 +307,16 @@ private:
     /*! Removes @p oi from all maps and destroys it. */
     void removeObjectInfo(ObjectInfo *oi);
 
+    /*! Rebuilds the method id lookup table of @p oi. */
+    static void indexMethods(ObjectInfo *oi);
+    /*! Returns the local information for method @p methodId of @p oi, resolving it if needed. */
+    static const MethodInfo &resolveMethod(ObjectInfo *oi, Protocol::MethodId methodId);
+    /*! Sends a call of method @p methodId, or @p method if that is invalid, of @p oi. */
+    void sendMethodCall(ObjectInfo *oi, Protocol::MethodId methodId, const QByteArray &method,
+                        const QVariantList &args) const;
+    /*! Invokes method @p methodId of @p oi with the arguments read from @p msg. */
+    static void invokeMethodById(ObjectInfo *oi, Protocol::MethodId methodId, const Message &msg);
+
     QHash<QString, ObjectInfo *> m_nameMap;
     QHash<Protocol::ObjectAddress, ObjectInfo *> m_addressMap;
     QHash<QObject *, ObjectInfo *> m_objectMap;
@@ -245,6 +331,21 @@ private:
     QString m_label;
     QString m_key;
     qint64 m_pid;
+
+    std::unique_ptr<SessionRecorder> m_recorder;
+
+    struct QueuedMessage
+    {
+        // position of the message end in the stream of buffered bytes
+        quint64 end;
+        quint64 timestamp;
+        Protocol::ObjectAddress address;
+        Protocol::MessageType type;
+    };
+    std::deque<QueuedMessage> m_queuedMessages;
+    quint64 m_bytesQueued = 0;
+    quint64 m_bytesFlushed = 0;
+    MessageLatencies m_latencies;
 };
 }
 
@@ -0,0 +1,207 @@
+/*
+  messagelatency.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "messagelatency.h"
+
+#include <QDataStream>
+#include <QJsonArray>
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace GammaRay;
+
+static int bucketIndex(quint64 usecs)
+{
+    if (usecs < 2)
+        return 0;
+    return std::min<int>(63 - qCountLeadingZeroBits(usecs), LatencyHistogram::BucketCount - 1);
+}
+
+void LatencyHistogram::add(quint64 usecs)
+{
+    ++m_buckets[bucketIndex(usecs)];
+    ++m_count;
+    m_total += usecs;
+    m_max = std::max(m_max, usecs);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (int i = 0; i < BucketCount; ++i)
+        m_buckets[i] += other.m_buckets[i];
+    m_count += other.m_count;
+    m_total += other.m_total;
+    m_max = std::max(m_max, other.m_max);
+}
+
+quint64 LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+quint64 LatencyHistogram::total() const
+{
+    return m_total;
+}
+
+quint64 LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+double LatencyHistogram::mean() const
+{
+    return m_count ? double(m_total) / double(m_count) : 0.0;
+}
+
+quint64 LatencyHistogram::percentile(double p) const
+{
+    if (!m_count)
+        return 0;
+    const auto target = std::max<quint64>(1, static_cast<quint64>(std::ceil(qBound(0.0, p, 1.0) * m_count)));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= target)
+            return std::min(bucketLimit(i), m_max);
+    }
+    return m_max;
+}
+
+quint32 LatencyHistogram::bucketCount(int bucket) const
+{
+    Q_ASSERT(bucket >= 0 && bucket < BucketCount);
+    return m_buckets[bucket];
+}
+
+quint64 LatencyHistogram::bucketLimit(int bucket)
+{
+    if (bucket >= BucketCount - 1)
+        return std::numeric_limits<quint64>::max();
+    return quint64(2) << bucket;
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+    QJsonObject obj;
+    obj.insert(QStringLiteral("count"), double(m_count));
+    obj.insert(QStringLiteral("meanUs"), mean());
+    obj.insert(QStringLiteral("medianUs"), double(percentile(0.5)));
+    obj.insert(QStringLiteral("p90Us"), double(percentile(0.9)));
+    obj.insert(QStringLiteral("p99Us"), double(percentile(0.99)));
+    obj.insert(QStringLiteral("maxUs"), double(m_max));
+
+    // sparse, as most buckets are empty
+    QJsonArray buckets;
+    for (int i = 0; i < BucketCount; ++i) {
+        if (!m_buckets[i])
+            continue;
+        QJsonObject bucket;
+        if (i < BucketCount - 1)
+            bucket.insert(QStringLiteral("limitUs"), double(bucketLimit(i)));
+        bucket.insert(QStringLiteral("count"), double(m_buckets[i]));
+        buckets.push_back(bucket);
+    }
+    obj.insert(QStringLiteral("buckets"), buckets);
+    return obj;
+}
+
+quint32 MessageLatencies::key(Kind kind, Protocol::ObjectAddress address, Protocol::MessageType type)
+{
+    return quint32(address) << 16 | quint32(kind) << 8 | type;
+}
+
+void MessageLatencies::add(Kind kind, Protocol::ObjectAddress address, Protocol::MessageType type, quint64 usecs)
+{
+    m_histograms[key(kind, address, type)].add(usecs);
+}
+
+void MessageLatencies::clear()
+{
+    m_histograms.clear();
+}
+
+bool MessageLatencies::isEmpty() const
+{
+    return m_histograms.isEmpty();
+}
+
+QVector<MessageLatencies::Entry> MessageLatencies::entries() const
+{
+    QVector<Entry> entries;
+    entries.reserve(m_histograms.size());
+    for (auto it = m_histograms.constBegin(); it != m_histograms.constEnd(); ++it) {
+        Entry entry;
+        entry.address = it.key() >> 16;
+        entry.kind = static_cast<Kind>((it.key() >> 8) & 0xff);
+        entry.type = it.key() & 0xff;
+        entry.histogram = it.value();
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+QString MessageLatencies::kindName(Kind kind)
+{
+    switch (kind) {
+    case RoundTrip:
+        return QStringLiteral("RoundTrip");
+    case Queued:
+        return QStringLiteral("Queued");
+    case Handling:
+        return QStringLiteral("Handling");
+    }
+    return QString();
+}
+
+namespace GammaRay {
+QDataStream &operator<<(QDataStream &out, const LatencyHistogram &histogram)
+{
+    out << histogram.m_count << histogram.m_total << histogram.m_max;
+    for (const auto bucket : histogram.m_buckets)
+        out << bucket;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, LatencyHistogram &histogram)
+{
+    in >> histogram.m_count >> histogram.m_total >> histogram.m_max;
+    for (auto &bucket : histogram.m_buckets)
+        in >> bucket;
+    return in;
+}
+
+QDataStream &operator<<(QDataStream &out, const MessageLatencies &latencies)
+{
+    out << quint32(latencies.m_histograms.size());
+    for (auto it = latencies.m_histograms.constBegin(); it != latencies.m_histograms.constEnd(); ++it)
+        out << it.key() << it.value();
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, MessageLatencies &latencies)
+{
+    latencies.m_histograms.clear();
+    quint32 size;
+    in >> size;
+    for (quint32 i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+        quint32 key;
+        LatencyHistogram histogram;
+        in >> key >> histogram;
+        latencies.m_histograms.insert(key, histogram);
+    }
+    return in;
+}
+}
@@ -0,0 +1,123 @@
+/*
+  messagelatency.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_MESSAGELATENCY_H
+#define GAMMARAY_MESSAGELATENCY_H
+
+#include "gammaray_common_export.h"
+#include "protocol.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMetaType>
+#include <QVector>
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+class QDataStream;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+/**
+ * Histogram of latency samples, in microseconds.
+ *
+ * Buckets have power-of-two widths: bucket 0 holds samples below 2µs, bucket i
+ * samples in [2^i, 2^(i+1)) µs, and the last bucket everything beyond that.
+ */
+class GAMMARAY_COMMON_EXPORT LatencyHistogram
+{
+public:
+    enum
+    {
+        BucketCount = 26 // the last bucket starts at ~33s
+    };
+
+    void add(quint64 usecs);
+    void merge(const LatencyHistogram &other);
+
+    quint64 count() const;
+    quint64 total() const;
+    quint64 max() const;
+    /** Mean of all samples, in microseconds. */
+    double mean() const;
+    /** Upper bound of the bucket containing the @p p quantile (0..1), capped at max(). */
+    quint64 percentile(double p) const;
+
+    quint32 bucketCount(int bucket) const;
+    /** Exclusive upper bound of @p bucket, in microseconds. */
+    static quint64 bucketLimit(int bucket);
+
+    QJsonObject toJson() const;
+
+private:
+    friend GAMMARAY_COMMON_EXPORT QDataStream &operator<<(QDataStream &out, const LatencyHistogram &histogram);
+    friend GAMMARAY_COMMON_EXPORT QDataStream &operator>>(QDataStream &in, LatencyHistogram &histogram);
+
+    std::array<quint32, BucketCount> m_buckets = {};
+    quint64 m_count = 0;
+    quint64 m_total = 0;
+    quint64 m_max = 0;
+};
+
+/**
+ * Latency histograms of the GammaRay-internal communication, per object address,
+ * message type and kind of measurement. Each Endpoint collects its own.
+ */
+class GAMMARAY_COMMON_EXPORT MessageLatencies
+{
+public:
+    enum Kind : quint8
+    {
+        /** From sending a request to receiving its reply, keyed by the request type. */
+        RoundTrip,
+        /** Time a message spent in the outgoing device buffer. */
+        Queued,
+        /** Time spent handling an incoming message. */
+        Handling
+    };
+
+    struct Entry
+    {
+        Protocol::ObjectAddress address;
+        Kind kind;
+        Protocol::MessageType type;
+        LatencyHistogram histogram;
+    };
+
+    void add(Kind kind, Protocol::ObjectAddress address, Protocol::MessageType type, quint64 usecs);
+    void clear();
+    bool isEmpty() const;
+
+    /** All non-empty histograms, in no particular order. */
+    QVector<Entry> entries() const;
+
+    static QString kindName(Kind kind);
+
+private:
+    friend GAMMARAY_COMMON_EXPORT QDataStream &operator<<(QDataStream &out, const MessageLatencies &latencies);
+    friend GAMMARAY_COMMON_EXPORT QDataStream &operator>>(QDataStream &in, MessageLatencies &latencies);
+
+    static quint32 key(Kind kind, Protocol::ObjectAddress address, Protocol::MessageType type);
+
+    QHash<quint32, LatencyHistogram> m_histograms;
+};
+
+GAMMARAY_COMMON_EXPORT QDataStream &operator<<(QDataStream &out, const LatencyHistogram &histogram);
+GAMMARAY_COMMON_EXPORT QDataStream &operator>>(QDataStream &in, LatencyHistogram &histogram);
+GAMMARAY_COMMON_EXPORT QDataStream &operator<<(QDataStream &out, const MessageLatencies &latencies);
+GAMMARAY_COMMON_EXPORT QDataStream &operator>>(QDataStream &in, MessageLatencies &latencies);
+}
+
+Q_DECLARE_METATYPE(GammaRay::MessageLatencies)
+
+#endif // GAMMARAY_MESSAGELATENCY_H
@@ -43,10 +43,17 @@ public:
     bool hasStackTrace() const;
     void setHasStackTrace(bool hasStackTrace);
 
+public slots:
+    /** Request the current paint buffer in the compact recording format, delivered via recordingChunk(). */
+    virtual void requestRecording() = 0;
+
 Q_SIGNALS:
     void hasArgumentDetailsChanged(bool);
     void hasStackTraceChanged(bool);
 
+    /** Part of the recording requested by requestRecording(), @p offset and @p totalSize are in bytes. */
+    void recordingChunk(int offset, int totalSize, const QByteArray &data);
+
 private:
     QString m_name;
     bool m_hasArgumentDetails;
@@ -14,6 +14,8 @@
 #ifndef GAMMARAY_PROBECONTROLLERINTERFACE_H
 #define GAMMARAY_PROBECONTROLLERINTERFACE_H
 
+#include "messagelatency.h"
+
 #include <QObject>
 #include <QDataStream>
 #include <QDebug>
@@ -36,6 +38,12 @@ public:
     /*! Detach GammaRay but keep host application running. */
     virtual void detachProbe() = 0;
 
+    /*! Request the latency statistics of the probe, answered by messageLatenciesReceived(). */
+    virtual void requestMessageLatencies() = 0;
+
+signals:
+    void messageLatenciesReceived(const GammaRay::MessageLatencies &latencies);
+
 private:
     Q_DISABLE_COPY(ProbeControllerInterface)
 };
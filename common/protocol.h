@@ -33,6 +33,8 @@ using PayloadSize = qint32;
 using ObjectAddress = quint16;
 /*! Message type type. */
 using MessageType = quint8;
+/*! Remote method id type, an index into the MethodTable of the receiving object. */
+using MethodId = quint16;
 
 /*! Invalid object address. */
 static const ObjectAddress InvalidObjectAddress = 0;
@@ -40,6 +42,8 @@ static const ObjectAddress InvalidObjectAddress = 0;
 static const ObjectAddress LauncherAddress = std::numeric_limits<ObjectAddress>::max();
 /*! Invalid message type. */
 static const MessageType InvalidMessageType = 0;
+/*! Method id of method calls addressing the method by name. */
+static const MethodId InvalidMethodId = std::numeric_limits<MethodId>::max();
 
 /*! Protocol message types. */
 enum BuildInMessageType
@@ -129,6 +133,15 @@ struct ItemSelectionRange
 /*! Protocol representation of an QItemSelection. */
 using ItemSelection = QVector<ItemSelectionRange>;
 
+/*! Transport protocol representation of a remotely invokable method. */
+struct MethodSignature
+{
+    QByteArray name;
+    QList<QByteArray> parameterTypes;
+};
+/*! Methods of a registered object, the position in this table is the MethodId used in method calls. */
+using MethodTable = QVector<MethodSignature>;
+
 /*! Serializes a QModelIndex. */
 GAMMARAY_COMMON_EXPORT ModelIndex fromQModelIndex(const QModelIndex &index);
 
@@ -158,6 +171,17 @@ inline QDataStream &operator<<(QDataStream &s, const GammaRay::Protocol::ModelIn
     return s;
 }
 
+inline QDataStream &operator>>(QDataStream &s, GammaRay::Protocol::MethodSignature &method)
+{
+    s >> method.name >> method.parameterTypes;
+    return s;
+}
+inline QDataStream &operator<<(QDataStream &s, const GammaRay::Protocol::MethodSignature &method)
+{
+    s << method.name << method.parameterTypes;
+    return s;
+}
+
 inline QDebug &operator<<(QDebug &s, const GammaRay::Protocol::ModelIndexData &data)
 {
     s << '(' << data.row << ',' << data.column << ')';
@@ -167,6 +191,7 @@ inline QDebug &operator<<(QDebug &s, const GammaRay::Protocol::ModelIndexData &d
 
 Q_DECLARE_TYPEINFO(GammaRay::Protocol::ModelIndexData, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(GammaRay::Protocol::ItemSelectionRange, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(GammaRay::Protocol::MethodSignature, Q_MOVABLE_TYPE);
 QT_END_NAMESPACE
 
 #endif
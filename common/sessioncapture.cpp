@@ -0,0 +1,191 @@
+/*
+  sessioncapture.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "sessioncapture.h"
+#include "message.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QtEndian>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace GammaRay;
+
+static const char s_magic[] = { 'G', 'R', 'S', 'C' };
+static const quint8 s_formatVersion = 1;
+static const int FileHeaderSize = 16;
+static const int RecordHeaderSize = sizeof(quint64) + 2;
+static const int MessageHeaderSize = sizeof(Protocol::PayloadSize) + sizeof(Protocol::ObjectAddress) + sizeof(Protocol::MessageType);
+
+SessionCapture::SessionCapture() = default;
+
+SessionCapture::~SessionCapture()
+{
+    close();
+}
+
+bool SessionCapture::open(const QString &fileName)
+{
+    close();
+    m_errorString.clear();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return fail(m_file.errorString());
+
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        m_fallbackData = m_file.readAll();
+        m_data = reinterpret_cast<const uchar *>(m_fallbackData.constData());
+    }
+
+    if (m_size < FileHeaderSize || memcmp(m_data, s_magic, sizeof(s_magic)) != 0)
+        return fail(QCoreApplication::translate("GammaRay::SessionCapture", "Not a GammaRay session capture."));
+    if (m_data[4] != s_formatVersion)
+        return fail(QCoreApplication::translate("GammaRay::SessionCapture", "Unsupported session capture version %1.").arg(static_cast<int>(m_data[4])));
+    m_startTime = qFromBigEndian<qint64>(m_data + 8);
+
+    // a truncated last record is ignored, that's what an aborted recording leaves behind
+    qint64 offset = FileHeaderSize;
+    while (offset + RecordHeaderSize + MessageHeaderSize <= m_size) {
+        const auto payloadSize = std::abs(qFromBigEndian<Protocol::PayloadSize>(m_data + offset + RecordHeaderSize));
+        const qint64 recordSize = RecordHeaderSize + MessageHeaderSize + payloadSize;
+        if (offset + recordSize > m_size)
+            break;
+        m_offsets.push_back(offset);
+        offset += recordSize;
+    }
+    return true;
+}
+
+void SessionCapture::close()
+{
+    if (m_data && m_fallbackData.isEmpty())
+        m_file.unmap(const_cast<uchar *>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+    m_fallbackData.clear();
+    m_offsets.clear();
+    m_file.close();
+}
+
+bool SessionCapture::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+QString SessionCapture::errorString() const
+{
+    return m_errorString;
+}
+
+bool SessionCapture::fail(const QString &error)
+{
+    close();
+    m_errorString = error;
+    return false;
+}
+
+QDateTime SessionCapture::startTime() const
+{
+    return QDateTime::fromMSecsSinceEpoch(m_startTime);
+}
+
+int SessionCapture::count() const
+{
+    return m_offsets.size();
+}
+
+SessionCapture::Record SessionCapture::record(int index) const
+{
+    Q_ASSERT(index >= 0 && index < m_offsets.size());
+    const auto offset = m_offsets.at(index);
+    const auto end = index + 1 < m_offsets.size() ? m_offsets.at(index + 1) : m_size;
+    const auto data = m_data + offset;
+
+    Record record;
+    record.timestamp = qFromBigEndian<quint64>(data);
+    record.direction = static_cast<Direction>(data[8]);
+    record.dataVersion = data[9];
+    record.address = qFromBigEndian<Protocol::ObjectAddress>(data + RecordHeaderSize + sizeof(Protocol::PayloadSize));
+    record.type = data[RecordHeaderSize + sizeof(Protocol::PayloadSize) + sizeof(Protocol::ObjectAddress)];
+    record.data = QByteArray::fromRawData(reinterpret_cast<const char *>(data) + RecordHeaderSize, end - offset - RecordHeaderSize);
+    return record;
+}
+
+Message SessionCapture::message(int index) const
+{
+    const auto r = record(index);
+    QByteArray data = r.data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    // the payload stream version is taken from the negotiated one
+    const auto negotiatedVersion = Message::negotiatedDataVersion();
+    Message::setNegotiatedDataVersion(r.dataVersion);
+    auto msg = Message::readMessage(&buffer);
+    Message::setNegotiatedDataVersion(negotiatedVersion);
+    return msg;
+}
+
+SessionRecorder::SessionRecorder() = default;
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+bool SessionRecorder::open(const QString &fileName)
+{
+    close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    char header[FileHeaderSize] = {};
+    memcpy(header, s_magic, sizeof(s_magic));
+    header[4] = s_formatVersion;
+    qToBigEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), header + 8);
+    m_file.write(header, sizeof(header));
+    m_clock.start();
+    return true;
+}
+
+void SessionRecorder::close()
+{
+    m_file.close();
+}
+
+bool SessionRecorder::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+QString SessionRecorder::errorString() const
+{
+    return m_file.errorString();
+}
+
+void SessionRecorder::record(SessionCapture::Direction direction, const Message &msg)
+{
+    if (!m_file.isOpen())
+        return;
+
+    char header[RecordHeaderSize];
+    qToBigEndian<quint64>(m_clock.nsecsElapsed() / 1000, header);
+    header[8] = direction;
+    header[9] = Message::negotiatedDataVersion();
+    m_file.write(header, sizeof(header));
+    msg.write(&m_file);
+}
@@ -0,0 +1,110 @@
+/*
+  sessioncapture.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SESSIONCAPTURE_H
+#define GAMMARAY_SESSIONCAPTURE_H
+
+#include "gammaray_common_export.h"
+#include "protocol.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QVector>
+
+namespace GammaRay {
+class Message;
+
+/**
+ * Read access to a recorded client/probe session, as written by SessionRecorder.
+ *
+ * Capture file format, all numbers in network byte order:
+ * - 4 bytes magic "GRSC", 1 byte format version, 3 bytes reserved
+ * - 8 byte recording start time, in milliseconds since the epoch
+ * - followed by one entry per message:
+ *   - 8 byte timestamp, in microseconds since the recording start
+ *   - 1 byte direction, see Direction
+ *   - 1 byte QDataStream version the payload was encoded with
+ *   - the message in its wire format, see Message
+ *
+ * The file is memory-mapped, records refer to the mapped data directly.
+ */
+class GAMMARAY_COMMON_EXPORT SessionCapture
+{
+public:
+    enum Direction : quint8
+    {
+        Incoming = 0,
+        Outgoing = 1
+    };
+
+    struct Record
+    {
+        quint64 timestamp = 0;
+        Direction direction = Incoming;
+        quint8 dataVersion = 0;
+        Protocol::ObjectAddress address = Protocol::InvalidObjectAddress;
+        Protocol::MessageType type = Protocol::InvalidMessageType;
+        /** The message in its wire format, referring to the mapped capture file. */
+        QByteArray data;
+    };
+
+    SessionCapture();
+    ~SessionCapture();
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const;
+    QString errorString() const;
+
+    QDateTime startTime() const;
+    int count() const;
+    Record record(int index) const;
+    /** Decodes the message of record @p index. */
+    Message message(int index) const;
+
+private:
+    Q_DISABLE_COPY(SessionCapture)
+    bool fail(const QString &error);
+
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    QByteArray m_fallbackData;
+    qint64 m_startTime = 0;
+    QVector<qint64> m_offsets;
+    QString m_errorString;
+};
+
+/** Writes all messages passing an Endpoint into a capture file, see SessionCapture. */
+class GAMMARAY_COMMON_EXPORT SessionRecorder
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const;
+    QString errorString() const;
+
+    void record(SessionCapture::Direction direction, const Message &msg);
+
+private:
+    Q_DISABLE_COPY(SessionRecorder)
+    QFile m_file;
+    QElapsedTimer m_clock;
+};
+}
+
+#endif // GAMMARAY_SESSIONCAPTURE_H
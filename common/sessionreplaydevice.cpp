@@ -0,0 +1,136 @@
+/*
+  sessionreplaydevice.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "sessionreplaydevice.h"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace GammaRay;
+
+// upper limit of data delivered per event loop iteration when replaying as fast as possible
+static const int MaxBatchSize = 1024 * 1024;
+
+SessionReplayDevice::SessionReplayDevice(QObject *parent)
+    : QIODevice(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &SessionReplayDevice::deliver);
+}
+
+SessionReplayDevice::~SessionReplayDevice() = default;
+
+bool SessionReplayDevice::openCapture(const QString &fileName)
+{
+    if (!m_capture.open(fileName)) {
+        setErrorString(m_capture.errorString());
+        return false;
+    }
+    m_next = 0;
+    m_delivered = 0;
+    return open(QIODevice::ReadWrite);
+}
+
+void SessionReplayDevice::setSpeed(double speed)
+{
+    m_speed = std::max(0.0, speed);
+}
+
+void SessionReplayDevice::start()
+{
+    m_clock.start();
+    m_timer->start(0);
+}
+
+int SessionReplayDevice::deliveredCount() const
+{
+    return m_delivered;
+}
+
+bool SessionReplayDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 SessionReplayDevice::bytesAvailable() const
+{
+    return m_buffer.size() - m_bufferOffset + QIODevice::bytesAvailable();
+}
+
+void SessionReplayDevice::close()
+{
+    m_timer->stop();
+    m_buffer.clear();
+    m_bufferOffset = 0;
+    m_capture.close();
+    QIODevice::close();
+}
+
+void SessionReplayDevice::disconnectFromPeer()
+{
+    close();
+    emit disconnected();
+}
+
+qint64 SessionReplayDevice::readData(char *data, qint64 maxSize)
+{
+    const auto size = std::min<qint64>(maxSize, m_buffer.size() - m_bufferOffset);
+    memcpy(data, m_buffer.constData() + m_bufferOffset, size);
+    m_bufferOffset += size;
+    if (m_bufferOffset == m_buffer.size()) {
+        m_buffer.resize(0);
+        m_bufferOffset = 0;
+    }
+    return size;
+}
+
+qint64 SessionReplayDevice::writeData(const char *data, qint64 size)
+{
+    Q_UNUSED(data);
+    return size;
+}
+
+void SessionReplayDevice::deliver()
+{
+    const quint64 now = m_speed > 0.0 ? m_clock.nsecsElapsed() / 1000 * m_speed : 0;
+    const int batchStart = m_buffer.size();
+    while (m_next < m_capture.count()) {
+        const auto record = m_capture.record(m_next);
+        if (m_speed > 0.0 ? record.timestamp > now : m_buffer.size() - batchStart >= MaxBatchSize)
+            break;
+        ++m_next;
+        if (record.direction != SessionCapture::Incoming)
+            continue;
+        m_buffer.append(record.data.constData(), record.data.size());
+        ++m_delivered;
+    }
+
+    if (m_buffer.size() > batchStart)
+        emit readyRead();
+    if (!isOpen())
+        return; // closed by the reader
+
+    if (m_next >= m_capture.count()) {
+        emit finished();
+        return;
+    }
+
+    if (m_speed > 0.0) {
+        const auto next = m_capture.record(m_next).timestamp;
+        m_timer->start(static_cast<int>((next - now) / m_speed / 1000));
+    } else {
+        m_timer->start(0);
+    }
+}
@@ -0,0 +1,86 @@
+/*
+  sessionreplaydevice.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SESSIONREPLAYDEVICE_H
+#define GAMMARAY_SESSIONREPLAYDEVICE_H
+
+#include "gammaray_common_export.h"
+#include "sessioncapture.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QIODevice>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+/**
+ * Sequential I/O device playing back the incoming messages of a recorded session,
+ * so an endpoint can be run against it without the other side.
+ *
+ * Everything written to the device is discarded. Messages are either delivered with
+ * their recorded timing, optionally sped up, or as fast as the reader keeps up.
+ */
+class GAMMARAY_COMMON_EXPORT SessionReplayDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    explicit SessionReplayDevice(QObject *parent = nullptr);
+    ~SessionReplayDevice() override;
+
+    /** Opens the capture @p fileName, and the device for reading and writing. */
+    bool openCapture(const QString &fileName);
+
+    /**
+     * Playback speed relative to the recording, 0 delivers messages as fast as possible.
+     * Default is 0.
+     */
+    void setSpeed(double speed);
+
+    /** Starts delivering messages. */
+    void start();
+    /** Number of messages delivered so far. */
+    int deliveredCount() const;
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    void close() override;
+
+    void disconnectFromPeer();
+
+signals:
+    /** Emitted once all messages of the capture have been delivered. */
+    void finished();
+    void disconnected();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 size) override;
+
+private slots:
+    void deliver();
+
+private:
+    SessionCapture m_capture;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    QByteArray m_buffer;
+    int m_bufferOffset = 0;
+    int m_next = 0;
+    int m_delivered = 0;
+    double m_speed = 0.0;
+};
+}
+
+#endif // GAMMARAY_SESSIONREPLAYDEVICE_H
@@ -0,0 +1,451 @@
+/*
+  sharedmemorydevice.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "sharedmemorydevice.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QSharedMemory>
+#include <QtMath>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+using namespace GammaRay;
+
+// both processes access the ring positions concurrently
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "shared memory transport requires lock-free atomics");
+
+namespace GammaRay {
+/*
+ * Control block of one direction. Positions are monotonically increasing byte counts,
+ * the offset into the ring data is the position modulo the ring size.
+ *
+ * The waiting flags implement the wakeup handshake: a side that runs out of data (or space)
+ * sets its flag and then checks the position again, the other side updates the position and
+ * then clears the flag, sending a wakeup if it was set. With sequentially consistent
+ * operations at least one of them observes the other, so no wakeup is lost.
+ */
+struct SharedMemoryRing
+{
+    // updated by the writer
+    alignas(64) std::atomic<quint64> writePos;
+    std::atomic<quint32> writerWaiting;
+    // updated by the reader
+    alignas(64) std::atomic<quint64> readPos;
+    std::atomic<quint32> readerWaiting;
+};
+}
+
+/*
+ * Segment layout:
+ * - SegmentHeader, padded to a cache line
+ * - two ring control blocks, the first one for data from server to client, the second one for the opposite direction
+ * - the data of the two rings, ringSize bytes each
+ */
+namespace {
+struct SegmentHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 ringSize;
+    quint32 reserved;
+};
+
+static const quint32 SegmentMagic = 0x47527368; // "GRsh"
+static const quint32 SegmentVersion = 1;
+static const int HeaderSize = 64;
+static const int DataOffset = HeaderSize + 2 * sizeof(SharedMemoryRing);
+static const char AnnouncementTag[] = "GammaRay-shm";
+static const char WakeupByte = 'w';
+
+static_assert(sizeof(SegmentHeader) <= HeaderSize, "segment header does not fit");
+
+SharedMemoryRing *ringAt(char *base, int index)
+{
+    return reinterpret_cast<SharedMemoryRing *>(base + HeaderSize) + index;
+}
+
+int remainingTime(int msecs, const QElapsedTimer &timer)
+{
+    if (msecs < 0)
+        return -1;
+    return qMax<int>(0, msecs - timer.elapsed());
+}
+}
+
+SharedMemoryDevice::SharedMemoryDevice(QLocalSocket *control, QObject *parent)
+    : QIODevice(parent)
+    , m_control(control)
+{
+    m_control->setParent(this);
+    connect(m_control, &QLocalSocket::readyRead, this, &SharedMemoryDevice::controlReadyRead);
+    connect(m_control, &QLocalSocket::disconnected, this, &SharedMemoryDevice::controlDisconnected);
+}
+
+SharedMemoryDevice::~SharedMemoryDevice()
+{
+    detach();
+}
+
+bool SharedMemoryDevice::createSegment(int ringSize)
+{
+    Q_ASSERT(!m_base);
+    m_server = true;
+    m_ringSize = qNextPowerOfTwo(quint32(qBound(4096, ringSize, 256 * 1024 * 1024) - 1));
+    const int size = int(DataOffset + 2 * m_ringSize);
+
+#if QT_CONFIG(sharedmemory)
+    static QAtomicInt segmentCounter;
+    m_segment = new QSharedMemory(this);
+    // keys of crashed processes might still be around, so retry a few times on collision
+    for (int attempt = 0; attempt < 8 && !m_segment->isAttached(); ++attempt) {
+        m_segment->setKey(QStringLiteral("gammaray-%1-%2").arg(QCoreApplication::applicationPid()).arg(segmentCounter.fetchAndAddRelaxed(1)));
+        if (!m_segment->create(size) && m_segment->error() != QSharedMemory::AlreadyExists)
+            break;
+    }
+    if (!m_segment->isAttached()) {
+        qWarning() << "Failed to create shared memory segment:" << m_segment->errorString();
+        setErrorString(m_segment->errorString());
+        return false;
+    }
+
+    m_base = static_cast<char *>(m_segment->data());
+    memset(m_base, 0, DataOffset);
+    auto header = reinterpret_cast<SegmentHeader *>(m_base);
+    header->magic = SegmentMagic;
+    header->version = SegmentVersion;
+    header->ringSize = m_ringSize;
+    for (int i = 0; i < 2; ++i) {
+        auto ring = new (ringAt(m_base, i)) SharedMemoryRing;
+        ring->writePos.store(0);
+        ring->writerWaiting.store(0);
+        ring->readPos.store(0);
+        ring->readerWaiting.store(0);
+    }
+
+    const QByteArray announcement = QByteArray(AnnouncementTag) + ' ' + QByteArray::number(SegmentVersion) + ' '
+        + m_segment->key().toUtf8() + ' ' + QByteArray::number(m_ringSize) + '\n';
+    m_control->write(announcement);
+    m_control->flush();
+
+    open(QIODevice::ReadWrite);
+    scheduleProcessing();
+    return true;
+#else
+    Q_UNUSED(size);
+    setErrorString(tr("Shared memory is not supported on this platform."));
+    return false;
+#endif
+}
+
+void SharedMemoryDevice::attachSegment()
+{
+    Q_ASSERT(!m_base);
+    m_server = false;
+    m_awaitingAnnouncement = true;
+    if (m_control->canReadLine())
+        controlReadyRead();
+}
+
+void SharedMemoryDevice::readAnnouncement()
+{
+    m_awaitingAnnouncement = false;
+    const auto fields = m_control->readLine().trimmed().split(' ');
+    if (fields.size() != 4 || fields.at(0) != AnnouncementTag || fields.at(1).toUInt() != SegmentVersion) {
+        emit attachFailed(tr("Unsupported shared memory transport version."));
+        return;
+    }
+
+#if QT_CONFIG(sharedmemory)
+    m_segment = new QSharedMemory(QString::fromUtf8(fields.at(2)), this);
+    if (!m_segment->attach()) {
+        emit attachFailed(m_segment->errorString());
+        return;
+    }
+
+    const auto header = static_cast<const SegmentHeader *>(m_segment->constData());
+    m_ringSize = fields.at(3).toULongLong();
+    if (m_segment->size() < DataOffset || header->magic != SegmentMagic || header->version != SegmentVersion
+        || header->ringSize != m_ringSize || m_segment->size() < qint64(DataOffset + 2 * m_ringSize)) {
+        m_segment->detach();
+        emit attachFailed(tr("Invalid shared memory segment."));
+        return;
+    }
+    m_base = static_cast<char *>(m_segment->data());
+
+    open(QIODevice::ReadWrite);
+    scheduleProcessing();
+    emit attached();
+#else
+    emit attachFailed(tr("Shared memory is not supported on this platform."));
+#endif
+}
+
+void SharedMemoryDevice::detach()
+{
+    m_base = nullptr;
+#if QT_CONFIG(sharedmemory)
+    if (m_segment)
+        m_segment->detach();
+#endif
+}
+
+SharedMemoryRing *SharedMemoryDevice::inRing() const
+{
+    return ringAt(m_base, m_server ? 1 : 0);
+}
+
+SharedMemoryRing *SharedMemoryDevice::outRing() const
+{
+    return ringAt(m_base, m_server ? 0 : 1);
+}
+
+char *SharedMemoryDevice::inData() const
+{
+    return m_base + DataOffset + (m_server ? m_ringSize : 0);
+}
+
+char *SharedMemoryDevice::outData() const
+{
+    return m_base + DataOffset + (m_server ? 0 : m_ringSize);
+}
+
+bool SharedMemoryDevice::isSequential() const
+{
+    return true;
+}
+
+quint64 SharedMemoryDevice::ringAvailable() const
+{
+    if (!m_base)
+        return 0;
+    const auto ring = inRing();
+    return ring->writePos.load(std::memory_order_acquire) - ring->readPos.load(std::memory_order_relaxed);
+}
+
+qint64 SharedMemoryDevice::bytesAvailable() const
+{
+    return QIODevice::bytesAvailable() + ringAvailable();
+}
+
+qint64 SharedMemoryDevice::bytesToWrite() const
+{
+    return m_pending.size() - m_pendingOffset;
+}
+
+qint64 SharedMemoryDevice::readData(char *data, qint64 maxSize)
+{
+    if (!m_base)
+        return -1;
+
+    const auto ring = inRing();
+    const auto readPos = ring->readPos.load(std::memory_order_relaxed);
+    const auto count = qMin<quint64>(maxSize, ring->writePos.load(std::memory_order_acquire) - readPos);
+    if (count == 0)
+        return 0;
+
+    const auto offset = readPos & (m_ringSize - 1);
+    const auto first = qMin(count, m_ringSize - offset);
+    memcpy(data, inData() + offset, first);
+    memcpy(data + first, inData(), count - first);
+
+    ring->readPos.store(readPos + count);
+    if (ring->writerWaiting.exchange(0))
+        wakePeer();
+    return count;
+}
+
+qint64 SharedMemoryDevice::writeData(const char *data, qint64 size)
+{
+    if (!m_base)
+        return -1;
+
+    // keep the order, anything queued before has to go first
+    qint64 written = 0;
+    if (m_pendingOffset == m_pending.size())
+        written = writeToRing(data, size);
+    if (written < size) {
+        m_pending.append(data + written, size - written);
+        flushPending();
+    }
+    return size;
+}
+
+quint64 SharedMemoryDevice::writeToRing(const char *data, quint64 size)
+{
+    const auto ring = outRing();
+    const auto writePos = ring->writePos.load(std::memory_order_relaxed);
+    const auto count = qMin(size, m_ringSize - (writePos - ring->readPos.load()));
+    if (count == 0)
+        return 0;
+
+    const auto offset = writePos & (m_ringSize - 1);
+    const auto first = qMin(count, m_ringSize - offset);
+    memcpy(outData() + offset, data, first);
+    memcpy(outData(), data + first, count - first);
+
+    ring->writePos.store(writePos + count);
+    if (ring->readerWaiting.exchange(0))
+        wakePeer();
+    return count;
+}
+
+void SharedMemoryDevice::flushPending()
+{
+    if (!m_base)
+        return;
+
+    const auto ring = outRing();
+    while (m_pendingOffset < m_pending.size()) {
+        const auto written = writeToRing(m_pending.constData() + m_pendingOffset, m_pending.size() - m_pendingOffset);
+        if (written) {
+            m_pendingOffset += int(written);
+            continue;
+        }
+        // ring is full, have the reader notify us once it made room
+        ring->writerWaiting.store(1);
+        if (ring->writePos.load(std::memory_order_relaxed) - ring->readPos.load() == m_ringSize)
+            break;
+    }
+
+    if (m_pendingOffset == m_pending.size()) {
+        m_pending.clear();
+        m_pendingOffset = 0;
+    }
+}
+
+void SharedMemoryDevice::wakePeer()
+{
+    m_control->write(&WakeupByte, 1);
+    m_control->flush();
+}
+
+void SharedMemoryDevice::drainControl()
+{
+    // wakeup bytes carry no information, the ring positions tell what happened
+    m_control->readAll();
+}
+
+void SharedMemoryDevice::controlReadyRead()
+{
+    if (m_awaitingAnnouncement) {
+        if (!m_control->canReadLine())
+            return;
+        readAnnouncement();
+    }
+    if (!m_base)
+        return;
+
+    drainControl();
+    flushPending();
+    processIncoming();
+}
+
+void SharedMemoryDevice::controlDisconnected()
+{
+    // deliver whatever the peer wrote before closing the connection
+    processIncoming();
+    emit disconnected();
+}
+
+void SharedMemoryDevice::scheduleProcessing()
+{
+    if (m_processScheduled)
+        return;
+    m_processScheduled = true;
+    QMetaObject::invokeMethod(this, "processIncoming", Qt::QueuedConnection);
+}
+
+void SharedMemoryDevice::processIncoming()
+{
+    m_processScheduled = false;
+    if (!m_base)
+        return;
+
+    const auto ring = inRing();
+    while (true) {
+        const auto writePos = ring->writePos.load();
+        if (writePos != m_notifiedWritePos) {
+            m_notifiedWritePos = writePos;
+            emit readyRead();
+            if (!m_base)
+                return;
+            continue;
+        }
+        // nothing new since the last notification, have the writer wake us up on its next write
+        ring->readerWaiting.store(1);
+        if (ring->writePos.load() == m_notifiedWritePos)
+            break;
+    }
+}
+
+bool SharedMemoryDevice::waitForReadyRead(int msecs)
+{
+    if (!m_base)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+    const auto ring = inRing();
+    while (ring->writePos.load() == m_notifiedWritePos) {
+        ring->readerWaiting.store(1);
+        if (ring->writePos.load() != m_notifiedWritePos)
+            break;
+        if (!m_control->waitForReadyRead(remainingTime(msecs, timer)))
+            return false;
+        drainControl();
+        flushPending();
+    }
+
+    processIncoming();
+    return true;
+}
+
+bool SharedMemoryDevice::waitForBytesWritten(int msecs)
+{
+    if (!m_base)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+    flushPending();
+    while (bytesToWrite() > 0) {
+        if (!m_control->waitForReadyRead(remainingTime(msecs, timer)))
+            return false;
+        drainControl();
+        flushPending();
+        // the wakeup might have been meant for the reading direction as well
+        scheduleProcessing();
+    }
+    return true;
+}
+
+void SharedMemoryDevice::close()
+{
+    if (!isOpen())
+        return;
+    QIODevice::close();
+    m_pending.clear();
+    m_pendingOffset = 0;
+    detach();
+    m_control->disconnectFromServer();
+}
+
+void SharedMemoryDevice::disconnectFromPeer()
+{
+    m_control->disconnectFromServer();
+}
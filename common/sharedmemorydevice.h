@@ -0,0 +1,116 @@
+/*
+  sharedmemorydevice.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SHAREDMEMORYDEVICE_H
+#define GAMMARAY_SHAREDMEMORYDEVICE_H
+
+#include "gammaray_common_export.h"
+
+#include <QByteArray>
+#include <QIODevice>
+
+QT_BEGIN_NAMESPACE
+class QLocalSocket;
+class QSharedMemory;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+struct SharedMemoryRing;
+
+/**
+ * Sequential I/O device for same-host connections, transferring data through
+ * a pair of single producer/single consumer byte rings in a shared memory segment.
+ *
+ * A local socket serves as control channel: the server side announces the segment
+ * on it, it carries wakeup notifications, and its disconnection ends the session.
+ * Wakeups are only sent when the peer indicated it is waiting for data or for free
+ * space, so a busy connection does not touch the control socket at all.
+ *
+ * Writes never block, data not fitting into the ring is queued locally and
+ * streamed into the ring as the reader makes room.
+ */
+class GAMMARAY_COMMON_EXPORT SharedMemoryDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    /** Takes ownership of @p control, which has to be connected already. */
+    explicit SharedMemoryDevice(QLocalSocket *control, QObject *parent = nullptr);
+    ~SharedMemoryDevice() override;
+
+    /** Default size of each of the two rings, in bytes. */
+    static const int DefaultRingSize = 4 * 1024 * 1024;
+
+    /**
+     * Server side: creates a new segment with two rings of @p ringSize bytes each,
+     * announces it to the client and opens the device.
+     * @return @c false if shared memory is not available.
+     */
+    bool createSegment(int ringSize = DefaultRingSize);
+    /**
+     * Client side: waits for the segment announcement on the control socket and
+     * attaches to it. Emits attached() or attachFailed() once done.
+     */
+    void attachSegment();
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    qint64 bytesToWrite() const override;
+    bool waitForReadyRead(int msecs) override;
+    bool waitForBytesWritten(int msecs) override;
+    void close() override;
+
+    /** Closes the control channel, which will disconnect both sides. */
+    void disconnectFromPeer();
+
+signals:
+    void attached();
+    void attachFailed(const QString &errorMessage);
+    void disconnected();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 size) override;
+
+private slots:
+    void controlReadyRead();
+    void controlDisconnected();
+    void processIncoming();
+
+private:
+    SharedMemoryRing *inRing() const;
+    SharedMemoryRing *outRing() const;
+    char *inData() const;
+    char *outData() const;
+
+    void readAnnouncement();
+    quint64 ringAvailable() const;
+    quint64 writeToRing(const char *data, quint64 size);
+    void flushPending();
+    void wakePeer();
+    void drainControl();
+    void scheduleProcessing();
+    void detach();
+
+    QLocalSocket *m_control;
+    QSharedMemory *m_segment = nullptr;
+    char *m_base = nullptr;
+    QByteArray m_pending;
+    int m_pendingOffset = 0;
+    quint64 m_ringSize = 0;
+    quint64 m_notifiedWritePos = 0;
+    bool m_server = false;
+    bool m_awaitingAnnouncement = false;
+    bool m_processScheduled = false;
+};
+}
+
+#endif // GAMMARAY_SHAREDMEMORYDEVICE_H
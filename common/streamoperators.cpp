@@ -19,6 +19,7 @@
 #include "objectid.h"
 #include "enumdefinition.h"
 #include "enumvalue.h"
+#include "messagelatency.h"
 #include "propertymodel.h"
 
 #include <QMetaMethod>
@@ -62,4 +63,5 @@ void StreamOperators::registerOperators()
 
     StreamOperators::registerOperators<EnumDefinition>();
     StreamOperators::registerOperators<EnumValue>();
+    StreamOperators::registerOperators<MessageLatencies>();
 }
@@ -0,0 +1,38 @@
+/*
+  probeoverheadinterface.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "probeoverheadinterface.h"
+
+#include <common/objectbroker.h>
+
+using namespace GammaRay;
+
+ProbeOverheadInterface::ProbeOverheadInterface(QObject *parent)
+    : QObject(parent)
+{
+    ObjectBroker::registerObject<ProbeOverheadInterface *>(this);
+}
+
+ProbeOverheadInterface::~ProbeOverheadInterface() = default;
+
+bool ProbeOverheadInterface::isProfilingEnabled() const
+{
+    return m_profilingEnabled;
+}
+
+void ProbeOverheadInterface::setProfilingEnabled(bool enabled)
+{
+    if (m_profilingEnabled == enabled)
+        return;
+    m_profilingEnabled = enabled;
+    emit profilingEnabledChanged(enabled);
+}
@@ -0,0 +1,47 @@
+/*
+  probeoverheadinterface.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PROBEOVERHEADINTERFACE_H
+#define GAMMARAY_PROBEOVERHEADINTERFACE_H
+
+#include <QObject>
+
+namespace GammaRay {
+
+/*! communication interface for the probe overhead tool. */
+class ProbeOverheadInterface : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool profilingEnabled READ isProfilingEnabled WRITE setProfilingEnabled NOTIFY profilingEnabledChanged)
+public:
+    explicit ProbeOverheadInterface(QObject *parent = nullptr);
+    ~ProbeOverheadInterface() override;
+
+    bool isProfilingEnabled() const;
+    void setProfilingEnabled(bool enabled);
+
+public slots:
+    virtual void resetStatistics() = 0;
+
+signals:
+    void profilingEnabledChanged(bool enabled);
+
+private:
+    bool m_profilingEnabled = false;
+};
+}
+
+QT_BEGIN_NAMESPACE
+Q_DECLARE_INTERFACE(GammaRay::ProbeOverheadInterface, "com.kdab.GammaRay.ProbeOverheadInterface")
+QT_END_NAMESPACE
+
+#endif // GAMMARAY_PROBEOVERHEADINTERFACE_H
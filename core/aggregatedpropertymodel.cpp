@@ -30,6 +30,8 @@
 #include <QDebug>
 #include <QMetaEnum>
 
+#include <algorithm>
+
 using namespace GammaRay;
 
 
@@ -87,11 +89,11 @@ void AggregatedPropertyModel::clear()
     if (!m_rootAdaptor)
         return;
 
-    const auto count = m_parentChildrenMap.at(m_rootAdaptor).size();
+    const auto count = m_adaptors.at(m_rootAdaptor).children.size();
     if (count)
         beginRemoveRows(QModelIndex(), 0, count - 1);
 
-    m_parentChildrenMap.clear();
+    m_adaptors.clear();
     delete m_rootAdaptor;
     m_rootAdaptor = nullptr;
 
@@ -114,7 +116,7 @@ QVariant AggregatedPropertyModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    const auto d = adaptor->propertyData(index.row());
+    const auto d = propertyData(adaptor, index.row());
     return data(adaptor, d, index.column(), role);
 }
 
@@ -133,7 +135,7 @@ QMap<int, QVariant> AggregatedPropertyModel::itemData(const QModelIndex &index)
         // clang-format on
         return res;
     }
-    const auto d = adaptor->propertyData(index.row());
+    const auto d = propertyData(adaptor, index.row());
 
     res.insert(Qt::DisplayRole, data(adaptor, d, index.column(), Qt::DisplayRole));
     res.insert(PropertyModel::ActionRole, data(adaptor, d, index.column(), PropertyModel::ActionRole));
@@ -251,7 +253,7 @@ bool AggregatedPropertyModel::setData(const QModelIndex &index, const QVariant &
     case Qt::EditRole: {
         QPointer<GammaRay::PropertyAdaptor> guard(adaptor);
         if (value.userType() == qMetaTypeId<EnumValue>()) {
-            const auto d = adaptor->propertyData(index.row());
+            const auto d = propertyData(adaptor, index.row());
             if (d.value().type() == QVariant::Int) {
                 adaptor->writeProperty(index.row(), value.value<EnumValue>().value());
             } else {
@@ -263,16 +265,19 @@ bool AggregatedPropertyModel::setData(const QModelIndex &index, const QVariant &
             adaptor->writeProperty(index.row(), value);
         }
         if (guard) {
+            invalidateValue(adaptor, index.row());
             propagateWrite(adaptor);
         }
         return true;
     }
     case Qt::CheckStateRole:
         adaptor->writeProperty(index.row(), value.toInt() == Qt::Checked);
+        invalidateValue(adaptor, index.row());
         propagateWrite(adaptor);
         return true;
     case PropertyModel::ResetActionRole:
         adaptor->resetProperty(index.row());
+        invalidateValue(adaptor, index.row());
         return true;
     }
 
@@ -290,17 +295,19 @@ int AggregatedPropertyModel::rowCount(const QModelIndex &parent) const
     if (!m_rootAdaptor || parent.column() > 0)
         return 0;
     if (!parent.isValid())
-        return m_parentChildrenMap.at(m_rootAdaptor).size();
+        return m_adaptors.at(m_rootAdaptor).children.size();
 
     auto adaptor = adaptorForIndex(parent);
-    auto &siblings = m_parentChildrenMap[adaptor];
+    auto &siblings = m_adaptors[adaptor].children;
     if (!m_inhibitAdaptorCreation && !siblings.at(parent.row())) {
         // TODO: remember we tried any of this
-        auto pd = adaptor->propertyData(parent.row());
+        const auto pd = propertyData(adaptor, parent.row());
         if (!isInvalidPointer(pd.value()) && !hasLoop(adaptor, pd.value())) {
             auto a = PropertyAdaptorFactory::create(pd.value(), adaptor);
             siblings[parent.row()] = a;
             addPropertyAdaptor(a);
+            if (a)
+                m_adaptors.at(a).row = parent.row();
         }
     }
 
@@ -310,7 +317,7 @@ int AggregatedPropertyModel::rowCount(const QModelIndex &parent) const
     auto childAdaptor = siblings.at(parent.row());
     if (!childAdaptor)
         return 0;
-    return m_parentChildrenMap.at(childAdaptor).size(); // childAdaptor->count() might already be updated in insert/removeRows
+    return m_adaptors.at(childAdaptor).children.size(); // childAdaptor->count() might already be updated in insert/removeRows
 }
 
 Qt::ItemFlags AggregatedPropertyModel::flags(const QModelIndex &index) const
@@ -320,7 +327,7 @@ Qt::ItemFlags AggregatedPropertyModel::flags(const QModelIndex &index) const
         return baseFlags;
 
     auto adaptor = adaptorForIndex(index);
-    auto data = adaptor->propertyData(index.row());
+    const auto data = propertyData(adaptor, index.row());
     const auto editable = (data.accessFlags() & PropertyData::Writable) && isParentEditable(adaptor);
     const auto booleanEditable = editable && data.value().type() == QVariant::Bool;
     if (booleanEditable)
@@ -335,7 +342,7 @@ QModelIndex AggregatedPropertyModel::parent(const QModelIndex &child) const
         return {};
 
     auto parentAdaptor = childAdaptor->parentAdaptor();
-    return createIndex(m_parentChildrenMap.at(parentAdaptor).indexOf(childAdaptor), 0, parentAdaptor);
+    return createIndex(m_adaptors.at(childAdaptor).row, 0, parentAdaptor);
 }
 
 QModelIndex AggregatedPropertyModel::index(int row, int column, const QModelIndex &parent) const
@@ -346,7 +353,7 @@ QModelIndex AggregatedPropertyModel::index(int row, int column, const QModelInde
     if (!parent.isValid())
         return createIndex(row, column, m_rootAdaptor);
     auto adaptor = adaptorForIndex(parent);
-    return createIndex(row, column, m_parentChildrenMap.at(adaptor).at(parent.row()));
+    return createIndex(row, column, m_adaptors.at(adaptor).children.at(parent.row()));
 }
 
 PropertyAdaptor *AggregatedPropertyModel::adaptorForIndex(const QModelIndex &index) const
@@ -361,21 +368,82 @@ void AggregatedPropertyModel::addPropertyAdaptor(PropertyAdaptor *adaptor) const
     if (!adaptor)
         return;
 
-    m_parentChildrenMap.emplace(adaptor, QVector<PropertyAdaptor *>(adaptor->count()));
+    AdaptorInfo info;
+    const auto count = adaptor->count();
+    info.children.resize(count);
+    info.values.resize(count);
+    info.states.resize(count);
+    m_adaptors.emplace(adaptor, std::move(info));
     connect(adaptor, &PropertyAdaptor::propertyChanged, this, &AggregatedPropertyModel::propertyChanged);
     connect(adaptor, &PropertyAdaptor::propertyAdded, this, &AggregatedPropertyModel::propertyAdded);
     connect(adaptor, &PropertyAdaptor::propertyRemoved, this, &AggregatedPropertyModel::propertyRemoved);
 }
 
+PropertyData AggregatedPropertyModel::propertyData(PropertyAdaptor *adaptor, int row) const
+{
+    auto &info = m_adaptors.at(adaptor);
+    if (row >= info.values.size()) // adaptor changed without telling us
+        return adaptor->propertyData(row);
+
+    switch (info.states.at(row)) {
+    case Cached:
+        return info.values.at(row);
+    case NotCacheable:
+        return adaptor->propertyData(row);
+    case NotRead:
+        break;
+    }
+
+    // the client asks for visible rows in batches, read the surrounding block in one go
+    const auto begin = row - row % SnapshotBlockSize;
+    const auto end = std::min<int>(begin + SnapshotBlockSize, info.values.size());
+    const auto notifying = adaptor->object().type() == ObjectInstance::QtObject;
+    PropertyData result;
+    for (int i = begin; i < end; ++i) {
+        if (info.states.at(i) != NotRead)
+            continue;
+        auto d = adaptor->propertyData(i);
+        if (notifying && !d.notifySignal().isEmpty()) {
+            info.values[i] = d;
+            info.states[i] = Cached;
+        } else {
+            info.states[i] = NotCacheable;
+        }
+        if (i == row)
+            result = std::move(d);
+    }
+    return result;
+}
+
+void AggregatedPropertyModel::invalidateValue(PropertyAdaptor *adaptor, int row)
+{
+    const auto it = m_adaptors.find(adaptor);
+    if (it == m_adaptors.end() || row < 0 || row >= it->second.states.size())
+        return;
+    it->second.values[row] = PropertyData();
+    it->second.states[row] = NotRead;
+}
+
+void AggregatedPropertyModel::updateChildRows(PropertyAdaptor *adaptor, int first)
+{
+    const auto &children = m_adaptors.at(adaptor).children;
+    for (int i = first; i < children.size(); ++i) {
+        if (children.at(i))
+            m_adaptors.at(children.at(i)).row = i;
+    }
+}
+
 void AggregatedPropertyModel::propertyChanged(int first, int last)
 {
     auto adaptor = qobject_cast<PropertyAdaptor *>(sender());
     Q_ASSERT(adaptor);
-    Q_ASSERT(m_parentChildrenMap.find(adaptor) != m_parentChildrenMap.cend());
+    Q_ASSERT(m_adaptors.find(adaptor) != m_adaptors.cend());
     Q_ASSERT(first <= last);
     Q_ASSERT(first >= 0);
     Q_ASSERT(last < adaptor->count());
 
+    for (int i = first; i <= last; ++i)
+        invalidateValue(adaptor, i);
     emit dataChanged(createIndex(first, 0, adaptor), createIndex(last, columnCount() - 1, adaptor));
     for (int i = first; i <= last; ++i)
         reloadSubTree(adaptor, i);
@@ -385,18 +453,24 @@ void AggregatedPropertyModel::propertyAdded(int first, int last)
 {
     auto adaptor = qobject_cast<PropertyAdaptor *>(sender());
     Q_ASSERT(adaptor);
-    Q_ASSERT(m_parentChildrenMap.find(adaptor) != m_parentChildrenMap.cend());
+    Q_ASSERT(m_adaptors.find(adaptor) != m_adaptors.cend());
     Q_ASSERT(first <= last);
     Q_ASSERT(first >= 0);
     Q_ASSERT(last < adaptor->count());
 
     auto idx = createIndex(first, 0, adaptor);
     beginInsertRows(idx.parent(), first, last);
-    auto &children = m_parentChildrenMap[adaptor];
-    if (first >= children.size())
-        children.resize(last + 1);
-    else
-        children.insert(first, last - first + 1, nullptr);
+    auto &info = m_adaptors[adaptor];
+    if (first >= info.children.size()) {
+        info.children.resize(last + 1);
+        info.values.resize(last + 1);
+        info.states.resize(last + 1);
+    } else {
+        info.children.insert(first, last - first + 1, nullptr);
+        info.values.insert(first, last - first + 1, PropertyData());
+        info.states.insert(first, last - first + 1, NotRead);
+        updateChildRows(adaptor, last + 1);
+    }
     endInsertRows();
 }
 
@@ -405,15 +479,18 @@ void AggregatedPropertyModel::propertyRemoved(int first, int last)
     auto adaptor = qobject_cast<PropertyAdaptor *>(sender());
 
     Q_ASSERT(adaptor);
-    Q_ASSERT(m_parentChildrenMap.find(adaptor) != m_parentChildrenMap.cend());
+    Q_ASSERT(m_adaptors.find(adaptor) != m_adaptors.cend());
     Q_ASSERT(first <= last);
     Q_ASSERT(first >= 0);
     Q_ASSERT(last < adaptor->count());
 
     auto idx = createIndex(first, 0, adaptor);
     beginRemoveRows(idx.parent(), first, last);
-    auto &children = m_parentChildrenMap[adaptor];
-    children.remove(first, last - first + 1);
+    auto &info = m_adaptors[adaptor];
+    info.children.remove(first, last - first + 1);
+    info.values.remove(first, last - first + 1);
+    info.states.remove(first, last - first + 1);
+    updateChildRows(adaptor, first);
     endRemoveRows();
 }
 
@@ -426,7 +503,7 @@ void AggregatedPropertyModel::objectInvalidated()
 void AggregatedPropertyModel::objectInvalidated(PropertyAdaptor *adaptor)
 {
     Q_ASSERT(adaptor);
-    if (m_parentChildrenMap.find(adaptor) == m_parentChildrenMap.end()) // already handled
+    if (m_adaptors.find(adaptor) == m_adaptors.end()) // already handled
         return;
 
     if (adaptor == m_rootAdaptor) {
@@ -436,8 +513,10 @@ void AggregatedPropertyModel::objectInvalidated(PropertyAdaptor *adaptor)
 
     auto parentAdaptor = adaptor->parentAdaptor();
     Q_ASSERT(parentAdaptor);
-    Q_ASSERT(m_parentChildrenMap.find(parentAdaptor) != m_parentChildrenMap.cend());
-    reloadSubTree(parentAdaptor, m_parentChildrenMap.at(parentAdaptor).indexOf(adaptor));
+    Q_ASSERT(m_adaptors.find(parentAdaptor) != m_adaptors.cend());
+    const auto row = m_adaptors.at(adaptor).row;
+    invalidateValue(parentAdaptor, row);
+    reloadSubTree(parentAdaptor, row);
 }
 
 bool AggregatedPropertyModel::hasLoop(PropertyAdaptor *adaptor, const QVariant &v)
@@ -460,23 +539,23 @@ bool AggregatedPropertyModel::hasLoop(PropertyAdaptor *adaptor, const QVariant &
 void AggregatedPropertyModel::reloadSubTree(PropertyAdaptor *parentAdaptor, int index)
 {
     Q_ASSERT(parentAdaptor);
-    Q_ASSERT(m_parentChildrenMap.find(parentAdaptor) != m_parentChildrenMap.cend());
+    Q_ASSERT(m_adaptors.find(parentAdaptor) != m_adaptors.cend());
     Q_ASSERT(index >= 0);
-    Q_ASSERT(index < m_parentChildrenMap.at(parentAdaptor).size());
+    Q_ASSERT(index < m_adaptors.at(parentAdaptor).children.size());
 
     // prevent rowCount calls as a result of the change notification to re-create
     // the adaptor
     m_inhibitAdaptorCreation = true;
 
     // remove the old sub-tree, if present
-    auto oldAdaptor = m_parentChildrenMap.at(parentAdaptor).at(index);
+    auto oldAdaptor = m_adaptors.at(parentAdaptor).children.at(index);
     if (oldAdaptor) {
-        auto oldRowCount = m_parentChildrenMap.at(oldAdaptor).size();
+        auto oldRowCount = m_adaptors.at(oldAdaptor).children.size();
         if (oldRowCount > 0)
             beginRemoveRows(createIndex(index, 0, parentAdaptor), 0, oldRowCount - 1);
-        m_parentChildrenMap[parentAdaptor][index] = nullptr;
+        m_adaptors[parentAdaptor].children[index] = nullptr;
 
-        m_parentChildrenMap.erase(oldAdaptor);
+        m_adaptors.erase(oldAdaptor);
         delete oldAdaptor;
         if (oldRowCount)
             endRemoveRows();
@@ -484,7 +563,7 @@ void AggregatedPropertyModel::reloadSubTree(PropertyAdaptor *parentAdaptor, int
 
     // re-add the sub-tree
     // TODO consolidate with code in rowCount()
-    auto pd = parentAdaptor->propertyData(index);
+    const auto pd = propertyData(parentAdaptor, index);
 
     if (isInvalidPointer(pd.value()) || hasLoop(parentAdaptor, pd.value())) {
         m_inhibitAdaptorCreation = false;
@@ -498,8 +577,9 @@ void AggregatedPropertyModel::reloadSubTree(PropertyAdaptor *parentAdaptor, int
     auto newRowCount = newAdaptor->count();
     if (newRowCount > 0)
         beginInsertRows(createIndex(index, 0, parentAdaptor), 0, newRowCount - 1);
-    m_parentChildrenMap[parentAdaptor][index] = newAdaptor;
+    m_adaptors[parentAdaptor].children[index] = newAdaptor;
     addPropertyAdaptor(newAdaptor);
+    m_adaptors.at(newAdaptor).row = index;
     if (newRowCount > 0)
         endInsertRows();
 
@@ -514,10 +594,10 @@ bool AggregatedPropertyModel::isParentEditable(PropertyAdaptor *adaptor) const
 
     // we need all value types along the way to be writable
     if (adaptor->object().isValueType()) {
-        const auto row = m_parentChildrenMap.at(parentAdaptor).indexOf(adaptor);
+        const auto row = m_adaptors.at(adaptor).row;
         Q_ASSERT(row >= 0);
 
-        const auto pd = parentAdaptor->propertyData(row);
+        const auto pd = propertyData(parentAdaptor, row);
         if ((pd.accessFlags() & PropertyData::Writable) == 0)
             return false;
     }
@@ -532,10 +612,11 @@ void AggregatedPropertyModel::propagateWrite(GammaRay::PropertyAdaptor *adaptor)
         return;
 
     if (adaptor->object().isValueType()) {
-        const auto row = m_parentChildrenMap.at(parentAdaptor).indexOf(adaptor);
+        const auto row = m_adaptors.at(adaptor).row;
         Q_ASSERT(row >= 0);
 
         parentAdaptor->writeProperty(row, adaptor->object().variant());
+        invalidateValue(parentAdaptor, row);
     }
 
     propagateWrite(parentAdaptor);
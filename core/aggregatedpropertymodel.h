@@ -15,6 +15,7 @@
 #define GAMMARAY_AGGREGATEDPROPERTYMODEL_H
 
 #include "gammaray_core_export.h"
+#include "propertydata.h"
 
 #include <QAbstractItemModel>
 #include <QHash>
@@ -24,10 +25,17 @@
 
 namespace GammaRay {
 class PropertyAdaptor;
-class PropertyData;
 class ObjectInstance;
 
-/** Generic property model. */
+/**
+ * Generic property model.
+ *
+ * Property values are read in blocks and kept in a per-adaptor snapshot, so repeated
+ * data(), itemData() and flags() calls for the same row do not call into the target
+ * object again. The snapshot of a property is discarded when its adaptor reports
+ * a change (ie. the property's notify signal fired) or after writing it. Properties
+ * without a notify signal can change unnoticed, so those are read on every access.
+ */
 class GAMMARAY_CORE_EXPORT AggregatedPropertyModel : public QAbstractItemModel
 {
     Q_OBJECT
@@ -50,9 +58,30 @@ public:
     QMap<int, QVariant> itemData(const QModelIndex &index) const override;
 
 private:
+    /** Number of rows read at once when filling the value snapshot. */
+    static const int SnapshotBlockSize = 64;
+
+    enum ValueState : char
+    {
+        NotRead,
+        Cached,
+        NotCacheable // no change notification, read on every access
+    };
+
+    struct AdaptorInfo
+    {
+        QVector<PropertyAdaptor *> children;
+        QVector<PropertyData> values;
+        QVector<ValueState> states;
+        int row = -1; // row of this adaptor in its parent adaptor
+    };
+
     void clear();
     PropertyAdaptor *adaptorForIndex(const QModelIndex &index) const;
     void addPropertyAdaptor(PropertyAdaptor *adaptor) const;
+    PropertyData propertyData(PropertyAdaptor *adaptor, int row) const;
+    void invalidateValue(PropertyAdaptor *adaptor, int row);
+    void updateChildRows(PropertyAdaptor *adaptor, int first);
     static QVariant data(PropertyAdaptor *adaptor, const PropertyData &d, int column, int role);
     static bool hasLoop(PropertyAdaptor *adaptor, const QVariant &v);
     void reloadSubTree(PropertyAdaptor *parentAdaptor, int index);
@@ -68,7 +97,7 @@ private slots:
 
 private:
     PropertyAdaptor *m_rootAdaptor = nullptr;
-    mutable std::unordered_map<PropertyAdaptor *, QVector<PropertyAdaptor *>> m_parentChildrenMap;
+    mutable std::unordered_map<PropertyAdaptor *, AdaptorInfo> m_adaptors;
     bool m_inhibitAdaptorCreation = false;
     bool m_readOnly = false;
 };
@@ -12,7 +12,6 @@
 */
 
 #include "associativepropertyadaptor.h"
-#include "objectinstance.h"
 #include "propertydata.h"
 #include "varianthandler.h"
 
@@ -20,39 +19,51 @@
 
 using namespace GammaRay;
 
-AssociativePropertyAdaptor::AssociativePropertyAdaptor(QObject *parent)
-    : PropertyAdaptor(parent)
+namespace {
+class AssociativeAccessor : public ContainerAccessor
 {
-}
+public:
+    explicit AssociativeAccessor(const QVariant &container)
+        : ContainerAccessor(container)
+        , m_iterators(m_container.value<QAssociativeIterable>(), isRandomAccess(m_container))
+    {
+        m_count = m_container.value<QAssociativeIterable>().size();
+    }
 
-AssociativePropertyAdaptor::~AssociativePropertyAdaptor() = default;
+    PropertyData propertyData(int index) override
+    {
+        const auto it = m_iterators.at(index);
+        PropertyData data;
+        data.setName(VariantHandler::displayString(it.key()));
+        data.setValue(it.value());
+        data.setClassName(m_container.typeName());
+        return data;
+    }
 
-void AssociativePropertyAdaptor::doSetObject(const ObjectInstance &oi)
-{
-    if (oi.type() == ObjectInstance::QtVariant)
-        m_value = oi.variant();
-}
+private:
+    static bool isRandomAccess(const QVariant &container)
+    {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        return container.value<QAssociativeIterable>().metaContainer().hasRandomAccessIterator();
+#else
+        // none of the associative containers supported by Qt 5 has random-access iterators
+        Q_UNUSED(container);
+        return false;
+#endif
+    }
 
-int AssociativePropertyAdaptor::count() const
-{
-    if (!m_value.canConvert<QVariantHash>())
-        return 0;
-    auto it = m_value.value<QAssociativeIterable>();
-    return it.size();
+    ContainerIteratorCache<QAssociativeIterable> m_iterators;
+};
 }
 
-PropertyData AssociativePropertyAdaptor::propertyData(int index) const
+AssociativePropertyAdaptor::AssociativePropertyAdaptor(QObject *parent)
+    : ContainerPropertyAdaptor(parent)
 {
-    Q_ASSERT(m_value.canConvert<QVariantHash>());
-
-    auto iterable = m_value.value<QAssociativeIterable>();
-    auto it = iterable.begin();
-    it += index;
+}
 
-    PropertyData data;
-    data.setName(VariantHandler::displayString(it.key()));
-    data.setValue(it.value());
-    data.setClassName(m_value.typeName());
+AssociativePropertyAdaptor::~AssociativePropertyAdaptor() = default;
 
-    return data;
+ContainerAccessor *AssociativePropertyAdaptor::createAccessor(const QVariant &container) const
+{
+    return new AssociativeAccessor(container);
 }
@@ -14,27 +14,19 @@
 #ifndef GAMMARAY_ASSOCIATIVEPROPERTYADAPTOR_H
 #define GAMMARAY_ASSOCIATIVEPROPERTYADAPTOR_H
 
-#include "propertyadaptor.h"
-
-#include <QVariant>
+#include "containerpropertyadaptor.h"
 
 namespace GammaRay {
 /** Adaptor for recursing into associative container property values. */
-class AssociativePropertyAdaptor : public PropertyAdaptor
+class AssociativePropertyAdaptor : public ContainerPropertyAdaptor
 {
     Q_OBJECT
 public:
     explicit AssociativePropertyAdaptor(QObject *parent = nullptr);
     ~AssociativePropertyAdaptor() override;
 
-    int count() const override;
-    PropertyData propertyData(int index) const override;
-
 protected:
-    void doSetObject(const ObjectInstance &oi) override;
-
-private:
-    QVariant m_value;
+    ContainerAccessor *createAccessor(const QVariant &container) const override;
 };
 }
 
@@ -14,6 +14,7 @@
 #include "bindingaggregator.h"
 
 #include <core/abstractbindingprovider.h>
+#include <core/bindinggraph.h>
 #include <core/bindingnode.h>
 #include <core/objectdataprovider.h>
 #include <core/probe.h>
@@ -22,6 +23,7 @@
 #include <common/objectbroker.h>
 
 // Qt
+#include <QHash>
 #include <QMetaProperty>
 #include <QMetaObject>
 #include <QMutexLocker>
@@ -44,32 +46,79 @@ bool GammaRay::BindingAggregator::providerAvailableFor(QObject *object)
         != s_providers()->end();
 }
 
-std::vector<std::unique_ptr<BindingNode>> BindingAggregator::findDependenciesFor(BindingNode *node)
+namespace {
+struct DependencyInfo
+{
+    QObject *object;
+    int propertyIndex;
+    QString canonicalName;
+};
+
+struct BindingInfo
+{
+    SourceLocation sourceLocation;
+    std::vector<DependencyInfo> dependencies;
+};
+
+// provider results per (object, property index), valid during one tree expansion
+typedef QHash<QPair<QObject *, int>, BindingInfo> DependencyCache;
+}
+
+static std::vector<std::unique_ptr<BindingNode>> findDependencies(BindingNode *node, DependencyCache &cache)
 {
     std::vector<std::unique_ptr<BindingNode>> allDependencies;
     if (node->isPartOfBindingLoop())
         return allDependencies;
 
-    for (const auto &provider : *s_providers()) {
-        auto providerDependencies = provider->findDependenciesFor(node);
-        for (auto &&providerDependency : providerDependencies) {
-            providerDependency->dependencies() = findDependenciesFor(providerDependency.get());
-            allDependencies.push_back(std::move(providerDependency));
+    // shared dependencies are only looked up once, the tree still needs its own nodes for each occurrence
+    const auto key = qMakePair(node->object(), node->propertyIndex());
+    const auto it = cache.constFind(key);
+    if (it != cache.constEnd()) {
+        if (it->sourceLocation.isValid())
+            node->setSourceLocation(it->sourceLocation);
+        allDependencies.reserve(it->dependencies.size());
+        for (const auto &info : it->dependencies) {
+            std::unique_ptr<BindingNode> dependency(new BindingNode(info.object, info.propertyIndex, node));
+            dependency->setCanonicalName(info.canonicalName);
+            allDependencies.push_back(std::move(dependency));
         }
+    } else {
+        for (const auto &provider : *s_providers()) {
+            auto providerDependencies = provider->findDependenciesFor(node);
+            for (auto &&providerDependency : providerDependencies)
+                allDependencies.push_back(std::move(providerDependency));
+        }
+        std::sort(
+            allDependencies.begin(),
+            allDependencies.end(),
+            [](const std::unique_ptr<BindingNode> &a, const std::unique_ptr<BindingNode> &b) {
+                return a->object() < b->object() || (a->object() == b->object() && a->propertyIndex() < b->propertyIndex());
+            });
+
+        BindingInfo info;
+        info.sourceLocation = node->sourceLocation();
+        info.dependencies.reserve(allDependencies.size());
+        for (const auto &dependency : allDependencies)
+            info.dependencies.push_back({ dependency->object(), dependency->propertyIndex(), dependency->canonicalName() });
+        cache.insert(key, info);
     }
-    std::sort(
-        allDependencies.begin(),
-        allDependencies.end(),
-        [](const std::unique_ptr<BindingNode> &a, const std::unique_ptr<BindingNode> &b) {
-            return a->object() < b->object() || (a->object() == b->object() && a->propertyIndex() < b->propertyIndex());
-        });
+
+    for (const auto &dependency : allDependencies)
+        dependency->dependencies() = findDependencies(dependency.get(), cache);
     return allDependencies;
 }
 
+std::vector<std::unique_ptr<BindingNode>> BindingAggregator::findDependenciesFor(BindingNode *node)
+{
+    DependencyCache cache;
+    return findDependencies(node, cache);
+}
+
 std::vector<std::unique_ptr<BindingNode>> BindingAggregator::bindingTreeForObject(QObject *obj)
 {
     std::vector<std::unique_ptr<BindingNode>> bindings;
     if (obj) {
+        DependencyCache cache;
         for (auto providerIt = s_providers()->begin(); providerIt != s_providers()->cend(); ++providerIt) {
             auto newBindings = (*providerIt)->findBindingsFor(obj);
             for (auto &&newBinding : newBindings) {
@@ -79,7 +128,7 @@ std::vector<std::unique_ptr<BindingNode>> BindingAggregator::bindingTreeForObjec
                     != bindings.end()) {
                     continue; // apparently this is a duplicate.
                 }
-                node->dependencies() = findDependenciesFor(node);
+                node->dependencies() = findDependencies(node, cache);
 
                 bindings.push_back(std::move(newBinding));
             }
@@ -90,25 +139,30 @@ std::vector<std::unique_ptr<BindingNode>> BindingAggregator::bindingTreeForObjec
 
 void BindingAggregator::scanForBindingLoops()
 {
-    const QVector<QObject *> &allObjects = Probe::instance()->allQObjects();
+    auto probe = Probe::instance();
 
     QMutexLocker lock(Probe::objectLock());
-    for (QObject *obj : allObjects) {
-        if (!Probe::instance()->isValidObject(obj))
-            continue;
-
-        auto bindings = bindingTreeForObject(obj);
-        for (auto &&bindingNode : bindings) {
-            if (bindingNode->isPartOfBindingLoop()) {
-                Problem p;
-                p.severity = Problem::Error;
-                p.description = QStringLiteral("Object %1 / Property %2 has a binding loop.").arg(ObjectDataProvider::typeName(bindingNode->object()), bindingNode->canonicalName());
-                p.object = ObjectId(bindingNode->object());
-                p.locations.push_back(bindingNode->sourceLocation());
-                p.problemId = QStringLiteral("com.kdab.GammaRay.ObjectInspector.BindingLoopScan:%1.%2").arg(reinterpret_cast<quintptr>(bindingNode->object())).arg(bindingNode->propertyIndex()); // no multi arg, both are ints
-                p.findingCategory = Problem::Scan;
-                ProblemCollector::addProblem(p);
-            }
+    // bindings can be replaced at runtime without any notification, so the graph
+    // isn't kept across scans, it's only the lookups within one scan that are shared
+    BindingGraph graph(s_providers());
+    for (QObject *obj : probe->allQObjects())
+        graph.addObject(obj);
+
+    const auto loops = graph.bindingLoops();
+    for (const auto &loop : loops) {
+        for (const auto node : loop) {
+            QObject *object = graph.object(node);
+            if (!probe->isValidObject(object))
+                continue;
+
+            Problem p;
+            p.severity = Problem::Error;
+            p.description = QStringLiteral("Object %1 / Property %2 has a binding loop.").arg(ObjectDataProvider::typeName(object), graph.canonicalName(node));
+            p.object = ObjectId(object);
+            p.locations.push_back(graph.sourceLocation(node));
+            p.problemId = QStringLiteral("com.kdab.GammaRay.ObjectInspector.BindingLoopScan:%1.%2").arg(reinterpret_cast<quintptr>(object)).arg(graph.propertyIndex(node)); // no multi arg, both are ints
+            p.findingCategory = Problem::Scan;
+            ProblemCollector::addProblem(p);
         }
     }
 }
@@ -0,0 +1,200 @@
+/*
+  bindinggraph.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// Own
+#include "bindinggraph.h"
+
+#include <core/abstractbindingprovider.h>
+#include <core/bindingnode.h>
+
+using namespace GammaRay;
+
+BindingGraph::BindingGraph(const Providers *providers)
+    : m_providers(providers)
+{
+    Q_ASSERT(m_providers);
+}
+
+BindingGraph::~BindingGraph() = default;
+
+void BindingGraph::addObject(QObject *object)
+{
+    if (!object)
+        return;
+
+    for (const auto &provider : *m_providers) {
+        const auto bindings = provider->findBindingsFor(object);
+        for (const auto &binding : bindings) {
+            const auto id = nodeFor(object, binding->propertyIndex(), binding->canonicalName());
+            m_nodes[id].isBinding = true;
+            enqueue(id);
+        }
+    }
+    expandQueued();
+}
+
+int BindingGraph::nodeCount() const
+{
+    return m_nodes.size();
+}
+
+int BindingGraph::edgeCount() const
+{
+    return m_edgeCount;
+}
+
+int BindingGraph::node(QObject *object, int propertyIndex) const
+{
+    return m_nodeIndex.value(qMakePair(object, propertyIndex), -1);
+}
+
+QObject *BindingGraph::object(int node) const
+{
+    return m_nodes.at(node).object;
+}
+
+int BindingGraph::propertyIndex(int node) const
+{
+    return m_nodes.at(node).propertyIndex;
+}
+
+QString BindingGraph::canonicalName(int node) const
+{
+    return m_nodes.at(node).canonicalName;
+}
+
+SourceLocation BindingGraph::sourceLocation(int node) const
+{
+    return m_nodes.at(node).sourceLocation;
+}
+
+bool BindingGraph::isBinding(int node) const
+{
+    return m_nodes.at(node).isBinding;
+}
+
+QVector<int> BindingGraph::dependencies(int node) const
+{
+    return m_nodes.at(node).dependencies;
+}
+
+QVector<QVector<int>> BindingGraph::bindingLoops() const
+{
+    // Tarjan's algorithm, iteratively as dependency chains can get very long
+    QVector<QVector<int>> loops;
+    const int count = m_nodes.size();
+    QVector<int> index(count, -1);
+    QVector<int> lowLink(count, 0);
+    QVector<bool> onStack(count, false);
+    QVector<int> stack;
+    QVector<QPair<int, int>> callStack; // node and the next dependency to visit
+    int nextIndex = 0;
+
+    auto visit = [&](int node) {
+        index[node] = lowLink[node] = nextIndex++;
+        stack.push_back(node);
+        onStack[node] = true;
+        callStack.push_back(qMakePair(node, 0));
+    };
+
+    for (int root = 0; root < count; ++root) {
+        if (index.at(root) >= 0)
+            continue;
+
+        visit(root);
+        while (!callStack.isEmpty()) {
+            const auto node = callStack.last().first;
+            const auto &dependencies = m_nodes.at(node).dependencies;
+            if (callStack.last().second < dependencies.size()) {
+                const auto dependency = dependencies.at(callStack.last().second++);
+                if (index.at(dependency) < 0)
+                    visit(dependency);
+                else if (onStack.at(dependency))
+                    lowLink[node] = qMin(lowLink.at(node), index.at(dependency));
+                continue;
+            }
+
+            callStack.removeLast();
+            if (!callStack.isEmpty()) {
+                const auto caller = callStack.last().first;
+                lowLink[caller] = qMin(lowLink.at(caller), lowLink.at(node));
+            }
+
+            if (lowLink.at(node) != index.at(node))
+                continue;
+            QVector<int> component;
+            int member;
+            do {
+                member = stack.takeLast();
+                onStack[member] = false;
+                component.push_back(member);
+            } while (member != node);
+            if (component.size() > 1 || dependencies.contains(node))
+                loops.push_back(component);
+        }
+    }
+    return loops;
+}
+
+int BindingGraph::nodeFor(QObject *object, int propertyIndex, const QString &canonicalName)
+{
+    const auto key = qMakePair(object, propertyIndex);
+    const auto it = m_nodeIndex.constFind(key);
+    if (it != m_nodeIndex.constEnd())
+        return it.value();
+
+    const int id = m_nodes.size();
+    m_nodes.push_back(Node());
+    auto &node = m_nodes.last();
+    node.object = object;
+    node.propertyIndex = propertyIndex;
+    node.canonicalName = canonicalName;
+    m_nodeIndex.insert(key, id);
+    return id;
+}
+
+void BindingGraph::enqueue(int node)
+{
+    auto &n = m_nodes[node];
+    if (n.queued)
+        return;
+    n.queued = true;
+    m_queue.push_back(node);
+}
+
+void BindingGraph::expandQueued()
+{
+    while (!m_queue.isEmpty()) {
+        const auto id = m_queue.takeLast();
+        if (m_nodes.at(id).object)
+            expand(id);
+    }
+}
+
+void BindingGraph::expand(int node)
+{
+    BindingNode query(m_nodes.at(node).object, m_nodes.at(node).propertyIndex);
+    for (const auto &provider : *m_providers) {
+        const auto dependencies = provider->findDependenciesFor(&query);
+        for (const auto &dependency : dependencies) {
+            const auto target = nodeFor(dependency->object(), dependency->propertyIndex(), dependency->canonicalName());
+            if (m_nodes.at(node).dependencies.contains(target))
+                continue;
+            m_nodes[node].dependencies.push_back(target);
+            ++m_edgeCount;
+            enqueue(target);
+        }
+    }
+
+    if (query.sourceLocation().isValid())
+        m_nodes[node].sourceLocation = query.sourceLocation();
+}
@@ -0,0 +1,109 @@
+/*
+  bindinggraph.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_BINDINGGRAPH_H
+#define GAMMARAY_BINDINGGRAPH_H
+
+// Own
+#include "gammaray_core_export.h"
+
+#include <common/sourcelocation.h>
+
+// Qt
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+// Std
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+class QObject;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+
+class AbstractBindingProvider;
+
+/**
+ * Dependency graph of all bindings known to the binding providers.
+ *
+ * Unlike the per-object binding trees shown in the object inspector, every
+ * (object, property index) pair is represented by exactly one node here, and
+ * the dependencies of each node are only looked up once. Binding loops are the
+ * strongly connected components of this graph.
+ */
+class GAMMARAY_CORE_EXPORT BindingGraph
+{
+public:
+    typedef std::vector<std::unique_ptr<AbstractBindingProvider>> Providers;
+
+    /** @p providers has to outlive the graph. */
+    explicit BindingGraph(const Providers *providers);
+    ~BindingGraph();
+
+    /**
+     * Adds the bindings of @p object, and everything they depend on.
+     * Nodes that are already part of the graph are not looked up again.
+     */
+    void addObject(QObject *object);
+
+    int nodeCount() const;
+    int edgeCount() const;
+
+    /** Node id for the given property, or -1 if it isn't part of the graph. */
+    int node(QObject *object, int propertyIndex) const;
+    QObject *object(int node) const;
+    int propertyIndex(int node) const;
+    QString canonicalName(int node) const;
+    SourceLocation sourceLocation(int node) const;
+    /** @c true if @p node was reported as a binding, rather than only being a dependency of one. */
+    bool isBinding(int node) const;
+    QVector<int> dependencies(int node) const;
+
+    /**
+     * All sets of nodes forming binding loops, i.e. strongly connected components with
+     * more than one node, or nodes depending on themselves. Runs in O(nodes + edges).
+     */
+    QVector<QVector<int>> bindingLoops() const;
+
+private:
+    Q_DISABLE_COPY(BindingGraph)
+
+    struct Node
+    {
+        QObject *object = nullptr;
+        int propertyIndex = -1;
+        QString canonicalName;
+        SourceLocation sourceLocation;
+        QVector<int> dependencies;
+        bool isBinding = false;
+        /// queued for or done with looking up the dependencies
+        bool queued = false;
+    };
+
+    int nodeFor(QObject *object, int propertyIndex, const QString &canonicalName);
+    void enqueue(int node);
+    void expandQueued();
+    void expand(int node);
+
+    const Providers *m_providers;
+    QVector<Node> m_nodes;
+    QVector<int> m_queue;
+    QHash<QPair<QObject *, int>, int> m_nodeIndex;
+    int m_edgeCount = 0;
+};
+}
+
+#endif // GAMMARAY_BINDINGGRAPH_H
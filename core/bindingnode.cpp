@@ -46,11 +46,19 @@ void BindingNode::checkForLoops()
         if (ancestor->m_object == m_object
             && ancestor->m_propertyIndex == m_propertyIndex) {
             m_foundBindingLoop = true;
+            invalidateDepth();
             return;
         }
         ancestor = ancestor->m_parent;
     }
     m_foundBindingLoop = false;
+    invalidateDepth();
+}
+
+void BindingNode::invalidateDepth()
+{
+    for (auto node = this; node; node = node->m_parent)
+        node->m_depthValid = false;
 }
 
 QMetaProperty BindingNode::property() const
@@ -115,6 +123,8 @@ GammaRay::SourceLocation GammaRay::BindingNode::sourceLocation() const
 }
 std::vector<std::unique_ptr<BindingNode>> &GammaRay::BindingNode::dependencies()
 {
+    // the caller might change the dependencies, and with that the depth of all ancestors
+    invalidateDepth();
     return m_dependencies;
 }
 const std::vector<std::unique_ptr<BindingNode>> &GammaRay::BindingNode::dependencies() const
@@ -134,18 +144,26 @@ void BindingNode::setSourceLocation(const SourceLocation &location)
 
 uint BindingNode::depth() const
 {
+    if (m_depthValid) {
+        return m_depth;
+    }
+
     uint depth = 0;
     if (m_foundBindingLoop) {
-        return std::numeric_limits<uint>::max(); // to be considered as infinity.
-    }
-    for (const auto &dependency : m_dependencies) {
-        uint depDepth = dependency->depth();
-        if (depDepth == std::numeric_limits<uint>::max()) {
-            depth = depDepth;
-            break;
-        } else if (depDepth + 1 > depth) {
-            depth = depDepth + 1;
+        depth = std::numeric_limits<uint>::max(); // to be considered as infinity.
+    } else {
+        for (const auto &dependency : m_dependencies) {
+            uint depDepth = dependency->depth();
+            if (depDepth == std::numeric_limits<uint>::max()) {
+                depth = depDepth;
+                break;
+            } else if (depDepth + 1 > depth) {
+                depth = depDepth + 1;
+            }
         }
     }
+
+    m_depth = depth;
+    m_depthValid = true;
     return depth;
 }
@@ -52,6 +52,11 @@ public:
     bool hasFoundBindingLoop() const;
     bool isPartOfBindingLoop() const;
     SourceLocation sourceLocation() const;
+    /**
+     * Length of the longest dependency chain below this node, or the maximum uint value
+     * for binding loops. The result is cached until the dependencies of this node or any
+     * of its descendants are accessed for modification.
+     */
     uint depth() const;
     QVariant cachedValue() const;
     QVariant readValue() const;
@@ -68,12 +73,16 @@ public:
 
 private:
     Q_DISABLE_COPY(BindingNode)
+    void invalidateDepth();
+
     BindingNode *m_parent;
     QObject *m_object;
     int m_propertyIndex;
     QString m_canonicalName;
     QVariant m_value;
     bool m_foundBindingLoop = false;
+    mutable bool m_depthValid = false;
+    mutable uint m_depth = 0;
     SourceLocation m_sourceLocation;
     std::vector<std::unique_ptr<BindingNode>> m_dependencies;
 
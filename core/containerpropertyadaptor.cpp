@@ -0,0 +1,100 @@
+/*
+  containerpropertyadaptor.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "containerpropertyadaptor.h"
+#include "objectinstance.h"
+#include "propertydata.h"
+
+#include <algorithm>
+
+using namespace GammaRay;
+
+static QString pageToString(const ContainerPage &page)
+{
+    return QStringLiteral("<%1 entries>").arg(page.size);
+}
+
+ContainerAccessor::ContainerAccessor(const QVariant &container)
+    : m_container(container)
+{
+}
+
+ContainerAccessor::~ContainerAccessor() = default;
+
+const QVariant &ContainerAccessor::container() const
+{
+    return m_container;
+}
+
+int ContainerAccessor::count() const
+{
+    return m_count;
+}
+
+ContainerPropertyAdaptor::ContainerPropertyAdaptor(QObject *parent)
+    : PropertyAdaptor(parent)
+{
+    static const bool registered = []() {
+        qRegisterMetaType<ContainerPage>();
+        return QMetaType::registerConverter<ContainerPage, QString>(pageToString);
+    }();
+    Q_UNUSED(registered);
+}
+
+ContainerPropertyAdaptor::~ContainerPropertyAdaptor() = default;
+
+void ContainerPropertyAdaptor::doSetObject(const ObjectInstance &oi)
+{
+    if (oi.type() != ObjectInstance::QtVariant)
+        return;
+
+    const auto &v = oi.variant();
+    if (v.userType() == qMetaTypeId<ContainerPage>()) {
+        const auto page = v.value<ContainerPage>();
+        m_accessor = page.accessor;
+        m_first = page.first;
+        m_size = page.size;
+    } else {
+        m_accessor.reset(createAccessor(v));
+        m_first = 0;
+        m_size = m_accessor->count();
+    }
+
+    m_pageSpan = 1;
+    while ((m_size - 1) / m_pageSpan >= ContainerAccessor::PageSize)
+        m_pageSpan *= ContainerAccessor::PageSize;
+}
+
+int ContainerPropertyAdaptor::count() const
+{
+    if (!m_accessor)
+        return 0;
+    return (m_size + m_pageSpan - 1) / m_pageSpan;
+}
+
+PropertyData ContainerPropertyAdaptor::propertyData(int index) const
+{
+    Q_ASSERT(m_accessor);
+    if (m_pageSpan == 1)
+        return m_accessor->propertyData(m_first + index);
+
+    ContainerPage page;
+    page.accessor = m_accessor;
+    page.first = m_first + index * m_pageSpan;
+    page.size = std::min(m_pageSpan, m_first + m_size - page.first);
+
+    PropertyData data;
+    data.setName(QStringLiteral("[%1..%2]").arg(page.first).arg(page.first + page.size - 1));
+    data.setValue(QVariant::fromValue(page));
+    data.setClassName(m_accessor->container().typeName());
+    return data;
+}
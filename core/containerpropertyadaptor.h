@@ -0,0 +1,142 @@
+/*
+  containerpropertyadaptor.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_CONTAINERPROPERTYADAPTOR_H
+#define GAMMARAY_CONTAINERPROPERTYADAPTOR_H
+
+#include "propertyadaptor.h"
+
+#include <QSharedPointer>
+#include <QVariant>
+
+#include <memory>
+#include <vector>
+
+namespace GammaRay {
+class PropertyData;
+
+/** Element access into a container value, shared between all page nodes of that container. */
+class ContainerAccessor
+{
+public:
+    explicit ContainerAccessor(const QVariant &container);
+    virtual ~ContainerAccessor();
+
+    /** Number of elements shown in one page node. */
+    static const int PageSize = 1000;
+
+    const QVariant &container() const;
+    int count() const;
+    virtual PropertyData propertyData(int index) = 0;
+
+protected:
+    QVariant m_container;
+    int m_count = 0;
+
+private:
+    Q_DISABLE_COPY(ContainerAccessor)
+};
+
+/**
+ * Iterator lookup for containers without random-access iterators.
+ * Iterators to the start of each page are remembered, as well as the last accessed
+ * position, so accessing an element never steps over more than one page.
+ */
+template<typename Iterable>
+class ContainerIteratorCache
+{
+public:
+    typedef typename Iterable::const_iterator Iterator;
+
+    ContainerIteratorCache(const Iterable &iterable, bool randomAccess)
+        : m_iterable(iterable)
+        , m_randomAccess(randomAccess)
+    {
+    }
+
+    Iterator at(int index)
+    {
+        if (m_randomAccess) {
+            auto it = m_iterable.begin();
+            it += index;
+            return it;
+        }
+
+        const int page = index / ContainerAccessor::PageSize;
+        if (!m_cursor || m_cursorIndex > index || m_cursorIndex / ContainerAccessor::PageSize != page) {
+            while (static_cast<int>(m_pageStarts.size()) <= page) {
+                if (m_pageStarts.empty()) {
+                    m_pageStarts.push_back(m_iterable.begin());
+                } else {
+                    auto it = m_pageStarts.back();
+                    it += ContainerAccessor::PageSize;
+                    m_pageStarts.push_back(it);
+                }
+            }
+            m_cursor.reset(new Iterator(m_pageStarts[page]));
+            m_cursorIndex = page * ContainerAccessor::PageSize;
+        }
+
+        *m_cursor += index - m_cursorIndex;
+        m_cursorIndex = index;
+        return *m_cursor;
+    }
+
+private:
+    Iterable m_iterable;
+    std::vector<Iterator> m_pageStarts;
+    std::unique_ptr<Iterator> m_cursor;
+    int m_cursorIndex = -1;
+    bool m_randomAccess;
+};
+
+/** A range of elements of a container value, shown as one "[first..last]" node. */
+struct ContainerPage
+{
+    QSharedPointer<ContainerAccessor> accessor;
+    int first = 0;
+    int size = 0;
+};
+
+/**
+ * Base class for adaptors recursing into container property values.
+ * Containers with more than ContainerAccessor::PageSize elements are presented as
+ * page nodes, nested further for very large containers, so no level of the property
+ * tree ever has more than ContainerAccessor::PageSize rows.
+ */
+class ContainerPropertyAdaptor : public PropertyAdaptor
+{
+    Q_OBJECT
+public:
+    ~ContainerPropertyAdaptor() override;
+
+    int count() const override;
+    PropertyData propertyData(int index) const override;
+
+protected:
+    explicit ContainerPropertyAdaptor(QObject *parent = nullptr);
+    void doSetObject(const ObjectInstance &oi) override;
+
+    /** Creates the element accessor for a container value. */
+    virtual ContainerAccessor *createAccessor(const QVariant &container) const = 0;
+
+private:
+    QSharedPointer<ContainerAccessor> m_accessor;
+    int m_first = 0;
+    int m_size = 0;
+    int m_pageSpan = 1;
+};
+}
+
+Q_DECLARE_METATYPE(GammaRay::ContainerPage)
+
+#endif // GAMMARAY_CONTAINERPROPERTYADAPTOR_H
@@ -119,6 +119,24 @@ Execution::Trace Execution::stackTrace(int maxDepth, int skip)
     return t;
 }
 
+static bool frameEquals(const Execution::TraceData &lhs, const Execution::TraceData &rhs, int index)
+{
+#ifdef USE_BACKWARD_CPP
+    return lhs[index].addr == rhs[index].addr;
+#else
+    return lhs.at(index) == rhs.at(index);
+#endif
+}
+
+static uint frameHash(const Execution::TraceData &data, int index, uint seed)
+{
+#ifdef USE_BACKWARD_CPP
+    return qHash(data[index].addr, seed);
+#else
+    return qHash(data.at(index), seed);
+#endif
+}
+
 #ifdef USE_BACKWARD_CPP
 static backward::TraceResolver *resolver()
 {
@@ -319,6 +337,16 @@ Execution::Trace Execution::stackTrace(int maxDepth, int skip)
     return t;
 }
 
+static bool frameEquals(const Execution::TraceData &lhs, const Execution::TraceData &rhs, int index)
+{
+    return lhs.at(index).name == rhs.at(index).name && lhs.at(index).location == rhs.at(index).location;
+}
+
+static uint frameHash(const Execution::TraceData &data, int index, uint seed)
+{
+    return qHash(data.at(index).name, seed);
+}
+
 Execution::ResolvedFrame Execution::resolveOne(const Execution::Trace &trace, int index)
 {
     return TracePrivate::get(trace).at(index);
@@ -374,6 +402,34 @@ int Trace::size() const
     return d->data.size();
 }
 
+bool Trace::operator==(const Trace &other) const
+{
+    if (d == other.d)
+        return true;
+    const auto count = size();
+    if (count != other.size())
+        return false;
+    for (int i = 0; i < count; ++i) {
+        if (!frameEquals(d->data, other.d->data, i))
+            return false;
+    }
+    return true;
+}
+
+bool Trace::operator!=(const Trace &other) const
+{
+    return !operator==(other);
+}
+
+uint qHash(const Trace &trace, uint seed)
+{
+    const auto &data = TracePrivate::get(trace);
+    uint h = seed;
+    for (int i = 0; i < trace.size(); ++i)
+        h = 31 * h + frameHash(data, i, seed);
+    return h;
+}
+
 }
 }
 // END generic code
@@ -54,11 +54,18 @@ public:
     bool empty() const;
     int size() const;
 
+    /*! Two traces are equal if they consist of the same frames. */
+    bool operator==(const Trace &other) const;
+    bool operator!=(const Trace &other) const;
+
 private:
     friend class TracePrivate;
     std::shared_ptr<TracePrivate> d;
 };
 
+/*! Hash function for Trace, allows interning of identical backtraces. */
+GAMMARAY_CORE_EXPORT uint qHash(const Trace &trace, uint seed = 0);
+
 /*! Create a backtrace.
  *  @param maxDepth The maximum amount of frames to trace
  *  @param skip The amount of frames to skip from the beginning. This is useful to
@@ -14,6 +14,7 @@
 #include "multisignalmapper.h"
 
 #include <QDebug>
+#include <QHash>
 #include <QMetaMethod>
 #include <QMetaObject>
 #include <QVariant>
@@ -37,30 +38,58 @@ public:
 
         if (call == QMetaObject::InvokeMetaMethod) {
             Q_ASSERT(sender());
-            const QVector<QVariant> v = convertArguments(sender(), methodId, args);
-            emit q->signalEmitted(sender(), methodId, v);
+            const QVector<int> types = parameterTypes(sender()->metaObject(), methodId);
+            if (argumentsHandler)
+                argumentsHandler(sender(), methodId, types, args);
+            else
+                emit q->signalEmitted(sender(), methodId, convertArguments(types, args));
             return -1; // indicates we handled the call
         }
         return methodId;
     }
 
-    static QVector<QVariant> convertArguments(QObject *sender, int signalIndex, void **args)
+    QVector<int> parameterTypes(const QMetaObject *mo, int signalIndex)
     {
-        Q_ASSERT(sender);
+        Q_ASSERT(mo);
         Q_ASSERT(signalIndex >= 0);
 
-        const QMetaMethod signal = sender->metaObject()->method(signalIndex);
+        const auto key = qMakePair(mo, signalIndex);
+        const auto it = m_parameterTypes.constFind(key);
+        if (it != m_parameterTypes.constEnd())
+            return it.value();
+
+        const QMetaMethod signal = mo->method(signalIndex);
         Q_ASSERT(signal.methodType() == QMetaMethod::Signal);
 
-        QVector<QVariant> v;
-        const QList<QByteArray> paramTypes = signal.parameterTypes();
-        for (int i = 0; i < paramTypes.size(); ++i) {
-            int type = QMetaType::type(paramTypes[i]);
+        QVector<int> types;
+        types.reserve(signal.parameterCount());
+        bool complete = true;
+        for (int i = 0; i < signal.parameterCount(); ++i) {
+            int type = signal.parameterType(i);
+            if (type == QMetaType::UnknownType)
+                type = QMetaType::type(signal.parameterTypes().at(i));
             if (type == QMetaType::Void || type == QMetaType::UnknownType) {
                 qWarning() << Q_FUNC_INFO << "unknown metatype for signal argument type"
-                           << paramTypes[i];
-                continue;
+                           << signal.parameterTypes().at(i);
+                complete = false;
             }
+            types.push_back(type);
+        }
+
+        // the type might get registered later, so only cache fully resolved signatures
+        if (complete)
+            m_parameterTypes.insert(key, types);
+        return types;
+    }
+
+    static QVector<QVariant> convertArguments(const QVector<int> &types, void **args)
+    {
+        QVector<QVariant> v;
+        v.reserve(types.size());
+        for (int i = 0; i < types.size(); ++i) {
+            const int type = types.at(i);
+            if (type == QMetaType::Void || type == QMetaType::UnknownType)
+                continue;
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
             v.push_back(QVariant(type, args[i + 1]));
 #else
@@ -71,8 +100,12 @@ public:
         return v;
     }
 
+    MultiSignalMapper::ArgumentsHandler argumentsHandler;
+
 private:
     MultiSignalMapper *q;
+    // parameter types per (meta object, signal index)
+    QHash<QPair<const QMetaObject *, int>, QVector<int>> m_parameterTypes;
 };
 }
 
@@ -92,3 +125,8 @@ void MultiSignalMapper::connectToSignal(QObject *sender, const QMetaMethod &sign
                          QObject::metaObject()->methodCount() + signal.methodIndex(), Qt::AutoConnection | Qt::UniqueConnection,
                          nullptr);
 }
+
+void MultiSignalMapper::setArgumentsHandler(const ArgumentsHandler &handler)
+{
+    d->argumentsHandler = handler;
+}
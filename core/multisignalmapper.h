@@ -16,6 +16,9 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QVector>
+
+#include <functional>
 
 namespace GammaRay {
 class MultiSignalMapperPrivate;
@@ -32,6 +35,16 @@ public:
 
     void connectToSignal(QObject *sender, const QMetaMethod &signal);
 
+    /** Callback for setArgumentsHandler().
+     *  @p parameterTypes are the meta type ids of the signal parameters, @p args the arguments as passed to qt_metacall.
+     */
+    typedef std::function<void(QObject *sender, int signalIndex, const QVector<int> &parameterTypes, void **args)> ArgumentsHandler;
+
+    /** Deliver signal emissions to @p handler instead of emitting signalEmitted().
+     *  This avoids converting the arguments to QVariants.
+     */
+    void setArgumentsHandler(const ArgumentsHandler &handler);
+
 signals:
     void signalEmitted(QObject *sender, int signalIndex, const QVector<QVariant> &arguments);
 
@@ -16,6 +16,7 @@
 #include "paintanalyzer.h"
 #include "paintbuffer.h"
 #include "paintbuffermodel.h"
+#include "paintbufferrecording.h"
 #include "painterprofilingreplayer.h"
 
 #include <core/aggregatedpropertymodel.h>
@@ -31,9 +32,12 @@
 
 #include <QItemSelectionModel>
 #include <QSortFilterProxyModel>
+#include <QTimer>
 
 using namespace GammaRay;
 
+static const int RecordingChunkSize = 256 * 1024;
+
 class PaintBufferModelFilterProxy : public QSortFilterProxyModel
 {
     Q_OBJECT
@@ -56,6 +60,7 @@ PaintAnalyzer::PaintAnalyzer(const QString &name, QObject *parent)
     , m_remoteView(new RemoteViewServer(name + QStringLiteral(".remoteView"), this))
     , m_argumentModel(new AggregatedPropertyModel(this))
     , m_stackTraceModel(new StackTraceModel(this))
+    , m_recordingOffset(0)
 {
     m_paintBufferModel = new PaintBufferModel(this);
     auto proxy = new ServerProxyModel<PaintBufferModelFilterProxy>(this);
@@ -173,6 +178,30 @@ void PaintAnalyzer::endAnalyzePainting()
     m_paintBufferModel->setCosts(profiler.costs());
 }
 
+void PaintAnalyzer::requestRecording()
+{
+    const auto pendingTransfer = !m_recording.isEmpty();
+    m_recording = PaintBufferRecording::save(m_paintBufferModel->buffer());
+    m_recordingOffset = 0;
+    if (!pendingTransfer)
+        sendRecordingChunk();
+}
+
+void PaintAnalyzer::sendRecordingChunk()
+{
+    // send in chunks via the event loop, so we don't block other communication while transferring large recordings
+    const auto chunk = m_recording.mid(m_recordingOffset, RecordingChunkSize);
+    emit recordingChunk(m_recordingOffset, m_recording.size(), chunk);
+    m_recordingOffset += chunk.size();
+
+    if (m_recordingOffset >= m_recording.size()) {
+        m_recording.clear();
+        m_recordingOffset = 0;
+        return;
+    }
+    QTimer::singleShot(0, this, &PaintAnalyzer::sendRecordingChunk);
+}
+
 void GammaRay::PaintAnalyzer::setOrigin(const ObjectId &obj)
 {
     m_paintBuffer->setOrigin(obj);
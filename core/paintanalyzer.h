@@ -63,12 +63,16 @@ public:
      */
     void setOrigin(const ObjectId &obj);
 
+public slots:
+    void requestRecording() override;
+
 signals:
     /** Polling for updated analysis. */
     void requestUpdate();
 
 private slots:
     void repaint();
+    void sendRecordingChunk();
 
 private:
     PaintBufferModel *m_paintBufferModel;
@@ -79,6 +83,8 @@ private:
     AggregatedPropertyModel *m_argumentModel;
     ObjectInstance m_currentArgument;
     StackTraceModel *m_stackTraceModel;
+    QByteArray m_recording;
+    int m_recordingOffset;
 };
 }
 
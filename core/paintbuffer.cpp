@@ -14,6 +14,7 @@
 #include "paintbuffer.h"
 #include "execution.h"
 
+#include <algorithm>
 
 using namespace GammaRay;
 
@@ -274,21 +275,14 @@ void PaintBufferEngine::createStackTrace()
     if (!Execution::stackTracingAvailable())
         return;
 
-    const auto size = m_buffer->data()->commands.size();
-    m_buffer->m_stackTraces.resize(size);
     // TODO find a way to stop this at the analyzer call site, we don't want to see the gammaray call chain
-    m_buffer->m_stackTraces.back() = Execution::stackTrace(16, 2);
+    m_buffer->recordStackTrace(m_buffer->data()->commands.size(), Execution::stackTrace(16, 2));
 }
 void PaintBufferEngine::pushOrigin()
 {
-    const auto size = m_buffer->data()->commands.size();
-    m_buffer->m_origins.reserve(size);
-    while (m_buffer->m_origins.size() < size) {
-        m_buffer->m_origins.push_back(m_buffer->m_currentOrigin);
-    }
+    m_buffer->recordOrigin(m_buffer->data()->commands.size());
 }
 
-
 class PaintBufferPrivacyViolater : public QPainterReplayer
 {
 public:
@@ -314,8 +308,11 @@ PaintBuffer::PaintBuffer()
 
 PaintBuffer::PaintBuffer(const PaintBuffer &other)
     : QPaintBuffer(other)
-    , m_stackTraces(other.m_stackTraces)
-    , m_origins(other.m_origins)
+    , m_traces(other.m_traces)
+    , m_traceIndex(other.m_traceIndex)
+    , m_commandTraces(other.m_commandTraces)
+    , m_originRuns(other.m_originRuns)
+    , m_originCount(other.m_originCount)
 {
     d = PaintBufferPrivacyViolater::get(this);
 }
@@ -326,8 +323,11 @@ PaintBuffer &PaintBuffer::operator=(const PaintBuffer &other)
 {
     QPaintBuffer::operator=(other);
     d = PaintBufferPrivacyViolater::get(this);
-    m_stackTraces = other.m_stackTraces;
-    m_origins = other.m_origins;
+    m_traces = other.m_traces;
+    m_traceIndex = other.m_traceIndex;
+    m_commandTraces = other.m_commandTraces;
+    m_originRuns = other.m_originRuns;
+    m_originCount = other.m_originCount;
     return *this;
 }
 
@@ -340,17 +340,51 @@ QPaintEngine *PaintBuffer::paintEngine() const
 
 Execution::Trace PaintBuffer::stackTrace(int index) const
 {
-    if (index < 0 || index >= m_stackTraces.size())
+    if (index < 0 || index >= m_commandTraces.size())
         return Execution::Trace();
-    return m_stackTraces.at(index);
+    const auto traceIndex = m_commandTraces.at(index);
+    if (traceIndex < 0)
+        return Execution::Trace();
+    return m_traces.at(traceIndex);
 }
 
 ObjectId PaintBuffer::origin(int index) const
 {
-    if (index < 0 || index >= m_origins.size()) {
+    if (index < 0 || index >= m_originCount) {
         return ObjectId();
     }
-    return m_origins.at(index);
+    auto it = std::upper_bound(m_originRuns.constBegin(), m_originRuns.constEnd(), index,
+                               [](int index, const OriginRun &run) {
+                                   return index < run.begin;
+                               });
+    Q_ASSERT(it != m_originRuns.constBegin());
+    return (--it)->origin;
+}
+
+void PaintBuffer::recordStackTrace(int commandCount, const Execution::Trace &trace)
+{
+    if (commandCount <= 0)
+        return;
+
+    // commands without a stack trace are marked with -1
+    while (m_commandTraces.size() < commandCount)
+        m_commandTraces.push_back(-1);
+
+    auto it = m_traceIndex.constFind(trace);
+    if (it == m_traceIndex.constEnd()) {
+        it = m_traceIndex.insert(trace, m_traces.size());
+        m_traces.push_back(trace);
+    }
+    m_commandTraces.back() = it.value();
+}
+
+void PaintBuffer::recordOrigin(int commandCount)
+{
+    if (commandCount <= m_originCount)
+        return;
+    if (m_originRuns.isEmpty() || !(m_originRuns.constLast().origin == m_currentOrigin))
+        m_originRuns.push_back({ m_originCount, m_currentOrigin });
+    m_originCount = commandCount;
 }
 
 void PaintBuffer::setOrigin(const ObjectId &obj)
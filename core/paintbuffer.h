@@ -15,18 +15,17 @@
 #define GAMMARAY_PAINTBUFFER_H
 
 #include "gammaray_core_export.h"
+#include "execution.h"
 
 #include <config-gammaray.h>
 #include <common/objectid.h>
+
+#include <QHash>
 #include <QVector>
 
 #include <private/qpaintbuffer_p.h>
 
 namespace GammaRay {
-namespace Execution {
-class Trace;
-}
-
 class PaintBuffer;
 
 class PaintBufferEngine : public QPaintBufferEngine
@@ -113,17 +112,31 @@ public:
     /** Returns the origin of command at @p index. */
     ObjectId origin(int index) const;
 
-
-
     QPaintBufferPrivate *data() const;
 
 private:
     friend class PaintBufferEngine;
+    friend class PaintBufferRecording;
+
+    /** Consecutive commands originating from the same object. */
+    struct OriginRun
+    {
+        int begin;
+        ObjectId origin;
+    };
+
+    void recordStackTrace(int commandCount, const Execution::Trace &trace);
+    void recordOrigin(int commandCount);
+
     QPaintBufferPrivate *d; // not protected in the base class, somewhat nasty to get to
-    QVector<Execution::Trace> m_stackTraces;
 
-public:
-    QVector<ObjectId> m_origins;
+    // stack traces are interned, most commands share their trace with a few others
+    QVector<Execution::Trace> m_traces;
+    QHash<Execution::Trace, int> m_traceIndex;
+    QVector<int> m_commandTraces;
+
+    QVector<OriginRun> m_originRuns;
+    int m_originCount = 0;
     ObjectId m_currentOrigin;
 };
 
@@ -0,0 +1,465 @@
+/*
+  paintbufferrecording.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "paintbufferrecording.h"
+#include "paintbuffer.h"
+
+#include <QBrush>
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+
+#include <cstring>
+
+using namespace GammaRay;
+
+namespace {
+const char RecordingMagic[4] = { 'G', 'R', 'P', 'B' };
+const quint32 RecordingVersion = 1;
+const quint32 ByteOrderMark = 0x01020304;
+const quint32 InvalidBlob = 0xffffffff;
+
+// all sections are 8 byte aligned, so the arrays can be read in-place from a mapped file
+struct RecordingHeader
+{
+    char magic[4];
+    quint32 version;
+    quint32 byteOrderMark;
+    quint32 qrealSize;
+    qint32 dataStreamVersion;
+    quint32 commandCount;
+    quint32 intCount;
+    quint32 floatCount;
+    quint32 frameCount;
+    quint32 variantCount;
+    quint32 blobCount;
+    quint32 originRunCount;
+    double boundingRect[4];
+    quint64 blobDataSize;
+};
+
+struct RecordedCommand
+{
+    quint32 idAndSize;
+    qint32 offset;
+    qint32 offset2;
+    qint32 extra;
+};
+
+struct RecordedBlob
+{
+    quint64 offset;
+    quint64 size;
+};
+
+struct RecordedOriginRun
+{
+    qint32 begin;
+    quint32 blob;
+};
+
+void appendSection(QByteArray &out, const void *data, qint64 size)
+{
+    out.append(reinterpret_cast<const char *>(data), size);
+    const auto padding = (8 - out.size() % 8) % 8;
+    out.append(padding, '\0');
+}
+
+/** Deduplicated storage of QDataStream-serialized values. */
+class BlobWriter
+{
+public:
+    quint32 addVariant(const QVariant &value)
+    {
+        // avoid serializing large values more than once, by looking them up by cache key first
+        QByteArray key;
+        if (value.userType() == QMetaType::QPixmap) {
+            key = derivedKey('P', value.value<QPixmap>().cacheKey());
+        } else if (value.userType() == QMetaType::QImage) {
+            key = derivedKey('I', value.value<QImage>().cacheKey());
+        } else if (value.userType() == QMetaType::QBrush) {
+            const auto brush = value.value<QBrush>();
+            if (brush.style() == Qt::TexturePattern) {
+                key = derivedKey('B', brush.texture().cacheKey());
+                QDataStream stream(&key, QIODevice::WriteOnly | QIODevice::Append);
+                stream << brush.color() << brush.transform();
+            }
+        }
+
+        if (!key.isEmpty()) {
+            const auto it = m_derivedKeys.constFind(key);
+            if (it != m_derivedKeys.constEnd())
+                return it.value();
+        }
+
+        QByteArray blob;
+        QDataStream stream(&blob, QIODevice::WriteOnly);
+        stream << value;
+        const auto index = addBlob(blob);
+        if (!key.isEmpty())
+            m_derivedKeys.insert(key, index);
+        return index;
+    }
+
+    quint32 addObjectId(const ObjectId &id)
+    {
+        QByteArray blob;
+        QDataStream stream(&blob, QIODevice::WriteOnly);
+        stream << id;
+        return addBlob(blob);
+    }
+
+    QVector<RecordedBlob> blobs;
+    QByteArray data;
+
+private:
+    static QByteArray derivedKey(char type, qint64 cacheKey)
+    {
+        QByteArray key(1 + sizeof(cacheKey), type);
+        memcpy(key.data() + 1, &cacheKey, sizeof(cacheKey));
+        return key;
+    }
+
+    quint32 addBlob(const QByteArray &blob)
+    {
+        const auto it = m_content.constFind(blob);
+        if (it != m_content.constEnd())
+            return it.value();
+
+        const auto index = static_cast<quint32>(blobs.size());
+        blobs.push_back({ static_cast<quint64>(data.size()), static_cast<quint64>(blob.size()) });
+        data.append(blob);
+        m_content.insert(blob, index);
+        return index;
+    }
+
+    QHash<QByteArray, quint32> m_content;
+    QHash<QByteArray, quint32> m_derivedKeys;
+};
+
+/** Bounds-checked sequential access to the sections of a recording. */
+class SectionReader
+{
+public:
+    SectionReader(const uchar *data, qint64 size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    template<typename T>
+    const T *read(quint64 count)
+    {
+        const auto size = count * sizeof(T);
+        if (m_pos + size > static_cast<quint64>(m_size) || size / sizeof(T) != count)
+            return nullptr;
+        const auto p = reinterpret_cast<const T *>(m_data + m_pos);
+        m_pos += size;
+        m_pos += (8 - m_pos % 8) % 8;
+        return p;
+    }
+
+private:
+    const uchar *m_data;
+    qint64 m_size;
+    quint64 m_pos = 0;
+};
+
+template<typename T>
+bool decodeBlob(const RecordingHeader *header, const RecordedBlob *blobs, const char *blobData, quint32 index, T &value)
+{
+    if (index >= header->blobCount || blobs[index].offset + blobs[index].size > header->blobDataSize)
+        return false;
+    QDataStream stream(QByteArray::fromRawData(blobData + blobs[index].offset, blobs[index].size));
+    stream.setVersion(header->dataStreamVersion);
+    stream >> value;
+    return stream.status() == QDataStream::Ok;
+}
+
+bool isInRange(qint64 offset, qint64 count, int size)
+{
+    return offset >= 0 && count >= 0 && offset + count <= size;
+}
+
+bool isListVariant(const QPaintBufferPrivate *d, int index, int minSize)
+{
+    return isInRange(index, 1, d->variants.size()) && d->variants.at(index).toList().size() >= minSize;
+}
+
+// checks that everything the replayers access for @p cmd is within the loaded data
+bool isValidCommand(const QPaintBufferPrivate *d, const QPaintBufferCommand &cmd)
+{
+    const auto ints = d->ints.size();
+    const auto floats = d->floats.size();
+    const auto variants = d->variants.size();
+    const qint64 size = cmd.size;
+
+    switch (cmd.id) {
+    case QPaintBufferPrivate::Cmd_Save:
+    case QPaintBufferPrivate::Cmd_Restore:
+    case QPaintBufferPrivate::Cmd_SetCompositionMode:
+    case QPaintBufferPrivate::Cmd_SetRenderHints:
+    case QPaintBufferPrivate::Cmd_SetBackgroundMode:
+        return true;
+    case QPaintBufferPrivate::Cmd_SetPen:
+    case QPaintBufferPrivate::Cmd_SetBrush:
+    case QPaintBufferPrivate::Cmd_SetBrushOrigin:
+    case QPaintBufferPrivate::Cmd_SetTransform:
+    case QPaintBufferPrivate::Cmd_SetOpacity:
+    case QPaintBufferPrivate::Cmd_SetClipEnabled:
+    case QPaintBufferPrivate::Cmd_ClipRegion:
+    case QPaintBufferPrivate::Cmd_SystemStateChanged:
+        return isInRange(cmd.offset, 1, variants);
+    case QPaintBufferPrivate::Cmd_Translate:
+        return isInRange(cmd.extra, 2, floats);
+    case QPaintBufferPrivate::Cmd_DrawVectorPath:
+    case QPaintBufferPrivate::Cmd_ClipVectorPath:
+    case QPaintBufferPrivate::Cmd_FillVectorPath:
+    case QPaintBufferPrivate::Cmd_StrokeVectorPath: {
+        // points in floats, hints followed by the element types unless the high bit is set in ints
+        if (cmd.id == QPaintBufferPrivate::Cmd_FillVectorPath || cmd.id == QPaintBufferPrivate::Cmd_StrokeVectorPath) {
+            if (!isInRange(cmd.extra, 1, variants))
+                return false;
+        }
+        const auto hasElements = (cmd.offset2 & 0x80000000) == 0;
+        return isInRange(cmd.offset, size * 2, floats) && isInRange(cmd.offset2 & 0x7fffffff, hasElements ? size + 1 : 1, ints);
+    }
+    case QPaintBufferPrivate::Cmd_DrawConvexPolygonF:
+    case QPaintBufferPrivate::Cmd_DrawPointsF:
+    case QPaintBufferPrivate::Cmd_DrawPolygonF:
+    case QPaintBufferPrivate::Cmd_DrawPolylineF:
+        return isInRange(cmd.offset, size * 2, floats);
+    case QPaintBufferPrivate::Cmd_DrawConvexPolygonI:
+    case QPaintBufferPrivate::Cmd_DrawPointsI:
+    case QPaintBufferPrivate::Cmd_DrawPolygonI:
+    case QPaintBufferPrivate::Cmd_DrawPolylineI:
+        return isInRange(cmd.offset, size * 2, ints);
+    case QPaintBufferPrivate::Cmd_DrawEllipseF:
+        return isInRange(cmd.offset, 4, floats);
+    case QPaintBufferPrivate::Cmd_DrawEllipseI:
+    case QPaintBufferPrivate::Cmd_ClipRect:
+        return isInRange(cmd.offset, 4, ints);
+    case QPaintBufferPrivate::Cmd_DrawLineF:
+    case QPaintBufferPrivate::Cmd_DrawRectF:
+        return isInRange(cmd.offset, size * 4, floats);
+    case QPaintBufferPrivate::Cmd_DrawLineI:
+    case QPaintBufferPrivate::Cmd_DrawRectI:
+        return isInRange(cmd.offset, size * 4, ints);
+    case QPaintBufferPrivate::Cmd_FillRectBrush:
+    case QPaintBufferPrivate::Cmd_FillRectColor:
+        return isInRange(cmd.offset, 4, floats) && isInRange(cmd.extra, 1, variants);
+    case QPaintBufferPrivate::Cmd_DrawText:
+        return isInRange(cmd.extra, 2, floats) && isListVariant(d, cmd.offset, 2);
+    case QPaintBufferPrivate::Cmd_DrawStaticText:
+        return isListVariant(d, cmd.offset, 1);
+    case QPaintBufferPrivate::Cmd_DrawImagePos:
+    case QPaintBufferPrivate::Cmd_DrawPixmapPos:
+        return isInRange(cmd.offset, 1, variants) && isInRange(cmd.extra, 2, floats);
+    case QPaintBufferPrivate::Cmd_DrawTiledPixmap:
+        return isInRange(cmd.offset, 1, variants) && isInRange(cmd.extra, 6, floats);
+    case QPaintBufferPrivate::Cmd_DrawImageRect:
+    case QPaintBufferPrivate::Cmd_DrawPixmapRect:
+        return isInRange(cmd.offset, 1, variants) && isInRange(cmd.extra, 8, floats);
+    }
+    // Cmd_DrawTextItem refers to in-memory data and is never recorded
+    return false;
+}
+}
+
+QByteArray PaintBufferRecording::save(const PaintBuffer &buffer)
+{
+    const auto d = buffer.data();
+
+    RecordingHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RecordingMagic, sizeof(RecordingMagic));
+    header.version = RecordingVersion;
+    header.byteOrderMark = ByteOrderMark;
+    header.qrealSize = sizeof(qreal);
+    header.dataStreamVersion = QDataStream().version();
+    header.commandCount = d->commands.size();
+    header.intCount = d->ints.size();
+    header.floatCount = d->floats.size();
+    header.frameCount = d->frames.size();
+    header.variantCount = d->variants.size();
+    const auto rect = buffer.boundingRect();
+    header.boundingRect[0] = rect.x();
+    header.boundingRect[1] = rect.y();
+    header.boundingRect[2] = rect.width();
+    header.boundingRect[3] = rect.height();
+
+    QVector<QVariant> variants = d->variants;
+    QVector<RecordedCommand> commands;
+    commands.reserve(d->commands.size());
+    for (const auto &cmd : d->commands) {
+        RecordedCommand rc = { cmd.id | (cmd.size << 8), cmd.offset, cmd.offset2, cmd.extra };
+        if (cmd.id == QPaintBufferPrivate::Cmd_DrawTextItem) {
+            // raw text items only exist in memory, store them as plain text instead
+            auto textItem = reinterpret_cast<QTextItemIntCopy *>(qvariant_cast<void *>(variants.at(cmd.offset)));
+            variants[cmd.offset] = QVariantList() << QVariant((*textItem)().font()) << QVariant((*textItem)().text());
+            rc.idAndSize = QPaintBufferPrivate::Cmd_DrawText | (cmd.size << 8);
+        }
+        commands.push_back(rc);
+    }
+
+    BlobWriter blobs;
+    QVector<quint32> variantBlobs;
+    variantBlobs.reserve(variants.size());
+    for (const auto &v : qAsConst(variants))
+        variantBlobs.push_back(v.isValid() ? blobs.addVariant(v) : InvalidBlob);
+
+    QVector<RecordedOriginRun> originRuns;
+    originRuns.reserve(buffer.m_originRuns.size());
+    for (const auto &run : buffer.m_originRuns)
+        originRuns.push_back({ run.begin, blobs.addObjectId(run.origin) });
+
+    header.blobCount = blobs.blobs.size();
+    header.originRunCount = originRuns.size();
+    header.blobDataSize = blobs.data.size();
+
+    const QVector<int> frames(d->frames.begin(), d->frames.end());
+
+    QByteArray out;
+    out.reserve(sizeof(header) + commands.size() * sizeof(RecordedCommand) + d->ints.size() * sizeof(int)
+                + d->floats.size() * sizeof(qreal) + blobs.data.size() + 1024);
+    appendSection(out, &header, sizeof(header));
+    appendSection(out, commands.constData(), commands.size() * sizeof(RecordedCommand));
+    appendSection(out, d->ints.constData(), d->ints.size() * sizeof(int));
+    appendSection(out, d->floats.constData(), d->floats.size() * sizeof(qreal));
+    appendSection(out, frames.constData(), frames.size() * sizeof(int));
+    appendSection(out, variantBlobs.constData(), variantBlobs.size() * sizeof(quint32));
+    appendSection(out, blobs.blobs.constData(), blobs.blobs.size() * sizeof(RecordedBlob));
+    appendSection(out, originRuns.constData(), originRuns.size() * sizeof(RecordedOriginRun));
+    appendSection(out, blobs.data.constData(), blobs.data.size());
+    return out;
+}
+
+bool PaintBufferRecording::save(const PaintBuffer &buffer, const QString &fileName)
+{
+    QFile f(fileName);
+    if (!f.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to open paint buffer recording file" << fileName << f.errorString();
+        return false;
+    }
+    const auto data = save(buffer);
+    return f.write(data) == data.size();
+}
+
+bool PaintBufferRecording::load(const uchar *data, qint64 size, PaintBuffer &buffer)
+{
+    SectionReader reader(data, size);
+    const auto header = reader.read<RecordingHeader>(1);
+    if (!header || memcmp(header->magic, RecordingMagic, sizeof(RecordingMagic)) != 0)
+        return false;
+    if (header->version != RecordingVersion || header->byteOrderMark != ByteOrderMark || header->qrealSize != sizeof(qreal)) {
+        qWarning() << "Paint buffer recording is from an incompatible host or version.";
+        return false;
+    }
+
+    const auto commands = reader.read<RecordedCommand>(header->commandCount);
+    const auto ints = reader.read<int>(header->intCount);
+    const auto floats = reader.read<qreal>(header->floatCount);
+    const auto frames = reader.read<int>(header->frameCount);
+    const auto variantBlobs = reader.read<quint32>(header->variantCount);
+    const auto blobs = reader.read<RecordedBlob>(header->blobCount);
+    const auto originRuns = reader.read<RecordedOriginRun>(header->originRunCount);
+    const auto blobData = reader.read<char>(header->blobDataSize);
+    if (!commands || !ints || !floats || !frames || !variantBlobs || !blobs || !originRuns || !blobData)
+        return false;
+
+    // build into a separate buffer, so that a failure doesn't leave a half filled one behind
+    PaintBuffer result;
+    auto d = result.data();
+
+    d->commands.resize(header->commandCount);
+    for (quint32 i = 0; i < header->commandCount; ++i) {
+        auto &cmd = d->commands[i];
+        cmd.id = commands[i].idAndSize & 0xff;
+        cmd.size = commands[i].idAndSize >> 8;
+        cmd.offset = commands[i].offset;
+        cmd.offset2 = commands[i].offset2;
+        cmd.extra = commands[i].extra;
+    }
+
+    d->ints.resize(header->intCount);
+    if (header->intCount)
+        memcpy(d->ints.data(), ints, header->intCount * sizeof(int));
+    d->floats.resize(header->floatCount);
+    if (header->floatCount)
+        memcpy(d->floats.data(), floats, header->floatCount * sizeof(qreal));
+    for (quint32 i = 0; i < header->frameCount; ++i) {
+        if (frames[i] < (i ? frames[i - 1] : 0) || frames[i] > static_cast<qint64>(header->commandCount))
+            return false;
+        d->frames.push_back(frames[i]);
+    }
+
+    // decode every distinct value only once, duplicates then share their data implicitly
+    QVector<QVariant> decoded(header->blobCount);
+    QVector<bool> isDecoded(header->blobCount, false);
+    d->variants.reserve(header->variantCount);
+    for (quint32 i = 0; i < header->variantCount; ++i) {
+        const auto blob = variantBlobs[i];
+        if (blob == InvalidBlob) {
+            d->variants.push_back(QVariant());
+            continue;
+        }
+        if (blob >= header->blobCount)
+            return false;
+        if (!isDecoded.at(blob)) {
+            if (!decodeBlob(header, blobs, blobData, blob, decoded[blob]))
+                return false;
+            isDecoded[blob] = true;
+        }
+        d->variants.push_back(decoded.at(blob));
+    }
+
+    // offsets of corrupt or truncated recordings would make the replay read out of bounds
+    for (const auto &cmd : qAsConst(d->commands)) {
+        if (!isValidCommand(d, cmd))
+            return false;
+    }
+
+    result.m_originRuns.reserve(header->originRunCount);
+    for (quint32 i = 0; i < header->originRunCount; ++i) {
+        PaintBuffer::OriginRun run;
+        run.begin = originRuns[i].begin;
+        // origin lookups expect sorted runs with the first one covering the first command
+        if (i == 0 ? run.begin != 0 : run.begin <= originRuns[i - 1].begin)
+            return false;
+        if (!decodeBlob(header, blobs, blobData, originRuns[i].blob, run.origin))
+            return false;
+        result.m_originRuns.push_back(run);
+    }
+    result.m_originCount = result.m_originRuns.isEmpty() ? 0 : header->commandCount;
+
+    result.setBoundingRect(QRectF(header->boundingRect[0], header->boundingRect[1],
+                                  header->boundingRect[2], header->boundingRect[3]));
+    buffer = result;
+    return true;
+}
+
+bool PaintBufferRecording::load(const QString &fileName, PaintBuffer &buffer)
+{
+    QFile f(fileName);
+    if (!f.open(QFile::ReadOnly)) {
+        qWarning() << "Failed to open paint buffer recording file" << fileName << f.errorString();
+        return false;
+    }
+
+    const uchar *data = f.map(0, f.size());
+    if (!data)
+        return false;
+    return load(data, f.size(), buffer);
+}
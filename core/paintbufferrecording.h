@@ -0,0 +1,61 @@
+/*
+  paintbufferrecording.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PAINTBUFFERRECORDING_H
+#define GAMMARAY_PAINTBUFFERRECORDING_H
+
+#include "gammaray_core_export.h"
+
+#include <QByteArray>
+
+QT_BEGIN_NAMESPACE
+class QString;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+class PaintBuffer;
+
+/**
+ * Compact binary representation of a PaintBuffer.
+ *
+ * In contrast to the QDataStream serialization of QPaintBuffer, this stores the
+ * command, integer and floating point streams as flat arrays that are restored with
+ * a single copy each instead of being parsed element by element, and deduplicates
+ * pixmaps, images, brushes and all other variant arguments as well as command origins.
+ *
+ * The format is meant for the host it has been recorded on, files with a different
+ * byte order or floating point size are rejected. Stack traces are not stored, as they
+ * are only meaningful within the recording process.
+ */
+class GAMMARAY_CORE_EXPORT PaintBufferRecording
+{
+public:
+    /** Serializes @p buffer into the compact recording format. */
+    static QByteArray save(const PaintBuffer &buffer);
+    /** Writes the compact recording of @p buffer to @p fileName. */
+    static bool save(const PaintBuffer &buffer, const QString &fileName);
+
+    /**
+     * Restores @p buffer from @p size bytes of recording data at @p data.
+     * The data is copied, @p buffer does not reference @p data afterwards.
+     * @returns @c false if @p data does not contain a valid recording, @p buffer is left unchanged then.
+     */
+    static bool load(const uchar *data, qint64 size, PaintBuffer &buffer);
+    /** Restores @p buffer from the recording file @p fileName, which is memory-mapped for reading. */
+    static bool load(const QString &fileName, PaintBuffer &buffer);
+
+private:
+    PaintBufferRecording() = delete;
+};
+}
+
+#endif // GAMMARAY_PAINTBUFFERRECORDING_H
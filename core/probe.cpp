@@ -37,6 +37,8 @@
 #include "remote/selectionmodelserver.h"
 #include "toolpluginerrormodel.h"
 #include "probeguard.h"
+#include "probeprofiler.h"
+#include "signalspydispatcher.h"
 
 #include <common/objectbroker.h>
 #include <common/streamoperators.h>
@@ -55,6 +57,7 @@
 #include <private/qobject_p.h>
 #include <private/qhooks_p.h>
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <cstdio>
 
@@ -72,25 +75,71 @@ using namespace std;
 QAtomicPointer<Probe> Probe::s_instance = QAtomicPointer<Probe>(nullptr);
 
 namespace GammaRay {
-static void signal_begin_callback(QObject *caller, int method_index, void **argv)
+/** Consumers interested in the end of a signal emission, between its begin and end callback. */
+struct PendingSignal
+{
+    int methodIndex;
+    quint64 consumers;
+};
+
+// Emissions nest strictly within a thread, so the innermost one is always at the end.
+// Qt calls the begin and end callbacks of an emission from the same callback set, and
+// signal_begin_end_callback is only ever installed together with signal_end_callback,
+// so each emission pushes and pops exactly once, however the consumers change meanwhile.
+static thread_local QVarLengthArray<PendingSignal, 16> t_pendingSignals;
+
+/** Runs the interested begin callbacks, and returns the consumers interested in the end of the emission. */
+static quint64 dispatchSignalBegin(QObject *caller, int &method_index, void **argv)
 {
+    const auto probe = Probe::instance();
+    if (method_index == 0 || !probe)
+        return 0;
+
+    SignalSpyDispatcher::BeginCallbacks callbacks;
+    const auto endConsumers = probe->signalSpyDispatcher()->signalBegin(caller, method_index, callbacks);
+    if (callbacks.isEmpty())
+        return endConsumers;
+
     // Ignore event dispatcher signals
-    if (caller->inherits("QAbstractEventDispatcher"))
-        return;
+    if (caller->inherits("QAbstractEventDispatcher") || probe->filterObject(caller))
+        return endConsumers;
 
-    if (method_index == 0 || !Probe::instance() || Probe::instance()->filterObject(caller))
-        return;
+    for (const auto callback : callbacks)
+        callback(caller, method_index, argv);
+    return endConsumers;
+}
 
-    method_index = Util::signalIndexToMethodIndex(caller->metaObject(), method_index);
-    Probe::executeSignalCallback([=](const SignalSpyCallbackSet &callbacks) {
-        if (callbacks.signalBeginCallback)
-            callbacks.signalBeginCallback(caller, method_index, argv);
-    });
+static void signal_begin_callback(QObject *caller, int method_index, void **argv)
+{
+    ProbeProfilerScope profilerScope(ProbeProfiler::SignalBegin);
+    dispatchSignalBegin(caller, method_index, argv);
+}
+
+static void signal_begin_end_callback(QObject *caller, int method_index, void **argv)
+{
+    ProbeProfilerScope profilerScope(ProbeProfiler::SignalBegin);
+    PendingSignal pending;
+    pending.consumers = dispatchSignalBegin(caller, method_index, argv);
+    pending.methodIndex = method_index;
+    t_pendingSignals.push_back(pending);
 }
 
 static void signal_end_callback(QObject *caller, int method_index)
 {
-    if (method_index == 0 || !Probe::instance())
+    ProbeProfilerScope profilerScope(ProbeProfiler::SignalEnd);
+    Q_UNUSED(method_index);
+
+    // always pop, whatever the consumers look like by now, to keep the stack balanced
+    auto &pendingSignals = t_pendingSignals;
+    Q_ASSERT(!pendingSignals.isEmpty());
+    if (pendingSignals.isEmpty())
+        return;
+    const auto pending = pendingSignals.last();
+    pendingSignals.removeLast();
+
+    // caller might have been deleted in a slot, so uninteresting emissions are discarded before looking at it
+    const auto probe = Probe::instance();
+    if (!pending.consumers || !probe)
         return;
 
     QMutexLocker locker(Probe::objectLock());
@@ -100,38 +149,64 @@ static void signal_end_callback(QObject *caller, int method_index)
         return; // deleted in the slot
     locker.unlock();
 
-    method_index = Util::signalIndexToMethodIndex(caller->metaObject(), method_index);
-    Probe::executeSignalCallback([=](const SignalSpyCallbackSet &callbacks) {
-        if (callbacks.signalEndCallback)
-            callbacks.signalEndCallback(caller, method_index);
-    });
+    SignalSpyDispatcher::EndCallbacks callbacks;
+    probe->signalSpyDispatcher()->signalEnd(pending.consumers, callbacks);
+    for (const auto callback : callbacks)
+        callback(caller, pending.methodIndex);
 }
 
 static void slot_begin_callback(QObject *caller, int method_index, void **argv)
 {
-    if (method_index == 0 || !Probe::instance() || Probe::instance()->filterObject(caller))
+    ProbeProfilerScope profilerScope(ProbeProfiler::SlotBegin);
+    const auto probe = Probe::instance();
+    if (method_index == 0 || !probe)
+        return;
+
+    SignalSpyDispatcher::BeginCallbacks callbacks;
+    probe->signalSpyDispatcher()->slotBegin(caller, callbacks);
+    if (callbacks.isEmpty() || probe->filterObject(caller))
         return;
 
-    Probe::executeSignalCallback([=](const SignalSpyCallbackSet &callbacks) {
-        if (callbacks.slotBeginCallback)
-            callbacks.slotBeginCallback(caller, method_index, argv);
-    });
+    for (const auto callback : callbacks)
+        callback(caller, method_index, argv);
 }
 
 static void slot_end_callback(QObject *caller, int method_index)
 {
-    if (method_index == 0 || !Probe::instance())
+    ProbeProfilerScope profilerScope(ProbeProfiler::SlotEnd);
+    const auto probe = Probe::instance();
+    if (method_index == 0 || !probe)
         return;
 
     QMutexLocker locker(Probe::objectLock());
-    if (!Probe::instance()->isValidObject(caller)) // implies filterObject()
+    if (!probe->isValidObject(caller)) // implies filterObject()
         return; // deleted in the slot
     locker.unlock();
 
-    Probe::executeSignalCallback([=](const SignalSpyCallbackSet &callbacks) {
-        if (callbacks.slotEndCallback)
-            callbacks.slotEndCallback(caller, method_index);
-    });
+    SignalSpyDispatcher::EndCallbacks callbacks;
+    probe->signalSpyDispatcher()->slotEnd(caller, callbacks);
+    for (const auto callback : callbacks)
+        callback(caller, method_index);
+}
+
+/** One callback set for each combination of callback types, indexed by a bitmask of SignalSpyDispatcher::CallbackType. */
+static std::array<QSignalSpyCallbackSet, 1 << SignalSpyDispatcher::CallbackTypeCount> createSignalSpyCallbackSets()
+{
+    std::array<QSignalSpyCallbackSet, 1 << SignalSpyDispatcher::CallbackTypeCount> sets;
+    for (int types = 0; types < static_cast<int>(sets.size()); ++types) {
+        auto &set = sets[types];
+        // the end callback needs a begin callback to pair emissions with
+        if (types & (1 << SignalSpyDispatcher::SignalEnd))
+            set.signal_begin_callback = signal_begin_end_callback;
+        else if (types & (1 << SignalSpyDispatcher::SignalBegin))
+            set.signal_begin_callback = signal_begin_callback;
+        else
+            set.signal_begin_callback = nullptr;
+        set.signal_end_callback = (types & (1 << SignalSpyDispatcher::SignalEnd)) ? signal_end_callback : nullptr;
+        set.slot_begin_callback = (types & (1 << SignalSpyDispatcher::SlotBegin)) ? slot_begin_callback : nullptr;
+        set.slot_end_callback = (types & (1 << SignalSpyDispatcher::SlotEnd)) ? slot_end_callback : nullptr;
+    }
+    return sets;
 }
 
 static QItemSelectionModel *selectionModelFactory(QAbstractItemModel *model)
@@ -184,6 +259,7 @@ Probe::Probe(QObject *parent)
     , m_window(nullptr)
     , m_metaObjectRegistry(new MetaObjectRegistry(this))
     , m_queueTimer(new QTimer(this))
+    , m_signalSpyDispatcher(new SignalSpyDispatcher)
     , m_server(nullptr)
 {
     qputenv("DEBUGINFOD_URLS", QByteArray());
@@ -503,6 +579,7 @@ QRecursiveMutex *Probe::objectLock()
  */
 void Probe::objectAdded(QObject *obj, bool fromCtor)
 {
+    ProbeProfilerScope profilerScope(ProbeProfiler::ObjectAdded);
     if (obj == nullptr)
         return;
     QMutexLocker lock(s_lock());
@@ -655,6 +732,7 @@ void Probe::objectFullyConstructed(QObject *obj)
  */
 void Probe::objectRemoved(QObject *obj)
 {
+    ProbeProfilerScope profilerScope(ProbeProfiler::ObjectRemoved);
     QMutexLocker lock(s_lock());
 
     if (!isInitialized()) {
@@ -765,6 +843,7 @@ void Probe::notifyQueuedObjectChanges()
 
 bool Probe::eventFilter(QObject *receiver, QEvent *event)
 {
+    ProbeProfilerScope profilerScope(ProbeProfiler::EventFilter);
     if (ProbeGuard::insideProbe() && receiver->thread() == QThread::currentThread())
         return QObject::eventFilter(receiver, event);
 
@@ -941,37 +1020,49 @@ void Probe::removeObjectAsFavorite(QObject *object)
     Q_EMIT objectUnfavorited(object);
 }
 
-void Probe::registerSignalSpyCallbackSet(const SignalSpyCallbackSet &callbacks)
+int Probe::registerSignalSpyCallbackSet(const SignalSpyCallbackSet &callbacks)
 {
     if (callbacks.isNull())
-        return;
-    m_signalSpyCallbacks.push_back(callbacks);
+        return -1;
+    const int id = m_signalSpyDispatcher->addConsumer(callbacks);
+    if (id < 0) {
+        std::cerr << "Too many signal spy callback sets registered, ignoring further ones." << std::endl;
+        return -1;
+    }
     setupSignalSpyCallbacks();
+    return id;
+}
+
+void Probe::unregisterSignalSpyCallbackSet(int id)
+{
+    m_signalSpyDispatcher->removeConsumer(id);
+    setupSignalSpyCallbacks();
+}
+
+SignalSpyDispatcher *Probe::signalSpyDispatcher() const
+{
+    return m_signalSpyDispatcher.get();
 }
 
 void Probe::setupSignalSpyCallbacks()
 {
+    if (m_signalSpyDispatcher->isEmpty()) {
+        qt_register_signal_spy_callbacks(m_previousSignalSpyCallbackSet);
+        return;
+    }
+
     // memory management is with us for Qt >= 5.14, therefore static here!
-    static QSignalSpyCallbackSet cbs = { nullptr, nullptr, nullptr, nullptr };
-    foreach (const auto &it, m_signalSpyCallbacks) {
-        if (it.signalBeginCallback)
-            cbs.signal_begin_callback = signal_begin_callback;
-        if (it.signalEndCallback)
-            cbs.signal_end_callback = signal_end_callback;
-        if (it.slotBeginCallback)
-            cbs.slot_begin_callback = slot_begin_callback;
-        if (it.slotEndCallback)
-            cbs.slot_end_callback = slot_end_callback;
-    }
-    qt_register_signal_spy_callbacks(&cbs);
-}
-
-template<typename Func>
-void Probe::executeSignalCallback(const Func &func)
-{
-    std::for_each(instance()->m_signalSpyCallbacks.constBegin(),
-                  instance()->m_signalSpyCallbacks.constEnd(),
-                  func);
+    // The sets are never modified once created, so an emission in progress keeps seeing
+    // the begin and end callbacks it started with, however often the consumers change.
+    static auto cbs = createSignalSpyCallbackSets();
+
+    const auto dispatcher = m_signalSpyDispatcher.get();
+    int types = 0;
+    for (int type = 0; type < SignalSpyDispatcher::CallbackTypeCount; ++type) {
+        if (dispatcher->hasCallback(static_cast<SignalSpyDispatcher::CallbackType>(type)))
+            types |= 1 << type;
+    }
+    qt_register_signal_spy_callbacks(&cbs[types]);
 }
 
 SourceLocation Probe::objectCreationSourceLocation(const QObject *object)
@@ -48,6 +48,7 @@ class Server;
 class ToolManager;
 class ProblemCollector;
 class MetaObjectRegistry;
+class SignalSpyDispatcher;
 namespace Execution {
 class Trace;
 }
@@ -177,9 +178,21 @@ public:
      * Signal indexes provided as arguments are mapped to method indexes, ie. argument semantics
      * are the same with Qt4 and Qt5.
      *
+     * The callbacks are only invoked for the classes and signals the set is restricted to,
+     * emissions nobody is interested in are filtered out before any callback is called.
+     *
+     * @return An id for unregisterSignalSpyCallbackSet(), or -1 if @p callbacks could not be registered.
      * @since 2.2
      */
-    void registerSignalSpyCallbackSet(const SignalSpyCallbackSet &callbacks);
+    int registerSignalSpyCallbackSet(const SignalSpyCallbackSet &callbacks);
+
+    /*!
+     * Unregister the signal spy callback set with @p id.
+     * Once no callback set is left, the probe stops observing signal emissions entirely.
+     *
+     * @since 3.2
+     */
+    void unregisterSignalSpyCallbackSet(int id);
 
     /*! Returns the source code location @p object was created at. */
     static SourceLocation objectCreationSourceLocation(const QObject *object);
@@ -225,8 +238,7 @@ public:
 
     ///@cond internal
     static void startupHookReceived();
-    template<typename Func>
-    static void executeSignalCallback(const Func &func);
+    SignalSpyDispatcher *signalSpyDispatcher() const;
     ///@endcond
 
     ProblemCollector *problemCollector() const;
@@ -344,7 +356,7 @@ private:
     QList<QObject *> m_pendingReparents;
     QTimer *m_queueTimer;
     QVector<QObject *> m_globalEventFilters;
-    QVector<SignalSpyCallbackSet> m_signalSpyCallbacks;
+    std::unique_ptr<SignalSpyDispatcher> m_signalSpyDispatcher;
 
     QSignalSpyCallbackSet *m_previousSignalSpyCallbackSet;
     Server *m_server;
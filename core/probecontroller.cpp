@@ -15,6 +15,8 @@
 
 #include "probe.h"
 
+#include <common/endpoint.h>
+
 #include <QDebug>
 #include <QCoreApplication>
 #include <QMutexLocker>
@@ -35,3 +37,8 @@ void ProbeController::quitHost()
 {
     QCoreApplication::instance()->quit();
 }
+
+void ProbeController::requestMessageLatencies()
+{
+    emit messageLatenciesReceived(Endpoint::instance()->messageLatencies());
+}
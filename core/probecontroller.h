@@ -30,6 +30,7 @@ public:
 public slots:
     void detachProbe() override;
     void quitHost() override;
+    void requestMessageLatencies() override;
 };
 }
 
@@ -13,9 +13,8 @@
 
 #include "probeguard.h"
 
-#include <QThreadStorage>
-
-static QThreadStorage<bool> s_probeGuards;
+// checked on every hook call, so avoid the QThreadStorage lookup
+static thread_local bool s_insideProbe = false;
 
 using namespace GammaRay;
 
@@ -38,14 +37,12 @@ ProbeGuard::~ProbeGuard()
 
 bool ProbeGuard::insideProbe()
 {
-    if (!s_probeGuards.hasLocalData())
-        return false;
-    return s_probeGuards.localData();
+    return s_insideProbe;
 }
 
 void ProbeGuard::setInsideProbe(bool inside)
 {
-    s_probeGuards.localData() = inside;
+    s_insideProbe = inside;
 }
 
 ProbeGuardSuspender::ProbeGuardSuspender()
@@ -0,0 +1,214 @@
+/*
+  probeprofiler.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "probeprofiler.h"
+
+#include <QCoreApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace GammaRay;
+
+std::atomic<bool> ProbeProfiler::s_enabled(false);
+
+namespace {
+/** Counters of a single thread. Only the owning thread writes, so no read-modify-write operations are needed. */
+struct ThreadCounters
+{
+    ThreadCounters()
+    {
+        for (int site = 0; site < ProbeProfiler::SiteCount; ++site) {
+            count[site] = 0;
+            total[site] = 0;
+            max[site] = 0;
+            for (int i = 0; i < ProbeProfiler::BucketCount; ++i)
+                histogram[site][i] = 0;
+        }
+    }
+
+    std::atomic<quint64> count[ProbeProfiler::SiteCount];
+    std::atomic<quint64> total[ProbeProfiler::SiteCount];
+    std::atomic<quint64> max[ProbeProfiler::SiteCount];
+    std::atomic<quint32> histogram[ProbeProfiler::SiteCount][ProbeProfiler::BucketCount];
+};
+
+template<typename T>
+void increment(std::atomic<T> &counter, T value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct ProfilerData
+{
+    QMutex mutex;
+    // counters of threads that already exited are kept, their data is still relevant
+    std::vector<std::unique_ptr<ThreadCounters>> threads;
+    quint64 enabledSince = 0;
+    quint64 recordingTime = 0;
+};
+}
+
+Q_GLOBAL_STATIC(ProfilerData, s_data)
+
+static thread_local ThreadCounters *t_counters = nullptr;
+
+static ThreadCounters *threadCounters()
+{
+    if (t_counters)
+        return t_counters;
+    if (s_data.isDestroyed())
+        return nullptr;
+
+    QMutexLocker lock(&s_data()->mutex);
+    s_data()->threads.emplace_back(new ThreadCounters);
+    t_counters = s_data()->threads.back().get();
+    return t_counters;
+}
+
+quint64 ProbeProfiler::SiteStatistics::percentile(double fraction) const
+{
+    if (!count)
+        return 0;
+    const auto target = std::max<quint64>(1, std::ceil(fraction * count));
+    quint64 sum = 0;
+    for (int i = 0; i < histogram.size(); ++i) {
+        sum += histogram.at(i);
+        if (sum >= target)
+            return std::min(bucketUpperBound(i), maxNSecs);
+    }
+    return maxNSecs;
+}
+
+void ProbeProfiler::setEnabled(bool enabled)
+{
+    QMutexLocker lock(&s_data()->mutex);
+    if (enabled == isEnabled())
+        return;
+
+    if (enabled)
+        s_data()->enabledSince = now();
+    else
+        s_data()->recordingTime += now() - s_data()->enabledSince;
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void ProbeProfiler::reset()
+{
+    QMutexLocker lock(&s_data()->mutex);
+    // racing with the owning thread can lose a few updates at most, which is acceptable here
+    for (const auto &counters : s_data()->threads) {
+        for (int site = 0; site < SiteCount; ++site) {
+            counters->count[site].store(0, std::memory_order_relaxed);
+            counters->total[site].store(0, std::memory_order_relaxed);
+            counters->max[site].store(0, std::memory_order_relaxed);
+            for (int i = 0; i < BucketCount; ++i)
+                counters->histogram[site][i].store(0, std::memory_order_relaxed);
+        }
+    }
+    s_data()->enabledSince = now();
+    s_data()->recordingTime = 0;
+}
+
+quint64 ProbeProfiler::recordingTime()
+{
+    QMutexLocker lock(&s_data()->mutex);
+    if (isEnabled())
+        return s_data()->recordingTime + now() - s_data()->enabledSince;
+    return s_data()->recordingTime;
+}
+
+void ProbeProfiler::record(Site site, quint64 nsecs)
+{
+    auto counters = threadCounters();
+    if (!counters)
+        return;
+
+    increment<quint64>(counters->count[site], 1);
+    increment<quint64>(counters->total[site], nsecs);
+    if (nsecs > counters->max[site].load(std::memory_order_relaxed))
+        counters->max[site].store(nsecs, std::memory_order_relaxed);
+    increment<quint32>(counters->histogram[site][bucketIndex(nsecs)], 1);
+}
+
+QVector<ProbeProfiler::SiteStatistics> ProbeProfiler::statistics()
+{
+    QVector<SiteStatistics> stats(SiteCount);
+    for (auto &s : stats)
+        s.histogram.resize(BucketCount);
+
+    QMutexLocker lock(&s_data()->mutex);
+    for (const auto &counters : s_data()->threads) {
+        for (int site = 0; site < SiteCount; ++site) {
+            auto &s = stats[site];
+            s.count += counters->count[site].load(std::memory_order_relaxed);
+            s.totalNSecs += counters->total[site].load(std::memory_order_relaxed);
+            s.maxNSecs = std::max<quint64>(s.maxNSecs, counters->max[site].load(std::memory_order_relaxed));
+            for (int i = 0; i < BucketCount; ++i)
+                s.histogram[i] += counters->histogram[site][i].load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
+QString ProbeProfiler::siteName(Site site)
+{
+    switch (site) {
+    case ObjectAdded:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Object added");
+    case ObjectRemoved:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Object removed");
+    case SignalBegin:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Signal begin");
+    case SignalEnd:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Signal end");
+    case SlotBegin:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Slot begin");
+    case SlotEnd:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Slot end");
+    case EventFilter:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Event filter");
+    case MessageHandler:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Message handler");
+    case RemoteModelRequest:
+        return QCoreApplication::translate("GammaRay::ProbeProfiler", "Remote model requests");
+    case SiteCount:
+        break;
+    }
+    return QString();
+}
+
+int ProbeProfiler::bucketIndex(quint64 nsecs)
+{
+    if (nsecs < static_cast<quint64>(LinearBuckets))
+        return static_cast<int>(nsecs);
+
+    const int msb = 63 - qCountLeadingZeroBits(nsecs);
+    const int shift = msb - 4; // keeps the top 5 bits, ie. a value in [SubBuckets, LinearBuckets)
+    const int index = LinearBuckets + (shift - 1) * SubBuckets + static_cast<int>(nsecs >> shift) - SubBuckets;
+    return std::min(index, BucketCount - 1);
+}
+
+quint64 ProbeProfiler::bucketUpperBound(int index)
+{
+    if (index < LinearBuckets)
+        return index;
+
+    const int shift = (index - LinearBuckets) / SubBuckets + 1;
+    const quint64 sub = (index - LinearBuckets) % SubBuckets + SubBuckets;
+    return ((sub + 1) << shift) - 1;
+}
@@ -0,0 +1,119 @@
+/*
+  probeprofiler.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PROBEPROFILER_H
+#define GAMMARAY_PROBEPROFILER_H
+
+#include "gammaray_core_export.h"
+
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <chrono>
+
+namespace GammaRay {
+/**
+ * Accounting of the time spent in the probe's hooks into the target application.
+ *
+ * Every hook site records call count, total and maximum duration and a log-linear
+ * latency histogram, in counters owned by the calling thread. When disabled, a
+ * hook only pays for a single relaxed atomic load.
+ */
+class GAMMARAY_CORE_EXPORT ProbeProfiler
+{
+public:
+    enum Site {
+        ObjectAdded,
+        ObjectRemoved,
+        SignalBegin,
+        SignalEnd,
+        SlotBegin,
+        SlotEnd,
+        EventFilter,
+        MessageHandler,
+        RemoteModelRequest,
+        SiteCount
+    };
+
+    /** Histogram buckets below this value (in nanoseconds) have a width of 1ns. */
+    static const int LinearBuckets = 32;
+    /** Buckets per power of two above that, ie. values are recorded with ~6% precision. */
+    static const int SubBuckets = LinearBuckets / 2;
+    /** Number of histogram buckets, covering durations up to 2^41ns (about 36 minutes). */
+    static const int BucketCount = LinearBuckets + 36 * SubBuckets;
+
+    struct SiteStatistics
+    {
+        quint64 count = 0;
+        quint64 totalNSecs = 0;
+        quint64 maxNSecs = 0;
+        QVector<quint64> histogram;
+
+        /** Upper bound of the duration of @p fraction (0..1) of all calls, in nanoseconds. */
+        quint64 percentile(double fraction) const;
+    };
+
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    /** Discards all recorded data. */
+    static void reset();
+    /** Time since profiling was enabled or reset, excluding disabled periods, in nanoseconds. */
+    static quint64 recordingTime();
+
+    static void record(Site site, quint64 nsecs);
+
+    /** Statistics of all sites, merged over all threads. */
+    static QVector<SiteStatistics> statistics();
+
+    static QString siteName(Site site);
+
+    static int bucketIndex(quint64 nsecs);
+    /** Largest value recorded into bucket @p index. */
+    static quint64 bucketUpperBound(int index);
+
+    static quint64 now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/** Records the lifetime of this object for @p site, if profiling is enabled. */
+class ProbeProfilerScope
+{
+public:
+    explicit ProbeProfilerScope(ProbeProfiler::Site site)
+        : m_start(ProbeProfiler::isEnabled() ? ProbeProfiler::now() : 0)
+        , m_site(site)
+    {
+    }
+    ~ProbeProfilerScope()
+    {
+        if (m_start)
+            ProbeProfiler::record(m_site, ProbeProfiler::now() - m_start);
+    }
+
+private:
+    Q_DISABLE_COPY(ProbeProfilerScope)
+    quint64 m_start;
+    ProbeProfiler::Site m_site;
+};
+}
+
+#endif // GAMMARAY_PROBEPROFILER_H
@@ -56,7 +56,9 @@ PropertyAdaptor *PropertyAdaptorFactory::create(const ObjectInstance &oi, QObjec
             }
         } else if (oi.typeName() == "QJSValue") {
         } else {
-            const auto &v = oi.variant();
+            auto v = oi.variant();
+            if (v.userType() == qMetaTypeId<ContainerPage>()) // page node of a large container
+                v = v.value<ContainerPage>().accessor->container();
             if (v.canConvert<QVariantList>())
                 adaptors.push_back(new SequentialPropertyAdaptor(parent));
             else if (v.canConvert<QVariantHash>())
@@ -44,8 +44,10 @@ void QMetaPropertyAdaptor::doSetObject(const ObjectInstance &oi)
         const QMetaProperty prop = mo->property(i);
         if (!PropertyFilters::matches(propertyMetaData(i))) {
             if (oi.type() == ObjectInstance::QtObject && oi.qtObject() && prop.hasNotifySignal()) {
-                const QByteArray sig = QByteArray("2") + prop.notifySignal().methodSignature();
-                connect(oi.qtObject(), sig, this, SLOT(propertyUpdated()));
+                if (!m_notifyToRowMap.contains(prop.notifySignalIndex())) {
+                    const QByteArray sig = QByteArray("2") + prop.notifySignal().methodSignature();
+                    connect(oi.qtObject(), sig, this, SLOT(propertyUpdated()));
+                }
                 m_notifyToRowMap.insert(prop.notifySignalIndex(), m_rowToPropertyIndex.size());
             }
             m_rowToPropertyIndex.push_back(i);
@@ -223,6 +225,7 @@ void QMetaPropertyAdaptor::propertyUpdated()
     if (m_notifyGuard) // do not emit change notifications during reading (happens for eg. lazy computed properties like QQItem::childrenRect, that confuses the hell out of QSFPM)
         return;
 
-    const int row = m_notifyToRowMap.value(senderSignalIndex());
-    emit propertyChanged(row, row);
+    const auto rows = m_notifyToRowMap.values(senderSignalIndex());
+    for (const auto row : rows)
+        emit propertyChanged(row, row);
 }
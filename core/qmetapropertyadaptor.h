@@ -42,7 +42,8 @@ private slots:
     void propertyUpdated();
 
 private:
-    QHash<int, int> m_notifyToRowMap;
+    /// properties can share a notify signal, e.g. for QML aliases
+    QMultiHash<int, int> m_notifyToRowMap;
     QVector<int> m_rowToPropertyIndex;
     mutable bool m_notifyGuard;
 };
@@ -15,6 +15,7 @@
 #include "common/remotemodelroles.h"
 #include "server.h"
 #include <core/probeguard.h>
+#include <core/probeprofiler.h>
 #include <common/protocol.h>
 #include <common/message.h>
 #include <common/modelevent.h>
@@ -39,6 +40,31 @@ using namespace std;
 
 void (*RemoteModelServer::s_registerServerCallback)() = nullptr;
 
+namespace {
+/** Records the time spent handling a request, including sending the reply. */
+class RequestHandlingTimer
+{
+public:
+    RequestHandlingTimer(Protocol::ObjectAddress address, Protocol::MessageType type)
+        : m_start(Endpoint::latencyTimestamp())
+        , m_address(address)
+        , m_type(type)
+    {
+    }
+    ~RequestHandlingTimer()
+    {
+        Endpoint::recordLatency(MessageLatencies::Handling, m_address, m_type,
+                                Endpoint::latencyTimestamp() - m_start);
+    }
+
+private:
+    Q_DISABLE_COPY(RequestHandlingTimer)
+    quint64 m_start;
+    Protocol::ObjectAddress m_address;
+    Protocol::MessageType m_type;
+};
+}
+
 RemoteModelServer::RemoteModelServer(const QString &objectName, QObject *parent)
     : QObject(parent)
     , m_model(nullptr)
@@ -139,6 +165,8 @@ void RemoteModelServer::newRequest(const GammaRay::Message &msg)
         return;
 
     ProbeGuard g;
+    ProbeProfilerScope profilerScope(ProbeProfiler::RemoteModelRequest);
+    RequestHandlingTimer handlingTimer(m_myAddress, msg.type());
     switch (msg.type()) {
     case Protocol::ModelRowColumnCountRequest: {
         quint32 size;
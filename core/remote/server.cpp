@@ -64,8 +64,9 @@ Server::Server(QObject *parent)
     connect(m_broadcastTimer, &QTimer::timeout, this, &Server::broadcast);
     connect(this, &Server::disconnected, m_broadcastTimer, [this] { m_broadcastTimer->start(); });
 
-    connect(m_signalMapper, &MultiSignalMapper::signalEmitted,
-            this, &Server::forwardSignal);
+    m_signalMapper->setArgumentsHandler([this](QObject *sender, int signalIndex, const QVector<int> &parameterTypes, void **args) {
+        forwardSignal(sender, signalIndex, parameterTypes, args);
+    });
 
     Endpoint::addObjectNameAddressMapping(QStringLiteral(
                                               "com.kdab.GammaRay.PropertySyncer"),
@@ -128,13 +129,19 @@ void Server::newConnection()
     if (isConnected()) {
         cerr << Q_FUNC_INFO << " connected already, refusing incoming connection." << endl;
         auto con = m_serverDevice->nextPendingConnection();
-        con->close();
-        con->deleteLater();
+        if (con) {
+            con->close();
+            con->deleteLater();
+        }
         return;
     }
 
-    m_broadcastTimer->stop();
     auto con = m_serverDevice->nextPendingConnection();
+    if (!con) {
+        cerr << Q_FUNC_INFO << " failed to set up incoming connection." << endl;
+        return;
+    }
+    m_broadcastTimer->stop();
     // FIXME Use proper type for m_serverDevice->nextPendingConnection, instead
     // of relying on runtime-connect to a slot which doesn't exist in QIODevice
     connect(con, SIGNAL(disconnected()), con, SLOT(deleteLater()));
@@ -162,7 +169,7 @@ void Server::sendServerGreeting()
 
     {
         Message msg(endpointAddress(), Protocol::ObjectMapReply);
-        msg << objectAddresses();
+        msg << objectAddresses() << methodTables();
         send(msg);
     }
 }
@@ -239,10 +246,11 @@ Protocol::ObjectAddress Server::registerObject(const QString &name, QObject *obj
     Protocol::ObjectAddress address = Endpoint::registerObject(name, object);
     Q_ASSERT(m_nextAddress);
     Q_ASSERT(m_nextAddress == address);
+    exportMethods(address);
 
     if (isConnected()) {
         Message msg(endpointAddress(), Protocol::ObjectAdded);
-        msg << name << m_nextAddress;
+        msg << name << m_nextAddress << methodTable(address);
         send(msg);
     }
 
@@ -264,25 +272,15 @@ Protocol::ObjectAddress Server::registerObject(const QString &name, QObject *obj
     return address;
 }
 
-void Server::forwardSignal(QObject *sender, int signalIndex, const QVector<QVariant> &args)
+void Server::forwardSignal(QObject *sender, int signalIndex, const QVector<int> &parameterTypes, void **args)
 {
     if (!isConnected())
         return;
 
     Q_ASSERT(sender);
     Q_ASSERT(signalIndex >= 0);
-    const QMetaMethod signal = sender->metaObject()->method(signalIndex);
-    Q_ASSERT(signal.methodType() == QMetaMethod::Signal);
-
-    QByteArray name = signal.methodSignature();
-    // get the name of the function to invoke, excluding the parens and function arguments.
-    name = name.mid(0, name.indexOf('('));
-
-    QVariantList v;
-    v.reserve(args.size());
-    foreach (const QVariant &arg, args)
-        v.push_back(arg);
-    Endpoint::invokeObject(sender->objectName(), name, v);
+    Q_ASSERT(sender->metaObject()->method(signalIndex).methodType() == QMetaMethod::Signal);
+    invokeRemoteMethod(sender, signalIndex, parameterTypes, args);
 }
 
 void Server::registerMonitorNotifier(Protocol::ObjectAddress address, QObject *receiver,
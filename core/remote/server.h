@@ -109,12 +109,12 @@ private slots:
     void newConnection();
     void broadcast();
 
+private:
     /**
-     * Forward the signal that triggered the call to this slot to the remote client if connected.
+     * Forward the signal @p signalIndex emitted by @p sender to the remote client if connected.
      */
-    void forwardSignal(QObject *sender, int signalIndex, const QVector<QVariant> &args);
+    void forwardSignal(QObject *sender, int signalIndex, const QVector<int> &parameterTypes, void **args);
 
-private:
     void sendServerGreeting();
     QUrl serverAddress_impl() const;
 
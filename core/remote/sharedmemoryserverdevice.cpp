@@ -0,0 +1,55 @@
+/*
+  sharedmemoryserverdevice.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "sharedmemoryserverdevice.h"
+
+#include <common/sharedmemorydevice.h>
+
+#include <QLocalServer>
+#include <QLocalSocket>
+
+using namespace GammaRay;
+
+SharedMemoryServerDevice::SharedMemoryServerDevice(QObject *parent)
+    : ServerDeviceImpl<QLocalServer>(parent)
+{
+    m_server = new QLocalServer(this);
+    m_server->setSocketOptions(QLocalServer::WorldAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &ServerDevice::newConnection);
+}
+
+bool SharedMemoryServerDevice::listen()
+{
+    QLocalServer::removeServer(m_address.path());
+    return m_server->listen(m_address.path());
+}
+
+bool SharedMemoryServerDevice::isListening() const
+{
+    return m_server->isListening();
+}
+
+QIODevice *SharedMemoryServerDevice::nextPendingConnection()
+{
+    Q_ASSERT(m_server->hasPendingConnections());
+    auto device = new SharedMemoryDevice(m_server->nextPendingConnection(), this);
+    if (!device->createSegment()) {
+        delete device;
+        return nullptr;
+    }
+    return device;
+}
+
+QUrl SharedMemoryServerDevice::externalAddress() const
+{
+    return m_address;
+}
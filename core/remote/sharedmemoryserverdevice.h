@@ -0,0 +1,38 @@
+/*
+  sharedmemoryserverdevice.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SHAREDMEMORYSERVERDEVICE_H
+#define GAMMARAY_SHAREDMEMORYSERVERDEVICE_H
+
+#include "serverdevice.h"
+
+#include <QLocalServer>
+
+namespace GammaRay {
+/** Server side of the shm:// transport.
+ *  Connections are accepted on a local socket, which then only serves as control channel
+ *  for a SharedMemoryDevice carrying the actual data.
+ */
+class SharedMemoryServerDevice : public ServerDeviceImpl<QLocalServer>
+{
+    Q_OBJECT
+public:
+    explicit SharedMemoryServerDevice(QObject *parent = nullptr);
+
+    bool listen() override;
+    bool isListening() const override;
+    QIODevice *nextPendingConnection() override;
+    QUrl externalAddress() const override;
+};
+}
+
+#endif // GAMMARAY_SHAREDMEMORYSERVERDEVICE_H
@@ -12,46 +12,55 @@
 */
 
 #include "sequentialpropertyadaptor.h"
-#include "objectinstance.h"
 #include "propertydata.h"
 
 #include <QSequentialIterable>
 
 using namespace GammaRay;
 
-SequentialPropertyAdaptor::SequentialPropertyAdaptor(QObject *parent)
-    : PropertyAdaptor(parent)
+namespace {
+class SequentialAccessor : public ContainerAccessor
 {
-}
+public:
+    explicit SequentialAccessor(const QVariant &container)
+        : ContainerAccessor(container)
+        , m_iterators(m_container.value<QSequentialIterable>(), isRandomAccess(m_container))
+    {
+        m_count = m_container.value<QSequentialIterable>().size();
+    }
 
-SequentialPropertyAdaptor::~SequentialPropertyAdaptor() = default;
+    PropertyData propertyData(int index) override
+    {
+        PropertyData data;
+        data.setName(QString::number(index));
+        data.setValue(*m_iterators.at(index));
+        data.setClassName(m_container.typeName());
+        return data;
+    }
 
-void SequentialPropertyAdaptor::doSetObject(const ObjectInstance &oi)
-{
-    if (oi.type() == ObjectInstance::QtVariant)
-        m_value = oi.variant();
-}
+private:
+    static bool isRandomAccess(const QVariant &container)
+    {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        return container.value<QSequentialIterable>().metaContainer().hasRandomAccessIterator();
+#else
+        const auto impl = container.value<QtMetaTypePrivate::QSequentialIterableImpl>();
+        return impl._iteratorCapabilities & QtMetaTypePrivate::RandomAccessCapability;
+#endif
+    }
 
-int SequentialPropertyAdaptor::count() const
-{
-    if (!m_value.canConvert<QVariantList>())
-        return 0;
-    auto it = m_value.value<QSequentialIterable>();
-    return it.size();
+    ContainerIteratorCache<QSequentialIterable> m_iterators;
+};
 }
 
-PropertyData SequentialPropertyAdaptor::propertyData(int index) const
+SequentialPropertyAdaptor::SequentialPropertyAdaptor(QObject *parent)
+    : ContainerPropertyAdaptor(parent)
 {
-    Q_ASSERT(m_value.canConvert<QVariantList>());
-
-    auto seq = m_value.value<QSequentialIterable>();
-    auto it = seq.begin();
-    it += index;
+}
 
-    PropertyData data;
-    data.setName(QString::number(index));
-    data.setValue(*it);
-    data.setClassName(m_value.typeName());
+SequentialPropertyAdaptor::~SequentialPropertyAdaptor() = default;
 
-    return data;
+ContainerAccessor *SequentialPropertyAdaptor::createAccessor(const QVariant &container) const
+{
+    return new SequentialAccessor(container);
 }
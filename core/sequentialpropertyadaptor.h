@@ -14,27 +14,19 @@
 #ifndef GAMMARAY_SEQUENTIALPROPERTYADAPTOR_H
 #define GAMMARAY_SEQUENTIALPROPERTYADAPTOR_H
 
-#include "propertyadaptor.h"
-
-#include <QVariant>
+#include "containerpropertyadaptor.h"
 
 namespace GammaRay {
 /** Adaptor for recursing into QSequentialIterable properties. */
-class SequentialPropertyAdaptor : public PropertyAdaptor
+class SequentialPropertyAdaptor : public ContainerPropertyAdaptor
 {
     Q_OBJECT
 public:
     explicit SequentialPropertyAdaptor(QObject *parent = nullptr);
     ~SequentialPropertyAdaptor() override;
 
-    int count() const override;
-    PropertyData propertyData(int index) const override;
-
 protected:
-    void doSetObject(const ObjectInstance &oi) override;
-
-private:
-    QVariant m_value;
+    ContainerAccessor *createAccessor(const QVariant &container) const override;
 };
 }
 
@@ -16,7 +16,8 @@
 
 #include "gammaray_core_export.h"
 
-#include <qglobal.h>
+#include <QByteArray>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QObject;
@@ -39,6 +40,16 @@ struct GAMMARAY_CORE_EXPORT SignalSpyCallbackSet
     EndCallback signalEndCallback = nullptr;
     BeginCallback slotBeginCallback = nullptr;
     EndCallback slotEndCallback = nullptr;
+
+    /** Class names of the objects to report, sub-classes included. All objects are reported if empty.
+     *  @since 3.2
+     */
+    QVector<QByteArray> classNames;
+    /** Normalized signatures of the signals to report, all signals are reported if empty.
+     *  This does not restrict slot callbacks.
+     *  @since 3.2
+     */
+    QVector<QByteArray> signalSignatures;
 };
 }
 
@@ -0,0 +1,193 @@
+/*
+  signalspydispatcher.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "signalspydispatcher.h"
+#include "util.h"
+
+#include <QMetaObject>
+#include <QObject>
+#include <QtAlgorithms>
+
+#include <private/qobject_p.h>
+
+#include <algorithm>
+
+using namespace GammaRay;
+
+static bool inherits(const QMetaObject *mo, const QByteArray &className)
+{
+    for (; mo; mo = mo->superClass()) {
+        if (className == mo->className())
+            return true;
+    }
+    return false;
+}
+
+SignalSpyDispatcher::SignalSpyDispatcher()
+{
+    std::fill(m_typeConsumers, m_typeConsumers + CallbackTypeCount, 0);
+}
+
+SignalSpyDispatcher::~SignalSpyDispatcher() = default;
+
+int SignalSpyDispatcher::addConsumer(const SignalSpyCallbackSet &callbacks)
+{
+    QWriteLocker lock(&m_lock);
+    for (int id = 0; id < MaxConsumers; ++id) {
+        if (!m_consumers[id].isNull())
+            continue;
+
+        m_consumers[id] = callbacks;
+        const quint64 bit = quint64(1) << id;
+        if (callbacks.signalBeginCallback)
+            m_typeConsumers[SignalBegin] |= bit;
+        if (callbacks.signalEndCallback)
+            m_typeConsumers[SignalEnd] |= bit;
+        if (callbacks.slotBeginCallback)
+            m_typeConsumers[SlotBegin] |= bit;
+        if (callbacks.slotEndCallback)
+            m_typeConsumers[SlotEnd] |= bit;
+        m_filters.clear();
+        return id;
+    }
+    return -1;
+}
+
+void SignalSpyDispatcher::removeConsumer(int id)
+{
+    if (id < 0 || id >= MaxConsumers)
+        return;
+
+    QWriteLocker lock(&m_lock);
+    m_consumers[id] = SignalSpyCallbackSet();
+    for (auto &consumers : m_typeConsumers)
+        consumers &= ~(quint64(1) << id);
+    m_filters.clear();
+}
+
+bool SignalSpyDispatcher::isEmpty() const
+{
+    QReadLocker lock(&m_lock);
+    return std::all_of(m_typeConsumers, m_typeConsumers + CallbackTypeCount, [](quint64 consumers) {
+        return consumers == 0;
+    });
+}
+
+bool SignalSpyDispatcher::hasCallback(CallbackType type) const
+{
+    QReadLocker lock(&m_lock);
+    return m_typeConsumers[type] != 0;
+}
+
+quint64 SignalSpyDispatcher::signalBegin(QObject *sender, int &index, BeginCallbacks &callbacks)
+{
+    QReadLocker lock(&m_lock);
+    const auto mo = sender->metaObject();
+    ClassFilter uncached;
+    const auto filter = classFilter(sender, lock, uncached);
+    if (!filter || !(filter->consumers & (m_typeConsumers[SignalBegin] | m_typeConsumers[SignalEnd])))
+        return 0;
+
+    index = Util::signalIndexToMethodIndex(mo, index);
+    const auto consumers = filter->allSignals | filter->signalConsumers.value(index);
+    collect(consumers & m_typeConsumers[SignalBegin], &SignalSpyCallbackSet::signalBeginCallback, callbacks);
+    return consumers & m_typeConsumers[SignalEnd];
+}
+
+void SignalSpyDispatcher::signalEnd(quint64 consumers, EndCallbacks &callbacks)
+{
+    QReadLocker lock(&m_lock);
+    collect(consumers & m_typeConsumers[SignalEnd], &SignalSpyCallbackSet::signalEndCallback, callbacks);
+}
+
+void SignalSpyDispatcher::slotBegin(QObject *receiver, BeginCallbacks &callbacks)
+{
+    QReadLocker lock(&m_lock);
+    collect(interestedConsumers(SlotBegin, receiver, lock), &SignalSpyCallbackSet::slotBeginCallback, callbacks);
+}
+
+void SignalSpyDispatcher::slotEnd(QObject *receiver, EndCallbacks &callbacks)
+{
+    QReadLocker lock(&m_lock);
+    collect(interestedConsumers(SlotEnd, receiver, lock), &SignalSpyCallbackSet::slotEndCallback, callbacks);
+}
+
+SignalSpyDispatcher::ClassFilter SignalSpyDispatcher::compileFilter(const QMetaObject *mo) const
+{
+    ClassFilter filter;
+    for (int id = 0; id < MaxConsumers; ++id) {
+        const auto &consumer = m_consumers[id];
+        if (consumer.isNull())
+            continue;
+        if (!consumer.classNames.isEmpty()
+            && std::none_of(consumer.classNames.constBegin(), consumer.classNames.constEnd(), [mo](const QByteArray &className) {
+                   return inherits(mo, className);
+               }))
+            continue;
+
+        const quint64 bit = quint64(1) << id;
+        filter.consumers |= bit;
+        if (consumer.signalSignatures.isEmpty()) {
+            filter.allSignals |= bit;
+            continue;
+        }
+        for (const auto &signature : consumer.signalSignatures) {
+            const int index = mo->indexOfSignal(signature.constData());
+            if (index >= 0)
+                filter.signalConsumers[index] |= bit;
+        }
+    }
+    return filter;
+}
+
+const SignalSpyDispatcher::ClassFilter *SignalSpyDispatcher::classFilter(QObject *object, QReadLocker &lock, ClassFilter &uncached)
+{
+    const auto mo = object->metaObject();
+    // dynamic meta objects (e.g. from QML) can be destroyed at runtime, so don't cache those
+    if (QObjectPrivate::get(object)->metaObject) {
+        uncached = compileFilter(mo);
+        return &uncached;
+    }
+
+    auto it = m_filters.constFind(mo);
+    if (it != m_filters.constEnd())
+        return &it.value();
+
+    lock.unlock();
+    {
+        QWriteLocker writeLock(&m_lock);
+        if (!m_filters.contains(mo))
+            m_filters.insert(mo, compileFilter(mo));
+    }
+    lock.relock();
+
+    // consumers might have changed in between, which discards all filters again
+    it = m_filters.constFind(mo);
+    return it != m_filters.constEnd() ? &it.value() : nullptr;
+}
+
+quint64 SignalSpyDispatcher::interestedConsumers(CallbackType type, QObject *object, QReadLocker &lock)
+{
+    ClassFilter uncached;
+    const auto filter = classFilter(object, lock, uncached);
+    return filter ? filter->consumers & m_typeConsumers[type] : 0;
+}
+
+template<typename Callback, typename Callbacks>
+void SignalSpyDispatcher::collect(quint64 consumers, Callback SignalSpyCallbackSet::*callback, Callbacks &callbacks) const
+{
+    while (consumers) {
+        const int id = qCountTrailingZeroBits(consumers);
+        consumers &= consumers - 1;
+        callbacks.push_back(m_consumers[id].*callback);
+    }
+}
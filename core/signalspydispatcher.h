@@ -0,0 +1,112 @@
+/*
+  signalspydispatcher.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SIGNALSPYDISPATCHER_H
+#define GAMMARAY_SIGNALSPYDISPATCHER_H
+
+#include "signalspycallbackset.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVarLengthArray>
+
+QT_BEGIN_NAMESPACE
+struct QMetaObject;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+/**
+ * Routes Qt's signal spy callbacks to the registered SignalSpyCallbackSet consumers.
+ *
+ * The class and signal restrictions of all consumers are compiled into a bitset of
+ * interested consumers per static QMetaObject on first use, so an emission nobody is interested
+ * in costs a hash lookup under a read lock, without looking at the consumers at all.
+ * Objects with a dynamic meta object, such as QML items, have their filter compiled for
+ * each emission instead, as such meta objects are destroyed along with their object.
+ */
+class SignalSpyDispatcher
+{
+public:
+    enum CallbackType
+    {
+        SignalBegin,
+        SignalEnd,
+        SlotBegin,
+        SlotEnd,
+        CallbackTypeCount
+    };
+
+    static const int MaxConsumers = 64;
+
+    typedef QVarLengthArray<SignalSpyCallbackSet::BeginCallback, 4> BeginCallbacks;
+    typedef QVarLengthArray<SignalSpyCallbackSet::EndCallback, 4> EndCallbacks;
+
+    SignalSpyDispatcher();
+    ~SignalSpyDispatcher();
+
+    /** Returns the id of the new consumer, or -1 if there are too many consumers already. */
+    int addConsumer(const SignalSpyCallbackSet &callbacks);
+    void removeConsumer(int id);
+
+    bool isEmpty() const;
+    /** Whether any consumer has a callback of @p type. */
+    bool hasCallback(CallbackType type) const;
+
+    /**
+     * Collects the callbacks interested in the emission of signal @p index of @p sender.
+     * @p index is a signal index, and is mapped to the method index if anyone is interested.
+     * Returns the consumers interested in the end of the emission, to be passed to signalEnd().
+     */
+    quint64 signalBegin(QObject *sender, int &index, BeginCallbacks &callbacks);
+    /**
+     * Collects the end callbacks of @p consumers, as returned by signalBegin(), that are still registered.
+     * The sender is not needed, as it might have been deleted during the emission.
+     */
+    void signalEnd(quint64 consumers, EndCallbacks &callbacks);
+
+    void slotBegin(QObject *receiver, BeginCallbacks &callbacks);
+    void slotEnd(QObject *receiver, EndCallbacks &callbacks);
+
+private:
+    Q_DISABLE_COPY(SignalSpyDispatcher)
+
+    /** Consumers interested in instances of a specific class, as bitsets of consumer ids. */
+    struct ClassFilter
+    {
+        /** Consumers interested in the class at all. */
+        quint64 consumers = 0;
+        /** Consumers interested in all signals of the class. */
+        quint64 allSignals = 0;
+        /** Consumers interested in specific signals, by method index. */
+        QHash<int, quint64> signalConsumers;
+    };
+
+    ClassFilter compileFilter(const QMetaObject *mo) const;
+    /**
+     * Returns the filter for the meta object of @p object, compiling it if necessary. @p lock has to be locked.
+     * Filters of dynamic meta objects are compiled into @p uncached instead of being cached.
+     */
+    const ClassFilter *classFilter(QObject *object, QReadLocker &lock, ClassFilter &uncached);
+    /** Consumers with a callback of @p type interested in @p object. */
+    quint64 interestedConsumers(CallbackType type, QObject *object, QReadLocker &lock);
+
+    template<typename Callback, typename Callbacks>
+    void collect(quint64 consumers, Callback SignalSpyCallbackSet::*callback, Callbacks &callbacks) const;
+
+    mutable QReadWriteLock m_lock;
+    SignalSpyCallbackSet m_consumers[MaxConsumers];
+    quint64 m_typeConsumers[CallbackTypeCount];
+    QHash<const QMetaObject *, ClassFilter> m_filters;
+};
+}
+
+#endif // GAMMARAY_SIGNALSPYDISPATCHER_H
@@ -22,6 +22,7 @@
 
 #include "tools/metatypebrowser/metatypebrowser.h"
 #include "tools/objectinspector/objectinspector.h"
+#include "tools/probeoverhead/probeoverhead.h"
 #include "tools/problemreporter/problemreporter.h"
 #include "tools/resourcebrowser/resourcebrowser.h"
 #include "tools/messagehandler/messagehandler.h"
@@ -49,6 +50,7 @@ ToolManager::ToolManager(QObject *parent)
     addToolFactory(new MetaTypeBrowserFactory(this));
     addToolFactory(new MessageHandlerFactory(this));
     addToolFactory(new ProblemReporterFactory(this));
+    addToolFactory(new ProbeOverheadFactory(this));
 
     Q_FOREACH (ToolFactory *factory, m_toolPluginManager->plugins())
         addToolFactory(factory);
@@ -17,6 +17,7 @@
 
 #include <core/execution.h>
 #include <core/probeguard.h>
+#include <core/probeprofiler.h>
 #include <core/remote/serverproxymodel.h>
 #include <core/stacktracemodel.h>
 
@@ -44,6 +45,8 @@ Q_GLOBAL_STATIC(QRecursiveMutex, s_mutex)
 
 static void handleMessage(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
+    ProbeProfilerScope profilerScope(ProbeProfiler::MessageHandler);
+
     /// WARNING: do not trigger *any* kind of debug output here
     ///          this would trigger an infinite loop and hence crash!
 
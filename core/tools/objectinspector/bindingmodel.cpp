@@ -156,7 +156,7 @@ int BindingModel::rowCount(const QModelIndex &parent) const
         return m_bindings->size();
     if (parent.column() != 0)
         return 0;
-    return static_cast<BindingNode *>(parent.internalPointer())->dependencies().size();
+    return static_cast<const BindingNode *>(parent.internalPointer())->dependencies().size();
 }
 
 QVariant BindingModel::data(const QModelIndex &index, int role) const
@@ -220,7 +220,7 @@ QModelIndex GammaRay::BindingModel::index(int row, int column, const QModelIndex
     }
     QModelIndex index;
     if (parent.isValid()) {
-        index = createIndex(row, column, static_cast<BindingNode *>(parent.internalPointer())->dependencies()[row].get());
+        index = createIndex(row, column, static_cast<const BindingNode *>(parent.internalPointer())->dependencies()[row].get());
     } else {
         index = createIndex(row, column, (*m_bindings)[row].get());
     }
@@ -246,7 +246,7 @@ QModelIndex GammaRay::BindingModel::parent(const QModelIndex &child) const
     if (!parent)
         return QModelIndex();
 
-    BindingNode *grandparent = parent->parent();
+    const BindingNode *grandparent = parent->parent();
 
     if (!grandparent)
         return findEquivalent(*m_bindings, parent);
@@ -0,0 +1,58 @@
+/*
+  probeoverhead.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "probeoverhead.h"
+#include "probeoverheadmodel.h"
+
+#include <core/probe.h>
+#include <core/probeprofiler.h>
+#include <core/probesettings.h>
+
+#include <QTimer>
+
+using namespace GammaRay;
+
+ProbeOverhead::ProbeOverhead(Probe *probe, QObject *parent)
+    : ProbeOverheadInterface(parent)
+    , m_model(new ProbeOverheadModel(this))
+    , m_updateTimer(new QTimer(this))
+{
+    probe->registerModel(QStringLiteral("com.kdab.GammaRay.ProbeOverheadModel"), m_model);
+
+    m_updateTimer->setInterval(1000);
+    connect(m_updateTimer, &QTimer::timeout, m_model, &ProbeOverheadModel::update);
+    connect(this, &ProbeOverheadInterface::profilingEnabledChanged, this, &ProbeOverhead::applyProfilingEnabled);
+
+    // allows to include the startup phase of the application
+    setProfilingEnabled(ProbeSettings::value(QStringLiteral("ProfileProbeOverhead"), false).toBool());
+}
+
+ProbeOverhead::~ProbeOverhead()
+{
+    ProbeProfiler::setEnabled(false);
+}
+
+void ProbeOverhead::resetStatistics()
+{
+    ProbeProfiler::reset();
+    m_model->update();
+}
+
+void ProbeOverhead::applyProfilingEnabled(bool enabled)
+{
+    ProbeProfiler::setEnabled(enabled);
+    m_model->update();
+    if (enabled)
+        m_updateTimer->start();
+    else
+        m_updateTimer->stop();
+}
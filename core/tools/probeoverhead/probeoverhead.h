@@ -0,0 +1,58 @@
+/*
+  probeoverhead.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PROBEOVERHEAD_PROBEOVERHEAD_H
+#define GAMMARAY_PROBEOVERHEAD_PROBEOVERHEAD_H
+
+#include <core/toolfactory.h>
+
+#include <common/tools/probeoverhead/probeoverheadinterface.h>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+
+class ProbeOverheadModel;
+
+class ProbeOverhead : public ProbeOverheadInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(GammaRay::ProbeOverheadInterface)
+public:
+    explicit ProbeOverhead(Probe *probe, QObject *parent = nullptr);
+    ~ProbeOverhead() override;
+
+public slots:
+    void resetStatistics() override;
+
+private:
+    void applyProfilingEnabled(bool enabled);
+
+    ProbeOverheadModel *m_model;
+    QTimer *m_updateTimer;
+};
+
+class ProbeOverheadFactory : public QObject, public StandardToolFactory<QObject, ProbeOverhead>
+{
+    Q_OBJECT
+    Q_INTERFACES(GammaRay::ToolFactory)
+public:
+    explicit ProbeOverheadFactory(QObject *parent)
+        : QObject(parent)
+    {
+    }
+};
+}
+
+#endif // GAMMARAY_PROBEOVERHEAD_PROBEOVERHEAD_H
@@ -0,0 +1,141 @@
+/*
+  probeoverheadmodel.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "probeoverheadmodel.h"
+
+using namespace GammaRay;
+
+static QString formatDuration(quint64 nsecs)
+{
+    if (nsecs < 1000)
+        return QStringLiteral("%1 ns").arg(nsecs);
+    if (nsecs < 1000000)
+        return QStringLiteral("%1 µs").arg(nsecs / 1000.0, 0, 'f', 1);
+    if (nsecs < 1000000000)
+        return QStringLiteral("%1 ms").arg(nsecs / 1000000.0, 0, 'f', 1);
+    return QStringLiteral("%1 s").arg(nsecs / 1000000000.0, 0, 'f', 2);
+}
+
+ProbeOverheadModel::ProbeOverheadModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    update();
+}
+
+ProbeOverheadModel::~ProbeOverheadModel() = default;
+
+QVariant ProbeOverheadModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    const auto &stats = m_stats.at(index.row());
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case SiteColumn:
+            return ProbeProfiler::siteName(static_cast<ProbeProfiler::Site>(index.row()));
+        case CallsColumn:
+            return stats.count;
+        case TotalColumn:
+            return formatDuration(stats.totalNSecs);
+        case ShareColumn:
+            if (!m_recordingTime)
+                return QVariant();
+            return QStringLiteral("%1 %").arg(100.0 * stats.totalNSecs / m_recordingTime, 0, 'f', 2);
+        case AverageColumn:
+            if (!stats.count)
+                return QVariant();
+            return formatDuration(stats.totalNSecs / stats.count);
+        case MedianColumn:
+            if (!stats.count)
+                return QVariant();
+            return formatDuration(stats.percentile(0.5));
+        case P99Column:
+            if (!stats.count)
+                return QVariant();
+            return formatDuration(stats.percentile(0.99));
+        case MaxColumn:
+            if (!stats.count)
+                return QVariant();
+            return formatDuration(stats.maxNSecs);
+        }
+    } else if (role == Qt::TextAlignmentRole && index.column() != SiteColumn) {
+        return QVariant::fromValue<int>(Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    return QVariant();
+}
+
+QVariant ProbeOverheadModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal)
+        return QVariant();
+
+    if (role == Qt::DisplayRole) {
+        switch (section) {
+        case SiteColumn:
+            return tr("Hook");
+        case CallsColumn:
+            return tr("Calls");
+        case TotalColumn:
+            return tr("Total");
+        case ShareColumn:
+            return tr("Share");
+        case AverageColumn:
+            return tr("Average");
+        case MedianColumn:
+            return tr("Median");
+        case P99Column:
+            return tr("99%");
+        case MaxColumn:
+            return tr("Max");
+        }
+    } else if (role == Qt::ToolTipRole) {
+        switch (section) {
+        case ShareColumn:
+            return tr("Time spent in this hook, relative to the time profiling was enabled.");
+        case P99Column:
+            return tr("99% of all calls took at most this long.");
+        }
+    }
+
+    return QVariant();
+}
+
+int ProbeOverheadModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_stats.size();
+}
+
+int ProbeOverheadModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return ColumnCount;
+}
+
+void ProbeOverheadModel::update()
+{
+    const auto stats = ProbeProfiler::statistics();
+    m_recordingTime = ProbeProfiler::recordingTime();
+    if (m_stats.size() != stats.size()) {
+        beginResetModel();
+        m_stats = stats;
+        endResetModel();
+        return;
+    }
+
+    m_stats = stats;
+    emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+}
@@ -0,0 +1,56 @@
+/*
+  probeoverheadmodel.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PROBEOVERHEAD_PROBEOVERHEADMODEL_H
+#define GAMMARAY_PROBEOVERHEAD_PROBEOVERHEADMODEL_H
+
+#include <core/probeprofiler.h>
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+namespace GammaRay {
+/** Cost of each probe hook site, as recorded by ProbeProfiler. */
+class ProbeOverheadModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    explicit ProbeOverheadModel(QObject *parent = nullptr);
+    ~ProbeOverheadModel() override;
+
+    enum Column {
+        SiteColumn,
+        CallsColumn,
+        TotalColumn,
+        ShareColumn,
+        AverageColumn,
+        MedianColumn,
+        P99Column,
+        MaxColumn,
+        ColumnCount
+    };
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /** Takes a new snapshot of the profiler statistics. */
+    void update();
+
+private:
+    QVector<ProbeProfiler::SiteStatistics> m_stats;
+    quint64 m_recordingTime = 0;
+};
+}
+
+#endif // GAMMARAY_PROBEOVERHEAD_PROBEOVERHEADMODEL_H
@@ -28,12 +28,14 @@
 #include <QDir>
 #include <QIcon>
 #include <QMetaObject>
+#include <QMutex>
 #include <QObject>
 #include <QPainter>
 
 #include <private/qobject_p.h>
 #include <private/qmetaobject_p.h>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace GammaRay;
@@ -178,31 +180,147 @@ static IconDatabase readIconData()
     return data;
 }
 
-static int iconIdForObject(const QMetaObject *mo, const QObject *obj)
+/// a property rule of IconCacheEntry, resolved against a specific meta object
+struct PropertyMatcher
 {
-    static const IconDatabase iconDataBase = readIconData();
+    enum Mode
+    {
+        EnumValue, ///< compare the integer value of an enum or flag property
+        VariantValue, ///< compare the property value to the converted expected value
+        StringValue ///< compare the stringified property value, e.g. for dynamic properties
+    };
+
+    bool matches(const QObject *obj) const
+    {
+        switch (mode) {
+        case EnumValue:
+            return property.read(obj).toInt() == enumValue;
+        case VariantValue:
+            return property.read(obj) == value;
+        case StringValue:
+            return stringifyProperty(obj, propertyName) == expectedString;
+        }
+        return false;
+    }
 
-    auto it = iconDataBase.constFind(QLatin1String(mo->className()));
-    if (it != iconDataBase.end()) {
-        for (const auto &propertyIcon : qAsConst(it->propertyIcons)) {
-            bool allMatch = true;
+    Mode mode = StringValue;
+    QMetaProperty property;
+    int enumValue = 0;
+    QVariant value;
+    QString propertyName;
+    QString expectedString;
+};
+
+/// icon information for a specific meta object, with all property rules resolved
+struct ResolvedIcon
+{
+    typedef QPair<int, QVector<PropertyMatcher>> PropertyIcon;
+
+    int defaultIcon = -1;
+    QVector<PropertyIcon> propertyIcons;
+};
+
+struct IconCache
+{
+    QMutex mutex;
+    IconDatabase database;
+    bool databaseLoaded = false;
+    QHash<const QMetaObject *, ResolvedIcon> resolved;
+};
+Q_GLOBAL_STATIC(IconCache, s_iconCache)
+
+static PropertyMatcher compilePropertyMatcher(const QMetaObject *mo, const IconCacheEntry::PropertyPair &rule)
+{
+    PropertyMatcher matcher;
+    matcher.propertyName = rule.first;
+    matcher.expectedString = rule.second;
+
+    const auto mp = mo->property(mo->indexOfProperty(rule.first.toLatin1().constData()));
+    if (!mp.isValid())
+        return matcher; // dynamic property, or not one at all
+
+    matcher.property = mp;
+    if (mp.isEnumType()) {
+        const auto me = mp.enumerator();
+        bool ok = false;
+        const auto key = rule.second.toLatin1();
+        const auto value = me.isFlag() ? me.keysToValue(key.constData(), &ok) : me.keyToValue(key.constData(), &ok);
+        if (ok) {
+            matcher.mode = PropertyMatcher::EnumValue;
+            matcher.enumValue = value;
+        }
+        return matcher;
+    }
+
+    QVariant value(rule.second);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    const auto converted = value.convert(mp.userType());
+#else
+    const auto converted = value.convert(mp.metaType());
+#endif
+    if (converted) {
+        matcher.mode = PropertyMatcher::VariantValue;
+        matcher.value = value;
+    }
+    return matcher;
+}
+
+static ResolvedIcon resolveIcon(const IconDatabase &database, const QMetaObject *mo)
+{
+    ResolvedIcon icon;
+    for (auto superMo = mo; superMo; superMo = superMo->superClass()) {
+        const auto it = database.constFind(QLatin1String(superMo->className()));
+        if (it == database.constEnd())
+            continue;
+
+        icon.defaultIcon = it->defaultIcon;
+        icon.propertyIcons.reserve(it->propertyIcons.size());
+        for (const auto &propertyIcon : it->propertyIcons) {
             Q_ASSERT(!propertyIcon.second.isEmpty());
-            for (const IconCacheEntry::PropertyPair &keyValue : qAsConst(propertyIcon.second)) {
-                if (stringifyProperty(obj, keyValue.first) != keyValue.second) {
-                    allMatch = false;
-                    break;
-                }
-            }
-            if (allMatch)
-                return propertyIcon.first;
+            QVector<PropertyMatcher> matchers;
+            matchers.reserve(propertyIcon.second.size());
+            for (const auto &rule : propertyIcon.second)
+                matchers.push_back(compilePropertyMatcher(mo, rule));
+            icon.propertyIcons.push_back(qMakePair(propertyIcon.first, matchers));
         }
-        return it->defaultIcon;
+        break;
     }
+    return icon;
+}
+
+static int iconIdForObject(const QMetaObject *mo, const QObject *obj)
+{
+    ResolvedIcon icon;
+    {
+        auto cache = s_iconCache();
+        QMutexLocker lock(&cache->mutex);
+        if (!cache->databaseLoaded) {
+            cache->database = readIconData();
+            cache->databaseLoaded = true;
+        }
 
-    if (mo->superClass())
-        return iconIdForObject(mo->superClass(), obj);
+        // dynamic meta objects (e.g. from QML) can be destroyed at runtime, so don't cache those
+        if (QObjectPrivate::get(const_cast<QObject *>(obj))->metaObject) {
+            icon = resolveIcon(cache->database, mo);
+        } else {
+            auto it = cache->resolved.constFind(mo);
+            if (it == cache->resolved.constEnd())
+                it = cache->resolved.insert(mo, resolveIcon(cache->database, mo));
+            if (it->propertyIcons.isEmpty())
+                return it->defaultIcon;
+            icon = it.value();
+        }
+    }
 
-    return -1;
+    for (const auto &propertyIcon : qAsConst(icon.propertyIcons)) {
+        const auto allMatch = std::all_of(propertyIcon.second.constBegin(), propertyIcon.second.constEnd(),
+                                          [obj](const PropertyMatcher &matcher) {
+                                              return matcher.matches(obj);
+                                          });
+        if (allMatch)
+            return propertyIcon.first;
+    }
+    return icon.defaultIcon;
 }
 }
 
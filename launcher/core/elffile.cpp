@@ -0,0 +1,323 @@
+/*
+  elffile.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <config-gammaray.h>
+
+#include "elffile.h"
+
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <limits>
+
+#ifdef HAVE_ELF_H
+#include <elf.h>
+#endif
+// on Linux sys/elf.h is not what we want, on QNX we cannot add "sys" to the include dir without messing other stuff up...
+#if defined(HAVE_SYS_ELF_H) && !defined(HAVE_ELF_H)
+#include <sys/elf.h>
+#endif
+
+using namespace GammaRay;
+
+#ifdef HAVE_ELF
+namespace {
+struct Elf32Types
+{
+    typedef Elf32_Ehdr Ehdr;
+    typedef Elf32_Phdr Phdr;
+    typedef Elf32_Shdr Shdr;
+    typedef Elf32_Dyn Dyn;
+    typedef Elf32_Verdef Verdef;
+    typedef Elf32_Verdaux Verdaux;
+    typedef quint32 Addr;
+};
+
+struct Elf64Types
+{
+    typedef Elf64_Ehdr Ehdr;
+    typedef Elf64_Phdr Phdr;
+    typedef Elf64_Shdr Shdr;
+    typedef Elf64_Dyn Dyn;
+    typedef Elf64_Verdef Verdef;
+    typedef Elf64_Verdaux Verdaux;
+    typedef quint64 Addr;
+};
+
+/** Bounds-checked access into the mapped file. */
+class ElfData
+{
+public:
+    ElfData(const uchar *data, quint64 size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    template<typename T>
+    const T *at(quint64 offset, quint64 count = 1) const
+    {
+        if (offset > m_size || count > (m_size - offset) / sizeof(T))
+            return nullptr;
+        return reinterpret_cast<const T *>(m_data + offset);
+    }
+
+    QByteArray string(quint64 offset) const
+    {
+        if (offset >= m_size)
+            return QByteArray();
+        const auto s = reinterpret_cast<const char *>(m_data + offset);
+        return QByteArray(s, qstrnlen(s, m_size - offset));
+    }
+
+private:
+    const uchar *m_data;
+    quint64 m_size;
+};
+
+int qtVersionFromVersionName(const QByteArray &name)
+{
+    // Qt_6, Qt_6.5 and Qt_6_PRIVATE_API
+    if (!name.startsWith("Qt_"))
+        return 0;
+    const auto version = name.mid(3).split('.');
+    bool majorOk = false, minorOk = true;
+    const auto major = version.at(0).toInt(&majorOk);
+    const auto minor = version.size() > 1 ? version.at(1).toInt(&minorOk) : 0;
+    if (!majorOk || !minorOk || major <= 0)
+        return 0;
+    return (major << 16) | (minor << 8);
+}
+
+bool isPlausibleQtVersion(quint64 version)
+{
+    return version >= 0x050000 && version < 0x0a0000;
+}
+}
+
+template<typename Types>
+bool ElfFile::parse(const uchar *data, quint64 size)
+{
+    typedef typename Types::Ehdr Ehdr;
+    typedef typename Types::Phdr Phdr;
+    typedef typename Types::Shdr Shdr;
+    typedef typename Types::Dyn Dyn;
+    typedef typename Types::Verdef Verdef;
+    typedef typename Types::Verdaux Verdaux;
+
+    const ElfData elf(data, size);
+    const auto hdr = elf.template at<Ehdr>(0);
+    if (!hdr)
+        return false;
+    m_machine = hdr->e_machine;
+
+    const auto phdrs = elf.template at<Phdr>(hdr->e_phoff, hdr->e_phnum);
+    if (hdr->e_phnum && (!phdrs || hdr->e_phentsize != sizeof(Phdr)))
+        return false;
+
+    // dynamic entries refer to virtual addresses, map them back to file offsets via the loadable segments
+    auto fileOffset = [phdrs, hdr](quint64 addr) -> quint64 {
+        for (int i = 0; i < hdr->e_phnum; ++i) {
+            const auto &phdr = phdrs[i];
+            if (phdr.p_type == PT_LOAD && addr >= phdr.p_vaddr && addr < phdr.p_vaddr + phdr.p_filesz)
+                return addr - phdr.p_vaddr + phdr.p_offset;
+        }
+        return std::numeric_limits<quint64>::max();
+    };
+
+    const Dyn *dyn = nullptr;
+    quint64 dynCount = 0;
+    for (int i = 0; i < hdr->e_phnum; ++i) {
+        if (phdrs[i].p_type != PT_DYNAMIC)
+            continue;
+        dynCount = phdrs[i].p_filesz / sizeof(Dyn);
+        dyn = elf.template at<Dyn>(phdrs[i].p_offset, dynCount);
+        break;
+    }
+
+    if (dyn) {
+        quint64 strtab = std::numeric_limits<quint64>::max();
+        quint64 verdef = 0;
+        quint64 verdefCount = 0;
+        for (quint64 i = 0; i < dynCount && dyn[i].d_tag != DT_NULL; ++i) {
+            switch (dyn[i].d_tag) {
+            case DT_STRTAB:
+                strtab = fileOffset(dyn[i].d_un.d_ptr);
+                break;
+#ifdef DT_VERDEF
+            case DT_VERDEF:
+                verdef = fileOffset(dyn[i].d_un.d_ptr);
+                break;
+            case DT_VERDEFNUM:
+                verdefCount = dyn[i].d_un.d_val;
+                break;
+#endif
+            }
+        }
+
+        if (strtab != std::numeric_limits<quint64>::max()) {
+            for (quint64 i = 0; i < dynCount && dyn[i].d_tag != DT_NULL; ++i) {
+                switch (dyn[i].d_tag) {
+                case DT_NEEDED:
+                    m_needed.push_back(QFile::decodeName(elf.string(strtab + dyn[i].d_un.d_val)));
+                    break;
+                case DT_RPATH:
+                    m_rpath += QFile::decodeName(elf.string(strtab + dyn[i].d_un.d_val)).split(QLatin1Char(':'), Qt::SkipEmptyParts);
+                    break;
+#ifdef DT_RUNPATH
+                case DT_RUNPATH:
+                    m_runpath += QFile::decodeName(elf.string(strtab + dyn[i].d_un.d_val)).split(QLatin1Char(':'), Qt::SkipEmptyParts);
+                    break;
+#endif
+                }
+            }
+
+            // symbol version definitions, QtCore defines Qt_X.Y for every minor version it is compatible with
+            for (quint64 i = 0; verdef && verdef != std::numeric_limits<quint64>::max() && i < verdefCount; ++i) {
+                const auto def = elf.template at<Verdef>(verdef);
+                if (!def)
+                    break;
+                if (!(def->vd_flags & VER_FLG_BASE) && def->vd_cnt > 0) {
+                    const auto aux = elf.template at<Verdaux>(verdef + def->vd_aux);
+                    if (aux)
+                        m_qtVersion = std::max(m_qtVersion, qtVersionFromVersionName(elf.string(strtab + aux->vda_name)));
+                }
+                if (!def->vd_next)
+                    break;
+                verdef += def->vd_next;
+            }
+        }
+    }
+
+    // QtCore also carries its exact version in the .qtversion section
+    const auto shdrs = elf.template at<Shdr>(hdr->e_shoff, hdr->e_shnum);
+    if (!shdrs || hdr->e_shentsize != sizeof(Shdr) || hdr->e_shstrndx >= hdr->e_shnum)
+        return true;
+    const auto &shstrtab = shdrs[hdr->e_shstrndx];
+    for (int i = 0; i < hdr->e_shnum; ++i) {
+        if (elf.string(shstrtab.sh_offset + shdrs[i].sh_name) != ".qtversion")
+            continue;
+        const auto count = shdrs[i].sh_size / sizeof(typename Types::Addr);
+        const auto words = elf.template at<typename Types::Addr>(shdrs[i].sh_offset, count);
+        for (quint64 j = 0; words && j < count; ++j) {
+            if (isPlausibleQtVersion(words[j])) {
+                m_qtVersion = words[j];
+                break;
+            }
+        }
+        break;
+    }
+
+    return true;
+}
+#endif
+
+ElfFile::ElfFile(const QString &filePath)
+{
+#ifdef HAVE_ELF
+    QFile f(filePath);
+    if (!f.open(QFile::ReadOnly))
+        return;
+
+    const uchar *data = f.map(0, f.size());
+    if (!data || f.size() < EI_NIDENT)
+        return;
+
+    if (qstrncmp(reinterpret_cast<const char *>(data), ELFMAG, SELFMAG) != 0) // no ELF signature
+        return;
+
+    m_class = data[EI_CLASS];
+    switch (m_class) {
+    case ELFCLASS32:
+        m_valid = parse<Elf32Types>(data, f.size());
+        break;
+    case ELFCLASS64:
+        m_valid = parse<Elf64Types>(data, f.size());
+        break;
+    }
+#else
+    Q_UNUSED(filePath);
+#endif
+}
+
+ElfFile::~ElfFile() = default;
+
+bool ElfFile::isValid() const
+{
+    return m_valid;
+}
+
+int ElfFile::elfClass() const
+{
+    return m_class;
+}
+
+bool ElfFile::is64Bit() const
+{
+#ifdef HAVE_ELF
+    return m_class == ELFCLASS64;
+#else
+    return false;
+#endif
+}
+
+int ElfFile::machine() const
+{
+    return m_machine;
+}
+
+QString ElfFile::architecture() const
+{
+#ifdef HAVE_ELF
+    if (!m_valid)
+        return QString();
+
+    switch (m_machine) {
+    case EM_386:
+        return QStringLiteral("i686");
+#ifdef EM_X86_64
+    case EM_X86_64:
+        return QStringLiteral("x86_64");
+#endif
+    case EM_ARM:
+        return QStringLiteral("arm");
+#ifdef EM_AARCH64
+    case EM_AARCH64:
+        return QStringLiteral("aarch64");
+#endif
+    }
+
+    qWarning() << "Unsupported ELF machine type:" << m_machine;
+#endif
+    return QString();
+}
+
+QStringList ElfFile::neededLibraries() const
+{
+    return m_needed;
+}
+
+QStringList ElfFile::rpath() const
+{
+    return m_rpath;
+}
+
+QStringList ElfFile::runpath() const
+{
+    return m_runpath;
+}
+
+int ElfFile::qtVersion() const
+{
+    return m_qtVersion;
+}
@@ -0,0 +1,68 @@
+/*
+  elffile.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_ELFFILE_H
+#define GAMMARAY_ELFFILE_H
+
+#include "gammaray_launcher_export.h"
+
+#include <QString>
+#include <QStringList>
+
+namespace GammaRay {
+/** Convenience API to deal with extracting information from ELF files.
+ *  This reads the file directly, without loading or executing it.
+ */
+class GAMMARAY_LAUNCHER_EXPORT ElfFile
+{
+public:
+    explicit ElfFile(const QString &filePath);
+    ~ElfFile();
+
+    bool isValid() const;
+
+    /** ELF class, ie. ELFCLASS32 or ELFCLASS64. */
+    int elfClass() const;
+    bool is64Bit() const;
+    /** ELF machine type, as in the e_machine header field. */
+    int machine() const;
+    /** Architecture name in the notation used by ProbeABI. */
+    QString architecture() const;
+
+    /** DT_NEEDED entries, in the order the dynamic linker processes them. */
+    QStringList neededLibraries() const;
+    /** DT_RPATH entries, not expanded. */
+    QStringList rpath() const;
+    /** DT_RUNPATH entries, not expanded. */
+    QStringList runpath() const;
+
+    /** Qt version in QT_VERSION encoding if this is a QtCore library, 0 otherwise.
+     *  This is taken from the .qtversion section if present, or the Qt_X.Y symbol versions otherwise.
+     */
+    int qtVersion() const;
+
+private:
+    Q_DISABLE_COPY(ElfFile)
+    template<typename Types>
+    bool parse(const uchar *data, quint64 size);
+
+    bool m_valid = false;
+    int m_class = 0;
+    int m_machine = 0;
+    int m_qtVersion = 0;
+    QStringList m_needed;
+    QStringList m_rpath;
+    QStringList m_runpath;
+};
+}
+
+#endif // GAMMARAY_ELFFILE_H
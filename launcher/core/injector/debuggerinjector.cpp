@@ -13,9 +13,12 @@
 
 #include "debuggerinjector.h"
 
+#include <compat/qasconst.h>
+
 #include <QDebug>
 #include <QFile>
 #include <QProcess>
+#include <QStringList>
 #include <QTime>
 #include <QStandardPaths>
 
@@ -25,6 +28,8 @@
 
 using namespace GammaRay;
 
+static const char s_phaseMarker[] = "GAMMARAY-PHASE ";
+
 DebuggerInjector::~DebuggerInjector()
 {
     stop_impl();
@@ -94,10 +99,42 @@ void DebuggerInjector::readyReadStandardOutput()
     while (m_process->canReadLine()) {
         const QString output = QString::fromLocal8Bit(m_process->readLine());
         processLog(DebuggerInjector::In, false, output);
+        // the debugger prompt might precede the marker on the same line
+        const auto markerPos = output.indexOf(QLatin1String(s_phaseMarker));
+        if (markerPos >= 0) {
+            m_phaseTimings.push_back({ output.mid(markerPos + qstrlen(s_phaseMarker)).trimmed(), m_phaseTimer.elapsed() });
+            continue;
+        }
         emit stdoutMessage(output);
     }
 }
 
+void DebuggerInjector::markPhase(const QByteArray &phase)
+{
+    printMessage(s_phaseMarker + phase);
+}
+
+void DebuggerInjector::reportPhaseTimings()
+{
+    if (m_phaseTimings.isEmpty())
+        return;
+
+    // whatever happens after the last marker is detaching and shutting down the debugger
+    m_phaseTimings.push_back({ QStringLiteral("detach"), m_phaseTimer.elapsed() });
+    QStringList phases;
+    qint64 start = 0;
+    for (const auto &timing : qAsConst(m_phaseTimings)) {
+        phases.push_back(QStringLiteral("%1 %2 ms").arg(timing.phase).arg(timing.end - start));
+        start = timing.end;
+    }
+    const auto summary = tr("Debugger injection took %1 ms: %2").arg(start).arg(phases.join(QStringLiteral(", ")));
+    m_phaseTimings.clear();
+
+    if (qEnvironmentVariableIntValue("GAMMARAY_UNITTEST") == 1)
+        std::cout << qPrintable(summary) << std::endl;
+    emit stdoutMessage(summary);
+}
+
 void DebuggerInjector::setManualError(const QString &msg)
 {
     mManualError = true;
@@ -111,6 +148,7 @@ void DebuggerInjector::setManualError(const QString &msg)
 
 void DebuggerInjector::processFinished()
 {
+    reportPhaseTimings();
     mExitCode = m_process->exitCode();
     mExitStatus = m_process->exitStatus();
     if (!mManualError) {
@@ -148,6 +186,8 @@ bool DebuggerInjector::startDebugger(const QStringList &args, const QProcessEnvi
             this, &AbstractInjector::started);
     connect(m_process.data(), QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &DebuggerInjector::processFinished);
     m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    m_phaseTimings.clear();
+    m_phaseTimer.start();
     m_process->start(filePath(), args);
     bool status = m_process->waitForStarted(-1);
 
@@ -197,15 +237,19 @@ void DebuggerInjector::waitForMain()
     loadSymbols("Qt" STR(QT_VERSION_MAJOR) "Core");
     addMethodBreakpoint("QCoreApplication::exec");
     execCmd("continue");
+    markPhase("startup");
 }
 
 bool DebuggerInjector::injectAndDetach(const QString &probeDll, const QString &probeFunc)
 {
     Q_ASSERT(m_process);
     loadSymbols("dl");
+    markPhase("symbols");
     execCmd(QStringLiteral("call (void) dlopen(\"%1\", %2)").arg(probeDll).arg(RTLD_NOW).toUtf8());
+    markPhase("dlopen");
     loadSymbols(probeDll.toUtf8());
     execCmd(QStringLiteral("call (void) %1()").arg(probeFunc).toUtf8());
+    markPhase("probe");
 
     if (qEnvironmentVariableIntValue("GAMMARAY_UNITTEST") != 1) {
         execCmd("detach");
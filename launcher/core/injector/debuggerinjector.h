@@ -16,8 +16,10 @@
 
 #include "abstractinjector.h"
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QProcess>
+#include <QVector>
 
 namespace GammaRay {
 /** Base class for debugger-based injectors. */
@@ -53,6 +55,14 @@ protected:
     virtual void printBacktrace() = 0;
     /** Load symbols for the given shared library. */
     virtual void loadSymbols(const QByteArray &library);
+    /** Make the debugger print @p text on stdout once it executes this command. */
+    virtual void printMessage(const QByteArray &text) = 0;
+
+    /**
+     * Marks the end of the attach/launch step @p phase. The debugger reports back when it gets
+     * there, the time spent in each step is reported as stdoutMessage() once the debugger is done.
+     */
+    void markPhase(const QByteArray &phase);
 
     /** Start the debugger with the given command line arguments. */
     bool startDebugger(const QStringList &args,
@@ -93,7 +103,16 @@ private:
     };
 
     void stop_impl();
+    void reportPhaseTimings();
     static void processLog(DebuggerInjector::Orientation orientation, bool isError, const QString &text);
+
+    struct PhaseTiming
+    {
+        QString phase;
+        qint64 end; // ms since the debugger was started
+    };
+    QElapsedTimer m_phaseTimer;
+    QVector<PhaseTiming> m_phaseTimings;
 };
 }
 
@@ -53,10 +53,16 @@ bool GdbInjector::attach(int pid, const QString &probeDll, const QString &probeF
     if (supportsAutoSolibAddOff()) {
         gdbArgs << QStringLiteral("-iex") << QStringLiteral("set auto-solib-add off");
     }
+    // Reading the debug information of large executables makes up most of the attach time,
+    // while calling dlopen and the probe entry point only needs the ELF symbol tables.
+    // Launching still needs it, for the breakpoints in main and QCoreApplication::exec.
+    if (supportsReadNever())
+        gdbArgs << QStringLiteral("--readnever");
     gdbArgs << QStringLiteral("-pid") << QString::number(pid);
     if (!startDebugger(gdbArgs))
         return false;
     setupGdb();
+    markPhase("attach");
     return injectAndDetach(probeDll, probeFunc);
 }
 
@@ -121,6 +127,22 @@ void GdbInjector::loadSymbols(const QByteArray &library)
 #endif
 }
 
+void GdbInjector::printMessage(const QByteArray &text)
+{
+    execCmd("echo " + text + "\\n");
+}
+
+bool GdbInjector::supportsReadNever()
+{
+    if (m_readNeverSupport == Support::Unknown) {
+        QProcess process;
+        process.start(filePath(), QStringList(QStringLiteral("--help")));
+        const bool supported = process.waitForFinished(5000) && process.readAllStandardOutput().contains("--readnever");
+        m_readNeverSupport = supported ? Support::Supported : Support::Unsupported;
+    }
+    return m_readNeverSupport == Support::Supported;
+}
+
 bool GdbInjector::supportsAutoSolibAddOff() const
 {
 #ifdef Q_OS_LINUX
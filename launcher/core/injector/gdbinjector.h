@@ -33,12 +33,23 @@ protected:
     void clearBreakpoints() override;
     void printBacktrace() override;
     void loadSymbols(const QByteArray &library) override;
+    void printMessage(const QByteArray &text) override;
     void parseStandardError(const QByteArray &line) override;
 
 private:
     void setupGdb();
     /** Certain configurations crash with auto-solib-add off. */
     bool supportsAutoSolibAddOff() const;
+    /** gdb 8.2 and newer can skip reading debug information entirely. */
+    bool supportsReadNever();
+
+    enum class Support
+    {
+        Unknown,
+        Supported,
+        Unsupported
+    };
+    Support m_readNeverSupport = Support::Unknown;
 };
 }
 
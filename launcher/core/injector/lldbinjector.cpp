@@ -107,6 +107,11 @@ void LldbInjector::printBacktrace()
     execCmd("thread backtrace");
 }
 
+void LldbInjector::printMessage(const QByteArray &text)
+{
+    execCmd("script print(\"" + text + "\")");
+}
+
 bool LldbInjector::launch(const QStringList &programAndArgs, const QString &probeDll,
                           const QString &probeFunc, const QProcessEnvironment &env)
 {
@@ -126,9 +131,15 @@ bool LldbInjector::launch(const QStringList &programAndArgs, const QString &prob
 bool LldbInjector::attach(int pid, const QString &probeDll, const QString &probeFunc)
 {
     Q_ASSERT(pid > 0);
-    if (!startDebugger(QStringList() << QStringLiteral("-p") << QString::number(pid)))
+    QStringList args;
+    // only load debug information when something actually needs it (LLDB 14 and newer),
+    // injecting the probe gets by with the symbol tables
+    args << QStringLiteral("-O") << QStringLiteral("settings set symbols.load-on-demand true");
+    args << QStringLiteral("-p") << QString::number(pid);
+    if (!startDebugger(args))
         return false;
     disableConfirmations();
+    markPhase("attach");
     return injectAndDetach(probeDll, probeFunc);
 }
 
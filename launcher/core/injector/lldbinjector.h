@@ -34,6 +34,7 @@ protected:
     void addMethodBreakpoint(const QByteArray &method) override;
     void clearBreakpoints() override;
     void printBacktrace() override;
+    void printMessage(const QByteArray &text) override;
     void parseStandardError(const QByteArray &line) override;
 
 private:
@@ -62,11 +62,16 @@ QVector<ProbeABI> ProbeABIDetector::abiForQtCore(const QString &path) const
     if (!fi.exists())
         return {};
 
-    auto it = m_abiForQtCoreCache.constFind(fi.canonicalFilePath());
-    if (it != m_abiForQtCoreCache.constEnd())
-        return it.value();
+    {
+        QMutexLocker lock(&m_abiForQtCoreCacheMutex);
+        auto it = m_abiForQtCoreCache.constFind(fi.canonicalFilePath());
+        if (it != m_abiForQtCoreCache.constEnd())
+            return it.value();
+    }
 
+    // detect outside of the lock, concurrent detection of the same library is harmless
     const QVector<ProbeABI> abi = detectAbiForQtCore(fi.canonicalFilePath());
+    QMutexLocker lock(&m_abiForQtCoreCacheMutex);
     m_abiForQtCoreCache.insert(fi.canonicalFilePath(), abi);
     return abi;
 }
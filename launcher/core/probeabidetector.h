@@ -19,12 +19,14 @@
 #include "probeabi.h"
 
 #include <QHash>
+#include <QMutex>
 #include <QString>
 #include <QVector>
 
 namespace GammaRay {
 /*! Detect the probe ABI required for a given target.
  *  A target can be specified as either a process id or a path to an executable to be launched.
+ *  The detection methods are safe to call concurrently.
  */
 class GAMMARAY_LAUNCHER_EXPORT ProbeABIDetector
 {
@@ -66,6 +68,7 @@ private:
      */
     static QString qtCoreFromLsof(qint64 pid);
 
+    mutable QMutex m_abiForQtCoreCacheMutex;
     mutable QHash<QString, QVector<ProbeABI>> m_abiForQtCoreCache;
 };
 }
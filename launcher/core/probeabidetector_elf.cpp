@@ -16,24 +16,242 @@
 #include "probeabidetector.h"
 #include "probeabi.h"
 #include "libraryutil.h"
+#include "elffile.h"
 
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QProcess>
 #include <QProcessEnvironment>
+#include <QQueue>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
-#ifdef HAVE_ELF_H
-#include <elf.h>
-#endif
-// on Linux sys/elf.h is not what we want, on QNX we cannot add "sys" to the include dir without messing other stuff up...
-#if defined(HAVE_SYS_ELF_H) && !defined(HAVE_ELF_H)
-#include <sys/elf.h>
-#endif
-
 using namespace GammaRay;
 
+namespace {
+struct ElfInfo
+{
+    bool valid = false;
+    int elfClass = 0;
+    bool is64Bit = false;
+    int machine = 0;
+    int qtVersion = 0;
+    QString architecture;
+    QStringList needed;
+    QStringList rpath;
+    QStringList runpath;
+};
+
+struct ElfInfoCacheEntry
+{
+    QDateTime lastModified;
+    ElfInfo info;
+};
+
+struct ElfInfoCache
+{
+    QMutex mutex;
+    QHash<QString, ElfInfoCacheEntry> entries;
+};
+}
+
+Q_GLOBAL_STATIC(ElfInfoCache, s_elfInfoCache)
+
+/** Parsed ELF information of @p path, cached by canonical path and modification time. */
+static ElfInfo elfInfo(const QString &path)
+{
+    const QFileInfo fi(path);
+    const QString canonicalPath = fi.canonicalFilePath();
+    if (canonicalPath.isEmpty())
+        return ElfInfo();
+    const QDateTime lastModified = fi.lastModified();
+
+    {
+        QMutexLocker lock(&s_elfInfoCache()->mutex);
+        const auto it = s_elfInfoCache()->entries.constFind(canonicalPath);
+        if (it != s_elfInfoCache()->entries.constEnd() && it.value().lastModified == lastModified)
+            return it.value().info;
+    }
+
+    ElfInfoCacheEntry entry;
+    entry.lastModified = lastModified;
+    const ElfFile elf(canonicalPath);
+    if (elf.isValid()) {
+        entry.info.valid = true;
+        entry.info.elfClass = elf.elfClass();
+        entry.info.is64Bit = elf.is64Bit();
+        entry.info.machine = elf.machine();
+        entry.info.qtVersion = elf.qtVersion();
+        entry.info.architecture = elf.architecture();
+        entry.info.needed = elf.neededLibraries();
+        entry.info.rpath = elf.rpath();
+        entry.info.runpath = elf.runpath();
+    }
+
+    QMutexLocker lock(&s_elfInfoCache()->mutex);
+    s_elfInfoCache()->entries.insert(canonicalPath, entry);
+    return entry.info;
+}
+
+static void ldSoConfDirectories(const QString &confFile, QStringList &dirs, QSet<QString> &visited)
+{
+    if (visited.contains(confFile))
+        return;
+    visited.insert(confFile);
+
+    QFile f(confFile);
+    if (!f.open(QFile::ReadOnly))
+        return;
+
+    forever {
+        QByteArray line = f.readLine();
+        if (line.isEmpty())
+            break;
+        const int commentPos = line.indexOf('#');
+        if (commentPos >= 0)
+            line.truncate(commentPos);
+        line = line.trimmed();
+        if (line.isEmpty())
+            continue;
+
+        if (line.startsWith("include") && line.size() > 7 && QChar(line.at(7)).isSpace()) {
+            // include patterns are globs, relative to the including file
+            QString pattern = QFile::decodeName(line.mid(8).trimmed());
+            if (QDir::isRelativePath(pattern))
+                pattern = QFileInfo(confFile).absolutePath() + QLatin1Char('/') + pattern;
+            const QFileInfo patternInfo(pattern);
+            QDir dir = patternInfo.absoluteDir();
+            const auto entries = dir.entryList(QStringList() << patternInfo.fileName(), QDir::Files, QDir::Name);
+            for (const auto &entry : entries)
+                ldSoConfDirectories(dir.absoluteFilePath(entry), dirs, visited);
+            continue;
+        }
+
+        // old-style "dir=TYPE" annotations
+        const int typePos = line.indexOf('=');
+        if (typePos > 0)
+            line.truncate(typePos);
+        foreach (const auto &dir, line.split(':')) {
+            if (!dir.trimmed().isEmpty())
+                dirs.push_back(QFile::decodeName(dir.trimmed()));
+        }
+    }
+}
+
+static QStringList ldSoConfDirectories()
+{
+    QStringList dirs;
+    QSet<QString> visited;
+    ldSoConfDirectories(QStringLiteral("/etc/ld.so.conf"), dirs, visited);
+    return dirs;
+}
+
+/** Expands the $ORIGIN, $LIB and $PLATFORM dynamic string tokens in search path entries. */
+static QStringList expandSearchPaths(const QStringList &paths, const QString &objectPath, const ElfInfo &info)
+{
+    QStringList result;
+    result.reserve(paths.size());
+    const QString origin = QFileInfo(objectPath).absolutePath();
+    const QString lib = info.is64Bit ? QStringLiteral("lib64") : QStringLiteral("lib");
+    const QString platform = info.architecture;
+    for (QString path : paths) {
+        path.replace(QLatin1String("${ORIGIN}"), origin);
+        path.replace(QLatin1String("$ORIGIN"), origin);
+        path.replace(QLatin1String("${LIB}"), lib);
+        path.replace(QLatin1String("$LIB"), lib);
+        path.replace(QLatin1String("${PLATFORM}"), platform);
+        path.replace(QLatin1String("$PLATFORM"), platform);
+        result.push_back(path);
+    }
+    return result;
+}
+
+namespace {
+struct PendingObject
+{
+    QString path;
+    ElfInfo info;
+    /// expanded RPATH entries of this object and the objects that loaded it
+    QStringList rpathChain;
+};
+}
+
+/** Resolves the shared library @p name needed by @p loader following the ld.so search order. */
+static QString resolveLibrary(const QString &name, const PendingObject &loader, const ElfInfo &target, ElfInfo &libInfo)
+{
+    auto matches = [&target, &libInfo](const QString &candidate) -> bool {
+        if (!QFile::exists(candidate))
+            return false;
+        libInfo = elfInfo(candidate);
+        return libInfo.valid && libInfo.elfClass == target.elfClass && libInfo.machine == target.machine;
+    };
+
+    if (name.contains(QLatin1Char('/'))) {
+        const auto path = expandSearchPaths(QStringList() << name, loader.path, loader.info).constFirst();
+        return matches(path) ? path : QString();
+    }
+
+    QStringList searchPaths;
+    // RPATH is only considered if the loading object has no RUNPATH
+    if (loader.info.runpath.isEmpty())
+        searchPaths += loader.rpathChain;
+    searchPaths += QString::fromLocal8Bit(qgetenv("LD_LIBRARY_PATH")).split(QLatin1Char(':'), Qt::SkipEmptyParts);
+    searchPaths += expandSearchPaths(loader.info.runpath, loader.path, loader.info);
+    static const QStringList confDirs = ldSoConfDirectories();
+    searchPaths += confDirs;
+    if (target.is64Bit)
+        searchPaths << QStringLiteral("/lib64") << QStringLiteral("/usr/lib64");
+    searchPaths << QStringLiteral("/lib") << QStringLiteral("/usr/lib");
+
+    for (const auto &dir : qAsConst(searchPaths)) {
+        const QString candidate = dir + QLatin1Char('/') + name;
+        if (matches(candidate))
+            return candidate;
+    }
+    return QString();
+}
+
+static QString qtCoreFromElf(const QString &path, const ElfInfo &info)
+{
+    // breadth-first, as the dynamic linker does
+    QQueue<PendingObject> queue;
+    PendingObject exe;
+    exe.path = path;
+    exe.info = info;
+    exe.rpathChain = expandSearchPaths(info.rpath, path, info);
+    queue.enqueue(exe);
+
+    QSet<QString> seen;
+    while (!queue.isEmpty()) {
+        const PendingObject loader = queue.dequeue();
+        for (const auto &name : qAsConst(loader.info.needed)) {
+            if (seen.contains(name))
+                continue;
+            seen.insert(name);
+
+            PendingObject lib;
+            lib.path = resolveLibrary(name, loader, info, lib.info);
+            if (lib.path.isEmpty())
+                continue;
+            if (ProbeABIDetector::containsQtCore(QFile::encodeName(name)))
+                return lib.path;
+
+            if (lib.info.runpath.isEmpty())
+                lib.rpathChain = expandSearchPaths(lib.info.rpath, lib.path, lib.info);
+            lib.rpathChain += loader.rpathChain;
+            queue.enqueue(lib);
+        }
+    }
+
+    return QString();
+}
+
 static QString qtCoreFromLdd(const QString &path)
 {
     foreach (const auto &lib, LibraryUtil::dependencies(path)) {
@@ -46,7 +264,9 @@ static QString qtCoreFromLdd(const QString &path)
 
 QString ProbeABIDetector::qtCoreForExecutable(const QString &path)
 {
-    // TODO: add fast version reading the ELF file directly?
+    const ElfInfo info = elfInfo(path);
+    if (info.valid)
+        return qtCoreFromElf(path, info);
     return qtCoreFromLdd(path);
 }
 
@@ -63,10 +283,16 @@ static bool qtCoreFromProc(qint64 pid, QString &path)
         return false;
     }
 
-    forever {
-        const QByteArray line = f.readLine();
-        if (line.isEmpty())
-            break;
+    // read in one go and only look at lines mentioning "Core", maps can have thousands of entries
+    const QByteArray maps = f.readAll();
+    for (int index = 0; (index = maps.indexOf("Core", index)) >= 0;) {
+        const int lineBegin = maps.lastIndexOf('\n', index) + 1;
+        int lineEnd = maps.indexOf('\n', index);
+        if (lineEnd < 0)
+            lineEnd = maps.size();
+        index = lineEnd;
+
+        const QByteArray line = maps.mid(lineBegin, lineEnd - lineBegin);
         if (ProbeABIDetector::containsQtCore(line)) {
             int pos = line.indexOf('/');
             if (pos <= 0)
@@ -128,74 +354,21 @@ static ProbeABI qtVersionFromExec(const QString &path)
     return abi;
 }
 
-#ifdef HAVE_ELF
-template<typename ElfEHdr>
-static QString archFromELFHeader(const uchar *data, quint64 size)
-{
-    if (size <= sizeof(ElfEHdr))
-        return QString();
-    const ElfEHdr *hdr = reinterpret_cast<const ElfEHdr *>(data);
-
-    switch (hdr->e_machine) {
-    case EM_386:
-        return QStringLiteral("i686");
-#ifdef EM_X86_64
-    case EM_X86_64:
-        return QStringLiteral("x86_64");
-#endif
-    case EM_ARM:
-        return QStringLiteral("arm");
-#ifdef EM_AARCH64
-    case EM_AARCH64:
-        return QStringLiteral("aarch64");
-#endif
-    }
-
-    qWarning() << "Unsupported ELF machine type:" << hdr->e_machine;
-    return QString();
-}
-
-#endif
-
-static QString archFromELF(const QString &path)
-{
-#ifdef HAVE_ELF
-    QFile f(path);
-    if (!f.open(QFile::ReadOnly))
-        return QString();
-
-    const uchar *data = f.map(0, f.size());
-    if (!data || f.size() < EI_NIDENT)
-        return QString();
-
-    if (qstrncmp(reinterpret_cast<const char *>(data), ELFMAG, SELFMAG) != 0) // no ELF signature
-        return QString();
-
-    switch (data[EI_CLASS]) {
-    case ELFCLASS32:
-        return archFromELFHeader<Elf32_Ehdr>(data, f.size());
-    case ELFCLASS64:
-        return archFromELFHeader<Elf64_Ehdr>(data, f.size());
-    }
-#else
-    Q_UNUSED(path);
-#endif
-    return QString();
-}
-
 QVector<ProbeABI> ProbeABIDetector::detectAbiForQtCore(const QString &path)
 {
     if (path.isEmpty())
         return {};
 
     // try to find the version
+    const ElfInfo info = elfInfo(path);
     ProbeABI abi = qtVersionFromFileName(path);
+    if (!abi.hasQtVersion() && info.qtVersion > 0)
+        abi.setQtVersion(info.qtVersion >> 16, (info.qtVersion >> 8) & 0xff);
     if (!abi.hasQtVersion())
         abi = qtVersionFromExec(path);
 
     // TODO: architecture detection fallback without elf.h?
-    const QString arch = archFromELF(path);
-    abi.setArchitecture(arch);
+    abi.setArchitecture(info.architecture);
 
     return { abi };
 }
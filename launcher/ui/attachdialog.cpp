@@ -29,6 +29,7 @@
 #include <QListView>
 #include <QTimer>
 #include <QFutureWatcher>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <QStackedWidget>
 #include <QStringListModel>
@@ -143,22 +144,23 @@ QString GammaRay::AttachDialog::absoluteExecutablePath() const
 
 void AttachDialog::updateProcesses()
 {
-    auto *watcher = new QFutureWatcher<ProcDataList>(this);
+    auto *watcher = new QFutureWatcher<ProcessSnapshot>(this);
     connect(watcher, &QFutureWatcherBase::finished,
             this, &AttachDialog::updateProcessesFinished);
-    watcher->setFuture(QtConcurrent::run(processList, m_model->processes()));
+    watcher->setFuture(QtConcurrent::run(processSnapshot));
 }
 
 void AttachDialog::updateProcessesFinished()
 {
-    QFutureWatcher<ProcDataList> *watcher = dynamic_cast<QFutureWatcher<ProcDataList> *>(sender());
+    QFutureWatcher<ProcessSnapshot> *watcher = dynamic_cast<QFutureWatcher<ProcessSnapshot> *>(sender());
     Q_ASSERT(watcher);
     if (ui->stackedWidget->currentWidget() != ui->listViewPage) {
         ui->stackedWidget->setCurrentWidget(ui->listViewPage);
         ui->filter->setFocus();
     }
+    const ProcessSnapshot snapshot = watcher->result();
     const int oldPid = pid();
-    m_model->mergeProcesses(watcher->result());
+    m_model->mergeProcesses(snapshot.processes);
     if (oldPid == 0) {
         ui->view->setCurrentIndex(m_proxyModel->index(0, 0));
     } else if (oldPid != pid()) {
@@ -167,6 +169,33 @@ void AttachDialog::updateProcessesFinished()
 
     watcher->deleteLater();
 
+    if (snapshot.pendingABIDetection.isEmpty()) {
+        QTimer::singleShot(1000, this, &AttachDialog::updateProcesses);
+        return;
+    }
+
+    // probe new processes concurrently, and show the results as they come in
+    auto *abiWatcher = new QFutureWatcher<ProcData>(this);
+    connect(abiWatcher, &QFutureWatcherBase::resultReadyAt,
+            this, &AttachDialog::processABIDetected);
+    connect(abiWatcher, &QFutureWatcherBase::finished,
+            this, &AttachDialog::processABIDetectionFinished);
+    abiWatcher->setFuture(QtConcurrent::mapped(snapshot.pendingABIDetection, detectProcessABI));
+}
+
+void AttachDialog::processABIDetected(int resultIndex)
+{
+    QFutureWatcher<ProcData> *watcher = dynamic_cast<QFutureWatcher<ProcData> *>(sender());
+    Q_ASSERT(watcher);
+    const ProcData proc = watcher->resultAt(resultIndex);
+    m_model->updateProcess(proc);
+    if (proc.ppid == pid())
+        selectABI(ui->view->currentIndex());
+}
+
+void AttachDialog::processABIDetectionFinished()
+{
+    sender()->deleteLater();
     QTimer::singleShot(1000, this, &AttachDialog::updateProcesses);
 }
 
@@ -59,6 +59,8 @@ signals:
 private slots:
     void updateProcesses();
     void updateProcessesFinished();
+    void processABIDetected(int resultIndex);
+    void processABIDetectionFinished();
     void selectABI(const QModelIndex &processIndex);
 
 private:
@@ -42,7 +42,9 @@
 
 struct ProcData
 {
-    qint64 ppid;
+    qint64 ppid = 0;
+    /// process start time in platform-specific units, 0 if unknown
+    quint64 startTime = 0;
     QString name;
     QString image;
     QString state;
@@ -52,6 +54,7 @@ struct ProcData
     inline bool equals(const ProcData &other) const
     {
         return ppid == other.ppid &&
+                startTime == other.startTime &&
                 name == other.name &&
                 image == other.image &&
                 state == other.state &&
@@ -62,6 +65,24 @@ struct ProcData
 
 typedef QList<ProcData> ProcDataList;
 
+struct ProcessSnapshot
+{
+    /// all running processes, with the probe ABI of already known processes
+    ProcDataList processes;
+    /// processes seen for the first time, their probe ABI has not been determined yet
+    ProcDataList pendingABIDetection;
+};
+
 GAMMARAY_LAUNCHER_UI_EXPORT ProcDataList processList(const ProcDataList &previous);
 
+/**
+ * Lists the running processes without probing processes that have been seen before.
+ * Pass the entries in ProcessSnapshot::pendingABIDetection to detectProcessABI(),
+ * which can be done concurrently.
+ */
+GAMMARAY_LAUNCHER_UI_EXPORT ProcessSnapshot processSnapshot();
+
+/// Returns @p proc with its probe ABI filled in, and remembers it for subsequent snapshots.
+GAMMARAY_LAUNCHER_UI_EXPORT ProcData detectProcessABI(const ProcData &proc);
+
 #endif // PROCESSLIST_H
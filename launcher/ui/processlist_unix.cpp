@@ -37,11 +37,37 @@
 #include <QProcess>
 #include <QtConcurrent/QtConcurrentMap>
 #include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
 
 #include <algorithm>
 
 Q_GLOBAL_STATIC(GammaRay::ProbeABIDetector, s_abiDetector)
 
+namespace {
+typedef QPair<qint64, quint64> ProcessKey;
+
+struct ProcessCacheEntry
+{
+    /// short process name, to detect a process replacing itself by exec()
+    QString command;
+    QString name;
+    GammaRay::ProbeABI abi;
+    bool abiDetected = false;
+};
+
+/** Information about the processes of the previous snapshots, keyed by pid and start time. */
+struct ProcessCache
+{
+    QMutex mutex;
+    QHash<ProcessKey, ProcessCacheEntry> entries;
+    QHash<uint, QString> userNames;
+};
+}
+
+Q_GLOBAL_STATIC(ProcessCache, s_processCache)
+
 static bool isUnixProcessId(const QString &procname)
 {
     for (int i = 0; i != procname.size(); ++i) {
@@ -51,25 +77,63 @@ static bool isUnixProcessId(const QString &procname)
     return true;
 }
 
-struct PidAndNameMatch
+/** Looks up @p proc in the cache, or adds it as a process with pending ABI detection.
+ *  @returns @c true if the probe ABI of @p proc is known.
+ */
+static bool lookupProcess(ProcData &proc, const QString &command)
 {
-    explicit PidAndNameMatch(qint64 ppid, const QString &name)
-        : m_ppid(ppid)
-        , m_name(name)
-    {
+    QMutexLocker lock(&s_processCache()->mutex);
+    auto &entry = s_processCache()->entries[qMakePair(proc.ppid, proc.startTime)];
+    if (entry.command != command || (!proc.name.isEmpty() && entry.name != proc.name)) {
+        entry = ProcessCacheEntry();
+        entry.command = command;
+        entry.name = proc.name.isEmpty() ? command : proc.name;
     }
+    if (proc.name.isEmpty())
+        proc.name = entry.name;
+    proc.abi = entry.abi;
+    return entry.abiDetected;
+}
 
-    bool operator()(const ProcData &p) const
-    {
-        return p.ppid == m_ppid && m_name == p.name;
+static void updateProcessName(const ProcData &proc)
+{
+    QMutexLocker lock(&s_processCache()->mutex);
+    const auto it = s_processCache()->entries.find(qMakePair(proc.ppid, proc.startTime));
+    if (it != s_processCache()->entries.end())
+        it.value().name = proc.name;
+}
+
+/** Drops cache entries for processes that no longer exist. */
+static void pruneProcessCache(const ProcDataList &processes)
+{
+    QSet<ProcessKey> alive;
+    alive.reserve(processes.size());
+    for (const auto &proc : processes)
+        alive.insert(qMakePair(proc.ppid, proc.startTime));
+
+    QMutexLocker lock(&s_processCache()->mutex);
+    for (auto it = s_processCache()->entries.begin(); it != s_processCache()->entries.end();) {
+        if (alive.contains(it.key()))
+            ++it;
+        else
+            it = s_processCache()->entries.erase(it);
     }
+}
 
-    const qint64 m_ppid;
-    const QString m_name;
-};
+static ProcessSnapshot makeSnapshot(const ProcDataList &processes, const QVector<bool> &known)
+{
+    ProcessSnapshot snapshot;
+    snapshot.processes = processes;
+    for (int i = 0; i < processes.size(); ++i) {
+        if (!known.at(i))
+            snapshot.pendingABIDetection.push_back(processes.at(i));
+    }
+    pruneProcessCache(processes);
+    return snapshot;
+}
 
 // Determine UNIX processes by running ps
-static ProcDataList unixProcessListPS(const ProcDataList &previous)
+static ProcessSnapshot unixProcessSnapshotPS()
 {
 #ifdef Q_OS_MAC
     // command goes last, otherwise it is cut off
@@ -81,12 +145,13 @@ static ProcDataList unixProcessListPS(const ProcDataList &previous)
     static const char formatC[] = "pid,state,user,cmd";
 #endif
     ProcDataList rc;
+    QVector<bool> known;
     QProcess psProcess;
     QStringList args;
     args << QStringLiteral("-e") << QStringLiteral("-o") << QLatin1String(formatC);
     psProcess.start(QStringLiteral("ps"), args);
     if (!psProcess.waitForStarted())
-        return rc;
+        return ProcessSnapshot();
     psProcess.waitForFinished();
     QByteArray output = psProcess.readAllStandardOutput();
     // Split "457 S+   /Users/foo.app"
@@ -106,102 +171,143 @@ static ProcDataList unixProcessListPS(const ProcDataList &previous)
             procData.state = line.mid(endOfPid + 1, endOfState - endOfPid - 1);
             procData.user = line.mid(endOfState + 1, endOfUser - endOfState - 1);
             procData.name = line.right(line.size() - endOfUser - 1);
-            PidAndNameMatch f(procData.ppid, procData.name);
-            ProcDataList::ConstIterator it = std::find_if(previous.constBegin(), previous.constEnd(), std::move(f));
-            if (it != previous.constEnd())
-                procData.abi = it->abi;
-            else
-                procData.abi = s_abiDetector->abiForProcess(procData.ppid);
+            // ps gives us no start time, the name has to do to tell reused pids apart
+            known.push_back(lookupProcess(procData, procData.name));
             rc.push_back(procData);
         }
     }
 
-    return rc;
+    return makeSnapshot(rc, known);
 }
 
-struct ProcIdToProcData
+struct ScannedProcess
 {
-    ProcIdToProcData(const ProcDataList &prev)
-        : previous(prev)
-    {
-    }
+    ProcData proc;
+    bool abiKnown = false;
+};
 
-    typedef ProcData result_type;
+struct ProcIdToProcData
+{
+    typedef ScannedProcess result_type;
 
-    ProcData operator()(const QString &procId) const
+    ScannedProcess operator()(const QString &procId) const
     {
-        ProcData proc;
+        ScannedProcess result;
+        ProcData &proc = result.proc;
         if (!isUnixProcessId(procId))
-            return proc;
+            return result;
 
         const QString filename = QLatin1String("/proc/") + procId + QLatin1String("/stat");
         QFile file(filename);
         if (!file.open(QIODevice::ReadOnly))
-            return proc; // process may have exited
+            return result; // process may have exited
 
-        const QStringList data = QString::fromLocal8Bit(file.readAll()).split(' ');
+        // "pid (comm) state ppid ...", comm may contain spaces and parentheses itself
+        const QByteArray stat = file.readAll();
+        const int commBegin = stat.indexOf('(');
+        const int commEnd = stat.lastIndexOf(')');
+        if (commBegin < 0 || commEnd < commBegin)
+            return result;
+        const QString command = QString::fromLocal8Bit(stat.mid(commBegin + 1, commEnd - commBegin - 1));
+        const QList<QByteArray> fields = stat.mid(commEnd + 2).split(' ');
 
-        proc.ppid = procId.toULongLong();
-        proc.name = data.at(1);
-        if (proc.name.startsWith(QLatin1Char('(')) && proc.name.endsWith(QLatin1Char(')'))) {
-            proc.name.truncate(proc.name.size() - 1);
-            proc.name.remove(0, 1);
-        }
-        proc.state = data.at(2);
-        // PPID is element 3
+        proc.state = QString::fromLatin1(fields.at(0));
+        // PPID is field 4 and the start time field 22, counting from 1 for the pid
+        if (fields.size() > 19)
+            proc.startTime = fields.at(19).toULongLong();
 
-        proc.user = QFileInfo(file).owner();
+        const QFileInfo statInfo(file);
         file.close();
+        {
+            QMutexLocker lock(&s_processCache()->mutex);
+            auto it = s_processCache()->userNames.constFind(statInfo.ownerId());
+            if (it == s_processCache()->userNames.constEnd())
+                it = s_processCache()->userNames.insert(statInfo.ownerId(), statInfo.owner());
+            proc.user = it.value();
+        }
+
+        proc.ppid = procId.toULongLong();
+        result.abiKnown = lookupProcess(proc, command);
+        if (result.abiKnown)
+            return result;
 
         QFile cmdFile(QLatin1String("/proc/") + procId + QLatin1String("/cmdline"));
         if (cmdFile.open(QFile::ReadOnly)) {
             QByteArray cmd = cmdFile.readAll();
             cmd.replace('\0', ' ');
-            if (!cmd.isEmpty())
+            if (!cmd.isEmpty()) {
                 proc.name = QString::fromLocal8Bit(cmd).trimmed();
+                updateProcessName(proc);
+            }
         }
         cmdFile.close();
 
-        ProcDataList::ConstIterator it = std::find_if(previous.constBegin(), previous.constEnd(),
-                                                      PidAndNameMatch(proc.ppid, proc.name));
-        if (it != previous.constEnd())
-            proc.abi = it->abi;
-        else
-            proc.abi = s_abiDetector->abiForProcess(proc.ppid);
-
-        return proc;
+        return result;
     }
-
-private:
-    const ProcDataList &previous;
 };
 
-
 // Determine UNIX processes by reading "/proc". Default to ps if
 // it does not exist
-ProcDataList processList(const ProcDataList &previous)
+ProcessSnapshot processSnapshot()
 {
     const QDir procDir(QStringLiteral("/proc/"));
 #ifndef Q_OS_FREEBSD
     if (!procDir.exists())
 #endif
-        return unixProcessListPS(previous);
+        return unixProcessSnapshotPS();
 
-    ProcDataList rc;
-    const QStringList procIds = procDir.entryList();
+    const QStringList procIds = procDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
     if (procIds.isEmpty())
-        return rc;
-
-    ProcIdToProcData procIdToProcData(previous);
+        return ProcessSnapshot();
 
     // start collection
-    rc = QtConcurrent::blockingMapped<ProcDataList>(procIds, procIdToProcData);
+    const auto scanned = QtConcurrent::blockingMapped<QVector<ScannedProcess>>(procIds, ProcIdToProcData());
+
+    ProcDataList rc;
+    QVector<bool> known;
+    rc.reserve(scanned.size());
+    known.reserve(scanned.size());
+    for (const auto &entry : scanned) {
+        // Filter out invalid entries
+        if (entry.proc.ppid == 0)
+            continue;
+        rc.push_back(entry.proc);
+        known.push_back(entry.abiKnown);
+    }
 
-    // Filter out invalid entries
-    rc.erase(std::remove_if(rc.begin(), rc.end(), [](const ProcData &pd) {
-                 return pd.ppid == 0;
-             }),
-             rc.end());
+    return makeSnapshot(rc, known);
+}
+
+ProcData detectProcessABI(const ProcData &proc)
+{
+    ProcData result = proc;
+    result.abi = s_abiDetector->abiForProcess(proc.ppid);
 
-    return rc;
+    QMutexLocker lock(&s_processCache()->mutex);
+    const auto it = s_processCache()->entries.find(qMakePair(proc.ppid, proc.startTime));
+    if (it != s_processCache()->entries.end()) {
+        it.value().abi = result.abi;
+        it.value().abiDetected = true;
+    }
+    return result;
+}
+
+ProcDataList processList(const ProcDataList & /*previous*/)
+{
+    // processes seen before are taken from the snapshot cache rather than from previous
+    ProcessSnapshot snapshot = processSnapshot();
+    if (snapshot.pendingABIDetection.isEmpty())
+        return snapshot.processes;
+
+    const auto detected = QtConcurrent::blockingMapped(snapshot.pendingABIDetection, detectProcessABI);
+    QHash<qint64, GammaRay::ProbeABI> abis;
+    abis.reserve(detected.size());
+    for (const auto &proc : detected)
+        abis.insert(proc.ppid, proc.abi);
+    for (auto &proc : snapshot.processes) {
+        const auto it = abis.constFind(proc.ppid);
+        if (it != abis.constEnd())
+            proc.abi = it.value();
+    }
+    return snapshot.processes;
 }
@@ -152,3 +152,17 @@ ProcDataList processList(const ProcDataList & /*previous*/)
     CloseHandle(snapshot);
     return rc;
 }
+
+ProcessSnapshot processSnapshot()
+{
+    ProcessSnapshot snapshot;
+    snapshot.processes = processList(ProcDataList());
+    return snapshot;
+}
+
+ProcData detectProcessABI(const ProcData &proc)
+{
+    ProcData result = proc;
+    result.abi = s_abiDetector.abiForProcess(proc.ppid);
+    return result;
+}
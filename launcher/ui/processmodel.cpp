@@ -60,6 +60,12 @@ void ProcessModel::setProcesses(const ProcDataList &processes)
 
 void ProcessModel::mergeProcesses(const ProcDataList &processes)
 {
+    // initial population, a single reset is a lot cheaper than thousands of row insertions
+    if (m_data.isEmpty()) {
+        setProcesses(processes);
+        return;
+    }
+
     // sort like m_data
     ProcDataList sortedProcesses = processes;
     std::stable_sort(sortedProcesses.begin(), sortedProcesses.end());
@@ -113,6 +119,17 @@ void ProcessModel::mergeProcesses(const ProcDataList &processes)
     Q_ASSERT(m_data == sortedProcesses);
 }
 
+void ProcessModel::updateProcess(const ProcData &process)
+{
+    const auto it = std::lower_bound(m_data.begin(), m_data.end(), process);
+    if (it == m_data.end() || !(*it == process) || it->startTime != process.startTime)
+        return;
+
+    *it = process;
+    const int row = static_cast<int>(std::distance(m_data.begin(), it));
+    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
 void ProcessModel::clear()
 {
     beginRemoveRows(QModelIndex(), 0, m_data.count());
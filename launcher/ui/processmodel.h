@@ -31,6 +31,8 @@ public:
 
     void setProcesses(const ProcDataList &processes);
     void mergeProcesses(const ProcDataList &processes);
+    /// Updates the entry with the same PID as @p process, if there is one.
+    void updateProcess(const ProcData &process);
     ProcData dataForIndex(const QModelIndex &index) const;
     ProcData dataForRow(int row) const;
     QModelIndex indexForPid(const QString &pid) const;
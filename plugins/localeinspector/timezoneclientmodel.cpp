@@ -68,6 +68,8 @@ QVariant TimezoneClientModel::headerData(int section, Qt::Orientation orientatio
             return tr("DST");
         case TimezoneModelColumns::WindowsIdColumn:
             return tr("Windows Id");
+        case TimezoneModelColumns::UtcOffsetColumn:
+            return tr("UTC Offset");
         }
     }
 
@@ -14,17 +14,42 @@
 #include "timezonemodel.h"
 #include "timezonemodelroles.h"
 
+#include <QDateTime>
 #include <QLocale>
+#include <QThread>
 #include <QTimeZone>
 
+#include <compat/qasconst.h>
+
 using namespace GammaRay;
 
+class TimezoneModel::Builder : public QThread
+{
+public:
+    explicit Builder(QObject *parent)
+        : QThread(parent)
+    {
+    }
+
+    Table table;
+
+protected:
+    void run() override
+    {
+        table = TimezoneModel::buildTable();
+    }
+};
+
 TimezoneModel::TimezoneModel(QObject *parent)
     : QAbstractTableModel(parent)
 {
 }
 
-TimezoneModel::~TimezoneModel() = default;
+TimezoneModel::~TimezoneModel()
+{
+    if (m_builder)
+        m_builder->wait();
+}
 
 int TimezoneModel::columnCount(const QModelIndex &parent) const
 {
@@ -36,9 +61,13 @@ int TimezoneModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    if (m_ids.isEmpty())
-        m_ids = QTimeZone::availableTimeZoneIds();
-    return m_ids.count();
+    if (!m_buildStarted) {
+        m_buildStarted = true;
+        m_builder = new Builder(const_cast<TimezoneModel *>(this));
+        connect(m_builder.data(), &QThread::finished, this, &TimezoneModel::tableReady);
+        m_builder->start(QThread::LowPriority);
+    }
+    return m_table.ianaIds.size();
 }
 
 static QString displayNameForAllTimeTypes(const QTimeZone &tz, QTimeZone::NameType nameType)
@@ -51,39 +80,80 @@ static QString displayNameForAllTimeTypes(const QTimeZone &tz, QTimeZone::NameTy
         + tz.displayName(QTimeZone::GenericTime, nameType);
 }
 
+TimezoneModel::Table TimezoneModel::buildTable()
+{
+    Table table;
+    table.ianaIds = QTimeZone::availableTimeZoneIds().toVector();
+    const int count = table.ianaIds.size();
+    table.countries.reserve(count);
+    table.standardNames.reserve(count);
+    table.displayNames.reserve(count);
+    table.comments.reserve(count);
+    table.hasDaylightTime.reserve(count);
+    table.windowsIds.reserve(count);
+    table.utcOffsets.reserve(count);
+
+    const auto now = QDateTime::currentDateTime();
+    for (const auto &id : qAsConst(table.ianaIds)) {
+        const QTimeZone tz(id);
+        table.countries.push_back(QLocale::countryToString(tz.country()));
+        table.standardNames.push_back(tz.displayName(QTimeZone::StandardTime));
+        table.displayNames.push_back(displayNameForAllTimeTypes(tz, QTimeZone::LongName) + QLatin1Char('\n')
+                                     + displayNameForAllTimeTypes(tz, QTimeZone::ShortName) + QLatin1Char('\n')
+                                     + displayNameForAllTimeTypes(tz, QTimeZone::OffsetName));
+        table.comments.push_back(tz.comment());
+        table.hasDaylightTime.push_back(tz.hasDaylightTime());
+        table.windowsIds.push_back(QTimeZone::ianaIdToWindowsId(id));
+        table.utcOffsets.push_back(tz.displayName(now, QTimeZone::OffsetName));
+    }
+    return table;
+}
+
+void TimezoneModel::tableReady()
+{
+    auto table = std::move(m_builder->table);
+    m_builder->deleteLater();
+    if (table.ianaIds.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), 0, table.ianaIds.size() - 1);
+    m_table = std::move(table);
+    m_systemZoneId = QTimeZone::systemTimeZoneId();
+    endInsertRows();
+}
+
 QVariant TimezoneModel::data(const QModelIndex &index, int role) const
 {
     if (!index.isValid())
         return QVariant();
 
+    const auto row = index.row();
     if (role == Qt::DisplayRole) {
-        const QTimeZone tz(m_ids.at(index.row()));
         switch (index.column()) {
         case TimezoneModelColumns::IanaIdColumn:
-            return tz.id();
+            return m_table.ianaIds.at(row);
         case TimezoneModelColumns::CountryColumn:
-            return QLocale::countryToString(tz.country());
+            return m_table.countries.at(row);
         case TimezoneModelColumns::StandardDisplayNameColumn:
-            return tz.displayName(QTimeZone::StandardTime);
+            return m_table.standardNames.at(row);
         case TimezoneModelColumns::DSTColumn:
-            return tz.hasDaylightTime();
+            return m_table.hasDaylightTime.at(row);
         case TimezoneModelColumns::WindowsIdColumn:
-            return QTimeZone::ianaIdToWindowsId(tz.id());
+            return m_table.windowsIds.at(row);
+        case TimezoneModelColumns::UtcOffsetColumn:
+            return m_table.utcOffsets.at(row);
         }
     } else if (role == Qt::ToolTipRole) {
-        const QTimeZone tz(m_ids.at(index.row()));
         switch (index.column()) {
         case 0:
-            return tz.comment();
+            return m_table.comments.at(row);
         case TimezoneModelColumns::StandardDisplayNameColumn:
-            return QString(displayNameForAllTimeTypes(tz, QTimeZone::LongName) + QLatin1Char('\n')
-                           + displayNameForAllTimeTypes(tz, QTimeZone::ShortName) + QLatin1Char('\n')
-                           + displayNameForAllTimeTypes(tz, QTimeZone::OffsetName));
+            return m_table.displayNames.at(row);
         default:
             return {};
         }
     } else if (role == TimezoneModelRoles::LocalZoneRole && index.column() == 0) {
-        if (m_ids.at(index.row()) == QTimeZone::systemTimeZoneId())
+        if (m_table.ianaIds.at(row) == m_systemZoneId)
             return true;
         return QVariant();
     }
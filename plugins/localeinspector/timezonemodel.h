@@ -16,10 +16,18 @@
 
 #include <QAbstractTableModel>
 #include <QByteArray>
-#include <QList>
+#include <QPointer>
+#include <QVector>
 
 namespace GammaRay {
 
+/**
+ * All time zones known to QTimeZone.
+ *
+ * Looking up time zone data is expensive, so everything shown is computed once on
+ * a worker thread on first use, and served from that table afterwards. The model is
+ * empty until that is done.
+ */
 class TimezoneModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -32,7 +40,27 @@ public:
     QVariant data(const QModelIndex &index, int role) const override;
 
 private:
-    mutable QList<QByteArray> m_ids;
+    /** Display data of all time zones, one vector per column. */
+    struct Table
+    {
+        QVector<QByteArray> ianaIds;
+        QVector<QString> countries;
+        QVector<QString> standardNames;
+        QVector<QString> displayNames;
+        QVector<QString> comments;
+        QVector<bool> hasDaylightTime;
+        QVector<QByteArray> windowsIds;
+        QVector<QString> utcOffsets;
+    };
+    class Builder;
+
+    static Table buildTable();
+    void tableReady();
+
+    Table m_table;
+    QByteArray m_systemZoneId;
+    mutable QPointer<Builder> m_builder;
+    mutable bool m_buildStarted = false;
 };
 
 }
@@ -33,6 +33,7 @@ enum Column
     StandardDisplayNameColumn,
     DSTColumn,
     WindowsIdColumn,
+    UtcOffsetColumn,
     COUNT
 };
 }
@@ -32,6 +32,19 @@ void TimezoneOffsetDataModel::setTimezone(const QTimeZone &tz)
         endRemoveRows();
     }
 
+    auto it = m_transitionCache.find(tz.id());
+    if (it == m_transitionCache.end())
+        it = m_transitionCache.insert(tz.id(), transitions(tz));
+
+    if (!it.value().isEmpty()) {
+        beginInsertRows(QModelIndex(), 0, it.value().size() - 1);
+        m_offsets = it.value();
+        endInsertRows();
+    }
+}
+
+QVector<QTimeZone::OffsetData> TimezoneOffsetDataModel::transitions(const QTimeZone &tz)
+{
     QVector<QTimeZone::OffsetData> offsets;
     offsets.reserve(60);
 
@@ -53,11 +66,7 @@ void TimezoneOffsetDataModel::setTimezone(const QTimeZone &tz)
         offsets.push_back(offset);
     }
 
-    if (!offsets.isEmpty()) {
-        beginInsertRows(QModelIndex(), 0, offsets.size() - 1);
-        m_offsets = std::move(offsets);
-        endInsertRows();
-    }
+    return offsets;
 }
 
 int TimezoneOffsetDataModel::columnCount(const QModelIndex &parent) const
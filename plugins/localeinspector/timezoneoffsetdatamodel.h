@@ -15,6 +15,7 @@
 #define GAMMARAY_TIMEZONEOFFSETDATAMODEL_H
 
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QTimeZone>
 
 namespace GammaRay {
@@ -33,7 +34,11 @@ public:
     QVariant data(const QModelIndex &index, int role) const override;
 
 private:
+    static QVector<QTimeZone::OffsetData> transitions(const QTimeZone &tz);
+
     QVector<QTimeZone::OffsetData> m_offsets;
+    // transitions are expensive to look up and don't change during a session
+    QHash<QByteArray, QVector<QTimeZone::OffsetData>> m_transitionCache;
 };
 
 }
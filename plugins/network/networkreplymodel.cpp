@@ -25,6 +25,7 @@
 #include <private/qobject_p_p.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
@@ -173,8 +174,8 @@ QVariant NetworkReplyModel::data(const QModelIndex &index, int role) const
         return reply.errorMsgs;
     } else if (role == NetworkReplyModelRole::ObjectIdRole && index.column() == NetworkReplyModelColumn::ObjectColumn) {
         return QVariant::fromValue(ObjectId(reply.reply));
-    } else if (role == NetworkReplyModelRole::ReplyResponseRole && index.column() == NetworkReplyModelColumn::ObjectColumn) {
-        return reply.response;
+    } else if (role == NetworkReplyModelRole::ReplyIdRole && index.column() == NetworkReplyModelColumn::ObjectColumn) {
+        return reply.id;
     } else if (role == NetworkReplyModelRole::ReplyContentType && index.column() == NetworkReplyModelColumn::ObjectColumn) {
         return reply.contentType;
     }
@@ -208,6 +209,7 @@ void NetworkReplyModel::objectCreated(QObject *obj)
         NAMNode node;
         node.nam = nam;
         node.displayName = Util::displayString(nam);
+        m_namRows.insert(nam, m_nodes.size());
         m_nodes.push_back(node);
         endInsertRows();
 
@@ -222,11 +224,7 @@ void NetworkReplyModel::objectCreated(QObject *obj)
 
     if (auto reply = qobject_cast<QNetworkReply *>(obj)) {
         auto nam = reply->manager();
-        auto namIt = std::find_if(m_nodes.begin(), m_nodes.end(), [nam](const NAMNode &node) {
-            return node.nam == nam;
-        });
-
-        if (namIt == m_nodes.end()) {
+        if (!m_namRows.contains(nam)) {
             // TODO
             return;
         }
@@ -267,7 +265,7 @@ QMap<int, QVariant> NetworkReplyModel::itemData(const QModelIndex &index) const
         m.insert(NetworkReplyModelRole::ReplyStateRole, data(index, NetworkReplyModelRole::ReplyStateRole));
         m.insert(NetworkReplyModelRole::ReplyErrorRole, data(index, NetworkReplyModelRole::ReplyErrorRole));
         m.insert(NetworkReplyModelRole::ObjectIdRole, data(index, NetworkReplyModelRole::ObjectIdRole));
-        m.insert(NetworkReplyModelRole::ReplyResponseRole, data(index, NetworkReplyModelRole::ReplyResponseRole));
+        m.insert(NetworkReplyModelRole::ReplyIdRole, data(index, NetworkReplyModelRole::ReplyIdRole));
         m.insert(NetworkReplyModelRole::ReplyContentType, data(index, NetworkReplyModelRole::ReplyContentType));
     }
     return m;
@@ -382,55 +380,176 @@ void NetworkReplyModel::maybePeekResponse(ReplyNode &node, QNetworkReply *reply)
 void NetworkReplyModel::updateReplyNode(QNetworkAccessManager *nam, const NetworkReplyModel::ReplyNode &newNode)
 {
     // WARNING reply is no longer safe to deref here!
-    const auto namIt = std::find_if(m_nodes.begin(), m_nodes.end(), [nam](const NAMNode &node) {
-        return node.nam == nam;
-    });
+    const auto namRowIt = m_namRows.constFind(nam);
+    if (namRowIt == m_namRows.constEnd()) {
+        return;
+    }
+    const int namRow = namRowIt.value();
+    auto &namNode = m_nodes[namRow];
 
-    if (namIt == m_nodes.end()) {
+    // addresses can be reused after deletion, so only replies that are still alive are in here
+    const auto idIt = m_replyIds.find(newNode.reply);
+    if (idIt == m_replyIds.end()) {
+        insertReplyNode(namRow, newNode);
         return;
     }
 
-    auto replyIt = std::find_if((*namIt).replies.rbegin(), (*namIt).replies.rend(), [newNode](const ReplyNode &node) {
-        // be careful with considering past deleted nodes, address can be reused
-        return node.reply == newNode.reply && ((node.state & NetworkReply::Deleted) == 0 || newNode.state & NetworkReply::Deleted);
-    });
+    const auto id = idIt.value();
+    if (newNode.state & NetworkReply::Deleted) {
+        m_replyIds.erase(idIt);
+    }
 
-    if (replyIt == (*namIt).replies.rend()) {
-        const auto parentIdx = createIndex(std::distance(m_nodes.begin(), namIt), 0, TopIndex);
-        beginInsertRows(parentIdx, (*namIt).replies.size(), (*namIt).replies.size());
-        ReplyNode replyNode = newNode;
-        if (replyNode.displayName.isEmpty()) {
-            replyNode.displayName = Util::addressToString(newNode.reply);
-        }
-        (*namIt).replies.push_back(replyNode);
-        endInsertRows();
-        replyIt = (*namIt).replies.rbegin();
-    } else {
-        if (!newNode.displayName.isEmpty()) {
-            (*replyIt).displayName = newNode.displayName;
-        }
-        (*replyIt).state |= newNode.state;
-        if ((*replyIt).state & NetworkReply::Unencrypted) {
-            (*replyIt).state &= ~NetworkReply::Encrypted;
-        }
-        if (!newNode.url.isEmpty()) {
-            (*replyIt).url = newNode.url;
-            (*replyIt).op = newNode.op;
+    const int row = replyRow(namNode, id);
+    if (row < 0) {
+        return; // already discarded by the retention policy
+    }
+
+    auto &reply = namNode.replies[row];
+    if (!newNode.displayName.isEmpty()) {
+        reply.displayName = newNode.displayName;
+    }
+    reply.state |= newNode.state;
+    if (reply.state & NetworkReply::Unencrypted) {
+        reply.state &= ~NetworkReply::Encrypted;
+    }
+    if (!newNode.url.isEmpty()) {
+        reply.url = newNode.url;
+        reply.op = newNode.op;
+    }
+    if (!newNode.response.isEmpty()) {
+        reply.response = newNode.response;
+    }
+    reply.errorMsgs += newNode.errorMsgs;
+    if (reply.duration > 0 && newNode.duration > 0 && (newNode.state & NetworkReply::Finished)) {
+        reply.duration = newNode.duration > reply.duration ? newNode.duration - reply.duration : 0;
+    }
+    reply.size = std::max(reply.size, newNode.size);
+    if (newNode.contentType != NetworkReply::Unknown)
+        reply.contentType = newNode.contentType;
+    storeResponse(reply);
+
+    const auto idx = createIndex(row, 0, namRow);
+    emit dataChanged(idx, idx.sibling(idx.row(), columnCount() - 1));
+
+    if (newNode.state & (NetworkReply::Finished | NetworkReply::Deleted)) {
+        applyRetentionPolicy();
+    }
+}
+
+void NetworkReplyModel::insertReplyNode(int namRow, const ReplyNode &newNode)
+{
+    auto &namNode = m_nodes[namRow];
+    const auto parentIdx = createIndex(namRow, 0, TopIndex);
+    beginInsertRows(parentIdx, namNode.replies.size(), namNode.replies.size());
+    ReplyNode replyNode = newNode;
+    if (replyNode.displayName.isEmpty()) {
+        replyNode.displayName = Util::addressToString(newNode.reply);
+    }
+    replyNode.id = m_nextReplyId++;
+    replyNode.created = m_time.elapsed();
+    storeResponse(replyNode);
+    namNode.replies.push_back(replyNode);
+    ++m_replyCount;
+    if ((replyNode.state & NetworkReply::Deleted) == 0) {
+        m_replyIds.insert(replyNode.reply, replyNode.id);
+    }
+    endInsertRows();
+
+    applyRetentionPolicy();
+}
+
+void NetworkReplyModel::storeResponse(ReplyNode &node)
+{
+    // responses of running replies are still growing, keep them in memory until then
+    if (node.response.isEmpty() || (node.state & (NetworkReply::Finished | NetworkReply::Deleted)) == 0) {
+        return;
+    }
+    m_responses.insert(node.id, node.response);
+    node.response.clear();
+}
+
+void NetworkReplyModel::applyRetentionPolicy()
+{
+    const auto now = m_time.elapsed();
+    forever {
+        // find the oldest reply that is done, running replies are always kept
+        int oldestNamRow = -1;
+        int oldestRow = -1;
+        for (int namRow = 0; namRow < static_cast<int>(m_nodes.size()); ++namRow) {
+            const auto &replies = m_nodes[namRow].replies;
+            for (int row = 0; row < static_cast<int>(replies.size()); ++row) {
+                if ((replies[row].state & (NetworkReply::Finished | NetworkReply::Deleted)) == 0) {
+                    continue;
+                }
+                if (oldestNamRow < 0 || replies[row].id < m_nodes[oldestNamRow].replies[oldestRow].id) {
+                    oldestNamRow = namRow;
+                    oldestRow = row;
+                }
+                break;
+            }
         }
-        if (!newNode.response.isEmpty()) {
-            (*replyIt).response = newNode.response;
+        if (oldestNamRow < 0) {
+            return;
         }
-        (*replyIt).errorMsgs += newNode.errorMsgs;
-        if ((*replyIt).duration > 0 && newNode.duration > 0 && (newNode.state & NetworkReply::Finished)) {
-            (*replyIt).duration = newNode.duration > (*replyIt).duration ? newNode.duration - (*replyIt).duration : 0;
+
+        auto &replies = m_nodes[oldestNamRow].replies;
+        const auto &oldest = replies[oldestRow];
+        const bool exceedsCount = m_maxReplyCount > 0 && m_replyCount > m_maxReplyCount;
+        const bool exceedsAge = m_maxReplyAge > 0 && now - oldest.created > m_maxReplyAge;
+        if (!exceedsCount && !exceedsAge) {
+            return;
         }
-        (*replyIt).size = std::max((*replyIt).size, newNode.size);
-        if (newNode.contentType != NetworkReply::Unknown)
-            (*replyIt).contentType = newNode.contentType;
 
-        const auto idx = createIndex(std::distance(replyIt, (*namIt).replies.rend()) - 1, 0, std::distance(m_nodes.begin(), namIt));
-        emit dataChanged(idx, idx.sibling(idx.row(), columnCount() - 1));
+        beginRemoveRows(createIndex(oldestNamRow, 0, TopIndex), oldestRow, oldestRow);
+        m_responses.remove(oldest.id);
+        replies.erase(replies.begin() + oldestRow);
+        --m_replyCount;
+        endRemoveRows();
+    }
+}
+
+int NetworkReplyModel::replyRow(const NAMNode &namNode, quint64 id) const
+{
+    const auto it = std::lower_bound(namNode.replies.begin(), namNode.replies.end(), id, [](const ReplyNode &node, quint64 value) {
+        return node.id < value;
+    });
+    if (it == namNode.replies.end() || (*it).id != id) {
+        return -1;
+    }
+    return std::distance(namNode.replies.begin(), it);
+}
+
+QByteArray NetworkReplyModel::response(quint64 replyId) const
+{
+    if (m_responses.contains(replyId)) {
+        return m_responses.response(replyId);
+    }
+
+    // still running
+    for (const auto &namNode : m_nodes) {
+        const int row = replyRow(namNode, replyId);
+        if (row >= 0) {
+            return namNode.replies[row].response;
+        }
     }
+    return {};
+}
+
+void NetworkReplyModel::setMaxReplyCount(int count)
+{
+    m_maxReplyCount = count;
+    applyRetentionPolicy();
+}
+
+void NetworkReplyModel::setMaxReplyAge(qint64 msecs)
+{
+    m_maxReplyAge = msecs;
+    applyRetentionPolicy();
+}
+
+void NetworkReplyModel::setMaxResponseBytes(qint64 bytes)
+{
+    m_responses.setByteBudget(bytes);
 }
 
 void NetworkReplyModel::setCaptureResponse(bool newCaptureResponse)
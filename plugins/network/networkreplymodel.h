@@ -15,12 +15,15 @@
 #define GAMMARAY_NETWORKREPLYMODEL_H
 
 #include "networkreplymodeldefs.h"
+#include "networkresponsestore.h"
 
 #include <QAbstractItemModel>
 #include <QElapsedTimer>
+#include <QHash>
 #include <QNetworkAccessManager>
 #include <QUrl>
 
+#include <deque>
 #include <functional>
 
 QT_BEGIN_NAMESPACE
@@ -29,7 +32,11 @@ QT_END_NAMESPACE
 
 namespace GammaRay {
 
-/** QNetworkReply tracking. */
+/** QNetworkReply tracking.
+ *  Replies are retained up to a configurable count and age, captured responses
+ *  are kept in a NetworkResponseStore with a byte budget and are not exposed
+ *  as a role, but via response().
+ */
 class NetworkReplyModel : public QAbstractItemModel
 {
     Q_OBJECT
@@ -50,6 +57,8 @@ public:
     struct ReplyNode
     {
         QNetworkReply *reply = nullptr;
+        quint64 id = 0;
+        qint64 created = 0;
         QString displayName;
         QUrl url;
         QStringList errorMsgs;
@@ -67,6 +76,16 @@ public:
     }
     void setCaptureResponse(bool newCaptureResponse);
 
+    /** Maximum number of finished replies to keep, 0 for no limit. */
+    void setMaxReplyCount(int count);
+    /** Maximum age in milliseconds of finished replies to keep, 0 for no limit. */
+    void setMaxReplyAge(qint64 msecs);
+    /** Maximum number of bytes for captured responses of finished replies. */
+    void setMaxResponseBytes(qint64 bytes);
+
+    /** The captured response of the reply with id @p replyId, if still available. */
+    QByteArray response(quint64 replyId) const;
+
 signals:
     void captureResponseChanged();
 
@@ -75,7 +94,7 @@ private:
     {
         QNetworkAccessManager *nam;
         QString displayName;
-        std::vector<ReplyNode> replies;
+        std::deque<ReplyNode> replies; // sorted by id
     };
 
     void replyFinished(QNetworkReply *reply, QNetworkAccessManager *nam);
@@ -89,9 +108,21 @@ private:
 
     void maybePeekResponse(ReplyNode &node, QNetworkReply *reply) const;
     Q_INVOKABLE void updateReplyNode(QNetworkAccessManager *nam, const GammaRay::NetworkReplyModel::ReplyNode &newNode);
+    void insertReplyNode(int namRow, const ReplyNode &newNode);
+    void storeResponse(ReplyNode &node);
+    void applyRetentionPolicy();
+    int replyRow(const NAMNode &namNode, quint64 id) const;
 
     std::vector<NAMNode> m_nodes;
+    QHash<QNetworkAccessManager *, int> m_namRows;
+    /// ids of replies not deleted yet, events refer to replies by address
+    QHash<QNetworkReply *, quint64> m_replyIds;
+    NetworkResponseStore m_responses;
     QElapsedTimer m_time;
+    quint64 m_nextReplyId = 1;
+    int m_replyCount = 0;
+    int m_maxReplyCount = 10000;
+    qint64 m_maxReplyAge = 0;
     bool m_captureResponse = false;
 };
 }
@@ -44,7 +44,7 @@ enum Role
     ReplyStateRole = GammaRay::UserRole,
     ReplyErrorRole,
     ObjectIdRole,
-    ReplyResponseRole,
+    ReplyIdRole, ///< unique id of the reply, to request the response from NetworkSupportInterface
     ReplyContentType,
 };
 }
@@ -51,7 +51,7 @@ NetworkReplyWidget::NetworkReplyWidget(QWidget *parent)
 
     ObjectBroker::registerClientObjectFactoryCallback<NetworkSupportInterface *>(
         createClientNetworkSupportInterface);
-    auto interface = ObjectBroker::object<NetworkSupportInterface *>();
+    m_interface = ObjectBroker::object<NetworkSupportInterface *>();
 
     auto srcModel = ObjectBroker::model(QStringLiteral("com.kdab.GammaRay.NetworkReplyModel"));
     auto proxy = new ClientNetworkReplyModel(this);
@@ -69,79 +69,114 @@ NetworkReplyWidget::NetworkReplyWidget(QWidget *parent)
     });
 
     connect(ui->replyView, &QWidget::customContextMenuRequested, this, &NetworkReplyWidget::contextMenu);
-    connect(ui->replyView->selectionModel(), &QItemSelectionModel::currentChanged, this, [this](const QModelIndex &current, const QModelIndex &) {
-        const auto objColumn = current.sibling(current.row(), NetworkReplyModelColumn::ObjectColumn);
-        auto response = objColumn.data(NetworkReplyModelRole::ReplyResponseRole).toByteArray();
-        const auto contentType = ( NetworkReply::ContentType )objColumn.data(NetworkReplyModelRole::ReplyContentType).toInt();
+    connect(ui->replyView->selectionModel(), &QItemSelectionModel::currentChanged, this, &NetworkReplyWidget::currentReplyChanged);
+    // request the response again once the current reply finished
+    connect(proxy, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        if (!m_currentReply.isValid() || m_currentReplyFinished || m_currentReply.parent() != topLeft.parent()
+            || m_currentReply.row() < topLeft.row() || m_currentReply.row() > bottomRight.row()) {
+            return;
+        }
+        const auto state = m_currentReply.data(NetworkReplyModelRole::ReplyStateRole).toInt();
+        if (state & (NetworkReply::Finished | NetworkReply::Deleted)) {
+            currentReplyChanged(m_currentReply);
+        }
+    });
+    connect(m_interface, &NetworkSupportInterface::responseAvailable, this, &NetworkReplyWidget::showResponse);
+    ui->responseTextEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    connect(ui->responseTextEdit, &QPlainTextEdit::textChanged, this, [this]() {
+        ui->responseTextEdit->setVisible(!ui->responseTextEdit->toPlainText().isEmpty());
+    });
+    connect(ui->captureResponse, &QCheckBox::toggled, m_interface, [this](bool checked) {
+        m_interface->setProperty("captureResponse", checked);
+    });
+}
 
+NetworkReplyWidget::~NetworkReplyWidget() = default;
+
+void NetworkReplyWidget::currentReplyChanged(const QModelIndex &current)
+{
+    const auto objColumn = current.sibling(current.row(), NetworkReplyModelColumn::ObjectColumn);
+    const auto replyId = objColumn.data(NetworkReplyModelRole::ReplyIdRole).value<quint64>();
+    const auto state = objColumn.data(NetworkReplyModelRole::ReplyStateRole).toInt();
+    if (m_currentReplyId != replyId) {
         ui->imageLabel->clear();
+        ui->responseTextEdit->clear();
+    }
+    m_currentReply = objColumn;
+    m_currentReplyId = replyId;
+    m_currentReplyFinished = state & (NetworkReply::Finished | NetworkReply::Deleted);
 
-        switch (contentType) {
-        case NetworkReply::Json:
-            response = QJsonDocument::fromJson(response).toJson(QJsonDocument::JsonFormat::Indented);
-            break;
-        case NetworkReply::Xml: {
-            QXmlStreamReader reader(response);
+    // responses can be large, so they are only transferred on demand
+    if (replyId > 0) {
+        m_interface->requestResponse(replyId);
+    }
+}
+
+void NetworkReplyWidget::showResponse(quint64 replyId, QByteArray response)
+{
+    if (replyId != m_currentReplyId || !m_currentReply.isValid()) {
+        return;
+    }
+    const auto contentType = ( NetworkReply::ContentType )m_currentReply.data(NetworkReplyModelRole::ReplyContentType).toInt();
 
-            QByteArray formattedResponse;
-            QXmlStreamWriter writer(&formattedResponse);
-            writer.setAutoFormatting(true);
+    ui->imageLabel->clear();
 
-            while (!reader.atEnd()) {
-                reader.readNext();
-                if (reader.isWhitespace()) {
-                    continue;
-                }
+    switch (contentType) {
+    case NetworkReply::Json:
+        response = QJsonDocument::fromJson(response).toJson(QJsonDocument::JsonFormat::Indented);
+        break;
+    case NetworkReply::Xml: {
+        QXmlStreamReader reader(response);
 
-                writer.writeCurrentToken(reader);
-            }
+        QByteArray formattedResponse;
+        QXmlStreamWriter writer(&formattedResponse);
+        writer.setAutoFormatting(true);
 
-            if (reader.hasError()) {
-                qWarning() << "Error while parsing XML:" << reader.errorString();
-                break;
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.isWhitespace()) {
+                continue;
             }
 
-            response.swap(formattedResponse);
-            break;
+            writer.writeCurrentToken(reader);
         }
-        case NetworkReply::Image:
-            ui->imageLabel->setPixmap(QPixmap::fromImage(QImage::fromData(response)));
-            response.clear();
-            break;
-        default:
+
+        if (reader.hasError()) {
+            qWarning() << "Error while parsing XML:" << reader.errorString();
             break;
         }
 
+        response.swap(formattedResponse);
+        break;
+    }
+    case NetworkReply::Image:
+        ui->imageLabel->setPixmap(QPixmap::fromImage(QImage::fromData(response)));
+        response.clear();
+        break;
+    default:
+        break;
+    }
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        QStringDecoder decoder(QStringDecoder::Utf8);
-        QByteArrayView bav(response.constData(), response.size());
-        const QString text = decoder.decode(bav);
-        if (!decoder.hasError()) {
-            ui->responseTextEdit->setPlainText(text);
-        }
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QByteArrayView bav(response.constData(), response.size());
+    const QString text = decoder.decode(bav);
+    if (!decoder.hasError()) {
+        ui->responseTextEdit->setPlainText(text);
+    }
 #else
 
-        QTextCodec::ConverterState state;
-        QTextCodec *codec = QTextCodec::codecForName("UTF-8");
-        const QString text = codec->toUnicode(response.constData(), response.size(), &state);
-        if (state.invalidChars > 0) {
-            ui->responseTextEdit->setPlainText(tr("%1: Unable to show response preview").arg(qApp->applicationName()));
-        } else {
-            ui->responseTextEdit->setPlainText(text);
-        }
+    QTextCodec::ConverterState state;
+    QTextCodec *codec = QTextCodec::codecForName("UTF-8");
+    const QString text = codec->toUnicode(response.constData(), response.size(), &state);
+    if (state.invalidChars > 0) {
+        ui->responseTextEdit->setPlainText(tr("%1: Unable to show response preview").arg(qApp->applicationName()));
+    } else {
+        ui->responseTextEdit->setPlainText(text);
+    }
 #endif
-    });
-    ui->responseTextEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
-    connect(ui->responseTextEdit, &QPlainTextEdit::textChanged, this, [this]() {
-        ui->responseTextEdit->setVisible(!ui->responseTextEdit->toPlainText().isEmpty());
-    });
-    connect(ui->captureResponse, &QCheckBox::toggled, interface, [interface](bool checked) {
-        interface->setProperty("captureResponse", checked);
-    });
 }
 
-NetworkReplyWidget::~NetworkReplyWidget() = default;
-
 void NetworkReplyWidget::contextMenu(QPoint pos)
 {
     const auto index = ui->replyView->indexAt(pos);
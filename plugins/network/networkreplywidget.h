@@ -14,11 +14,13 @@
 #ifndef GAMMARAY_NETWORKREPLYWIDGET_H
 #define GAMMARAY_NETWORKREPLYWIDGET_H
 
+#include <QPersistentModelIndex>
 #include <QWidget>
 
 #include <memory>
 
 namespace GammaRay {
+class NetworkSupportInterface;
 
 namespace Ui {
 class NetworkReplyWidget;
@@ -33,8 +35,14 @@ public:
 
 private:
     void contextMenu(QPoint pos);
+    void currentReplyChanged(const QModelIndex &current);
+    void showResponse(quint64 replyId, QByteArray response);
 
     std::unique_ptr<Ui::NetworkReplyWidget> ui;
+    NetworkSupportInterface *m_interface = nullptr;
+    QPersistentModelIndex m_currentReply;
+    quint64 m_currentReplyId = 0;
+    bool m_currentReplyFinished = false;
 };
 
 }
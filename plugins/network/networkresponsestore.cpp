@@ -0,0 +1,135 @@
+/*
+  networkresponsestore.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "networkresponsestore.h"
+
+#include <QDir>
+#include <QTemporaryFile>
+
+using namespace GammaRay;
+
+NetworkResponseStore::NetworkResponseStore(qint64 byteBudget, qint64 segmentSize)
+    : m_byteBudget(byteBudget)
+    , m_segmentSize(segmentSize)
+{
+}
+
+NetworkResponseStore::~NetworkResponseStore() = default;
+
+qint64 NetworkResponseStore::byteBudget() const
+{
+    return m_byteBudget;
+}
+
+void NetworkResponseStore::setByteBudget(qint64 byteBudget)
+{
+    m_byteBudget = byteBudget;
+    enforceBudget();
+}
+
+qint64 NetworkResponseStore::size() const
+{
+    return m_size;
+}
+
+void NetworkResponseStore::insert(quint64 id, const QByteArray &response)
+{
+    remove(id);
+    if (response.isEmpty() || response.size() > m_byteBudget)
+        return;
+
+    if (m_segments.empty() || (m_segments.back().size > 0 && m_segments.back().size + response.size() > m_segmentSize))
+        appendSegment();
+
+    auto &segment = m_segments.back();
+    Entry entry;
+    entry.segment = m_firstSegment + m_segments.size() - 1;
+    entry.offset = segment.size;
+    entry.size = response.size();
+
+    if (segment.file) {
+        if (!segment.file->seek(entry.offset) || segment.file->write(response) != response.size())
+            return;
+    } else {
+        segment.buffer.append(response);
+    }
+
+    segment.size += entry.size;
+    segment.ids.push_back(id);
+    m_size += entry.size;
+    m_entries.insert(id, entry);
+
+    enforceBudget();
+}
+
+void NetworkResponseStore::remove(quint64 id)
+{
+    // the space is reclaimed once the segment is dropped
+    m_entries.remove(id);
+}
+
+bool NetworkResponseStore::contains(quint64 id) const
+{
+    return m_entries.contains(id);
+}
+
+QByteArray NetworkResponseStore::response(quint64 id) const
+{
+    const auto it = m_entries.constFind(id);
+    if (it == m_entries.constEnd())
+        return QByteArray();
+
+    const auto &segment = m_segments[it.value().segment - m_firstSegment];
+    if (!segment.file)
+        return segment.buffer.mid(it.value().offset, it.value().size);
+
+    if (!segment.file->seek(it.value().offset))
+        return QByteArray();
+    return segment.file->read(it.value().size);
+}
+
+void NetworkResponseStore::clear()
+{
+    m_firstSegment += m_segments.size();
+    m_segments.clear();
+    m_entries.clear();
+    m_size = 0;
+}
+
+void NetworkResponseStore::appendSegment()
+{
+    Segment segment;
+    segment.file.reset(new QTemporaryFile(QDir::tempPath() + QLatin1String("/gammaray-network-XXXXXX")));
+    if (!segment.file->open())
+        segment.file.reset();
+    m_segments.push_back(std::move(segment));
+}
+
+void NetworkResponseStore::dropOldestSegment()
+{
+    auto &segment = m_segments.front();
+    for (const auto id : qAsConst(segment.ids)) {
+        // a newer body for the same reply might live in a later segment
+        const auto it = m_entries.find(id);
+        if (it != m_entries.end() && it.value().segment == m_firstSegment)
+            m_entries.erase(it);
+    }
+    m_size -= segment.size;
+    m_segments.pop_front();
+    ++m_firstSegment;
+}
+
+void NetworkResponseStore::enforceBudget()
+{
+    while (m_size > m_byteBudget && !m_segments.empty())
+        dropOldestSegment();
+}
@@ -0,0 +1,83 @@
+/*
+  networkresponsestore.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_NETWORKRESPONSESTORE_H
+#define GAMMARAY_NETWORKRESPONSESTORE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include <deque>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+class QTemporaryFile;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+
+/** Bounded storage for captured network response bodies.
+ *  Bodies are appended to a sequence of segments which are spilled to temporary
+ *  files, or kept in memory if that is not possible. When the byte budget is
+ *  exceeded, the oldest segment is dropped together with all bodies in it.
+ */
+class NetworkResponseStore
+{
+public:
+    explicit NetworkResponseStore(qint64 byteBudget = 256 * 1024 * 1024, qint64 segmentSize = 16 * 1024 * 1024);
+    ~NetworkResponseStore();
+
+    qint64 byteBudget() const;
+    void setByteBudget(qint64 byteBudget);
+    /** Bytes currently occupied by the store, including superseded bodies. */
+    qint64 size() const;
+
+    /** Stores @p response for reply @p id, replacing any previous one. */
+    void insert(quint64 id, const QByteArray &response);
+    void remove(quint64 id);
+    bool contains(quint64 id) const;
+    QByteArray response(quint64 id) const;
+    void clear();
+
+private:
+    Q_DISABLE_COPY(NetworkResponseStore)
+
+    struct Segment
+    {
+        std::unique_ptr<QTemporaryFile> file;
+        QByteArray buffer; // used if we couldn't create a temporary file
+        qint64 size = 0;
+        QVector<quint64> ids;
+    };
+
+    struct Entry
+    {
+        quint64 segment;
+        qint64 offset;
+        qint64 size;
+    };
+
+    void appendSegment();
+    void dropOldestSegment();
+    void enforceBudget();
+
+    std::deque<Segment> m_segments;
+    quint64 m_firstSegment = 0; // sequence number of m_segments.front()
+    QHash<quint64, Entry> m_entries;
+    qint64 m_byteBudget;
+    qint64 m_segmentSize;
+    qint64 m_size = 0;
+};
+}
+
+#endif // GAMMARAY_NETWORKRESPONSESTORE_H
@@ -23,6 +23,7 @@
 #include <core/metaenum.h>
 #include <core/metaobject.h>
 #include <core/metaobjectrepository.h>
+#include <core/probesettings.h>
 #include <core/propertycontroller.h>
 #include <core/remote/serverproxymodel.h>
 #include <core/varianthandler.h>
@@ -114,16 +115,25 @@ NetworkSupport::NetworkSupport(Probe *probe, QObject *parent)
     probe->registerModel(QStringLiteral("com.kdab.GammaRay.NetworkConfigurationModel"), configProxy);
 #endif
 
-    auto replyModel = new NetworkReplyModel(this);
-    connect(this, &NetworkSupportInterface::captureResponseChanged, replyModel, &NetworkReplyModel::setCaptureResponse);
-    connect(probe, &Probe::objectCreated, replyModel, &NetworkReplyModel::objectCreated);
-    probe->registerModel(QStringLiteral("com.kdab.GammaRay.NetworkReplyModel"), replyModel);
+    m_replyModel = new NetworkReplyModel(this);
+    // retention of finished replies: count and age in seconds (0 for no limit), size of captured responses in KiB
+    m_replyModel->setMaxReplyCount(ProbeSettings::value(QStringLiteral("NetworkReplyCount"), 10000).toInt());
+    m_replyModel->setMaxReplyAge(ProbeSettings::value(QStringLiteral("NetworkReplyAge"), 0).toLongLong() * 1000);
+    m_replyModel->setMaxResponseBytes(ProbeSettings::value(QStringLiteral("NetworkResponseStoreSize"), 256 * 1024).toLongLong() * 1024);
+    connect(this, &NetworkSupportInterface::captureResponseChanged, m_replyModel, &NetworkReplyModel::setCaptureResponse);
+    connect(probe, &Probe::objectCreated, m_replyModel, &NetworkReplyModel::objectCreated);
+    probe->registerModel(QStringLiteral("com.kdab.GammaRay.NetworkReplyModel"), m_replyModel);
 
     PropertyController::registerExtension<CookieExtension>();
 }
 
 NetworkSupport::~NetworkSupport() = default;
 
+void NetworkSupport::requestResponse(quint64 replyId)
+{
+    emit responseAvailable(replyId, m_replyModel->response(replyId));
+}
+
 void NetworkSupport::registerMetaTypes()
 {
     MetaObject *mo = nullptr;
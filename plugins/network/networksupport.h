@@ -19,6 +19,8 @@
 #include <core/toolfactory.h>
 
 namespace GammaRay {
+class NetworkReplyModel;
+
 class NetworkSupport : public NetworkSupportInterface
 {
     Q_OBJECT
@@ -26,9 +28,14 @@ public:
     explicit NetworkSupport(Probe *probe, QObject *parent = nullptr);
     ~NetworkSupport() override;
 
+public slots:
+    void requestResponse(quint64 replyId) override;
+
 private:
     static void registerMetaTypes();
     static void registerVariantHandler();
+
+    NetworkReplyModel *m_replyModel;
 };
 
 class NetworkSupportFactory : public QObject, public StandardToolFactory<QObject, NetworkSupport>
@@ -13,6 +13,8 @@
 
 #include "networksupportclient.h"
 
+#include <common/endpoint.h>
+
 namespace GammaRay {
 NetworkSupportClient::NetworkSupportClient(QObject *parent)
     : NetworkSupportInterface(parent)
@@ -20,4 +22,9 @@ NetworkSupportClient::NetworkSupportClient(QObject *parent)
 }
 
 NetworkSupportClient::~NetworkSupportClient() = default;
+
+void NetworkSupportClient::requestResponse(quint64 replyId)
+{
+    Endpoint::instance()->invokeObject(objectName(), "requestResponse", QVariantList() << replyId);
+}
 }
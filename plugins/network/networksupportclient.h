@@ -24,6 +24,9 @@ class NetworkSupportClient : public NetworkSupportInterface
 public:
     explicit NetworkSupportClient(QObject *parent = nullptr);
     ~NetworkSupportClient() override;
+
+public slots:
+    void requestResponse(quint64 replyId) override;
 };
 }
 
@@ -25,8 +25,15 @@ public:
     explicit NetworkSupportInterface(QObject *parent = nullptr);
     ~NetworkSupportInterface() override;
 
+public slots:
+    /** Requests the captured response of the reply with the given NetworkReplyModelRole::ReplyIdRole value.
+     *  The result is delivered by the responseAvailable() signal.
+     */
+    virtual void requestResponse(quint64 replyId) = 0;
+
 signals:
     void captureResponseChanged(bool captureResponse);
+    void responseAvailable(quint64 replyId, const QByteArray &response);
 
 private:
     bool m_captureResponse = false;
@@ -15,6 +15,7 @@
 
 #include <core/propertycontroller.h>
 #include <core/util.h>
+#include <compat/qasconst.h>
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #include <Qt3DCore/QAttribute>
@@ -32,15 +33,24 @@ namespace Qt3DGeometry = Qt3DRender;
 #include <Qt3DRender/QGeometryRenderer>
 #include <Qt3DCore/QEntity>
 
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QTimer>
 
 using namespace GammaRay;
 
+// large enough to not be dominated by message overhead, small enough to not stall the connection
+static const int BufferChunkSize = 1024 * 1024;
+
 Qt3DGeometryExtension::Qt3DGeometryExtension(GammaRay::PropertyController *controller)
     : Qt3DGeometryExtensionInterface(controller->objectBaseName() + ".qt3dGeometry", controller)
     , PropertyControllerExtension(controller->objectBaseName() + ".qt3dGeometry")
     , m_geometry(nullptr)
+    , m_transferTimer(new QTimer(this))
 {
+    // one chunk per event loop iteration, so other messages can get through in between
+    m_transferTimer->setInterval(0);
+    connect(m_transferTimer, &QTimer::timeout, this, &Qt3DGeometryExtension::sendBufferChunk);
 }
 
 Qt3DGeometryExtension::~Qt3DGeometryExtension()
@@ -80,6 +90,7 @@ bool Qt3DGeometryExtension::setQObject(QObject *object)
 void Qt3DGeometryExtension::updateGeometryData()
 {
     Qt3DGeometryData data;
+    m_bufferData.clear();
     if (!m_geometry || !m_geometry->geometry()) {
         setGeometryData(data);
         return;
@@ -104,9 +115,13 @@ void Qt3DGeometryExtension::updateGeometryData()
         if (bufferIt != bufferMap.constEnd()) {
             attrData.bufferIndex = bufferIt.value();
         } else {
+            // only the content hash is sent along, the client fetches unknown content separately
+            const auto content = attr->buffer()->data();
             Qt3DGeometryBufferData buffer;
             buffer.name = Util::displayString(attr->buffer());
-            buffer.data = attr->buffer()->data();
+            buffer.hash = bufferHash(attr->buffer(), content);
+            buffer.size = content.size();
+            m_bufferData.insert(buffer.hash, content);
 
             attrData.bufferIndex = data.buffers.size();
             bufferMap.insert(attr->buffer(), attrData.bufferIndex);
@@ -117,3 +132,66 @@ void Qt3DGeometryExtension::updateGeometryData()
 
     setGeometryData(data);
 }
+
+QByteArray Qt3DGeometryExtension::bufferHash(Qt3DGeometry::QBuffer *buffer, const QByteArray &content)
+{
+    const auto it = m_bufferHashes.constFind(buffer);
+    if (it != m_bufferHashes.constEnd())
+        return it.value();
+
+    const auto hash = QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+    m_bufferHashes.insert(buffer, hash);
+    connect(buffer, &Qt3DGeometry::QBuffer::dataChanged, this, &Qt3DGeometryExtension::bufferChanged, Qt::UniqueConnection);
+    connect(buffer, &QObject::destroyed, this, &Qt3DGeometryExtension::bufferChanged, Qt::UniqueConnection);
+    return hash;
+}
+
+void Qt3DGeometryExtension::bufferChanged()
+{
+    // only used as a key, the object might already be partially destroyed here
+    m_bufferHashes.remove(static_cast<Qt3DGeometry::QBuffer *>(sender()));
+}
+
+QByteArray Qt3DGeometryExtension::bufferData(const QByteArray &hash) const
+{
+    return m_bufferData.value(hash);
+}
+
+void Qt3DGeometryExtension::requestBuffer(const QByteArray &hash)
+{
+    const auto it = m_bufferData.constFind(hash);
+    if (it == m_bufferData.constEnd()) {
+        // the geometry changed since the client asked, it would wait for this forever otherwise
+        emit bufferUnavailable(hash);
+        return;
+    }
+    for (auto &transfer : m_transfers) {
+        if (transfer.hash == hash) {
+            // the client dropped what it had received so far, start over
+            transfer.offset = 0;
+            return;
+        }
+    }
+
+    BufferTransfer transfer;
+    transfer.hash = hash;
+    transfer.data = it.value();
+    transfer.offset = 0;
+    m_transfers.push_back(transfer);
+    m_transferTimer->start();
+}
+
+void Qt3DGeometryExtension::sendBufferChunk()
+{
+    if (m_transfers.isEmpty()) {
+        m_transferTimer->stop();
+        return;
+    }
+
+    auto &transfer = m_transfers.first();
+    const auto chunk = transfer.data.mid(transfer.offset, BufferChunkSize);
+    emit bufferDataChunk(transfer.hash, transfer.offset, transfer.data.size(), chunk);
+    transfer.offset += chunk.size();
+    if (transfer.offset >= uint(transfer.data.size()))
+        m_transfers.removeFirst();
+}
@@ -18,7 +18,11 @@
 
 #include <core/propertycontrollerextension.h>
 
+#include <QHash>
+#include <QVector>
+
 QT_BEGIN_NAMESPACE
+class QTimer;
 namespace Qt3DRender {
 class QGeometryRenderer;
 }
@@ -36,10 +40,31 @@ public:
 
     bool setQObject(QObject *object) override;
 
+    QByteArray bufferData(const QByteArray &hash) const override;
+
+public slots:
+    void requestBuffer(const QByteArray &hash) override;
+
 private:
     void updateGeometryData();
+    QByteArray bufferHash(Qt3DGeometry::QBuffer *buffer, const QByteArray &content);
+    void bufferChanged();
+    void sendBufferChunk();
+
+    struct BufferTransfer
+    {
+        QByteArray hash;
+        QByteArray data;
+        uint offset;
+    };
 
     Qt3DRender::QGeometryRenderer *m_geometry;
+    /// buffer contents of the current geometry, by content hash
+    QHash<QByteArray, QByteArray> m_bufferData;
+    /// content hashes, until the buffer content changes
+    QHash<Qt3DGeometry::QBuffer *, QByteArray> m_bufferHashes;
+    QVector<BufferTransfer> m_transfers;
+    QTimer *m_transferTimer;
 };
 }
 
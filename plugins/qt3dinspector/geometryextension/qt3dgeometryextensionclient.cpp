@@ -13,9 +13,122 @@
 
 #include "qt3dgeometryextensionclient.h"
 
+#include <common/endpoint.h>
+#include <compat/qasconst.h>
+
+#include <QCache>
+#include <QSet>
+
 using namespace GammaRay;
 
+// buffer contents by content hash, shared by all geometry views so that re-selecting an entity
+// or selecting one sharing a mesh with a previous one does not need to transfer the buffers again
+typedef QCache<QByteArray, QByteArray> BufferCache;
+Q_GLOBAL_STATIC_WITH_ARGS(BufferCache, s_bufferCache, (256 * 1024)) // cost is in KiB
+
+static int bufferCost(const QByteArray &data)
+{
+    return data.size() / 1024 + 1;
+}
+
 Qt3DGeometryExtensionClient::Qt3DGeometryExtensionClient(const QString &name, QObject *parent)
     : Qt3DGeometryExtensionInterface(name, parent)
 {
+    connect(this, &Qt3DGeometryExtensionInterface::geometryDataChanged, this, &Qt3DGeometryExtensionClient::updateBuffers);
+    connect(this, &Qt3DGeometryExtensionInterface::bufferDataChunk, this, &Qt3DGeometryExtensionClient::bufferChunkReceived);
+    connect(this, &Qt3DGeometryExtensionInterface::bufferUnavailable, this, &Qt3DGeometryExtensionClient::bufferUnavailableReceived);
+}
+
+QByteArray Qt3DGeometryExtensionClient::bufferData(const QByteArray &hash) const
+{
+    const auto it = m_buffers.constFind(hash);
+    if (it != m_buffers.constEnd())
+        return it.value();
+    if (const auto data = s_bufferCache()->object(hash))
+        return *data;
+    return QByteArray();
+}
+
+void Qt3DGeometryExtensionClient::requestBuffer(const QByteArray &hash)
+{
+    if (m_transfers.contains(hash) || !bufferData(hash).isNull())
+        return;
+    m_transfers.insert(hash, BufferTransfer { QByteArray(), 0 });
+    Endpoint::instance()->invokeObject(objectName(), "requestBuffer", QVariantList() << hash);
+}
+
+void Qt3DGeometryExtensionClient::updateBuffers()
+{
+    // hold on to what the current geometry needs, the cache might evict it otherwise
+    QHash<QByteArray, QByteArray> buffers;
+    QSet<QByteArray> hashes;
+    for (const auto &buffer : geometryData().buffers) {
+        hashes.insert(buffer.hash);
+        const auto data = bufferData(buffer.hash);
+        if (!data.isNull())
+            buffers.insert(buffer.hash, data);
+    }
+    m_buffers = buffers;
+
+    // the probe no longer has buffers of the previous geometry, so those transfers might never complete
+    bool dropped = false;
+    for (auto it = m_transfers.begin(); it != m_transfers.end();) {
+        if (hashes.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_transfers.erase(it);
+            dropped = true;
+        }
+    }
+    if (dropped)
+        updateTransferProgress();
+}
+
+void Qt3DGeometryExtensionClient::bufferChunkReceived(const QByteArray &hash, uint offset, uint size, const QByteArray &chunk)
+{
+    const auto it = m_transfers.find(hash);
+    if (it == m_transfers.end())
+        return;
+
+    auto &transfer = it.value();
+    if (offset == 0) {
+        transfer.data.clear();
+        transfer.data.reserve(size);
+        transfer.size = size;
+    }
+    if (offset != uint(transfer.data.size()) || size != transfer.size) { // out of sequence, start over
+        m_transfers.erase(it);
+        requestBuffer(hash);
+        return;
+    }
+    transfer.data.append(chunk);
+
+    const bool complete = uint(transfer.data.size()) >= transfer.size;
+    if (complete) {
+        const auto data = transfer.data;
+        m_transfers.erase(it);
+        m_buffers.insert(hash, data);
+        s_bufferCache()->insert(hash, new QByteArray(data), bufferCost(data));
+    }
+
+    updateTransferProgress();
+    if (complete)
+        emit bufferDataAvailable();
+}
+
+void Qt3DGeometryExtensionClient::bufferUnavailableReceived(const QByteArray &hash)
+{
+    if (m_transfers.remove(hash))
+        updateTransferProgress();
+}
+
+void Qt3DGeometryExtensionClient::updateTransferProgress()
+{
+    qint64 received = 0;
+    qint64 total = 0;
+    for (const auto &pending : qAsConst(m_transfers)) {
+        received += pending.data.size();
+        total += pending.size;
+    }
+    emit bufferTransferProgress(received, total);
 }
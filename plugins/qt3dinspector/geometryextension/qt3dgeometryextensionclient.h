@@ -16,6 +16,8 @@
 
 #include "qt3dgeometryextensioninterface.h"
 
+#include <QHash>
+
 namespace GammaRay {
 class Qt3DGeometryExtensionClient : public Qt3DGeometryExtensionInterface
 {
@@ -23,6 +25,26 @@ class Qt3DGeometryExtensionClient : public Qt3DGeometryExtensionInterface
     Q_INTERFACES(GammaRay::Qt3DGeometryExtensionInterface)
 public:
     explicit Qt3DGeometryExtensionClient(const QString &name, QObject *parent);
+
+    QByteArray bufferData(const QByteArray &hash) const override;
+
+public slots:
+    void requestBuffer(const QByteArray &hash) override;
+
+private:
+    void updateBuffers();
+    void bufferChunkReceived(const QByteArray &hash, uint offset, uint size, const QByteArray &chunk);
+    void bufferUnavailableReceived(const QByteArray &hash);
+    void updateTransferProgress();
+
+    struct BufferTransfer
+    {
+        QByteArray data;
+        uint size;
+    };
+    QHash<QByteArray, BufferTransfer> m_transfers;
+    /// buffer contents of the current geometry, kept independent of the cache
+    QHash<QByteArray, QByteArray> m_buffers;
 };
 }
 
@@ -62,20 +62,20 @@ bool Qt3DGeometryAttributeData::operator==(const Qt3DGeometryAttributeData &rhs)
 QT_BEGIN_NAMESPACE
 QDataStream &operator<<(QDataStream &out, const Qt3DGeometryBufferData &data)
 {
-    out << data.name << data.data;
+    out << data.name << data.hash << data.size << data.data;
     return out;
 }
 
 QDataStream &operator>>(QDataStream &in, Qt3DGeometryBufferData &data)
 {
-    in >> data.name >> data.data;
+    in >> data.name >> data.hash >> data.size >> data.data;
     return in;
 }
 QT_END_NAMESPACE
 
 bool Qt3DGeometryBufferData::operator==(const Qt3DGeometryBufferData &rhs) const
 {
-    return name == rhs.name && data == rhs.data;
+    return name == rhs.name && hash == rhs.hash && size == rhs.size && data == rhs.data;
 }
 
 QT_BEGIN_NAMESPACE
@@ -49,6 +49,10 @@ struct Qt3DGeometryBufferData
     bool operator==(const Qt3DGeometryBufferData &rhs) const;
 
     QString name;
+    /** Content hash, identifying the buffer content independent of the buffer object. */
+    QByteArray hash;
+    uint size = 0;
+    /** Buffer content, not transferred as part of the geometry data, see Qt3DGeometryExtensionInterface::bufferData(). */
     QByteArray data;
 };
 
@@ -72,8 +76,25 @@ public:
     Qt3DGeometryData geometryData() const;
     void setGeometryData(const Qt3DGeometryData &data);
 
+    /** Content of the buffer with content hash @p hash, if available locally.
+     *  Returns a null byte array otherwise, use requestBuffer() to fetch it.
+     */
+    virtual QByteArray bufferData(const QByteArray &hash) const = 0;
+
+public slots:
+    /** Requests the content of the buffer with content hash @p hash, which is then streamed in chunks. */
+    virtual void requestBuffer(const QByteArray &hash) = 0;
+
 signals:
     void geometryDataChanged();
+    /** @p chunk starting at @p offset of the requested buffer with content hash @p hash and a total of @p size bytes. */
+    void bufferDataChunk(const QByteArray &hash, uint offset, uint size, const QByteArray &chunk);
+    /** The requested buffer with content hash @p hash is no longer part of the current geometry, and won't be sent. */
+    void bufferUnavailable(const QByteArray &hash);
+    /** Progress of all pending buffer transfers, in bytes. */
+    void bufferTransferProgress(qint64 received, qint64 total);
+    /** A requested buffer has been received completely and is available via bufferData(). */
+    void bufferDataAvailable();
 
 private:
     Qt3DGeometryData m_data;
@@ -66,6 +66,7 @@ namespace Qt3DGeometry = Qt3DRender;
 
 #include <QDebug>
 #include <QOpenGLContext>
+#include <QProgressBar>
 #include <QUrl>
 #include <QToolBar>
 #include <QWindow>
@@ -118,6 +119,11 @@ Qt3DGeometryTab::Qt3DGeometryTab(PropertyWidget *parent)
     m_shadingModeCombo = new QComboBox(toolbar);
     m_shadingModeCombo->setSizeAdjustPolicy(QComboBox::AdjustToContents);
     auto shadingModeAction = toolbar->addWidget(m_shadingModeCombo);
+    m_transferProgress = new QProgressBar(this);
+    m_transferProgress->setRange(0, 100);
+    m_transferProgress->setFormat(tr("Transferring buffers: %p%"));
+    m_transferProgress->hide();
+    ui->topLayout->insertWidget(1, m_transferProgress);
 
     connect(ui->actionResetCam, &QAction::triggered, this, &Qt3DGeometryTab::resetCamera);
 
@@ -182,6 +188,13 @@ Qt3DGeometryTab::Qt3DGeometryTab(PropertyWidget *parent)
         parent->objectBaseName() + ".qt3dGeometry");
     connect(m_interface, &Qt3DGeometryExtensionInterface::geometryDataChanged, this,
             &Qt3DGeometryTab::updateGeometry);
+    connect(m_interface, &Qt3DGeometryExtensionInterface::bufferDataAvailable, this,
+            &Qt3DGeometryTab::updateGeometry);
+    connect(m_interface, &Qt3DGeometryExtensionInterface::bufferTransferProgress, this,
+            [this](qint64 received, qint64 total) {
+                if (total > 0)
+                    m_transferProgress->setValue(int(received * 100 / total));
+            });
 }
 
 Qt3DGeometryTab::~Qt3DGeometryTab() = default;
@@ -467,7 +480,22 @@ void Qt3DGeometryTab::updateGeometry()
     if (!m_geometryRenderer)
         return;
 
-    const auto geo = m_interface->geometryData();
+    // buffer contents are transferred separately, and only if they are not available locally already
+    auto geo = m_interface->geometryData();
+    bool complete = true;
+    for (auto &bufferData : geo.buffers) {
+        if (!bufferData.data.isEmpty() || bufferData.size == 0)
+            continue;
+        bufferData.data = m_interface->bufferData(bufferData.hash);
+        if (bufferData.data.isNull()) {
+            complete = false;
+            m_interface->requestBuffer(bufferData.hash);
+        }
+    }
+    m_transferProgress->setVisible(!complete);
+    if (!complete)
+        return;
+
     m_bufferModel->setGeometryData(geo);
 
     auto geometry = new Qt3DGeometry::QGeometry();
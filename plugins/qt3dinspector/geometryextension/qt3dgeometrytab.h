@@ -37,6 +37,7 @@ class QPickEvent;
 class QRenderPass;
 }
 class QComboBox;
+class QProgressBar;
 class QSurfaceFormat;
 QT_END_NAMESPACE
 
@@ -75,6 +76,7 @@ private:
 
     std::unique_ptr<Ui::Qt3DGeometryTab> ui;
     QComboBox *m_shadingModeCombo;
+    QProgressBar *m_transferProgress;
     Qt3DGeometryExtensionInterface *m_interface;
 
     QWindow *m_surface;
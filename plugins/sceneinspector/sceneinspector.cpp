@@ -14,6 +14,7 @@
 #include "sceneinspector.h"
 
 #include "scenemodel.h"
+#include "scenetilecache.h"
 #include "paintanalyzerextension.h"
 
 #include <core/metaenum.h>
@@ -63,6 +64,7 @@ SceneInspector::SceneInspector(Probe *probe, QObject *parent)
     : SceneInspectorInterface(parent)
     , m_propertyController(new PropertyController(QStringLiteral("com.kdab.GammaRay.SceneInspector"),
                                                   this))
+    , m_tileCache(new SceneTileCache(this))
     , m_clientConnected(false)
 {
     Server::instance()->registerMonitorNotifier(Endpoint::instance()->objectAddress(
@@ -112,6 +114,8 @@ void SceneInspector::sceneSelected(const QItemSelection &selection)
         disconnect(m_sceneModel->scene(), nullptr, this, nullptr);
 
     m_sceneModel->setScene(scene);
+    m_tileCache->setScene(scene);
+    m_sentTiles.clear();
     connectToScene();
 }
 
@@ -136,6 +140,9 @@ void SceneInspector::initializeGui()
         return;
     }
 
+    // a new view on the client, which has no tiles yet
+    m_sentTiles.clear();
+
     QGraphicsScene *scene = m_sceneModel->scene();
     if (!scene)
         return;
@@ -146,6 +153,7 @@ void SceneInspector::initializeGui()
 void SceneInspector::clientConnectedChanged(bool clientConnected)
 {
     m_clientConnected = clientConnected;
+    m_sentTiles.clear();
     connectToScene();
 }
 
@@ -160,6 +168,47 @@ void SceneInspector::renderScene(const QTransform &transform, const QSize &size)
     if (!scene)
         return;
 
+    if (!isTileable(transform)) {
+        renderView(scene, transform, size);
+        return;
+    }
+
+    QGraphicsItem *currentItem = m_itemSelectionModel->currentIndex().data(SceneModel::SceneItemRole).value<QGraphicsItem *>();
+    m_tileCache->setDecoratedItem(currentItem);
+
+    // the client drops its tiles on zoom changes, and those far away from the viewport
+    const auto zoom = tileZoom(transform);
+    const auto visible = visibleTiles(transform, size);
+    if (zoom != m_clientZoom) {
+        m_clientZoom = zoom;
+        m_sentTiles.clear();
+    } else {
+        const auto retained = visible.adjusted(-TileRetainMargin, -TileRetainMargin, TileRetainMargin, TileRetainMargin);
+        for (auto it = m_sentTiles.begin(); it != m_sentTiles.end();) {
+            if (retained.contains(it.key().first, it.key().second))
+                ++it;
+            else
+                it = m_sentTiles.erase(it);
+        }
+    }
+
+    // only send what the client doesn't have yet, or what changed since
+    for (int y = visible.top(); y <= visible.bottom(); ++y) {
+        for (int x = visible.left(); x <= visible.right(); ++x) {
+            const auto tile = m_tileCache->tile(zoom, QPoint(x, y));
+            auto &sentKey = m_sentTiles[qMakePair(x, y)];
+            if (sentKey == tile.cacheKey())
+                continue;
+            sentKey = tile.cacheKey();
+            emit sceneTileRendered(zoom, QPoint(x, y), tile);
+        }
+    }
+
+    m_tileCache->prefetch(transform, size);
+}
+
+void SceneInspector::renderView(QGraphicsScene *scene, const QTransform &transform, const QSize &size)
+{
     // initialize transparent pixmap
     QPixmap view(size);
     view.fill(Qt::transparent);
@@ -188,8 +237,9 @@ void SceneInspector::sceneItemSelectionChanged(const QItemSelection &selection)
     if (!selection.isEmpty())
         index = selection.first().topLeft();
 
-    if (index.isValid()) {
-        QGraphicsItem *item = index.data(SceneModel::SceneItemRole).value<QGraphicsItem *>();
+    // null if the item got deleted and the model didn't notice yet
+    QGraphicsItem *item = index.isValid() ? index.data(SceneModel::SceneItemRole).value<QGraphicsItem *>() : nullptr;
+    if (item) {
         QGraphicsObject *obj = item->toGraphicsObject();
         if (obj)
             m_propertyController->setObject(obj);
@@ -18,6 +18,9 @@
 #include "sceneinspectorinterface.h"
 
 #include <QGraphicsScene>
+#include <QHash>
+#include <QPair>
+#include <QTransform>
 
 QT_BEGIN_NAMESPACE
 class QItemSelectionModel;
@@ -28,6 +31,7 @@ QT_END_NAMESPACE
 namespace GammaRay {
 class PropertyController;
 class SceneModel;
+class SceneTileCache;
 
 class SceneInspector : public SceneInspectorInterface
 {
@@ -54,11 +58,16 @@ private:
     static void registerGraphicsViewMetaTypes();
     static void registerVariantHandlers();
     void connectToScene();
+    void renderView(QGraphicsScene *scene, const QTransform &transform, const QSize &size);
 
 private:
     SceneModel *m_sceneModel;
     QItemSelectionModel *m_itemSelectionModel;
     PropertyController *m_propertyController;
+    SceneTileCache *m_tileCache;
+    // tiles the client has for m_clientZoom, with the cache key of the sent pixmap
+    QHash<QPair<int, int>, qint64> m_sentTiles;
+    QTransform m_clientZoom;
     bool m_clientConnected;
 };
 
@@ -17,9 +17,17 @@
 
 #include <QGraphicsItem>
 #include <QPainter>
+#include <QRect>
+
+#include <cmath>
 
 using namespace GammaRay;
 
+static int tileIndex(int coord)
+{
+    return static_cast<int>(std::floor(coord / double(SceneInspectorInterface::TileSize)));
+}
+
 SceneInspectorInterface::SceneInspectorInterface(QObject *parent)
     : QObject(parent)
 {
@@ -28,29 +36,84 @@ SceneInspectorInterface::SceneInspectorInterface(QObject *parent)
 
 SceneInspectorInterface::~SceneInspectorInterface() = default;
 
-void SceneInspectorInterface::paintItemDecoration(QGraphicsItem *item, const QTransform &transform,
-                                                  QPainter *painter)
+bool SceneInspectorInterface::ItemDecoration::isNull() const
+{
+    return boundingBox.isEmpty();
+}
+
+QRectF SceneInspectorInterface::ItemDecoration::boundingRect() const
 {
+    if (isNull())
+        return QRectF();
+    return QRectF(xAxis.p1(), xAxis.p2()).normalized()
+        .united(QRectF(yAxis.p1(), yAxis.p2()).normalized())
+        .united(boundingBox.boundingRect())
+        .united(shape.boundingRect());
+}
+
+SceneInspectorInterface::ItemDecoration SceneInspectorInterface::itemDecoration(QGraphicsItem *item)
+{
+    ItemDecoration decoration;
     const QRectF itemBoundingRect = item->boundingRect();
     // coord system, TODO: nicer axis with arrows, tics, markers for current mouse position etc.
-    painter->setPen(Qt::black);
     const qreal maxX = qMax(qAbs(itemBoundingRect.left()), qAbs(itemBoundingRect.right()));
     const qreal maxY = qMax(qAbs(itemBoundingRect.top()), qAbs(itemBoundingRect.bottom()));
     const qreal maxXY = qMax(maxX, maxY) * 1.5f;
-    painter->drawLine(item->mapToScene(-maxXY, 0), item->mapToScene(maxXY, 0));
-    painter->drawLine(item->mapToScene(0, -maxXY), item->mapToScene(0, maxXY));
+    decoration.xAxis = QLineF(item->mapToScene(-maxXY, 0), item->mapToScene(maxXY, 0));
+    decoration.yAxis = QLineF(item->mapToScene(0, -maxXY), item->mapToScene(0, maxXY));
+    decoration.boundingBox = item->mapToScene(itemBoundingRect);
+    decoration.shape = item->mapToScene(item->shape());
+    decoration.transformOrigin = item->mapToScene(item->transformOriginPoint());
+    return decoration;
+}
+
+void SceneInspectorInterface::paintItemDecoration(const ItemDecoration &decoration, const QTransform &transform,
+                                                  QPainter *painter)
+{
+    if (decoration.isNull())
+        return;
+
+    painter->setPen(Qt::black);
+    painter->drawLine(decoration.xAxis);
+    painter->drawLine(decoration.yAxis);
 
     painter->setPen(Qt::blue);
-    const QPolygonF boundingBox = item->mapToScene(itemBoundingRect);
-    painter->drawPolygon(boundingBox);
+    painter->drawPolygon(decoration.boundingBox);
 
     painter->setPen(Qt::green);
-    const QPainterPath shape = item->mapToScene(item->shape());
-    painter->drawPath(shape);
+    painter->drawPath(decoration.shape);
 
     painter->setPen(Qt::red);
-    const QPointF transformOrigin = item->mapToScene(item->transformOriginPoint());
-    painter->drawEllipse(transformOrigin,
+    painter->drawEllipse(decoration.transformOrigin,
                          5.0 / transform.m11(),
                          5.0 / transform.m22());
 }
+
+void SceneInspectorInterface::paintItemDecoration(QGraphicsItem *item, const QTransform &transform,
+                                                  QPainter *painter)
+{
+    paintItemDecoration(itemDecoration(item), transform, painter);
+}
+
+QTransform SceneInspectorInterface::tileZoom(const QTransform &transform)
+{
+    return QTransform(transform.m11(), transform.m12(), transform.m13(),
+                      transform.m21(), transform.m22(), transform.m23(),
+                      0, 0, transform.m33());
+}
+
+bool SceneInspectorInterface::isTileable(const QTransform &transform)
+{
+    return transform.isAffine() && transform.isInvertible();
+}
+
+QRect SceneInspectorInterface::visibleTiles(const QTransform &transform, const QSize &size)
+{
+    if (size.isEmpty())
+        return QRect();
+    // the viewport in the coordinate system of tileZoom()
+    const int left = -qRound(transform.dx());
+    const int top = -qRound(transform.dy());
+    return QRect(QPoint(tileIndex(left), tileIndex(top)),
+                 QPoint(tileIndex(left + size.width() - 1), tileIndex(top + size.height() - 1)));
+}
@@ -14,7 +14,10 @@
 #ifndef GAMMARAY_SCENEINSPECTOR_SCENEINSPECTORINTERFACE_H
 #define GAMMARAY_SCENEINSPECTOR_SCENEINSPECTORINTERFACE_H
 
+#include <QLineF>
 #include <QObject>
+#include <QPainterPath>
+#include <QPolygonF>
 
 QT_BEGIN_NAMESPACE
 class QPainter;
@@ -23,7 +26,8 @@ class QSize;
 class QTransform;
 class QRectF;
 class QPixmap;
-class QPointF;
+class QPoint;
+class QRect;
 QT_END_NAMESPACE
 
 namespace GammaRay {
@@ -31,15 +35,53 @@ class SceneInspectorInterface : public QObject
 {
     Q_OBJECT
 public:
+    enum
+    {
+        /** Edge length of the tiles the scene is transferred in, in device pixels. */
+        TileSize = 256,
+        /** Number of tiles around the viewport the client keeps when scrolling. */
+        TileRetainMargin = 2
+    };
+
     explicit SceneInspectorInterface(QObject *parent = nullptr);
     ~SceneInspectorInterface() override;
 
     virtual void initializeGui() = 0;
 
+    /** Geometry of the decoration of an item, in scene coordinates. */
+    struct ItemDecoration
+    {
+        bool isNull() const;
+        /** Area covered by the decoration, except for the transform origin marker. */
+        QRectF boundingRect() const;
+
+        QLineF xAxis;
+        QLineF yAxis;
+        QPolygonF boundingBox;
+        QPainterPath shape;
+        QPointF transformOrigin;
+    };
+
+    static ItemDecoration itemDecoration(QGraphicsItem *item);
+    static void paintItemDecoration(const ItemDecoration &decoration, const QTransform &transform,
+                                    QPainter *painter);
     static void paintItemDecoration(QGraphicsItem *item, const QTransform &transform,
                                     QPainter *painter);
 
+    /** The part of the view @p transform tiles depend on, i.e. without translation. */
+    static QTransform tileZoom(const QTransform &transform);
+    /** Whether @p transform can be rendered in tiles, which is not the case for perspective transforms. */
+    static bool isTileable(const QTransform &transform);
+    /** The tiles visible in a viewport of @p size for the view @p transform, in tile coordinates. */
+    static QRect visibleTiles(const QTransform &transform, const QSize &size);
+
 public slots:
+    /**
+     * Requests the scene content visible in a viewport of @p size for the view @p transform.
+     * For affine transforms, this is answered by sceneTileRendered() for all visible tiles that
+     * changed since they were last sent for the current zoom level and are still near the
+     * viewport. Otherwise by sceneRendered() with the entire viewport.
+     */
     virtual void renderScene(const QTransform &transform, const QSize &size) = 0;
     virtual void sceneClicked(const QPointF &pos) = 0;
 
@@ -47,6 +89,8 @@ signals:
     void sceneRectChanged(const QRectF &rect);
     void sceneChanged();
     void sceneRendered(const QPixmap &view);
+    /** Tile @p pos of the scene at @p zoom, see renderScene(). */
+    void sceneTileRendered(const QTransform &zoom, const QPoint &pos, const QPixmap &tile);
     void itemSelected(const QRectF &boundingRect);
 };
 }
@@ -30,6 +30,7 @@
 #include <QScrollBar>
 #include <QMenu>
 #include <QMouseEvent>
+#include <QPainter>
 #include <QDebug>
 #include <QTimer>
 
@@ -51,6 +52,7 @@ SceneInspectorWidget::SceneInspectorWidget(QWidget *parent)
     , m_scene(new QGraphicsScene(this))
     , m_pixmap(new QGraphicsPixmapItem)
     , m_updateTimer(new QTimer(this))
+    , m_composePending(false)
 {
     ObjectBroker::registerClientObjectFactoryCallback<SceneInspectorInterface *>(
         createClientSceneInspector);
@@ -84,6 +86,8 @@ SceneInspectorWidget::SceneInspectorWidget(QWidget *parent)
             this, &SceneInspectorWidget::sceneChanged);
     connect(m_interface, &SceneInspectorInterface::sceneRendered,
             this, &SceneInspectorWidget::sceneRendered);
+    connect(m_interface, &SceneInspectorInterface::sceneTileRendered,
+            this, &SceneInspectorWidget::sceneTileRendered);
     connect(m_interface, &SceneInspectorInterface::itemSelected,
             this, &SceneInspectorWidget::itemSelected);
 
@@ -166,18 +170,84 @@ void SceneInspectorWidget::requestSceneUpdate()
         return;
     }
 
-    m_interface->renderScene(ui->graphicsSceneView->view()->viewportTransform(),
-                             ui->graphicsSceneView->view()->viewport()->rect().size());
+    const auto transform = ui->graphicsSceneView->view()->viewportTransform();
+    const auto size = ui->graphicsSceneView->view()->viewport()->rect().size();
+
+    // the probe assumes we drop tiles exactly like this, so it knows what to send again
+    if (SceneInspectorInterface::isTileable(transform)) {
+        const auto zoom = SceneInspectorInterface::tileZoom(transform);
+        if (zoom != m_tileZoom) {
+            m_tileZoom = zoom;
+            m_tiles.clear();
+        } else {
+            const int margin = SceneInspectorInterface::TileRetainMargin;
+            const auto retained = SceneInspectorInterface::visibleTiles(transform, size).adjusted(-margin, -margin, margin, margin);
+            for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+                if (retained.contains(it.key().first, it.key().second))
+                    ++it;
+                else
+                    it = m_tiles.erase(it);
+            }
+        }
+    }
+
+    m_interface->renderScene(transform, size);
 }
 
 void SceneInspectorWidget::sceneRendered(const QPixmap &view)
 {
     m_pixmap->setPixmap(view);
+    m_pixmap->setPos(ui->graphicsSceneView->view()->mapToScene(0, 0));
+}
+
+void SceneInspectorWidget::sceneTileRendered(const QTransform &zoom, const QPoint &pos, const QPixmap &tile)
+{
+    if (zoom != m_tileZoom)
+        return; // outdated
+
+    m_tiles.insert(qMakePair(pos.x(), pos.y()), tile);
+    // tiles come in bursts, compose them once
+    if (!m_composePending) {
+        m_composePending = true;
+        QMetaObject::invokeMethod(this, "composeTiles", Qt::QueuedConnection);
+    }
+}
+
+void SceneInspectorWidget::composeTiles()
+{
+    m_composePending = false;
+
+    const auto view = ui->graphicsSceneView->view();
+    const auto transform = view->viewportTransform();
+    if (m_tiles.isEmpty() || !SceneInspectorInterface::isTileable(transform)
+        || SceneInspectorInterface::tileZoom(transform) != m_tileZoom)
+        return; // wait for the tiles of the new zoom level
+
+    const auto size = view->viewport()->rect().size();
+    const auto visible = SceneInspectorInterface::visibleTiles(transform, size);
+    const QPoint offset(qRound(transform.dx()), qRound(transform.dy()));
+
+    QPixmap pixmap(size);
+    pixmap.fill(Qt::transparent);
+    QPainter painter(&pixmap);
+    for (auto it = m_tiles.constBegin(); it != m_tiles.constEnd(); ++it) {
+        const QPoint pos(it.key().first, it.key().second);
+        if (visible.contains(pos))
+            painter.drawPixmap(pos * SceneInspectorInterface::TileSize + offset, it.value());
+    }
+    painter.end();
+
+    m_pixmap->setPixmap(pixmap);
+    m_pixmap->setPos(view->mapToScene(0, 0));
 }
 
 void SceneInspectorWidget::visibleSceneRectChanged()
 {
-    m_pixmap->setPos(ui->graphicsSceneView->view()->mapToScene(0, 0));
+    // show what we already have right away when scrolling, the rest follows from the probe
+    if (Endpoint::instance()->isRemoteClient())
+        composeTiles();
+    else
+        m_pixmap->setPos(ui->graphicsSceneView->view()->mapToScene(0, 0));
     sceneChanged();
 }
 
@@ -16,6 +16,11 @@
 
 #include <ui/uistatemanager.h>
 #include <ui/tooluifactory.h>
+
+#include <QHash>
+#include <QPair>
+#include <QPixmap>
+#include <QTransform>
 #include <QWidget>
 
 QT_BEGIN_NAMESPACE
@@ -45,6 +50,8 @@ private slots:
     void sceneChanged();
     void requestSceneUpdate();
     void sceneRendered(const QPixmap &view);
+    void sceneTileRendered(const QTransform &zoom, const QPoint &pos, const QPixmap &tile);
+    void composeTiles();
     void visibleSceneRectChanged();
     void itemSelected(const QRectF &boundingRect);
     void sceneContextMenu(QPoint pos);
@@ -59,6 +66,10 @@ private:
     QGraphicsScene *m_scene;
     QGraphicsPixmapItem *m_pixmap;
     QTimer *m_updateTimer;
+    // tiles received for m_tileZoom, see SceneInspectorInterface::renderScene
+    QHash<QPair<int, int>, QPixmap> m_tiles;
+    QTransform m_tileZoom;
+    bool m_composePending;
 };
 
 class SceneInspectorUiFactory : public QObject, public StandardToolUiFactory<SceneInspectorWidget>
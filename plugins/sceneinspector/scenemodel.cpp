@@ -16,10 +16,16 @@
 #include <common/objectmodel.h>
 #include <common/objectid.h>
 
+#include <compat/qasconst.h>
+
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QGraphicsItem>
 #include <QGraphicsScene>
 #include <QPalette>
+#include <QTimer>
+
+#include <algorithm>
 
 using namespace GammaRay;
 
@@ -29,9 +35,13 @@ using namespace GammaRay;
         m_typeNames.insert(t.type(), QStringLiteral(#Type)); \
     }
 
+// lower and upper bound for the delay of updating the item hierarchy after a scene change
+static const int MinUpdateInterval = 100;
+static const int MaxUpdateInterval = 5000;
+
 SceneModel::SceneModel(QObject *parent)
     : QAbstractItemModel(parent)
-    , m_scene(nullptr)
+    , m_updateTimer(new QTimer(this))
 {
     QGV_ITEMTYPE(QGraphicsLineItem)
     QGV_ITEMTYPE(QGraphicsPixmapItem)
@@ -41,12 +51,45 @@ SceneModel::SceneModel(QObject *parent)
     QGV_ITEMTYPE(QGraphicsPolygonItem)
     QGV_ITEMTYPE(QGraphicsSimpleTextItem)
     QGV_ITEMTYPE(QGraphicsItemGroup)
+
+    m_nodes.insert(nullptr, new Node);
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(MinUpdateInterval);
+    connect(m_updateTimer, &QTimer::timeout, this, &SceneModel::updateItems);
+}
+
+SceneModel::~SceneModel()
+{
+    qDeleteAll(m_nodes);
 }
 
 void SceneModel::setScene(QGraphicsScene *scene)
 {
     beginResetModel();
+    if (m_scene)
+        disconnect(m_scene.data(), nullptr, this, nullptr);
     m_scene = scene;
+    m_updateTimer->stop();
+    m_sceneItemsValid = false;
+    clearNodes();
+
+    if (m_scene) {
+        // there are no notifications for added, removed or reparented items, but all of
+        // that results in a change of the scene content
+        connect(m_scene.data(), &QGraphicsScene::changed, this, [this]() {
+            if (!m_updateTimer->isActive())
+                m_updateTimer->start();
+        });
+        connect(m_scene.data(), &QObject::destroyed, this, [this]() {
+            setScene(nullptr);
+        });
+
+        auto hierarchy = currentHierarchy();
+        auto root = m_nodes.value(nullptr);
+        root->children = hierarchy.take(nullptr);
+        if (!root->children.isEmpty())
+            createNodes(nullptr, 0, root->children.size() - 1, hierarchy);
+    }
     endResetModel();
 }
 
@@ -60,8 +103,10 @@ QVariant SceneModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
     QGraphicsItem *item = static_cast<QGraphicsItem *>(index.internalPointer());
+    if (!isInScene(item))
+        return QVariant();
 
-    if (item && role == Qt::DisplayRole) {
+    if (role == Qt::DisplayRole) {
         QGraphicsObject *obj = item->toGraphicsObject();
         if (index.column() == 0) {
             if (obj && !obj->objectName().isEmpty())
@@ -74,10 +119,10 @@ QVariant SceneModel::data(const QModelIndex &index, int role) const
         }
     } else if (role == SceneItemRole) {
         return QVariant::fromValue(item);
-    } else if (item && role == Qt::ForegroundRole) {
+    } else if (role == Qt::ForegroundRole) {
         if (!item->isVisible())
             return qApp->palette().color(QPalette::Disabled, QPalette::Text);
-    } else if (item && role == ObjectModel::ObjectIdRole) {
+    } else if (role == ObjectModel::ObjectIdRole) {
         // TODO also handle the non-QObject case
         return QVariant::fromValue(ObjectId(item->toGraphicsObject()));
     }
@@ -92,75 +137,196 @@ int SceneModel::columnCount(const QModelIndex &parent) const
 
 int SceneModel::rowCount(const QModelIndex &parent) const
 {
-    if (!m_scene)
+    if (parent.isValid() && parent.column() != 0)
         return 0;
-    if (parent.isValid()) {
-        if (parent.column() != 0)
-            return 0;
-        QGraphicsItem *item = static_cast<QGraphicsItem *>(parent.internalPointer());
-        if (item)
-            return item->childItems().size();
-        else
-            return 0;
-    }
-    return topLevelItems().size();
+    const auto node = m_nodes.value(static_cast<QGraphicsItem *>(parent.internalPointer()));
+    return node ? node->children.size() : 0;
 }
 
-// QGraphicsItem::childItems() sorts them by stacking order, which takes into account the
-// items' insertion order, calls to QGraphicsItem::stackBefore(), and Z-values
-// That's too prone to change under our feet without telling us, breaking model invariants
-// So always just sort them... by pointer address, for lack of a better idea
-namespace {
-QList<QGraphicsItem *> sortedChildItems(QGraphicsItem *parent)
+bool SceneModel::isInScene(QGraphicsItem *item) const
 {
-    auto items = parent->childItems();
-    std::sort(items.begin(), items.end());
-    return items;
-}
+    if (!item || !m_scene)
+        return false;
+
+    if (!m_sceneItemsValid) {
+        const auto items = m_scene->items();
+        m_sceneItems = QSet<QGraphicsItem *>(items.constBegin(), items.constEnd());
+        m_sceneItemsValid = true;
+        // the application can only delete items once we return to the event loop
+        QTimer::singleShot(0, this, [this]() {
+            m_sceneItemsValid = false;
+        });
+    }
+    if (m_sceneItems.contains(item))
+        return true;
+
+    // deleted before the scheduled update noticed, get rid of the row right away
+    m_updateTimer->start(0);
+    return false;
 }
 
 int SceneModel::rowForItem(QGraphicsItem *item) const
 {
-    auto parent = item->parentItem();
-    if (parent)
-        return sortedChildItems(parent).indexOf(item);
-    else
-        return topLevelItems().indexOf(item);
+    const auto node = m_nodes.value(item);
+    Q_ASSERT(node);
+    const auto parentNode = m_nodes.value(node->parent);
+    if (parentNode->rowsDirty) {
+        for (int row = 0; row < parentNode->children.size(); ++row)
+            m_nodes.value(parentNode->children.at(row))->row = row;
+        parentNode->rowsDirty = false;
+    }
+    return node->row;
+}
+
+QModelIndex SceneModel::indexForItem(QGraphicsItem *item) const
+{
+    if (!item)
+        return QModelIndex();
+    return createIndex(rowForItem(item), 0, item);
 }
 
 QModelIndex SceneModel::parent(const QModelIndex &child) const
 {
     if (!child.isValid())
         return {};
-    QGraphicsItem *item = static_cast<QGraphicsItem *>(child.internalPointer());
-    if (!item->parentItem())
-        return QModelIndex();
-    const int row = rowForItem(item->parentItem());
-    return createIndex(row, 0, item->parentItem());
+    const auto node = m_nodes.value(static_cast<QGraphicsItem *>(child.internalPointer()));
+    if (!node)
+        return {};
+    return indexForItem(node->parent);
 }
 
 QModelIndex SceneModel::index(int row, int column, const QModelIndex &parent) const
 {
-    if (column < 0 || column >= columnCount())
+    if (row < 0 || column < 0 || column >= columnCount() || (parent.isValid() && parent.column() != 0))
         return {};
-    if (!parent.isValid() && row >= 0 && row < topLevelItems().size())
-        return createIndex(row, column, topLevelItems().at(row));
-    QGraphicsItem *parentItem = static_cast<QGraphicsItem *>(parent.internalPointer());
-    if (!parentItem || row < 0 || row >= parentItem->childItems().size())
-        return QModelIndex();
-    return createIndex(row, column, sortedChildItems(parentItem).at(row));
+    const auto node = m_nodes.value(static_cast<QGraphicsItem *>(parent.internalPointer()));
+    if (!node || row >= node->children.size())
+        return {};
+    return createIndex(row, column, node->children.at(row));
 }
 
-QList<QGraphicsItem *> SceneModel::topLevelItems() const
+SceneModel::ChildMap SceneModel::currentHierarchy() const
 {
-    QList<QGraphicsItem *> topLevel;
+    ChildMap hierarchy;
     if (!m_scene)
-        return topLevel;
-    const auto allItems = m_scene->items();
-    const auto isTopLevel = [](QGraphicsItem *item) { return !item->parentItem(); };
-    std::copy_if(allItems.begin(), allItems.end(), std::back_inserter(topLevel), isTopLevel);
-    std::sort(topLevel.begin(), topLevel.end());
-    return topLevel;
+        return hierarchy;
+    const auto items = m_scene->items();
+    for (auto item : items)
+        hierarchy[item->parentItem()].push_back(item);
+    for (auto it = hierarchy.begin(); it != hierarchy.end(); ++it)
+        std::sort(it.value().begin(), it.value().end());
+    return hierarchy;
+}
+
+void SceneModel::clearNodes()
+{
+    qDeleteAll(m_nodes);
+    m_nodes.clear();
+    m_nodes.insert(nullptr, new Node);
+}
+
+void SceneModel::createNodes(QGraphicsItem *parent, int first, int last, ChildMap &hierarchy)
+{
+    const auto parentNode = m_nodes.value(parent);
+    for (int row = first; row <= last; ++row) {
+        const auto item = parentNode->children.at(row);
+        auto node = new Node;
+        node->parent = parent;
+        node->row = row;
+        node->children = hierarchy.take(item);
+        m_nodes.insert(item, node);
+        if (!node->children.isEmpty())
+            createNodes(item, 0, node->children.size() - 1, hierarchy);
+    }
+}
+
+void SceneModel::removeNode(QGraphicsItem *item)
+{
+    const auto node = m_nodes.take(item);
+    for (auto child : qAsConst(node->children))
+        removeNode(child);
+    delete node;
+}
+
+void SceneModel::updateItems()
+{
+    m_updateTimer->stop();
+    m_sceneItemsValid = false;
+    QElapsedTimer t;
+    t.start();
+
+    // removals first, so items moved between parents no longer have a node when inserted again
+    auto hierarchy = currentHierarchy();
+    removeChildren(nullptr, hierarchy);
+    insertChildren(nullptr, hierarchy);
+
+    // keep the update overhead for large, constantly changing scenes at bay
+    m_updateTimer->setInterval(qBound<int>(MinUpdateInterval, int(t.elapsed() * 10), MaxUpdateInterval));
+}
+
+void SceneModel::removeChildren(QGraphicsItem *parent, const ChildMap &hierarchy)
+{
+    const auto node = m_nodes.value(parent);
+    const auto newChildren = hierarchy.value(parent);
+    auto &children = node->children;
+    const auto contains = [&newChildren](QGraphicsItem *item) {
+        return std::binary_search(newChildren.constBegin(), newChildren.constEnd(), item);
+    };
+
+    // back to front to keep the rows of the remaining ranges valid
+    QModelIndex parentIndex;
+    for (int last = children.size() - 1; last >= 0; --last) {
+        if (contains(children.at(last)))
+            continue;
+        int first = last;
+        while (first > 0 && !contains(children.at(first - 1)))
+            --first;
+        if (!parentIndex.isValid())
+            parentIndex = indexForItem(parent);
+        beginRemoveRows(parentIndex, first, last);
+        for (int row = first; row <= last; ++row)
+            removeNode(children.at(row));
+        children.remove(first, last - first + 1);
+        node->rowsDirty = true;
+        endRemoveRows();
+        last = first;
+    }
+
+    for (auto child : qAsConst(children))
+        removeChildren(child, hierarchy);
+}
+
+void SceneModel::insertChildren(QGraphicsItem *parent, ChildMap &hierarchy)
+{
+    const auto node = m_nodes.value(parent);
+    const auto newChildren = hierarchy.take(parent);
+    auto &children = node->children;
+
+    // the remaining children are a subset of the new ones, both sorted the same way
+    const auto existingChildren = children;
+    QModelIndex parentIndex;
+    for (int first = 0; first < newChildren.size();) {
+        if (first < children.size() && children.at(first) == newChildren.at(first)) {
+            ++first;
+            continue;
+        }
+        const auto next = first < children.size() ? children.at(first) : nullptr;
+        int last = first;
+        while (last + 1 < newChildren.size() && newChildren.at(last + 1) != next)
+            ++last;
+        if (!parentIndex.isValid())
+            parentIndex = indexForItem(parent);
+        beginInsertRows(parentIndex, first, last);
+        children.insert(first, last - first + 1, nullptr);
+        std::copy(newChildren.constBegin() + first, newChildren.constBegin() + last + 1, children.begin() + first);
+        createNodes(parent, first, last, hierarchy);
+        node->rowsDirty = true;
+        endInsertRows();
+        first = last + 1;
+    }
+
+    for (auto child : existingChildren)
+        insertChildren(child, hierarchy);
 }
 
 QVariant SceneModel::headerData(int section, Qt::Orientation orientation, int role) const
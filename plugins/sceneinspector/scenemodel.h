@@ -15,14 +15,27 @@
 #define GAMMARAY_SCENEINSPECTOR_SCENEMODEL_H
 
 #include <QAbstractItemModel>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+#include <QVector>
 #include <common/modelroles.h>
 
 QT_BEGIN_NAMESPACE
 class QGraphicsScene;
 class QGraphicsItem;
+class QTimer;
 QT_END_NAMESPACE
 
 namespace GammaRay {
+/**
+ * Item hierarchy of a QGraphicsScene.
+ *
+ * The model works on a mirror of the hierarchy, with children sorted by pointer
+ * address, so lookups don't have to query the scene. The mirror is brought up to
+ * date whenever the scene reports changes. As items can be deleted before that, the
+ * item data is only accessed for items verified to still be in the scene.
+ */
 class SceneModel : public QAbstractItemModel
 {
     Q_OBJECT
@@ -32,6 +45,8 @@ public:
         SceneItemRole = UserRole + 1
     };
     explicit SceneModel(QObject *parent = nullptr);
+    ~SceneModel() override;
+
     void setScene(QGraphicsScene *scene);
     QGraphicsScene *scene() const;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
@@ -43,15 +58,50 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation,
                         int role = Qt::DisplayRole) const override;
 
+public slots:
+    /** Brings the item hierarchy up to date with the scene right away. */
+    void updateItems();
+
 private:
-    QList<QGraphicsItem *> topLevelItems() const;
+    struct Node
+    {
+        QGraphicsItem *parent = nullptr;
+        int row = 0;
+        // rows of the children need to be recomputed
+        bool rowsDirty = false;
+        // sorted by pointer address, as the stacking order of QGraphicsItem::childItems()
+        // changes without notification
+        QVector<QGraphicsItem *> children;
+    };
+    using ChildMap = QHash<QGraphicsItem *, QVector<QGraphicsItem *>>;
+
+    /** The item hierarchy currently in the scene, children sorted by pointer address. */
+    ChildMap currentHierarchy() const;
+    void clearNodes();
+    /** Creates the nodes for the children @p first to @p last of @p parent, and everything below them. */
+    void createNodes(QGraphicsItem *parent, int first, int last, ChildMap &hierarchy);
+    /** Destroys the node of @p item and everything below it. */
+    void removeNode(QGraphicsItem *item);
+    /** Removes everything below @p parent that is no longer in @p hierarchy. */
+    void removeChildren(QGraphicsItem *parent, const ChildMap &hierarchy);
+    /** Adds everything from @p hierarchy that is missing below @p parent, consuming @p hierarchy. */
+    void insertChildren(QGraphicsItem *parent, ChildMap &hierarchy);
+    /** Whether @p item is still part of the scene, ie. safe to dereference. */
+    bool isInScene(QGraphicsItem *item) const;
     int rowForItem(QGraphicsItem *item) const;
+    QModelIndex indexForItem(QGraphicsItem *item) const;
 
     /// Returns a string type name for the given QGV item type id
     QString typeName(int itemType) const;
 
-    QGraphicsScene *m_scene;
+    QPointer<QGraphicsScene> m_scene;
     QHash<int, QString> m_typeNames;
+    // nullptr holds the top-level items
+    QHash<QGraphicsItem *, Node *> m_nodes;
+    QTimer *m_updateTimer;
+    // items in the scene, valid until the next event loop iteration
+    mutable QSet<QGraphicsItem *> m_sceneItems;
+    mutable bool m_sceneItemsValid = false;
 };
 }
 
@@ -0,0 +1,186 @@
+/*
+  scenetilecache.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "scenetilecache.h"
+
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QTimer>
+
+using namespace GammaRay;
+
+// in KiB, enough for a few screens worth of tiles on each of the cached zoom levels
+static const int MaxCacheCost = 64 * 1024;
+static const int TileSize = SceneInspectorInterface::TileSize;
+static const int TileCost = TileSize * TileSize * 4 / 1024;
+// in device pixels, for antialiasing and the transform origin marker of the decoration
+static const qreal InvalidationMargin = 8.0;
+// the zoom steps of GraphicsView
+static const qreal ZoomInFactor = 1.2;
+static const qreal ZoomOutFactor = 0.8;
+
+uint GammaRay::qHash(const SceneTileKey &key, uint seed)
+{
+    return ::qHash(key.zoom, seed) ^ ::qHash((quint64(quint32(key.pos.x())) << 32) | quint32(key.pos.y()), seed);
+}
+
+SceneTileCache::SceneTileCache(QObject *parent)
+    : QObject(parent)
+    , m_tiles(MaxCacheCost)
+    , m_prefetchTimer(new QTimer(this))
+{
+    m_prefetchTimer->setSingleShot(true);
+    m_prefetchTimer->setInterval(0);
+    connect(m_prefetchTimer, &QTimer::timeout, this, &SceneTileCache::prefetchNext);
+}
+
+SceneTileCache::~SceneTileCache() = default;
+
+void SceneTileCache::setScene(QGraphicsScene *scene)
+{
+    if (m_scene)
+        disconnect(m_scene.data(), nullptr, this, nullptr);
+    m_scene = scene;
+    m_decoration = SceneInspectorInterface::ItemDecoration();
+    m_tiles.clear();
+    m_prefetchQueue.clear();
+    m_prefetchTimer->stop();
+
+    if (m_scene)
+        connect(m_scene.data(), &QGraphicsScene::changed, this, &SceneTileCache::invalidate);
+}
+
+QGraphicsScene *SceneTileCache::scene() const
+{
+    return m_scene;
+}
+
+void SceneTileCache::setDecoratedItem(QGraphicsItem *item)
+{
+    // the item might have moved since the last call, so always compare the covered area
+    const auto oldRect = m_decoration.boundingRect();
+    m_decoration = item ? SceneInspectorInterface::itemDecoration(item) : SceneInspectorInterface::ItemDecoration();
+    const auto newRect = m_decoration.boundingRect();
+    if (oldRect == newRect)
+        return;
+
+    QList<QRectF> regions;
+    if (!oldRect.isNull())
+        regions.push_back(oldRect);
+    if (!newRect.isNull())
+        regions.push_back(newRect);
+    invalidate(regions);
+}
+
+QPixmap SceneTileCache::tile(const QTransform &zoom, const QPoint &pos)
+{
+    const SceneTileKey key(zoom, pos);
+    if (auto pixmap = m_tiles.object(key))
+        return *pixmap;
+
+    const auto pixmap = render(zoom, pos);
+    m_tiles.insert(key, new QPixmap(pixmap), TileCost);
+    return pixmap;
+}
+
+bool SceneTileCache::contains(const QTransform &zoom, const QPoint &pos) const
+{
+    return m_tiles.contains(SceneTileKey(zoom, pos));
+}
+
+QPixmap SceneTileCache::render(const QTransform &zoom, const QPoint &pos) const
+{
+    QPixmap pixmap(TileSize, TileSize);
+    pixmap.fill(Qt::transparent);
+    if (!m_scene)
+        return pixmap;
+
+    const auto transform = zoom * QTransform::fromTranslate(-pos.x() * TileSize, -pos.y() * TileSize);
+    QPainter painter(&pixmap);
+    painter.setWorldTransform(transform);
+
+    // same as for the full view, the area is the tile _before_ applying the transformation
+    const auto area = transform.inverted().mapRect(QRectF(0, 0, TileSize, TileSize));
+    m_scene->render(&painter, area, area, Qt::IgnoreAspectRatio);
+
+    SceneInspectorInterface::paintItemDecoration(m_decoration, transform, &painter);
+    return pixmap;
+}
+
+void SceneTileCache::invalidate(const QList<QRectF> &regions)
+{
+    if (regions.isEmpty()) {
+        m_tiles.clear();
+        return;
+    }
+
+    const auto keys = m_tiles.keys();
+    for (const auto &key : keys) {
+        const QRectF tileRect(key.pos.x() * TileSize, key.pos.y() * TileSize, TileSize, TileSize);
+        for (const auto &region : regions) {
+            const auto deviceRect = key.zoom.mapRect(region).adjusted(-InvalidationMargin, -InvalidationMargin,
+                                                                      InvalidationMargin, InvalidationMargin);
+            if (deviceRect.intersects(tileRect)) {
+                m_tiles.remove(key);
+                break;
+            }
+        }
+    }
+}
+
+void SceneTileCache::prefetch(const QTransform &transform, const QSize &size)
+{
+    m_prefetchQueue.clear();
+    if (!m_scene || !SceneInspectorInterface::isTileable(transform) || size.isEmpty())
+        return;
+
+    // one ring of tiles around the viewport at the current zoom level first, as panning is
+    // the most common interaction
+    const auto zoom = SceneInspectorInterface::tileZoom(transform);
+    const auto visible = SceneInspectorInterface::visibleTiles(transform, size);
+    const auto ring = visible.adjusted(-1, -1, 1, 1);
+    for (int y = ring.top(); y <= ring.bottom(); ++y) {
+        for (int x = ring.left(); x <= ring.right(); ++x) {
+            if (!visible.contains(x, y))
+                m_prefetchQueue.push_back(SceneTileKey(zoom, QPoint(x, y)));
+        }
+    }
+
+    // then the viewport one zoom step in and out, around the viewport center
+    const QPointF viewCenter(size.width() / 2.0, size.height() / 2.0);
+    const auto sceneCenter = transform.inverted().map(viewCenter);
+    for (const auto factor : { ZoomInFactor, ZoomOutFactor }) {
+        const auto nextZoom = QTransform::fromScale(factor, factor) * zoom;
+        const auto offset = viewCenter - nextZoom.map(sceneCenter);
+        const auto nextVisible = SceneInspectorInterface::visibleTiles(nextZoom * QTransform::fromTranslate(offset.x(), offset.y()), size);
+        for (int y = nextVisible.top(); y <= nextVisible.bottom(); ++y) {
+            for (int x = nextVisible.left(); x <= nextVisible.right(); ++x)
+                m_prefetchQueue.push_back(SceneTileKey(nextZoom, QPoint(x, y)));
+        }
+    }
+
+    m_prefetchTimer->start();
+}
+
+void SceneTileCache::prefetchNext()
+{
+    // one tile per event loop iteration, to not block the application
+    while (!m_prefetchQueue.isEmpty()) {
+        const auto key = m_prefetchQueue.takeFirst();
+        if (m_tiles.contains(key))
+            continue;
+        m_tiles.insert(key, new QPixmap(render(key.zoom, key.pos)), TileCost);
+        break;
+    }
+    if (!m_prefetchQueue.isEmpty() && m_scene)
+        m_prefetchTimer->start();
+}
@@ -0,0 +1,103 @@
+/*
+  scenetilecache.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_SCENEINSPECTOR_SCENETILECACHE_H
+#define GAMMARAY_SCENEINSPECTOR_SCENETILECACHE_H
+
+#include "sceneinspectorinterface.h"
+
+#include <QCache>
+#include <QObject>
+#include <QPixmap>
+#include <QPoint>
+#include <QPointer>
+#include <QRectF>
+#include <QTransform>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QGraphicsItem;
+class QGraphicsScene;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+/** A tile of a scene rendered at a specific zoom level. */
+struct SceneTileKey
+{
+    SceneTileKey() = default;
+    SceneTileKey(const QTransform &zoom, const QPoint &pos)
+        : zoom(zoom)
+        , pos(pos)
+    {
+    }
+    bool operator==(const SceneTileKey &other) const
+    {
+        return pos == other.pos && zoom == other.zoom;
+    }
+
+    QTransform zoom;
+    QPoint pos;
+};
+
+uint qHash(const SceneTileKey &key, uint seed = 0);
+
+/**
+ * Rendered tiles of a QGraphicsScene.
+ *
+ * Tiles are SceneInspectorInterface::TileSize pixels large, in the coordinate system of
+ * SceneInspectorInterface::tileZoom(), so scrolling a view keeps using the same tiles.
+ * Tiles are dropped when the scene reports changes in their area, and tiles next to the
+ * current viewport and of the adjacent zoom levels are rendered ahead of time while idle.
+ */
+class SceneTileCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SceneTileCache(QObject *parent = nullptr);
+    ~SceneTileCache() override;
+
+    void setScene(QGraphicsScene *scene);
+    QGraphicsScene *scene() const;
+
+    /**
+     * Item whose decoration is painted on top of the tiles, see SceneInspectorInterface::paintItemDecoration.
+     * Only the item's current geometry is kept, so it may be deleted afterwards.
+     */
+    void setDecoratedItem(QGraphicsItem *item);
+
+    /** Returns the tile at @p pos for @p zoom, rendering it if it is not cached. */
+    QPixmap tile(const QTransform &zoom, const QPoint &pos);
+    bool contains(const QTransform &zoom, const QPoint &pos) const;
+
+    /** Schedules rendering of the tiles likely needed next, for a viewport of @p size, in the background. */
+    void prefetch(const QTransform &transform, const QSize &size);
+
+public slots:
+    /** Drops all tiles intersecting the scene areas @p regions, or all tiles if @p regions is empty. */
+    void invalidate(const QList<QRectF> &regions = QList<QRectF>());
+
+private slots:
+    void prefetchNext();
+
+private:
+    QPixmap render(const QTransform &zoom, const QPoint &pos) const;
+
+    QPointer<QGraphicsScene> m_scene;
+    SceneInspectorInterface::ItemDecoration m_decoration;
+    QCache<SceneTileKey, QPixmap> m_tiles;
+    QVector<SceneTileKey> m_prefetchQueue;
+    QTimer *m_prefetchTimer;
+};
+}
+
+#endif // GAMMARAY_SCENEINSPECTOR_SCENETILECACHE_H
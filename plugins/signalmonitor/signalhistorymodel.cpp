@@ -75,7 +75,7 @@ SignalHistoryModel::SignalHistoryModel(Probe *probe, QObject *parent)
 
     SignalSpyCallbackSet spy;
     spy.signalBeginCallback = signal_begin_callback;
-    probe->registerSignalSpyCallbackSet(spy);
+    m_signalSpyId = probe->registerSignalSpyCallbackSet(spy);
 
     s_historyModel = this;
 
@@ -88,6 +88,8 @@ SignalHistoryModel::SignalHistoryModel(Probe *probe, QObject *parent)
 SignalHistoryModel::~SignalHistoryModel()
 {
     s_historyModel = nullptr;
+    if (auto probe = Probe::instance())
+        probe->unregisterSignalSpyCallbackSet(m_signalSpyId);
     qDeleteAll(m_objectsToBeInserted);
     qDeleteAll(m_tracedObjects);
 }
@@ -107,6 +107,7 @@ private:
 
     QTimer *m_delayInsertTimer;
     QVector<Item *> m_objectsToBeInserted;
+    int m_signalSpyId = -1;
 };
 } // namespace GammaRay
 
@@ -35,3 +35,8 @@ void StateMachineViewerClient::repopulateGraph()
 {
     Endpoint::instance()->invokeObject(objectName(), "repopulateGraph");
 }
+
+void StateMachineViewerClient::requestEvents(qint64 from, qint64 to)
+{
+    Endpoint::instance()->invokeObject(objectName(), "requestEvents", QVariantList() << from << to);
+}
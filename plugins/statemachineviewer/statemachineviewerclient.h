@@ -27,6 +27,7 @@ public:
     void selectStateMachine(int index) override;
     void toggleRunning() override;
     void repopulateGraph() override;
+    void requestEvents(qint64 from, qint64 to) override;
 };
 }
 
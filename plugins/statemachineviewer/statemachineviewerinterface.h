@@ -17,6 +17,7 @@
 #include <QObject>
 #include <QMetaType>
 #include <QDataStream>
+#include <QStringList>
 #include <QVector>
 
 namespace GammaRay {
@@ -111,6 +112,9 @@ public slots:
 
     virtual void repopulateGraph() = 0;
 
+    /** Requests the recorded events with a timestamp in [@p from, @p to], answered by eventsAvailable(). */
+    virtual void requestEvents(qint64 from, qint64 to) = 0;
+
 signals:
     void statusChanged(bool haveStateMachine, bool running);
     void message(const QString &message);
@@ -125,6 +129,12 @@ signals:
     void stateExited(GammaRay::StateId state);
     void transitionAdded(GammaRay::TransitionId state, GammaRay::StateId source,
                          GammaRay::StateId target, const QString &label);
+    /**
+     * Periodic summary of the @p count events recorded in the time range [@p from, @p to],
+     * with @p recent describing the most recent of them. Timestamps are in nanoseconds.
+     */
+    void eventsRecorded(qint64 from, qint64 to, quint64 count, const QStringList &recent);
+    void eventsAvailable(qint64 from, qint64 to, const QStringList &events);
 };
 }
 
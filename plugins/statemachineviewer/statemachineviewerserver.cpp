@@ -24,12 +24,14 @@
 
 #include <core/objecttypefilterproxymodel.h>
 #include <core/singlecolumnobjectproxymodel.h>
+#include <core/probesettings.h>
 #include <core/remote/serverproxymodel.h>
 #include <common/objectbroker.h>
 #include <compat/qasconst.h>
 
 #include <QStateMachine>
 #include <QItemSelectionModel>
+#include <QTimer>
 
 #ifdef HAVE_QT_SCXML
 #include <QScxmlStateMachine>
@@ -38,15 +40,29 @@
 #include <QtPlugin>
 
 #include <iostream>
+#include <limits>
 
 using namespace GammaRay;
 using namespace std;
 
+static const int SummaryInterval = 100; // ms
+static const int MaxSummaryEvents = 50;
+static const int MaxPendingMessages = 100;
+
 StateMachineViewerServer::StateMachineViewerServer(Probe *probe, QObject *parent)
     : StateMachineViewerInterface(parent)
     , m_stateModel(new StateModel(this))
     , m_transitionModel(new TransitionModel(this))
+    , m_summaryTimer(new QTimer(this))
 {
+    // size of the event log in KiB
+    const auto logSize = ProbeSettings::value(QStringLiteral("StateMachineEventLogSize"), 1024).toLongLong();
+    m_transitionLog.setMemoryLimit(static_cast<int>(qBound<qint64>(0, logSize, std::numeric_limits<int>::max() / 1024) * 1024));
+    m_logClock.start();
+    m_summaryTimer->setSingleShot(true);
+    m_summaryTimer->setInterval(SummaryInterval);
+    connect(m_summaryTimer, &QTimer::timeout, this, &StateMachineViewerServer::sendSummary);
+
     auto proxyModel = new ServerProxyModel<QIdentityProxyModel>(this);
     proxyModel->setSourceModel(m_stateModel);
     proxyModel->addRole(StateModel::StateIdRole);
@@ -140,6 +156,7 @@ void StateMachineViewerServer::setSelectedStateMachine(StateMachineDebugInterfac
     if (oldMachine) {
         oldMachine->disconnect(this);
     }
+    resetTransitionLog();
 
     m_stateModel->setStateMachine(machine);
 
@@ -214,19 +231,107 @@ void StateMachineViewerServer::stateSelectionChanged()
 
 void StateMachineViewerServer::handleTransitionTriggered(Transition transition)
 {
-    emit transitionTriggered(TransitionId(transition), selectedStateMachine()->transitionLabel(transition));
+    if (!m_transitionLabels.contains(transition))
+        m_transitionLabels.insert(transition, selectedStateMachine()->transitionLabel(transition));
+    m_lastTransition = transition;
+    recordEvent(StateMachineEvent::TransitionTriggered, transition);
 }
 
 void StateMachineViewerServer::stateEntered(State state)
 {
-    emit message(tr("State entered: %1").arg(selectedStateMachine()->stateLabel(state)));
-    stateConfigurationChanged();
+    if (!m_stateLabels.contains(state))
+        m_stateLabels.insert(state, selectedStateMachine()->stateLabel(state));
+    m_configurationChanged = true;
+    recordEvent(StateMachineEvent::StateEntered, state);
 }
 
 void StateMachineViewerServer::stateExited(State state)
 {
-    emit message(tr("State exited: %1").arg(selectedStateMachine()->stateLabel(state)));
-    stateConfigurationChanged();
+    if (!m_stateLabels.contains(state))
+        m_stateLabels.insert(state, selectedStateMachine()->stateLabel(state));
+    m_configurationChanged = true;
+    recordEvent(StateMachineEvent::StateExited, state);
+}
+
+void StateMachineViewerServer::recordEvent(StateMachineEvent::Type type, quint64 id)
+{
+    m_transitionLog.append(type, id, m_logClock.nsecsElapsed());
+    if (!m_summaryTimer->isActive())
+        m_summaryTimer->start();
+}
+
+void StateMachineViewerServer::sendSummary()
+{
+    // the client only ever shows the latest configuration and transition, intermediate ones don't matter
+    if (m_configurationChanged) {
+        m_configurationChanged = false;
+        stateConfigurationChanged();
+    }
+    if (m_lastTransition) {
+        emit transitionTriggered(TransitionId(m_lastTransition), m_transitionLabels.value(m_lastTransition));
+        m_lastTransition = Transition();
+    }
+
+    const auto count = m_transitionLog.totalCount() - m_summarizedCount;
+    if (count > 0) {
+        const auto now = m_logClock.nsecsElapsed();
+        QStringList recent;
+        const auto events = m_transitionLog.lastEvents(int(qMin<quint64>(count, MaxSummaryEvents)));
+        recent.reserve(events.size());
+        for (const auto &event : events)
+            recent.push_back(formatEvent(event));
+        emit eventsRecorded(m_summaryStart, now, count, recent);
+        m_summarizedCount = m_transitionLog.totalCount();
+        m_summaryStart = now + 1;
+    }
+
+    if (!m_pendingMessages.isEmpty()) {
+        if (m_droppedMessages > 0)
+            m_pendingMessages.push_back(tr("%n log message(s) dropped.", "", m_droppedMessages));
+        emit message(m_pendingMessages.join(QLatin1Char('\n')));
+        m_pendingMessages.clear();
+        m_droppedMessages = 0;
+    }
+}
+
+QString StateMachineViewerServer::formatEvent(const StateMachineEvent &event) const
+{
+    const auto time = QString::number(event.timestamp / 1000000000.0, 'f', 6);
+    switch (event.type) {
+    case StateMachineEvent::StateEntered:
+        return tr("[%1 s] State entered: %2").arg(time, m_stateLabels.value(event.id));
+    case StateMachineEvent::StateExited:
+        return tr("[%1 s] State exited: %2").arg(time, m_stateLabels.value(event.id));
+    case StateMachineEvent::TransitionTriggered:
+        return tr("[%1 s] Transition triggered: %2").arg(time, m_transitionLabels.value(event.id));
+    }
+    return QString();
+}
+
+void StateMachineViewerServer::requestEvents(qint64 from, qint64 to)
+{
+    const auto events = m_transitionLog.events(from, to);
+    QStringList lines;
+    lines.reserve(events.size());
+    for (const auto &event : events)
+        lines.push_back(formatEvent(event));
+    emit eventsAvailable(from, to, lines);
+}
+
+void StateMachineViewerServer::resetTransitionLog()
+{
+    m_summaryTimer->stop();
+    m_transitionLog.clear();
+    m_logClock.restart();
+    m_summarizedCount = 0;
+    m_summaryStart = 0;
+    m_configurationChanged = false;
+    m_lastTransition = Transition();
+    m_pendingMessages.clear();
+    m_droppedMessages = 0;
+    // labels are cached as the objects might be gone by the time we look at older events
+    m_stateLabels.clear();
+    m_transitionLabels.clear();
 }
 
 void StateMachineViewerServer::stateConfigurationChanged()
@@ -315,7 +420,13 @@ void StateMachineViewerServer::toggleRunning()
 
 void StateMachineViewerServer::handleLogMessage(const QString &label, const QString &msg)
 {
-    emit message(tr("Log [label=%1]: %2").arg(label, msg));
+    if (m_pendingMessages.size() >= MaxPendingMessages) {
+        ++m_droppedMessages;
+        return;
+    }
+    m_pendingMessages.push_back(tr("Log [label=%1]: %2").arg(label, msg));
+    if (!m_summaryTimer->isActive())
+        m_summaryTimer->start();
 }
 
 void StateMachineViewerServer::objectSelected(QObject *obj)
@@ -17,9 +17,11 @@
 #include "statemachineviewerutil.h"
 #include "statemachineviewerinterface.h"
 #include "statemachinedebuginterface.h"
+#include "transitionlog.h"
 
 #include <core/toolfactory.h>
 
+#include <QElapsedTimer>
 #include <QHash>
 #include <QSet>
 #include <QString>
@@ -33,6 +35,7 @@ class QAbstractItemModel;
 class QAbstractProxyModel;
 class QItemSelectionModel;
 class QModelIndex;
+class QTimer;
 QT_END_NAMESPACE
 
 namespace GammaRay {
@@ -76,8 +79,14 @@ private slots:
 
     void objectSelected(QObject *obj);
 
+    void requestEvents(qint64 from, qint64 to) override;
+
 private:
     bool mayAddState(State state);
+    void recordEvent(StateMachineEvent::Type type, quint64 id);
+    void sendSummary();
+    QString formatEvent(const StateMachineEvent &event) const;
+    void resetTransitionLog();
 
     QAbstractProxyModel *m_stateMachinesModel;
     StateModel *m_stateModel;
@@ -89,6 +98,19 @@ private:
 
     QVector<State> m_recursionGuard;
     QVector<State> m_lastStateConfig;
+
+    // events are recorded as they happen, but only sent to the client in periodic summaries
+    TransitionLog m_transitionLog;
+    QElapsedTimer m_logClock;
+    QTimer *m_summaryTimer;
+    quint64 m_summarizedCount = 0;
+    qint64 m_summaryStart = 0;
+    bool m_configurationChanged = false;
+    Transition m_lastTransition;
+    QStringList m_pendingMessages;
+    int m_droppedMessages = 0;
+    QHash<quint64, QString> m_stateLabels;
+    QHash<quint64, QString> m_transitionLabels;
 };
 
 class StateMachineViewerFactory : public QObject,
@@ -146,6 +146,9 @@ StateMachineViewerWidget::StateMachineViewerWidget(QWidget *parent, Qt::WindowFl
     connect(m_ui->showLogPushButton, &QPushButton::clicked, this, [this]() {
         setShowLog(true);
     });
+    m_ui->logTextEdit->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(m_ui->logTextEdit, &QWidget::customContextMenuRequested, this,
+            &StateMachineViewerWidget::logContextMenu);
     setShowLog(false);
 
     QAbstractItemModel *stateMachineModel = ObjectBroker::model(QStringLiteral("com.kdab.GammaRay.StateMachineModel"));
@@ -192,6 +195,10 @@ StateMachineViewerWidget::StateMachineViewerWidget(QWidget *parent, Qt::WindowFl
             });
 
     connect(m_interface, SIGNAL(message(QString)), this, SLOT(showMessage(QString)));
+    connect(m_interface, SIGNAL(eventsRecorded(qint64, qint64, quint64, QStringList)),
+            this, SLOT(eventsRecorded(qint64, qint64, quint64, QStringList)));
+    connect(m_interface, SIGNAL(eventsAvailable(qint64, qint64, QStringList)),
+            this, SLOT(eventsAvailable(qint64, qint64, QStringList)));
     connect(m_interface, SIGNAL(stateConfigurationChanged(GammaRay::StateMachineConfiguration)),
             this, SLOT(stateConfigurationChanged(GammaRay::StateMachineConfiguration)));
     connect(m_interface,
@@ -309,6 +316,37 @@ void StateMachineViewerWidget::showMessage(const QString &message)
     sb->setValue(sb->maximum());
 }
 
+void StateMachineViewerWidget::eventsRecorded(qint64 from, qint64 to, quint64 count, const QStringList &recent)
+{
+    if (count > quint64(recent.size())) {
+        m_omittedFrom = from;
+        m_omittedTo = to;
+        showMessage(tr("%n earlier event(s) omitted, use the context menu to show them.", "", int(count - recent.size())));
+    }
+    showMessage(recent.join(QLatin1Char('\n')));
+}
+
+void StateMachineViewerWidget::eventsAvailable(qint64 from, qint64 to, const QStringList &events)
+{
+    showMessage(tr("Events between %1 s and %2 s:").arg(from / 1000000000.0, 0, 'f', 6).arg(to / 1000000000.0, 0, 'f', 6));
+    if (events.isEmpty())
+        showMessage(tr("No events left in the event log for this time range."));
+    else
+        showMessage(events.join(QLatin1Char('\n')));
+}
+
+void StateMachineViewerWidget::logContextMenu(QPoint pos)
+{
+    QScopedPointer<QMenu> menu(m_ui->logTextEdit->createStandardContextMenu());
+    menu->addSeparator();
+    auto action = menu->addAction(tr("Show Omitted Events"));
+    action->setEnabled(m_omittedFrom >= 0);
+    connect(action, &QAction::triggered, this, [this]() {
+        m_interface->requestEvents(m_omittedFrom, m_omittedTo);
+    });
+    menu->exec(m_ui->logTextEdit->mapToGlobal(pos));
+}
+
 void StateMachineViewerWidget::stateConfigurationChanged(const StateMachineConfiguration &config)
 {
     if (m_machine)
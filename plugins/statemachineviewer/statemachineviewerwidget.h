@@ -50,6 +50,8 @@ public:
 
 private slots:
     void showMessage(const QString &message);
+    void eventsRecorded(qint64 from, qint64 to, quint64 count, const QStringList &recent);
+    void eventsAvailable(qint64 from, qint64 to, const QStringList &events);
     void stateAdded(const GammaRay::StateId stateId, const GammaRay::StateId parentId,
                     const bool hasChildren, const QString &label, const GammaRay::StateType type,
                     const bool connectToInitial);
@@ -67,6 +69,7 @@ private slots:
     void setShowLog(bool show);
 
     void objectInspectorContextMenu(QPoint pos);
+    void logContextMenu(QPoint pos);
 
 private:
     /**
@@ -88,6 +91,9 @@ private:
     QHash<TransitionId, KDSME::Transition *> m_idToTransitionMap;
     KDSME::StateMachine *m_machine;
     bool m_showLog;
+    // time range of the most recent summary not listing all of its events
+    qint64 m_omittedFrom = -1;
+    qint64 m_omittedTo = -1;
 };
 
 class StateMachineViewerUiFactory : public QObject,
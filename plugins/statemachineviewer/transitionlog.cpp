@@ -0,0 +1,115 @@
+/*
+  transitionlog.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "transitionlog.h"
+
+#include <limits>
+
+using namespace GammaRay;
+
+TransitionLog::TransitionLog(int memoryLimit)
+{
+    setMemoryLimit(memoryLimit);
+}
+
+int TransitionLog::memoryLimit() const
+{
+    return m_events.size() * sizeof(StateMachineEvent);
+}
+
+void TransitionLog::setMemoryLimit(int bytes)
+{
+    m_events.clear();
+    m_events.resize(qMax<int>(1, bytes / sizeof(StateMachineEvent)));
+    m_events.squeeze();
+    clear();
+}
+
+int TransitionLog::capacity() const
+{
+    return m_events.size();
+}
+
+int TransitionLog::size() const
+{
+    return m_size;
+}
+
+quint64 TransitionLog::totalCount() const
+{
+    return m_totalCount;
+}
+
+void TransitionLog::clear()
+{
+    m_head = 0;
+    m_size = 0;
+    m_totalCount = 0;
+}
+
+void TransitionLog::append(StateMachineEvent::Type type, quint64 id, qint64 timestamp)
+{
+    auto &event = m_events[m_head];
+    event.timestamp = timestamp;
+    event.id = id;
+    event.type = type;
+
+    m_head = (m_head + 1) % m_events.size();
+    m_size = qMin(m_size + 1, m_events.size());
+    ++m_totalCount;
+}
+
+const StateMachineEvent &TransitionLog::at(int index) const
+{
+    Q_ASSERT(index >= 0 && index < m_size);
+    return m_events.at((m_head - m_size + index + m_events.size()) % m_events.size());
+}
+
+int TransitionLog::lowerBound(qint64 timestamp) const
+{
+    int begin = 0;
+    int count = m_size;
+    while (count > 0) {
+        const auto step = count / 2;
+        if (at(begin + step).timestamp < timestamp) {
+            begin += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return begin;
+}
+
+QVector<StateMachineEvent> TransitionLog::events(qint64 from, qint64 to) const
+{
+    QVector<StateMachineEvent> result;
+    if (from > to)
+        return result;
+
+    const auto begin = lowerBound(from);
+    const auto end = to == std::numeric_limits<qint64>::max() ? m_size : lowerBound(to + 1);
+    result.reserve(end - begin);
+    for (int i = begin; i < end; ++i)
+        result.push_back(at(i));
+    return result;
+}
+
+QVector<StateMachineEvent> TransitionLog::lastEvents(int count) const
+{
+    QVector<StateMachineEvent> result;
+    count = qMin(count, m_size);
+    result.reserve(count);
+    for (int i = m_size - count; i < m_size; ++i)
+        result.push_back(at(i));
+    return result;
+}
@@ -0,0 +1,79 @@
+/*
+  transitionlog.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_STATEMACHINEVIEWER_TRANSITIONLOG_H
+#define GAMMARAY_STATEMACHINEVIEWER_TRANSITIONLOG_H
+
+#include <QVector>
+
+namespace GammaRay {
+
+struct StateMachineEvent
+{
+    enum Type : quint32
+    {
+        StateEntered,
+        StateExited,
+        TransitionTriggered
+    };
+
+    /// monotonic, in nanoseconds
+    qint64 timestamp;
+    /// the state or transition, depending on type
+    quint64 id;
+    Type type;
+};
+
+/** Fixed-size ring buffer of state machine events.
+ *  Once the memory limit is reached, the oldest events are overwritten.
+ *  Timestamps are expected to be non-decreasing, which allows time range lookups
+ *  by binary search.
+ */
+class TransitionLog
+{
+public:
+    explicit TransitionLog(int memoryLimit = 1024 * 1024);
+
+    /** Memory used for the events at most, in bytes. Rounded down to whole events. */
+    int memoryLimit() const;
+    /** Discards all events. */
+    void setMemoryLimit(int bytes);
+
+    int capacity() const;
+    int size() const;
+    /** Number of events appended since the last clear(), including overwritten ones. */
+    quint64 totalCount() const;
+    void clear();
+
+    void append(StateMachineEvent::Type type, quint64 id, qint64 timestamp);
+
+    /** Events with a timestamp in [from, to], oldest first. */
+    QVector<StateMachineEvent> events(qint64 from, qint64 to) const;
+    /** The @p count most recent events, oldest first. */
+    QVector<StateMachineEvent> lastEvents(int count) const;
+
+private:
+    const StateMachineEvent &at(int index) const;
+    int lowerBound(qint64 timestamp) const;
+
+    QVector<StateMachineEvent> m_events;
+    int m_head = 0; // index of the next write
+    int m_size = 0;
+    quint64 m_totalCount = 0;
+};
+}
+
+QT_BEGIN_NAMESPACE
+Q_DECLARE_TYPEINFO(GammaRay::StateMachineEvent, Q_PRIMITIVE_TYPE);
+QT_END_NAMESPACE
+
+#endif // GAMMARAY_STATEMACHINEVIEWER_TRANSITIONLOG_H
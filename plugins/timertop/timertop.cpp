@@ -98,6 +98,8 @@ TimerTop::TimerTop(Probe *probe, QObject *parent)
     SignalSpyCallbackSet callbacks;
     callbacks.signalBeginCallback = signal_begin_callback;
     callbacks.signalEndCallback = signal_end_callback;
+    callbacks.classNames = { QByteArrayLiteral("QTimer"), QByteArrayLiteral("QQmlTimer") };
+    callbacks.signalSignatures = { QByteArrayLiteral("timeout()"), QByteArrayLiteral("triggered()"), QByteArrayLiteral("runningChanged()") };
     probe->registerSignalSpyCallbackSet(callbacks);
 
     probe->registerModel(QStringLiteral("com.kdab.GammaRay.TimerModel"), TimerModel::instance());
@@ -31,7 +31,7 @@ int TranslationsModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return m_nodes.size();
+    return m_visibleRows;
 }
 
 int TranslationsModel::columnCount(const QModelIndex &) const
@@ -43,7 +43,7 @@ QVariant TranslationsModel::data(const QModelIndex &index, int role) const
 {
     if (!index.isValid())
         return QVariant();
-    Row node = m_nodes.at(index.row());
+    const Row &node = m_nodes.at(index.row());
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
         switch (index.column()) {
         case 0:
@@ -69,6 +69,8 @@ bool TranslationsModel::setData(const QModelIndex &index, const QVariant &value,
         if (node.translation == value.toString())
             return true;
         node.translation = value.toString();
+        if (!node.isOverridden)
+            ++m_overrideCount;
         node.isOverridden = true;
         emit dataChanged(index, index, QVector<int>() << Qt::DisplayRole << Qt::EditRole);
         return true;
@@ -119,68 +121,143 @@ void TranslationsModel::resetTranslations(const QItemSelection &selection)
         }
     }
 
+    removeRanges(ranges);
+}
+
+void TranslationsModel::removeRanges(const QVector<QPair<int, int>> &ranges)
+{
+    if (ranges.isEmpty())
+        return;
+
     for (int i = ranges.count() - 1; i >= 0; --i) {
         const auto &range = ranges[i];
+        const int count = range.second - range.first + 1;
         beginRemoveRows(QModelIndex(), range.first, range.second);
-        m_nodes.remove(range.first, range.second - range.first + 1);
+        for (int row = range.first; row <= range.second; ++row) {
+            if (m_nodes.at(row).isOverridden)
+                --m_overrideCount;
+        }
+        m_nodes.remove(range.first, count);
+        m_visibleRows -= count;
         endRemoveRows();
     }
+    rebuildIndex();
 }
 
 QString TranslationsModel::translation(const char *context, const char *sourceText,
                                        const char *disambiguation, const int n,
                                        const QString &default_)
 {
-    QModelIndex existingIndex = findNode(context, sourceText, disambiguation, n, true);
-    Row &row = m_nodes[existingIndex.row()];
-    if (!row.isOverridden)
-        setTranslation(existingIndex, default_);
-    return row.translation;
+    const int row = findNode(context, sourceText, disambiguation, n, true);
+    Row &node = m_nodes[row];
+    // retranslating mostly yields the same string again, which needs no update
+    if (!node.isOverridden && node.translation != default_) {
+        node.translation = default_;
+        if (row < m_visibleRows)
+            emit dataChanged(index(row, 3), index(row, 3));
+    }
+    return node.translation;
+}
+
+bool TranslationsModel::overriddenTranslation(const char *context, const char *sourceText,
+                                              const char *disambiguation, QString *translation) const
+{
+    const auto it = m_rowIndex.constFind(lookupKey(context, sourceText, disambiguation));
+    if (it == m_rowIndex.constEnd())
+        return false;
+    const auto &node = m_nodes.at(it.value());
+    if (!node.isOverridden)
+        return false;
+    *translation = node.translation;
+    return true;
 }
 
 void TranslationsModel::resetAllUnchanged()
 {
-    for (int i = 0; i < m_nodes.size(); ++i) {
-        if (!m_nodes[i].isOverridden)
-            resetTranslations(QItemSelection(index(i, 0), index(i, 0)));
+    QVector<QPair<int, int>> ranges; // pair of first/last
+    for (int i = 0; i < m_visibleRows; ++i) {
+        if (m_nodes.at(i).isOverridden)
+            continue;
+        if (ranges.isEmpty() || ranges.last().second != i - 1)
+            ranges << qMakePair(i, i);
+        else
+            ranges.last().second = i;
     }
+    removeRanges(ranges);
 }
 
-void TranslationsModel::setTranslation(const QModelIndex &index, const QString &translation)
+void TranslationsModel::insertPendingRows()
 {
-    if (!index.isValid())
+    m_insertPending = false;
+    if (m_visibleRows == m_nodes.size())
         return;
 
-    auto &row = m_nodes[index.row()];
-    if (row.isOverridden || row.translation == translation)
-        return;
-    row.translation = translation;
-    emit dataChanged(index, index);
+    beginInsertRows(QModelIndex(), m_visibleRows, m_nodes.size() - 1);
+    m_visibleRows = m_nodes.size();
+    endInsertRows();
 }
 
-QModelIndex TranslationsModel::findNode(const char *context, const char *sourceText,
-                                        const char *disambiguation, const int n, const bool create)
+TranslationsModel::Key TranslationsModel::lookupKey(const char *context, const char *sourceText,
+                                                    const char *disambiguation)
 {
-    Q_UNUSED(n);
-    // QUESTION make use of n?
+    // no copies for looking up, only stored keys need to own their data
+    Key key;
+    if (context)
+        key.context = QByteArray::fromRawData(context, qstrlen(context));
+    if (sourceText)
+        key.sourceText = QByteArray::fromRawData(sourceText, qstrlen(sourceText));
+    if (disambiguation)
+        key.disambiguation = QByteArray::fromRawData(disambiguation, qstrlen(disambiguation));
+    return key;
+}
+
+QByteArray TranslationsModel::intern(const char *string)
+{
+    if (!string || !*string)
+        return QByteArray();
+    const auto it = m_strings.constFind(QByteArray::fromRawData(string, qstrlen(string)));
+    if (it != m_strings.constEnd())
+        return *it;
+    const QByteArray s(string);
+    m_strings.insert(s);
+    return s;
+}
+
+void TranslationsModel::rebuildIndex()
+{
+    m_rowIndex.clear();
+    m_rowIndex.reserve(m_nodes.size());
     for (int i = 0; i < m_nodes.size(); ++i) {
-        const Row &node = m_nodes.at(i);
-        if (node.context == context && node.sourceText == sourceText
-            && node.disambiguation == disambiguation)
-            return index(i, 0);
+        const auto &node = m_nodes.at(i);
+        m_rowIndex.insert({ node.context, node.sourceText, node.disambiguation }, i);
     }
-    if (create) {
-        Row node;
-        node.context = context;
-        node.sourceText = sourceText;
-        node.disambiguation = disambiguation;
-        const int newRow = m_nodes.size();
-        beginInsertRows(QModelIndex(), newRow, newRow);
-        m_nodes.append(node);
-        endInsertRows();
-        return index(newRow, 0);
+}
+
+int TranslationsModel::findNode(const char *context, const char *sourceText,
+                                const char *disambiguation, const int n, const bool create)
+{
+    Q_UNUSED(n);
+    // QUESTION make use of n?
+    const auto it = m_rowIndex.constFind(lookupKey(context, sourceText, disambiguation));
+    if (it != m_rowIndex.constEnd())
+        return it.value();
+    if (!create)
+        return -1;
+
+    Row node;
+    node.context = intern(context);
+    node.sourceText = sourceText;
+    node.disambiguation = intern(disambiguation);
+    const int newRow = m_nodes.size();
+    m_nodes.append(node);
+    m_rowIndex.insert({ node.context, node.sourceText, node.disambiguation }, newRow);
+
+    // a view rebuild or language change translates lots of strings at once, announce them together
+    if (!m_insertPending) {
+        m_insertPending = true;
+        QMetaObject::invokeMethod(this, &TranslationsModel::insertPendingRows, Qt::QueuedConnection);
     }
-    return {};
+    return newRow;
 }
 
 TranslatorWrapper::TranslatorWrapper(QTranslator *wrapped, QObject *parent)
@@ -204,10 +281,16 @@ bool TranslatorWrapper::isEmpty() const
 QString TranslatorWrapper::translate(const char *context, const char *sourceText,
                                      const char *disambiguation, int n) const
 {
-    const QString translation = translateInternal(context, sourceText, disambiguation, n);
-
     if (context && strncmp(context, "GammaRay::", 10) == 0)
+        return translateInternal(context, sourceText, disambiguation, n);
+
+    // overrides don't depend on the wrapped translator, so there's no need to ask it
+    QString translation;
+    if (m_model->hasOverrides()
+        && m_model->overriddenTranslation(context, sourceText, disambiguation, &translation))
         return translation;
+
+    translation = translateInternal(context, sourceText, disambiguation, n);
     // it's not for this translator
     if (translation.isNull())
         return translation;
@@ -17,7 +17,10 @@
 #include <common/modelroles.h>
 
 #include <QAbstractItemModel>
+#include <QHash>
+#include <QSet>
 #include <QTranslator>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QItemSelection;
@@ -48,9 +51,19 @@ public:
     void resetTranslations(const QItemSelection &selection);
     QString translation(const char *context, const char *sourceText, const char *disambiguation,
                         const int n, const QString &default_);
+    /** Looks up the overridden translation for the given string, returns @c false if there is none. */
+    bool overriddenTranslation(const char *context, const char *sourceText, const char *disambiguation,
+                               QString *translation) const;
+    bool hasOverrides() const
+    {
+        return m_overrideCount > 0;
+    }
 
     void resetAllUnchanged();
 
+    /** New strings are added as rows in batches, this inserts the pending ones right away. */
+    void insertPendingRows();
+
     TranslatorWrapper *translator() const
     {
         return m_translator;
@@ -73,10 +86,39 @@ private:
         bool isOverridden = false;
     };
     QVector<Row> m_nodes;
+    // rows of m_nodes from this one on have not been announced to views yet
+    int m_visibleRows = 0;
+    bool m_insertPending = false;
+    int m_overrideCount = 0;
 
-    QModelIndex findNode(const char *context, const char *sourceText, const char *disambiguation,
-                         const int n, const bool create);
-    void setTranslation(const QModelIndex &index, const QString &translation);
+    struct Key
+    {
+        QByteArray context;
+        QByteArray sourceText;
+        QByteArray disambiguation;
+
+        bool operator==(const Key &other) const
+        {
+            return sourceText == other.sourceText && context == other.context
+                && disambiguation == other.disambiguation;
+        }
+        friend uint qHash(const Key &key, uint seed = 0)
+        {
+            seed = qHash(key.context, seed);
+            seed = qHash(key.sourceText, seed);
+            return qHash(key.disambiguation, seed);
+        }
+    };
+    QHash<Key, int> m_rowIndex;
+    // contexts and disambiguations, shared by all rows using them
+    QSet<QByteArray> m_strings;
+
+    static Key lookupKey(const char *context, const char *sourceText, const char *disambiguation);
+    QByteArray intern(const char *string);
+    void rebuildIndex();
+    void removeRanges(const QVector<QPair<int, int>> &ranges);
+    int findNode(const char *context, const char *sourceText, const char *disambiguation,
+                 const int n, const bool create);
 };
 
 class TranslatorWrapper : public QTranslator
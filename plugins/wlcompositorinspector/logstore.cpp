@@ -0,0 +1,221 @@
+/*
+  logstore.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "logstore.h"
+
+#include <algorithm>
+
+using namespace GammaRay;
+
+static const int MinBucketShift = 16; // ~65µs
+static const int DensityLevels = 16;
+static const int MaxBuckets = 1 << 20; // per level
+
+LogStore::LogStore(int maxChunks)
+    : m_maxChunks(qMax(1, maxChunks))
+{
+}
+
+void LogStore::append(quint64 pid, qint64 time, const QByteArray &message)
+{
+    if (m_chunks.isEmpty() || m_chunks.last().size() == ChunkSize) {
+        if (m_chunks.size() == m_maxChunks)
+            dropFirstChunk();
+        m_chunks.push_back(QVector<LogEntry>());
+        m_chunks.last().reserve(ChunkSize);
+    }
+
+    m_chunks.last().push_back({ time, pid, message });
+    m_clientEntries[pid].push_back(m_firstSequence + m_count);
+    ++m_count;
+    addToDensity(time);
+}
+
+void LogStore::clear()
+{
+    m_chunks.clear();
+    m_count = 0;
+    m_firstSequence = 0;
+    m_clientEntries.clear();
+    m_density.clear();
+    m_densityOrigin = 0;
+}
+
+int LogStore::count() const
+{
+    return m_count;
+}
+
+const LogEntry &LogStore::at(int index) const
+{
+    Q_ASSERT(index >= 0 && index < m_count);
+    // only the last chunk is ever partially filled
+    return m_chunks.at(index / ChunkSize).at(index % ChunkSize);
+}
+
+int LogStore::count(quint64 pid) const
+{
+    if (!pid)
+        return m_count;
+    const auto it = m_clientEntries.constFind(pid);
+    return it == m_clientEntries.constEnd() ? 0 : it.value().size();
+}
+
+int LogStore::entryIndex(quint64 pid, int row) const
+{
+    if (!pid)
+        return row;
+    const auto it = m_clientEntries.constFind(pid);
+    Q_ASSERT(it != m_clientEntries.constEnd() && row >= 0 && row < it.value().size());
+    return int(it.value().at(row) - m_firstSequence);
+}
+
+int LogStore::lowerBound(qint64 time) const
+{
+    int begin = 0;
+    int count = m_count;
+    while (count > 0) {
+        const auto step = count / 2;
+        if (at(begin + step).time < time) {
+            begin += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return begin;
+}
+
+qint64 LogStore::startTime() const
+{
+    return m_count ? at(0).time : 0;
+}
+
+qint64 LogStore::endTime() const
+{
+    return m_count ? at(m_count - 1).time : 0;
+}
+
+QVector<quint32> LogStore::density(qint64 from, qreal binWidth, int bins) const
+{
+    QVector<quint32> result(qMax(0, bins), 0);
+    if (bins <= 0 || binWidth <= 0 || m_count == 0)
+        return result;
+
+    const DensityLevel *level = nullptr;
+    for (const auto &l : m_density) {
+        if ((qint64(1) << l.shift) > binWidth)
+            break;
+        level = &l;
+    }
+
+    if (!level) {
+        // bins are finer than the histogram, but then there are only few entries per bin anyway
+        auto begin = lowerBound(from);
+        for (int bin = 0; bin < bins && begin < m_count; ++bin) {
+            const auto end = lowerBound(from + qint64((bin + 1) * binWidth));
+            result[bin] = end - begin;
+            begin = end;
+        }
+        return result;
+    }
+
+    const auto to = from + qint64(bins * binWidth); // exclusive
+    if (to <= m_densityOrigin)
+        return result;
+    const auto firstBucket = qMax(level->firstBucket, qMax<qint64>(0, from - m_densityOrigin) >> level->shift);
+    const auto lastBucket = qMin(level->firstBucket + level->counts.size() - 1, (to - 1 - m_densityOrigin) >> level->shift);
+    for (auto bucket = firstBucket; bucket <= lastBucket; ++bucket) {
+        const auto count = level->counts.at(int(bucket - level->firstBucket));
+        if (!count)
+            continue;
+        const auto start = m_densityOrigin + (bucket << level->shift);
+        const auto bin = qBound(0, int((start - from) / binWidth), bins - 1);
+        result[bin] += count;
+    }
+    return result;
+}
+
+void LogStore::dropFirstChunk()
+{
+    const auto chunk = m_chunks.takeFirst();
+    for (const auto &entry : chunk)
+        removeFromDensity(entry.time);
+    m_count -= chunk.size();
+    m_firstSequence += chunk.size();
+
+    for (auto it = m_clientEntries.begin(); it != m_clientEntries.end();) {
+        auto &entries = it.value();
+        entries.erase(entries.begin(), std::lower_bound(entries.begin(), entries.end(), m_firstSequence));
+        if (entries.isEmpty())
+            it = m_clientEntries.erase(it);
+        else
+            ++it;
+    }
+
+    // release the now empty leading buckets
+    for (auto &level : m_density) {
+        int empty = 0;
+        while (empty < level.counts.size() && level.counts.at(empty) == 0)
+            ++empty;
+        level.counts.remove(0, empty);
+        level.firstBucket += empty;
+    }
+}
+
+void LogStore::addToDensity(qint64 time)
+{
+    if (m_density.isEmpty()) {
+        m_densityOrigin = time;
+        for (int i = 0; i < DensityLevels; ++i)
+            m_density.push_back({ MinBucketShift + i, 0, QVector<quint32>() });
+    }
+
+    const auto offset = qMax<qint64>(0, time - m_densityOrigin);
+
+    // the finest level grows fastest, as long as it would get too large replace it by a coarser one on top,
+    // this depends on the time covered rather than the number of events, so a single late event can take several steps
+    while ((offset >> m_density.first().shift) - m_density.first().firstBucket >= MaxBuckets) {
+        m_density.removeFirst();
+        addDensityLevel();
+    }
+
+    for (auto &level : m_density) {
+        const auto index = int((offset >> level.shift) - level.firstBucket);
+        Q_ASSERT(index >= 0 && index < MaxBuckets);
+        if (index >= level.counts.size())
+            level.counts.resize(index + 1);
+        ++level.counts[index];
+    }
+}
+
+void LogStore::removeFromDensity(qint64 time)
+{
+    const auto offset = qMax<qint64>(0, time - m_densityOrigin);
+    for (auto &level : m_density) {
+        const auto index = int((offset >> level.shift) - level.firstBucket);
+        Q_ASSERT(index >= 0 && index < level.counts.size() && level.counts.at(index) > 0);
+        --level.counts[index];
+    }
+}
+
+void LogStore::addDensityLevel()
+{
+    const auto &top = m_density.last();
+    DensityLevel level { top.shift + 1, top.firstBucket >> 1, QVector<quint32>() };
+    if (!top.counts.isEmpty()) {
+        level.counts.resize(int(((top.firstBucket + top.counts.size() - 1) >> 1) - level.firstBucket + 1));
+        for (int i = 0; i < top.counts.size(); ++i)
+            level.counts[int(((top.firstBucket + i) >> 1) - level.firstBucket)] += top.counts.at(i);
+    }
+    m_density.push_back(level);
+}
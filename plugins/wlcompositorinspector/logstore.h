@@ -0,0 +1,101 @@
+/*
+  logstore.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_LOGSTORE_H
+#define GAMMARAY_LOGSTORE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+namespace GammaRay {
+
+struct LogEntry
+{
+    qint64 time;
+    quint64 pid;
+    QByteArray message;
+};
+
+/**
+ * Append-only store for the compositor protocol log.
+ *
+ * Entries are kept in fixed-size chunks, once the capacity is exceeded the oldest
+ * chunk is released as a whole. Timestamps are expected to be non-decreasing, which
+ * allows looking up entries by time using binary search.
+ *
+ * Alongside the entries a histogram of event counts is maintained at multiple
+ * resolutions (each level doubling the bucket width of the previous one), so that
+ * the density of large time ranges can be drawn without touching the entries.
+ */
+class LogStore
+{
+public:
+    enum
+    {
+        ChunkSize = 4096
+    };
+
+    explicit LogStore(int maxChunks = 64);
+
+    void append(quint64 pid, qint64 time, const QByteArray &message);
+    void clear();
+
+    int count() const;
+    const LogEntry &at(int index) const;
+
+    /** Number of entries of client @p pid, or of all entries if @p pid is 0. */
+    int count(quint64 pid) const;
+    /** Index of the @p row'th entry of client @p pid, or @p row if @p pid is 0. */
+    int entryIndex(quint64 pid, int row) const;
+
+    /** Index of the first entry not older than @p time, count() if there is none. */
+    int lowerBound(qint64 time) const;
+
+    qint64 startTime() const;
+    qint64 endTime() const;
+
+    /**
+     * Number of events in @p bins consecutive bins of @p binWidth nanoseconds each,
+     * starting at @p from. Uses the coarsest histogram level that is still finer than
+     * a bin, and falls back to counting entries when the bins are finer than that.
+     */
+    QVector<quint32> density(qint64 from, qreal binWidth, int bins) const;
+
+private:
+    struct DensityLevel
+    {
+        int shift;
+        qint64 firstBucket;
+        QVector<quint32> counts;
+    };
+
+    void dropFirstChunk();
+    void addToDensity(qint64 time);
+    void removeFromDensity(qint64 time);
+    void addDensityLevel();
+
+    QList<QVector<LogEntry>> m_chunks;
+    int m_maxChunks;
+    int m_count = 0;
+    qint64 m_firstSequence = 0; // sequence number of at(0)
+
+    // sequence numbers of the entries of each client
+    QHash<quint64, QVector<qint64>> m_clientEntries;
+
+    QVector<DensityLevel> m_density;
+    qint64 m_densityOrigin = 0;
+};
+}
+
+#endif // GAMMARAY_LOGSTORE_H
@@ -15,23 +15,33 @@
 
 #include <QMouseEvent>
 #include <QScrollBar>
-#include <QStaticText>
 #include <QPainter>
 #include <QScrollArea>
 #include <QClipboard>
 #include <QApplication>
+#include <QTimer>
 #include <QtMath>
 
-#include "ringbuffer.h"
+#include <algorithm>
+#include <cmath>
+
+#include "logstore.h"
 
 namespace GammaRay {
 
+static const int UpdateInterval = 50; // ms
+
+static QString formatLine(const LogEntry &entry)
+{
+    return QString("[%1ms] %2").arg(QString::number(entry.time / 1e6), QString(entry.message));
+}
+
 class View : public QWidget
 {
 public:
-    explicit View(QWidget *p)
+    explicit View(const LogStore *store, QWidget *p)
         : QWidget(p)
-        , m_lines(5000)
+        , m_store(store)
         , m_metrics(QFont())
         , m_lineHeight(m_metrics.height())
         , m_client(0)
@@ -46,22 +56,27 @@ public:
         return size();
     }
 
-    void drawLine(QPainter &painter, const QRect &rect, const QStaticText &line)
+    // rows are the lines of the currently shown client
+    QString lineText(int row) const
+    {
+        return formatLine(m_store->at(m_store->entryIndex(m_client, row)));
+    }
+
+    void drawLine(QPainter &painter, const QRect &rect, const QString &text)
     {
         painter.setPen(palette().color(QPalette::Text));
-        painter.drawStaticText(0, rect.y(), line);
+        painter.drawText(rect, Qt::TextDontClip, text);
     }
 
-    void drawLineSelected(QPainter &painter, const QRect &rect, const QStaticText &line)
+    void drawLineSelected(QPainter &painter, const QRect &rect, const QString &text)
     {
         painter.fillRect(rect, palette().highlight());
         painter.setPen(palette().color(QPalette::HighlightedText));
-        painter.drawStaticText(0, rect.y(), line);
+        painter.drawText(rect, Qt::TextDontClip, text);
     }
 
-    void drawLinePartialSelected(QPainter &painter, const QRect &rect, const QStaticText &line, int startSelectChar, int endSelectChar)
+    void drawLinePartialSelected(QPainter &painter, const QRect &rect, const QString &text, int startSelectChar, int endSelectChar)
     {
-        const QString &text = line.text();
         const int startX = m_metrics.horizontalAdvance(text.left(startSelectChar));
         const int endX = m_metrics.horizontalAdvance(text.left(endSelectChar));
 
@@ -74,7 +89,7 @@ public:
         painter.setPen(palette().color(QPalette::HighlightedText));
         painter.drawText(selectRect, Qt::TextDontClip, text.mid(startSelectChar, endSelectChar - startSelectChar));
 
-        if (endSelectChar < text.count()) {
+        if (endSelectChar < text.size()) {
             painter.setPen(palette().color(QPalette::Text));
             painter.drawText(QRect(rect.x() + endX, rect.y(), m_metrics.horizontalAdvance(text) - endX, rect.height()), text.mid(endSelectChar));
         }
@@ -101,7 +116,7 @@ public:
         int start;
         int end;
     };
-    LineSelection lineSelection(int line) const
+    LineSelection lineSelection(int row, const QString &text) const
     {
         if (m_selectionStart == m_selectionEnd) {
             return { 0, 0 };
@@ -110,16 +125,16 @@ public:
         QPoint start, end;
         selectionBoundaries(start, end);
 
-        if (start.y() < line && line < end.y()) {
-            return { 0, ( int )m_lines.at(line).text.text().count() };
+        if (start.y() < row && row < end.y()) {
+            return { 0, ( int )text.size() };
         }
 
-        if (start.y() == line || end.y() == line) {
+        if (start.y() == row || end.y() == row) {
             int startChar = 0;
-            int endChar = m_lines.at(line).text.text().count();
-            if (start.y() == line)
+            int endChar = text.size();
+            if (start.y() == row)
                 startChar = start.x();
-            if (end.y() == line)
+            if (end.y() == row)
                 endChar = end.x() + 1;
             return { startChar, endChar };
         }
@@ -129,26 +144,24 @@ public:
 
     void paintEvent(QPaintEvent *event) override
     {
-        if (m_lineHeight < 0) {
+        if (m_lineHeight <= 0) {
             return;
         }
 
         QPainter painter(this);
 
+        // only the visible rows are looked at, independent of how many there are
         QRectF drawRect = event->rect();
-        int startingLine = lineAt(drawRect.y());
+        const int rows = linesCount();
         int y = linePosAt(drawRect.y());
 
-        for (int i = startingLine; i < m_lines.count(); ++i) {
-            if (m_client && m_lines.at(i).pid != m_client) {
-                continue;
-            }
-            const QStaticText &text = m_lines.at(i).text;
+        for (int row = lineAt(drawRect.y()); row < rows; ++row) {
+            const QString text = lineText(row);
 
-            QRect lineRect(QRect(0, y, text.size().width(), m_lineHeight));
-            painter.fillRect(QRectF(0, y, drawRect.width(), m_lineHeight), i % 2 ? palette().base() : palette().alternateBase());
+            QRect lineRect(QRect(0, y, m_metrics.horizontalAdvance(text), m_lineHeight));
+            painter.fillRect(QRectF(0, y, drawRect.width(), m_lineHeight), row % 2 ? palette().base() : palette().alternateBase());
 
-            LineSelection selection = lineSelection(i);
+            LineSelection selection = lineSelection(row, text);
             if (selection.isNull()) {
                 drawLine(painter, lineRect, text);
             } else if (selection.isFull()) {
@@ -165,38 +178,29 @@ public:
 
     inline int linesCount() const
     {
-        return m_client ? m_linesCount.value(m_client) : m_lines.count();
+        return m_store->count(m_client);
     }
 
     inline int linePosAt(int y) const
     {
-        int line = qMin(y / m_lineHeight, m_lines.count() - 1);
-        return line * m_lineHeight;
+        return lineAt(y) * m_lineHeight;
     }
 
     inline int lineAt(int y) const
     {
-        int line = qMin(y / m_lineHeight, m_lines.count() - 1);
-        if (!m_client) {
-            return line;
-        }
-
-        for (int i = 0, l = 0; i < m_lines.count(); ++i) {
-            if (m_lines.at(i).pid == m_client) {
-                if (l++ == line) {
-                    return i;
-                }
-            }
-        }
-        return line;
+        return qBound(0, y / m_lineHeight, qMax(0, linesCount() - 1));
     }
+
     inline QPoint charPosAt(const QPointF &p) const
     {
+        if (linesCount() == 0)
+            return {};
+
         int line = lineAt(p.y());
         int lineX = 0;
 
-        const QString &text = m_lines.at(line).text.text();
-        for (int x = 0, i = 0; i < text.count(); ++i) {
+        const QString text = lineText(line);
+        for (int x = 0, i = 0; i < text.size(); ++i) {
             const QChar &c = text.at(i);
             if (p.x() >= x) {
                 lineX = i;
@@ -232,16 +236,13 @@ public:
         QPoint start, end;
         selectionBoundaries(start, end);
         QString string;
-        for (int i = start.y(); i <= end.y(); ++i) {
-            if (m_client && m_lines.at(i).pid != m_client) {
-                continue;
-            }
-            const QStaticText &line = m_lines.at(i).text;
-            LineSelection selection = lineSelection(i);
+        for (int i = start.y(); i <= end.y() && i < linesCount(); ++i) {
+            const QString line = lineText(i);
+            LineSelection selection = lineSelection(i, line);
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-            string += line.text().midRef(selection.start, selection.end - selection.start);
+            string += line.midRef(selection.start, selection.end - selection.start);
 #else
-            string += line.text().mid(selection.start, selection.end - selection.start);
+            string += line.mid(selection.start, selection.end - selection.start);
 #endif
             string += QLatin1Char('\n');
         }
@@ -261,49 +262,7 @@ public:
         update();
     }
 
-    struct Line
-    {
-        quint64 pid = 0;
-        QStaticText text;
-        int *counter = nullptr;
-
-        Line() = default;
-
-        Line(quint64 p, const QStaticText &t, int *cnt)
-            : pid(p)
-            , text(t)
-            , counter(cnt)
-        {
-            (*counter)++;
-        }
-
-        Line(const Line &l)
-            : pid(l.pid)
-            , text(l.text)
-            , counter(l.counter)
-        {
-            (*counter)++;
-        }
-
-        ~Line()
-        {
-            (*counter)--;
-        }
-
-        Line &operator=(const Line &l)
-        {
-            (*counter)--;
-
-            pid = l.pid;
-            text = l.text;
-            counter = l.counter;
-
-            (*counter)++;
-            return *this;
-        }
-    };
-    RingBuffer<Line> m_lines;
-    QHash<quint64, int> m_linesCount;
+    const LogStore *m_store;
     QFontMetricsF m_metrics;
     int m_lineHeight;
     QPoint m_selectionStart;
@@ -315,55 +274,60 @@ public:
 class Messages : public QScrollArea
 {
 public:
-    explicit Messages(QWidget *parent)
+    explicit Messages(const LogStore *store, QWidget *parent)
         : QScrollArea(parent)
-        , m_view(new View(this))
+        , m_view(new View(store, this))
+        , m_updateTimer(new QTimer(this))
     {
         m_view->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
         setWidget(m_view);
         setWidgetResizable(true);
+
+        m_updateTimer->setSingleShot(true);
+        m_updateTimer->setInterval(UpdateInterval);
+        QObject::connect(m_updateTimer, &QTimer::timeout, this, [this]() {
+            updateSize();
+        });
     }
 
     void logMessage(quint64 pid, qint64 time, const QByteArray &msg)
     {
-        auto scrollbar = verticalScrollBar();
-        bool scroll = scrollbar->value() >= scrollbar->maximum();
-
-        add(pid, time, msg);
+        if (m_view->m_client && pid != m_view->m_client) {
+            return;
+        }
 
-        if (scroll)
-            scrollbar->setValue(scrollbar->maximum());
+        // the layout is only updated periodically, remember the longest line until then
+        if (msg.size() >= m_widestPending.message.size())
+            m_widestPending = { time, pid, msg };
+        if (!m_updateTimer->isActive())
+            m_updateTimer->start();
     }
 
-    void reset() const
+    void reset()
     {
-        m_view->m_lines.clear();
+        m_updateTimer->stop();
+        m_widestPending = LogEntry();
+        m_view->resetSelection();
         m_view->resize(0, 0);
     }
 
-    void updateSize() const
+    void updateSize()
     {
-        QSizeF lineSize = m_view->m_lines.last().text.size();
+        auto scrollbar = verticalScrollBar();
+        bool scroll = scrollbar->value() >= scrollbar->maximum();
 
         int w = m_view->width();
         int h = m_view->linesCount() * m_view->m_lineHeight;
 
-        if (lineSize.width() > w) {
-            w = lineSize.width();
+        if (!m_widestPending.message.isEmpty()) {
+            w = qMax<int>(w, m_view->m_metrics.horizontalAdvance(formatLine(m_widestPending)));
+            m_widestPending = LogEntry();
         }
         m_view->resize(w, h);
         m_view->update();
-    }
 
-    void add(quint64 pid, qint64 time, const QByteArray &m)
-    {
-        m_view->m_lines.append(View::Line(pid, QStaticText(QString("[%1ms] %2").arg(QString::number(time / 1e6), QString(m))), &m_view->m_linesCount[pid]));
-
-        if (m_view->m_client && pid != m_view->m_client) {
-            return;
-        }
-
-        updateSize();
+        if (scroll)
+            scrollbar->setValue(scrollbar->maximum());
     }
 
     void setLoggingClient(quint64 pid)
@@ -374,6 +338,7 @@ public:
         qreal v = ( qreal )scrollbar->value() / ( qreal )scrollbar->maximum();
 
         m_view->resetSelection();
+        m_updateTimer->stop();
         updateSize();
 
         // keep the scrollbar at he same percentage
@@ -381,6 +346,8 @@ public:
     }
 
     View *m_view;
+    QTimer *m_updateTimer;
+    LogEntry m_widestPending = LogEntry();
 };
 
 
@@ -390,15 +357,8 @@ public:
     class View : public QWidget
     {
     public:
-        struct DataPoint
-        {
-            qint64 time;
-            quint64 pid;
-            QByteArray msg;
-        };
-
-        View()
-            : m_data(5000)
+        explicit View(const LogStore *store)
+            : m_store(store)
         {
             resize(100, 100);
             setAttribute(Qt::WA_OpaquePaintEvent);
@@ -412,7 +372,7 @@ public:
 
         inline qint64 initialTime() const
         {
-            return m_data.isEmpty() ? 0 : m_data.at(0).time;
+            return m_store->startTime();
         }
 
         void paintEvent(QPaintEvent *event) override
@@ -470,39 +430,52 @@ public:
                 }
             }
 
-            // finally draw the event lines
-            painter.setPen(palette.color(QPalette::Text));
-            bool hasDrawn = false;
-            for (int i = 0; i < m_data.count(); ++i) {
-                const auto &point = m_data.at(i);
-                if (m_client && point.pid != m_client) {
-                    painter.setPen(palette.color(QPalette::Dark));
-                } else {
-                    painter.setPen(palette.color(QPalette::Text));
+            // finally draw the events in the visible time range
+            const qreal y = qMax(qreal(40.), drawRect.y());
+            const int left = qFloor(drawRect.left());
+            const int width = qCeil(drawRect.right()) - left + 1;
+            const qint64 from = m_start + left * m_zoom;
+            const int begin = m_store->lowerBound(from);
+            const int end = m_store->lowerBound(m_start + (left + width) * m_zoom);
+
+            if (end - begin <= width) {
+                for (int i = begin; i < end; ++i) {
+                    const auto &entry = m_store->at(i);
+                    if (m_client && entry.pid != m_client) {
+                        painter.setPen(palette.color(QPalette::Dark));
+                    } else {
+                        painter.setPen(palette.color(QPalette::Text));
+                    }
+
+                    qreal x = (entry.time - m_start) / m_zoom;
+                    painter.drawLine(QPointF(x, y), QPointF(x, drawRect.bottom()));
                 }
+                return;
+            }
 
-                qreal offset = point.time - m_start;
-                qreal x = offset / m_zoom;
-                qreal y = qMax(qreal(40.), drawRect.y());
-                if (!drawRect.contains(QPoint(x, y))) {
-                    if (hasDrawn)
-                        break;
-                    else
-                        continue;
-                }
-                hasDrawn = true;
-
-                painter.drawLine(x, y, x, drawRect.bottom());
+            // too many events to tell apart, draw their density per pixel instead
+            const auto density = m_store->density(from, m_zoom, width);
+            const auto maxCount = *std::max_element(density.constBegin(), density.constEnd());
+            QColor color = palette.color(QPalette::Text);
+            for (int i = 0; i < width; ++i) {
+                if (!density.at(i))
+                    continue;
+                color.setAlphaF(0.25 + 0.75 * std::log1p(density.at(i)) / std::log1p(maxCount));
+                painter.setPen(color);
+                painter.drawLine(QPointF(left + i, y), QPointF(left + i, drawRect.bottom()));
             }
         }
 
         void mouseMoveEvent(QMouseEvent *e) override
         {
             const QPointF &pos = e->localPos();
-            for (int i = 0; i < m_data.count(); ++i) {
-                qreal timex = (m_data.at(i).time - m_start) / m_zoom;
+            const qint64 time = m_start + pos.x() * m_zoom;
+            for (int i = m_store->lowerBound(time - 2 * m_zoom); i < m_store->count(); ++i) {
+                qreal timex = (m_store->at(i).time - m_start) / m_zoom;
+                if (timex - pos.x() >= 2)
+                    break;
                 if (fabs(pos.x() - timex) < 2) {
-                    setToolTip(m_data.at(i).msg);
+                    setToolTip(m_store->at(i).message);
                     return;
                 }
             }
@@ -516,33 +489,50 @@ public:
 
         void updateSize()
         {
-            if (m_data.count() == 0)
+            if (m_store->count() == 0) {
+                update();
                 return;
+            }
 
-            m_start = round(m_data.at(0).time, -1);
-            m_timespan = round(m_data.last().time, 1) - m_start;
+            m_start = round(m_store->startTime(), -1);
+            m_timespan = round(m_store->endTime(), 1) - m_start;
             resize(m_timespan / m_zoom, height());
+            update();
         }
 
-        RingBuffer<DataPoint> m_data;
+        const LogStore *m_store;
         qreal m_zoom = 100000;
         qint64 m_start = 0;
         qint64 m_timespan = 0;
         quint64 m_client = 0;
     };
 
-    explicit Timeline(QWidget *parent)
+    explicit Timeline(const LogStore *store, QWidget *parent)
         : QScrollArea(parent)
+        , m_view(store)
+        , m_updateTimer(new QTimer(this))
     {
         m_view.setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
         setWidget(&m_view);
         setWidgetResizable(true);
         m_view.installEventFilter(this);
+
+        m_updateTimer->setSingleShot(true);
+        m_updateTimer->setInterval(UpdateInterval);
+        QObject::connect(m_updateTimer, &QTimer::timeout, this, [this]() {
+            m_view.updateSize();
+        });
     }
 
-    void logMessage(quint64 pid, qint64 time, const QByteArray &msg)
+    void logMessage()
     {
-        m_view.m_data.append({ time, pid, msg });
+        if (!m_updateTimer->isActive())
+            m_updateTimer->start();
+    }
+
+    void reset()
+    {
+        m_updateTimer->stop();
         m_view.updateSize();
     }
 
@@ -576,18 +566,22 @@ public:
     }
 
     View m_view;
+    QTimer *m_updateTimer;
 };
 
 LogView::LogView(QWidget *p)
     : QTabWidget(p)
-    , m_messages(new Messages(this))
-    , m_timeline(new Timeline(this))
+    , m_store(new LogStore)
+    , m_messages(new Messages(m_store.get(), this))
+    , m_timeline(new Timeline(m_store.get(), this))
 {
     setTabPosition(QTabWidget::West);
     addTab(m_messages, tr("Messages"));
     addTab(m_timeline, tr("Timeline"));
 }
 
+LogView::~LogView() = default;
+
 QSize LogView::sizeHint() const
 {
     return { 200, 200 };
@@ -595,8 +589,9 @@ QSize LogView::sizeHint() const
 
 void LogView::logMessage(quint64 pid, qint64 time, const QByteArray &msg)
 {
+    m_store->append(pid, time, msg);
     m_messages->logMessage(pid, time, msg);
-    m_timeline->logMessage(pid, time, msg);
+    m_timeline->logMessage();
 }
 
 void LogView::setLoggingClient(quint64 pid)
@@ -607,7 +602,9 @@ void LogView::setLoggingClient(quint64 pid)
 
 void LogView::reset()
 {
+    m_store->clear();
     m_messages->reset();
+    m_timeline->reset();
 }
 
 }
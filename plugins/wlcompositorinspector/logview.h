@@ -17,8 +17,11 @@
 #include <QScrollArea>
 #include <QTabWidget>
 
+#include <memory>
+
 namespace GammaRay {
 
+class LogStore;
 class Messages;
 class Timeline;
 
@@ -27,6 +30,7 @@ class LogView : public QTabWidget
     Q_OBJECT
 public:
     explicit LogView(QWidget *p);
+    ~LogView() override;
 
     QSize sizeHint() const override;
     void logMessage(quint64 pid, qint64 time, const QByteArray &msg);
@@ -34,6 +38,7 @@ public:
     void reset();
 
 private:
+    std::unique_ptr<LogStore> m_store;
     Messages *m_messages;
     Timeline *m_timeline;
 };
@@ -14,30 +14,91 @@
 #include "benchsuite.h"
 #include "core/probe.h"
 #include "core/util.h"
+#include "core/remote/server.h"
 
 #include <QtTestGui>
 
+#include <QFile>
 #include <QLabel>
+#include <QLocalSocket>
+#include <QScrollBar>
+#include <QSlider>
+#include <QTemporaryDir>
 #include <QTreeView>
 
 QTEST_MAIN(GammaRay::BenchSuite)
 
 using namespace GammaRay;
 
+void BenchSuite::iconForObject_data()
+{
+    QTest::addColumn<int>("hierarchy");
+
+    QTest::newRow("shallow") << 0;
+    QTest::newRow("deep") << 1;
+    QTest::newRow("property rules") << 2;
+}
+
 void BenchSuite::iconForObject()
 {
+    QFETCH(int, hierarchy);
+
     QWidget widget;
     QLabel label;
     QTreeView treeView;
+    DeepWidget8 deepWidget;
+    QSlider slider(Qt::Vertical);
+    QScrollBar scrollBar(Qt::Horizontal);
+
+    QVector<QObject *> objects;
+    switch (hierarchy) {
+    case 0:
+        objects << this << &widget << &label << &treeView;
+        break;
+    case 1:
+        objects << &deepWidget;
+        break;
+    case 2:
+        objects << &slider << &scrollBar;
+        break;
+    }
+
     QBENCHMARK
     {
-        Util::iconIdForObject(this);
-        Util::iconIdForObject(&widget);
-        Util::iconIdForObject(&label);
-        Util::iconIdForObject(&treeView);
+        for (auto object : objects)
+            Util::iconIdForObject(object);
     }
 }
 
+void BenchSuite::server_forwardSignal()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString socketPath = dir.path() + QLatin1String("/gammaray.socket");
+    qputenv("GAMMARAY_ServerAddress", QByteArray("local://") + QFile::encodeName(socketPath));
+
+    Server server;
+    QVERIFY(server.listen());
+    QLocalSocket socket;
+    socket.connectToServer(socketPath);
+    QTRY_VERIFY(Server::isConnected());
+
+    BenchEmitter emitter;
+    server.registerObject(QStringLiteral("com.kdab.GammaRay.BenchEmitter"), &emitter, Server::ExportSignals);
+    const QString text = QStringLiteral("GammaRay");
+
+    QBENCHMARK
+    {
+        for (int i = 0; i < 1000; ++i)
+            emit emitter.valueChanged(i, text);
+        // drain what we have sent so far, to not grow the socket buffers indefinitely
+        QCoreApplication::processEvents();
+        socket.readAll();
+    }
+
+    qunsetenv("GAMMARAY_ServerAddress");
+}
+
 void BenchSuite::probe_objectAdded()
 {
     Probe::createProbe(false);
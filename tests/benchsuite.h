@@ -15,14 +15,58 @@
 #define GAMMARAY_BENCHSUITE_H
 
 #include <QObject>
+#include <QWidget>
 
 namespace GammaRay {
+// deep class hierarchy without any icon of its own, for iconForObject
+class DeepWidget1 : public QWidget
+{
+    Q_OBJECT
+};
+class DeepWidget2 : public DeepWidget1
+{
+    Q_OBJECT
+};
+class DeepWidget3 : public DeepWidget2
+{
+    Q_OBJECT
+};
+class DeepWidget4 : public DeepWidget3
+{
+    Q_OBJECT
+};
+class DeepWidget5 : public DeepWidget4
+{
+    Q_OBJECT
+};
+class DeepWidget6 : public DeepWidget5
+{
+    Q_OBJECT
+};
+class DeepWidget7 : public DeepWidget6
+{
+    Q_OBJECT
+};
+class DeepWidget8 : public DeepWidget7
+{
+    Q_OBJECT
+};
+
+class BenchEmitter : public QObject
+{
+    Q_OBJECT
+signals:
+    void valueChanged(int value, const QString &text);
+};
+
 class BenchSuite : public QObject
 {
     Q_OBJECT
 
 private slots:
+    static void iconForObject_data();
     void iconForObject();
+    static void server_forwardSignal();
     static void probe_objectAdded();
 };
 }
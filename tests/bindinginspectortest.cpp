@@ -24,6 +24,7 @@
 
 #include <core/abstractbindingprovider.h>
 #include <core/bindingaggregator.h>
+#include <core/bindinggraph.h>
 #include <core/bindingnode.h>
 #include <core/tools/objectinspector/bindingextension.h>
 #include <core/tools/objectinspector/bindingmodel.h>
@@ -229,6 +230,8 @@ private slots:
     void testModelRemovalAtEnd();
     void testModelRemovalInside();
     void testIntegration();
+    static void testBindingGraph();
+    static void benchmarkBindingGraph();
 
 private:
     MockBindingProvider *provider;
@@ -1059,6 +1062,103 @@ void BindingInspectorTest::testIntegration()
     QTRY_VERIFY(bindingModel->rowCount() == 0);
 }
 
+void BindingInspectorTest::testBindingGraph()
+{
+    MockObject obj1 { 53, true, 'x', 5.3, "Hello World" };
+    MockObject obj2 { 35, false, 'y', 3.5, "Bye, World" };
+    const auto index = [](const char *name) { return MockObject::staticMetaObject.indexOfProperty(name); };
+
+    auto provider = new MockBindingProvider;
+    BindingGraph::Providers providers;
+    providers.push_back(std::unique_ptr<AbstractBindingProvider>(provider));
+    provider->data = { {
+        { &obj1, "a", &obj1, "e" },
+        { &obj1, "c", &obj1, "b" },
+        { &obj1, "c", &obj2, "b" },
+        { &obj2, "b", &obj2, "a" },
+        { &obj2, "a", &obj1, "c" },
+    } };
+
+    BindingGraph graph(&providers);
+    graph.addObject(&obj1);
+    QCOMPARE(graph.nodeCount(), 6);
+    QCOMPARE(graph.edgeCount(), 5);
+
+    const auto obj1c = graph.node(&obj1, index("c"));
+    const auto obj2b = graph.node(&obj2, index("b"));
+    QVERIFY(obj1c >= 0);
+    QVERIFY(obj2b >= 0);
+    QCOMPARE(graph.object(obj1c), &obj1);
+    QCOMPARE(graph.propertyIndex(obj1c), index("c"));
+    QCOMPARE(graph.dependencies(obj1c).size(), 2);
+    QVERIFY(graph.isBinding(obj1c));
+    QVERIFY(!graph.isBinding(obj2b));
+
+    // obj1.c -> obj2.b -> obj2.a -> obj1.c
+    auto loops = graph.bindingLoops();
+    QCOMPARE(loops.size(), 1);
+    QCOMPARE(loops.at(0).size(), 3);
+    QVERIFY(loops.at(0).contains(obj1c));
+    QVERIFY(loops.at(0).contains(obj2b));
+    QVERIFY(!loops.at(0).contains(graph.node(&obj1, index("a"))));
+
+    // known nodes are not looked up again
+    graph.addObject(&obj2);
+    QCOMPARE(graph.nodeCount(), 6);
+    QCOMPARE(graph.edgeCount(), 5);
+    QVERIFY(graph.isBinding(obj2b));
+
+    // self-dependency
+    provider->data.clear();
+    provider->data.emplace_back(&obj1, "d", &obj1, "d");
+    BindingGraph selfGraph(&providers);
+    selfGraph.addObject(&obj1);
+    loops = selfGraph.bindingLoops();
+    QCOMPARE(loops.size(), 1);
+    QCOMPARE(loops.at(0), QVector<int>() << selfGraph.node(&obj1, index("d")));
+}
+
+void BindingInspectorTest::benchmarkBindingGraph()
+{
+    // 10000 objects with 10 bindings each, each one depending on the previous one
+    const int objectCount = 10000;
+    QByteArray code = "import QtQuick 2.0\n"
+                      "Item {\n"
+                      "    id: root\n"
+                      "    property int value: 0\n";
+    for (int i = 0; i < objectCount; ++i) {
+        QByteArray source = "root.value";
+        if (i > 0)
+            source = "o" + QByteArray::number(i - 1) + ".p9";
+        code += "    QtObject {\n";
+        code += "        id: o" + QByteArray::number(i) + "\n";
+        code += "        property int p0: " + source + "\n";
+        for (int j = 1; j < 10; ++j)
+            code += "        property int p" + QByteArray::number(j) + ": p" + QByteArray::number(j - 1) + " + 1\n";
+        code += "    }\n";
+    }
+    code += "}\n";
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(code, QUrl());
+    std::unique_ptr<QObject> root(component.create());
+    QVERIFY(root);
+    const auto objects = root->findChildren<QObject *>();
+    QVERIFY(objects.size() >= objectCount);
+
+    BindingGraph::Providers providers;
+    providers.push_back(std::unique_ptr<AbstractBindingProvider>(new QmlBindingProvider));
+
+    QBENCHMARK {
+        BindingGraph graph(&providers);
+        for (auto object : objects)
+            graph.addObject(object);
+        QVERIFY(graph.nodeCount() >= objectCount * 10);
+        QVERIFY(graph.bindingLoops().isEmpty());
+    }
+}
+
 QTEST_MAIN(BindingInspectorTest)
 
 #include "bindinginspectortest.moc"
@@ -0,0 +1,278 @@
+/*
+  endpointtest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <common/endpoint.h>
+#include <common/message.h>
+#include <common/variantwrapper.h>
+
+#include <QBuffer>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+#include <QUrl>
+
+using namespace GammaRay;
+
+class EndpointTarget : public QObject
+{
+    Q_OBJECT
+public:
+    explicit EndpointTarget(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+    int value = 0;
+    QString text;
+    QVariant variant;
+    int calls = 0;
+
+public slots:
+    void setValue(int v)
+    {
+        value = v;
+        ++calls;
+    }
+    void setValues(int v, const QString &t)
+    {
+        value = v;
+        text = t;
+        ++calls;
+    }
+    void setVariant(const QVariant &v)
+    {
+        variant = v;
+        ++calls;
+    }
+    void overloaded(int v)
+    {
+        value = v;
+        ++calls;
+    }
+    void overloaded(const QString &t)
+    {
+        text = t;
+        ++calls;
+    }
+
+signals:
+    void valueChanged(int value);
+};
+
+/** Endpoint that delivers all messages to itself. */
+class LoopbackEndpoint : public Endpoint
+{
+    Q_OBJECT
+public:
+    explicit LoopbackEndpoint(QObject *parent = nullptr)
+        : Endpoint(parent)
+        , m_nextAddress(endpointAddress())
+    {
+        setDevice(new QBuffer(this));
+    }
+
+    Protocol::ObjectAddress registerTarget(const QString &name, QObject *object, bool exportMethods)
+    {
+        addObjectNameAddressMapping(name, ++m_nextAddress);
+        const auto address = registerObject(name, object);
+        if (exportMethods)
+            Endpoint::exportMethods(address);
+        return address;
+    }
+
+    using Endpoint::invokeRemoteMethod;
+    using Endpoint::methodTable;
+
+    Protocol::MethodId lastMethodId = Protocol::InvalidMethodId;
+
+protected:
+    void doSendMessage(const Message &msg) override
+    {
+        QByteArray ba;
+        QBuffer buffer(&ba);
+        buffer.open(QIODevice::ReadWrite);
+        msg.write(&buffer);
+
+        buffer.seek(0);
+        const auto header = Message::readMessage(&buffer);
+        header >> lastMethodId;
+
+        buffer.seek(0);
+        dispatchMessage(Message::readMessage(&buffer));
+    }
+
+    bool isRemoteClient() const override
+    {
+        return false;
+    }
+    void messageReceived(const GammaRay::Message &msg) override
+    {
+        dispatchMessage(msg);
+    }
+    QUrl serverAddress() const override
+    {
+        return QUrl();
+    }
+    void handlerDestroyed(Protocol::ObjectAddress, const QString &) override
+    {
+    }
+    void objectDestroyed(Protocol::ObjectAddress, const QString &objectName, QObject *) override
+    {
+        removeObjectNameAddressMapping(objectName);
+    }
+
+private:
+    Protocol::ObjectAddress m_nextAddress;
+};
+
+class EndpointTest : public QObject
+{
+    Q_OBJECT
+private:
+    static LoopbackEndpoint *endpoint()
+    {
+        return static_cast<LoopbackEndpoint *>(Endpoint::instance());
+    }
+
+private slots:
+    static void initTestCase()
+    {
+        new LoopbackEndpoint;
+        QVERIFY(Endpoint::isConnected());
+    }
+
+    static void cleanupTestCase()
+    {
+        delete Endpoint::instance();
+    }
+
+    static void testMethodTable()
+    {
+        EndpointTarget target;
+        const auto address = endpoint()->registerTarget(QStringLiteral("com.kdab.GammaRay.UnitTest.Table"), &target, true);
+
+        const auto methods = endpoint()->methodTable(address);
+        QVERIFY(!methods.isEmpty());
+        bool found = false;
+        for (const auto &method : methods) {
+            if (method.name != "setValues")
+                continue;
+            QCOMPARE(method.parameterTypes, QList<QByteArray>() << "int" << "QString");
+            found = true;
+        }
+        QVERIFY(found);
+    }
+
+    static void testInvokeById()
+    {
+        EndpointTarget target;
+        const QString name = QStringLiteral("com.kdab.GammaRay.UnitTest.ById");
+        endpoint()->registerTarget(name, &target, true);
+
+        endpoint()->invokeObject(name, "setValue", QVariantList() << 42);
+        QVERIFY(endpoint()->lastMethodId != Protocol::InvalidMethodId);
+        QCOMPARE(target.calls, 1);
+        QCOMPARE(target.value, 42);
+
+        endpoint()->invokeObject(name, "setValues", QVariantList() << 23 << QStringLiteral("GammaRay"));
+        QVERIFY(endpoint()->lastMethodId != Protocol::InvalidMethodId);
+        QCOMPARE(target.calls, 2);
+        QCOMPARE(target.value, 23);
+        QCOMPARE(target.text, QStringLiteral("GammaRay"));
+
+        // arguments are converted to the parameter type
+        endpoint()->invokeObject(name, "setValue", QVariantList() << QStringLiteral("7"));
+        QVERIFY(endpoint()->lastMethodId != Protocol::InvalidMethodId);
+        QCOMPARE(target.calls, 3);
+        QCOMPARE(target.value, 7);
+
+        endpoint()->invokeObject(name, "setVariant", QVariantList() << QVariant::fromValue(VariantWrapper(QVariant(1.5))));
+        QVERIFY(endpoint()->lastMethodId != Protocol::InvalidMethodId);
+        QCOMPARE(target.calls, 4);
+        QCOMPARE(target.variant, QVariant(1.5));
+    }
+
+    static void testInvokeByName()
+    {
+        EndpointTarget target;
+        const QString name = QStringLiteral("com.kdab.GammaRay.UnitTest.ByName");
+        endpoint()->registerTarget(name, &target, false);
+
+        endpoint()->invokeObject(name, "setValues", QVariantList() << 23 << QStringLiteral("GammaRay"));
+        QCOMPARE(endpoint()->lastMethodId, Protocol::InvalidMethodId);
+        QCOMPARE(target.calls, 1);
+        QCOMPARE(target.value, 23);
+        QCOMPARE(target.text, QStringLiteral("GammaRay"));
+    }
+
+    static void testOverloaded()
+    {
+        EndpointTarget target;
+        const QString name = QStringLiteral("com.kdab.GammaRay.UnitTest.Overloaded");
+        endpoint()->registerTarget(name, &target, true);
+
+        // ambiguous by name and argument count, needs to be resolved based on the argument types
+        endpoint()->invokeObject(name, "overloaded", QVariantList() << QStringLiteral("GammaRay"));
+        QCOMPARE(endpoint()->lastMethodId, Protocol::InvalidMethodId);
+        QCOMPARE(target.calls, 1);
+        QCOMPARE(target.text, QStringLiteral("GammaRay"));
+
+        endpoint()->invokeObject(name, "overloaded", QVariantList() << 42);
+        QCOMPARE(target.calls, 2);
+        QCOMPARE(target.value, 42);
+    }
+
+    static void testForwardSignal()
+    {
+        EndpointTarget target;
+        endpoint()->registerTarget(QStringLiteral("com.kdab.GammaRay.UnitTest.Signal"), &target, true);
+        QSignalSpy spy(&target, &EndpointTarget::valueChanged);
+        QVERIFY(spy.isValid());
+
+        const auto signalIndex = target.metaObject()->indexOfSignal("valueChanged(int)");
+        QVERIFY(signalIndex >= 0);
+        int value = 5;
+        void *args[] = { nullptr, &value };
+        endpoint()->invokeRemoteMethod(&target, signalIndex, QVector<int>() << QMetaType::Int, args);
+        QVERIFY(endpoint()->lastMethodId != Protocol::InvalidMethodId);
+        QCOMPARE(spy.size(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), 5);
+    }
+
+    static void benchmarkRoundTrip_data()
+    {
+        QTest::addColumn<bool>("exportMethods");
+
+        QTest::newRow("method id") << true;
+        QTest::newRow("method name") << false;
+    }
+
+    static void benchmarkRoundTrip()
+    {
+        QFETCH(bool, exportMethods);
+
+        EndpointTarget target;
+        const QString name = QStringLiteral("com.kdab.GammaRay.UnitTest.Benchmark.") + QLatin1String(exportMethods ? "ById" : "ByName");
+        endpoint()->registerTarget(name, &target, exportMethods);
+        const QVariantList args = QVariantList() << 23 << QStringLiteral("GammaRay");
+
+        QBENCHMARK {
+            endpoint()->invokeObject(name, "setValues", args);
+        }
+        QVERIFY(target.calls > 0);
+        QCOMPARE(target.text, QStringLiteral("GammaRay"));
+    }
+};
+
+QTEST_MAIN(EndpointTest)
+
+#include "endpointtest.moc"
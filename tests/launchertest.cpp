@@ -22,6 +22,7 @@
 #include <launcher/core/probefinder.h>
 #include <launcher/core/probeabi.h>
 #include <launcher/core/probeabidetector.h>
+#include <compat/qasconst.h>
 
 #include <QDebug>
 #include <QObject>
@@ -155,6 +156,70 @@ private slots:
         spy.wait(30000);
         QCOMPARE(spy.count(), 1);
     }
+
+    void testDebuggerPhaseTimings_data()
+    {
+        QTest::addColumn<QString>("injectorType", nullptr);
+        QTest::newRow("dummy") << QString(); // workaround for QTestlib asserting on empty test data sets
+        if (hasInjector("gdb"))
+            QTest::newRow("gdb") << QStringLiteral("gdb");
+        if (hasInjector("lldb"))
+            QTest::newRow("lldb") << QStringLiteral("lldb");
+    }
+
+    static void testDebuggerPhaseTimings()
+    {
+        QFETCH(QString, injectorType);
+        if (injectorType.isEmpty())
+            return;
+
+        QProcess target;
+        auto cleanup = kdScopeGuard([&target] {
+            target.kill();
+            target.waitForFinished();
+        });
+
+        target.setProcessChannelMode(QProcess::ForwardedChannels);
+        target.start(QLatin1String(TESTBIN_DIR "/minimalcoreapplication"), {}, QProcess::ReadWrite);
+        QVERIFY(target.waitForStarted());
+
+        LaunchOptions options;
+        options.setUiMode(LaunchOptions::NoUi);
+        options.setProbeSetting(QStringLiteral("ServerAddress"), GAMMARAY_DEFAULT_LOCAL_TCP_URL);
+        options.setPid(target.processId());
+        options.setInjectorType(injectorType);
+        QTest::qWait(5000); // see testAttach
+        ProbeABIDetector detector;
+        options.setProbeABI(ProbeFinder::findBestMatchingABI(detector.abiForProcess(options.pid())));
+        Launcher launcher(options);
+
+        QSignalSpy messageSpy(&launcher, &Launcher::stdoutMessage);
+        QVERIFY(messageSpy.isValid());
+        QSignalSpy spy(&launcher, &Launcher::attached);
+        QVERIFY(spy.isValid());
+        QVERIFY(launcher.start());
+
+        spy.wait(30000);
+        QCOMPARE(spy.count(), 1);
+
+        // one summary of all steps, and none of the markers themselves
+        // the summary is reported when the debugger exits, which can be after the probe attached
+        const auto collectSummaries = [&messageSpy]() {
+            QStringList summaries;
+            for (const auto &args : qAsConst(messageSpy)) {
+                const auto message = args.at(0).toString();
+                if (message.startsWith(QLatin1String("Debugger injection took")))
+                    summaries.push_back(message);
+            }
+            return summaries;
+        };
+        QTRY_COMPARE_WITH_TIMEOUT(collectSummaries().size(), 1, 30000);
+        for (const auto &args : qAsConst(messageSpy))
+            QVERIFY(!args.at(0).toString().contains(QLatin1String("GAMMARAY-PHASE")));
+        const auto summaries = collectSummaries();
+        for (const auto phase : { "attach", "symbols", "dlopen", "probe", "detach" })
+            QVERIFY2(summaries.at(0).contains(QLatin1String(phase) + QLatin1String(" ")), qPrintable(summaries.at(0)));
+    }
 };
 
 QTEST_MAIN(LauncherTest)
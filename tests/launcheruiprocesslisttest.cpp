@@ -15,6 +15,7 @@
 
 #include <launcher/ui/processlist.h>
 
+#include <QCoreApplication>
 #include <QTest>
 
 using namespace GammaRay;
@@ -37,6 +38,35 @@ private slots:
         QVERIFY(!proc.state.isEmpty());
         QVERIFY(!proc.user.isEmpty());
     }
+
+    static void testProcessSnapshot()
+    {
+        const auto findSelf = [](const ProcDataList &processes) -> ProcData {
+            for (const auto &proc : processes) {
+                if (proc.ppid == QCoreApplication::applicationPid())
+                    return proc;
+            }
+            return ProcData();
+        };
+
+        processList(ProcDataList()); // make sure everything has been seen before
+
+        // known processes are not reported for detection again
+        ProcessSnapshot snapshot = processSnapshot();
+        QVERIFY(!snapshot.processes.isEmpty());
+        const ProcData self = findSelf(snapshot.processes);
+        QCOMPARE(self.ppid, QCoreApplication::applicationPid());
+        QVERIFY(!self.name.isEmpty());
+        QVERIFY(findSelf(snapshot.pendingABIDetection).ppid == 0);
+        QCOMPARE(self.abi.id(), QStringLiteral(GAMMARAY_PROBE_ABI));
+
+        // detection results are kept for subsequent snapshots
+        const ProcData detected = detectProcessABI(self);
+        QCOMPARE(detected.abi, self.abi);
+        snapshot = processSnapshot();
+        QCOMPARE(findSelf(snapshot.processes).abi, self.abi);
+        QCOMPARE(findSelf(snapshot.processes).name, self.name);
+    }
 };
 
 QTEST_MAIN(LauncherUiProcessListTest)
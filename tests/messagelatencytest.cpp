@@ -0,0 +1,111 @@
+/*
+  messagelatencytest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <common/messagelatency.h>
+
+#include <QDataStream>
+#include <QJsonArray>
+#include <QObject>
+#include <QTest>
+
+using namespace GammaRay;
+
+class MessageLatencyTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testHistogram()
+    {
+        LatencyHistogram h;
+        QCOMPARE(h.count(), quint64(0));
+        QCOMPARE(h.percentile(0.5), quint64(0));
+
+        for (int i = 0; i < 98; ++i)
+            h.add(100); // bucket [64, 128)
+        h.add(0);
+        h.add(5000); // bucket [4096, 8192)
+
+        QCOMPARE(h.count(), quint64(100));
+        QCOMPARE(h.total(), quint64(98 * 100 + 5000));
+        QCOMPARE(h.max(), quint64(5000));
+        QCOMPARE(h.bucketCount(0), 1u);
+        QCOMPARE(h.bucketCount(6), 98u);
+        QCOMPARE(h.bucketCount(12), 1u);
+        QCOMPARE(h.percentile(0.01), quint64(2));
+        QCOMPARE(h.percentile(0.5), quint64(128));
+        QCOMPARE(h.percentile(0.99), quint64(128));
+        // capped at the largest sample
+        QCOMPARE(h.percentile(1.0), quint64(5000));
+
+        h.add(quint64(1) << 40);
+        QCOMPARE(h.bucketCount(LatencyHistogram::BucketCount - 1), 1u);
+
+        LatencyHistogram other;
+        other.add(1);
+        other.merge(h);
+        QCOMPARE(other.count(), quint64(102));
+        QCOMPARE(other.bucketCount(0), 2u);
+        QCOMPARE(other.max(), h.max());
+
+        const auto json = h.toJson();
+        QCOMPARE(json.value(QStringLiteral("count")).toInt(), 101);
+        QCOMPARE(json.value(QStringLiteral("buckets")).toArray().size(), 4);
+    }
+
+    void testSerialization()
+    {
+        MessageLatencies latencies;
+        QVERIFY(latencies.isEmpty());
+        latencies.add(MessageLatencies::RoundTrip, 23, Protocol::ModelContentRequest, 300);
+        latencies.add(MessageLatencies::RoundTrip, 23, Protocol::ModelContentRequest, 500);
+        latencies.add(MessageLatencies::Queued, 42, Protocol::ModelContentReply, 10);
+        latencies.add(MessageLatencies::Handling, 23, Protocol::ModelContentRequest, 70);
+        QCOMPARE(latencies.entries().size(), 3);
+
+        QByteArray data;
+        {
+            QDataStream out(&data, QIODevice::WriteOnly);
+            out << latencies;
+        }
+        MessageLatencies copy;
+        QDataStream in(data);
+        in >> copy;
+        QCOMPARE(in.status(), QDataStream::Ok);
+
+        const auto entries = copy.entries();
+        QCOMPARE(entries.size(), 3);
+        for (const auto &entry : entries) {
+            switch (entry.kind) {
+            case MessageLatencies::RoundTrip:
+                QCOMPARE(entry.address, Protocol::ObjectAddress(23));
+                QCOMPARE(entry.type, Protocol::MessageType(Protocol::ModelContentRequest));
+                QCOMPARE(entry.histogram.count(), quint64(2));
+                QCOMPARE(entry.histogram.max(), quint64(500));
+                break;
+            case MessageLatencies::Queued:
+                QCOMPARE(entry.address, Protocol::ObjectAddress(42));
+                QCOMPARE(entry.type, Protocol::MessageType(Protocol::ModelContentReply));
+                break;
+            case MessageLatencies::Handling:
+                QCOMPARE(entry.histogram.total(), quint64(70));
+                break;
+            }
+        }
+
+        copy.clear();
+        QVERIFY(copy.isEmpty());
+    }
+};
+
+QTEST_MAIN(MessageLatencyTest)
+
+#include "messagelatencytest.moc"
@@ -79,6 +79,48 @@ private slots:
         QCOMPARE(spy.at(1).at(2).value<QVector<QVariant>>().first().toString(),
                  QStringLiteral("hello"));
     }
+
+    void testArgumentsHandler()
+    {
+        Emitter emitter;
+
+        MultiSignalMapper mapper;
+        mapper.connectToSignal(&emitter, method(&emitter, "signal1(int)"));
+        mapper.connectToSignal(&emitter, method(&emitter, "signal2(QString)"));
+
+        QSignalSpy spy(&mapper, &MultiSignalMapper::signalEmitted);
+        QVERIFY(spy.isValid());
+
+        QObject *sender = nullptr;
+        int signalIndex = -1;
+        QVector<int> types;
+        QVariant value;
+        mapper.setArgumentsHandler([&](QObject *s, int index, const QVector<int> &parameterTypes, void **args) {
+            sender = s;
+            signalIndex = index;
+            types = parameterTypes;
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+            value = QVariant(parameterTypes.at(0), args[1]);
+#else
+            value = QVariant(QMetaType(parameterTypes.at(0)), args[1]);
+#endif
+        });
+
+        emit emitter.signal1(42);
+        QCOMPARE(sender, &emitter);
+        QCOMPARE(signalIndex, emitter.metaObject()->indexOfSignal("signal1(int)"));
+        QCOMPARE(types, QVector<int>() << QMetaType::Int);
+        QCOMPARE(value.toInt(), 42);
+
+        // repeated emissions use the cached parameter types
+        emit emitter.signal2(QStringLiteral("hello"));
+        emit emitter.signal2(QStringLiteral("world"));
+        QCOMPARE(signalIndex, emitter.metaObject()->indexOfSignal("signal2(QString)"));
+        QCOMPARE(types, QVector<int>() << QMetaType::QString);
+        QCOMPARE(value.toString(), QStringLiteral("world"));
+
+        QVERIFY(spy.isEmpty());
+    }
 };
 
 QTEST_MAIN(MultiSignalMapperTest)
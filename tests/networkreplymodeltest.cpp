@@ -0,0 +1,169 @@
+/*
+  networkreplymodeltest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/network/networkreplymodel.h>
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTest>
+
+using namespace GammaRay;
+
+class NetworkReplyModelTest : public QObject
+{
+    Q_OBJECT
+private:
+    /** Starts a request for a data: URL with @p content and reports the reply to @p model. */
+    static QNetworkReply *get(NetworkReplyModel &model, QNetworkAccessManager &nam, const QByteArray &content)
+    {
+        auto reply = nam.get(QNetworkRequest(QUrl(QLatin1String("data:,") + QString::fromLatin1(content))));
+        model.objectCreated(reply);
+        return reply;
+    }
+
+    static int replyCount(const NetworkReplyModel &model)
+    {
+        return model.rowCount(model.index(0, 0, QModelIndex()));
+    }
+
+    static QModelIndex replyIndex(const NetworkReplyModel &model, int row)
+    {
+        return model.index(row, 0, model.index(0, 0, QModelIndex()));
+    }
+
+    static quint64 replyId(const NetworkReplyModel &model, int row)
+    {
+        return replyIndex(model, row).data(NetworkReplyModelRole::ReplyIdRole).toULongLong();
+    }
+
+    static int replyState(const NetworkReplyModel &model, int row)
+    {
+        return replyIndex(model, row).data(NetworkReplyModelRole::ReplyStateRole).toInt();
+    }
+
+    static bool allFinished(const NetworkReplyModel &model)
+    {
+        for (int row = 0; row < replyCount(model); ++row) {
+            if ((replyState(model, row) & NetworkReply::Finished) == 0)
+                return false;
+        }
+        return true;
+    }
+
+private slots:
+    static void testReplyIds()
+    {
+        NetworkReplyModel model;
+        QNetworkAccessManager nam;
+        model.objectCreated(&nam);
+
+        auto reply = get(model, nam, "first");
+        QCOMPARE(replyCount(model), 1);
+        const auto firstId = replyId(model, 0);
+        QVERIFY(firstId > 0);
+        const auto firstUrl = replyIndex(model, 0).sibling(0, NetworkReplyModelColumn::UrlColumn).data();
+
+        // events of the reply update its row
+        QTRY_VERIFY(replyState(model, 0) & NetworkReply::Finished);
+        QCOMPARE(replyCount(model), 1);
+        QCOMPARE(replyId(model, 0), firstId);
+
+        delete reply;
+        QVERIFY(replyState(model, 0) & NetworkReply::Deleted);
+
+        // a new reply gets a new row, even if it reuses the address of the deleted one
+        get(model, nam, "second");
+        QCOMPARE(replyCount(model), 2);
+        QVERIFY(replyId(model, 1) > firstId);
+        QTRY_VERIFY(replyState(model, 1) & NetworkReply::Finished);
+        QCOMPARE(replyCount(model), 2);
+        QCOMPARE(replyId(model, 0), firstId);
+        QCOMPARE(replyIndex(model, 0).sibling(0, NetworkReplyModelColumn::UrlColumn).data(), firstUrl);
+        QVERIFY(replyState(model, 0) & NetworkReply::Deleted);
+        QVERIFY((replyState(model, 1) & NetworkReply::Deleted) == 0);
+    }
+
+    static void testCountEviction()
+    {
+        NetworkReplyModel model;
+        model.setCaptureResponse(true);
+        model.setMaxReplyCount(3);
+        QNetworkAccessManager nam;
+        model.objectCreated(&nam);
+
+        for (int i = 0; i < 5; ++i)
+            get(model, nam, QByteArray::number(i));
+        // running replies are always kept
+        QCOMPARE(replyCount(model), 5);
+        const auto firstId = replyId(model, 0);
+        const auto lastId = replyId(model, 4);
+
+        QTRY_VERIFY(allFinished(model));
+        QCOMPARE(replyCount(model), 3);
+        QCOMPARE(replyId(model, 2), lastId);
+        QCOMPARE(replyId(model, 0), lastId - 2);
+        QCOMPARE(model.response(lastId), QByteArray("4"));
+        QVERIFY(model.response(firstId).isEmpty());
+
+        // lowering the limit applies to replies already recorded
+        model.setMaxReplyCount(1);
+        QCOMPARE(replyCount(model), 1);
+        QCOMPARE(replyId(model, 0), lastId);
+    }
+
+    static void testAgeEviction()
+    {
+        NetworkReplyModel model;
+        QNetworkAccessManager nam;
+        model.objectCreated(&nam);
+
+        get(model, nam, "old");
+        QTRY_VERIFY(allFinished(model));
+        QTest::qWait(500);
+        get(model, nam, "new");
+        QTRY_VERIFY(allFinished(model));
+        QCOMPARE(replyCount(model), 2);
+        const auto newId = replyId(model, 1);
+
+        model.setMaxReplyAge(250);
+        QCOMPARE(replyCount(model), 1);
+        QCOMPARE(replyId(model, 0), newId);
+    }
+
+    static void testResponseBudget()
+    {
+        NetworkReplyModel model;
+        model.setCaptureResponse(true);
+        model.setMaxResponseBytes(1000);
+        QNetworkAccessManager nam;
+        model.objectCreated(&nam);
+
+        get(model, nam, "hello");
+        get(model, nam, QByteArray(2000, 'x'));
+        QTRY_VERIFY(allFinished(model));
+        const auto smallId = replyId(model, 0);
+        const auto largeId = replyId(model, 1);
+
+        // responses exceeding the budget are not kept
+        QCOMPARE(model.response(smallId), QByteArray("hello"));
+        QVERIFY(model.response(largeId).isEmpty());
+
+        // dropping responses leaves the replies alone
+        model.setMaxResponseBytes(0);
+        QVERIFY(model.response(smallId).isEmpty());
+        QCOMPARE(replyCount(model), 2);
+    }
+};
+
+QTEST_MAIN(NetworkReplyModelTest)
+
+#include "networkreplymodeltest.moc"
@@ -0,0 +1,73 @@
+/*
+  networkresponsestoretest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/network/networkresponsestore.h>
+
+#include <QTest>
+
+using namespace GammaRay;
+
+class NetworkResponseStoreTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    static void testInsertAndReplace()
+    {
+        NetworkResponseStore store(1024, 256);
+        QVERIFY(!store.contains(1));
+        QVERIFY(store.response(1).isEmpty());
+
+        store.insert(1, QByteArray("hello"));
+        store.insert(2, QByteArray(100, 'x'));
+        QVERIFY(store.contains(1));
+        QCOMPARE(store.response(1), QByteArray("hello"));
+        QCOMPARE(store.response(2), QByteArray(100, 'x'));
+
+        store.insert(1, QByteArray("world"));
+        QCOMPARE(store.response(1), QByteArray("world"));
+
+        store.remove(2);
+        QVERIFY(!store.contains(2));
+        QVERIFY(store.response(2).isEmpty());
+        QCOMPARE(store.response(1), QByteArray("world"));
+
+        store.clear();
+        QVERIFY(!store.contains(1));
+        QCOMPARE(store.size(), 0);
+    }
+
+    static void testByteBudget()
+    {
+        NetworkResponseStore store(1000, 250);
+        for (quint64 id = 1; id <= 40; ++id)
+            store.insert(id, QByteArray(100, char('a' + id % 26)));
+
+        QVERIFY(store.size() <= 1000);
+        // oldest bodies are dropped first
+        QVERIFY(!store.contains(1));
+        QVERIFY(store.contains(40));
+        QCOMPARE(store.response(40), QByteArray(100, char('a' + 40 % 26)));
+        QCOMPARE(store.response(39), QByteArray(100, char('a' + 39 % 26)));
+
+        // too large to ever fit
+        store.insert(100, QByteArray(2000, 'z'));
+        QVERIFY(!store.contains(100));
+
+        store.setByteBudget(0);
+        QVERIFY(!store.contains(40));
+        QCOMPARE(store.size(), 0);
+    }
+};
+
+QTEST_MAIN(NetworkResponseStoreTest)
+
+#include "networkresponsestoretest.moc"
@@ -12,10 +12,15 @@
 */
 
 #include <config-gammaray.h>
+#include <gammaray-test-config.h>
 
 #include <launcher/core/probeabi.h>
 #include <launcher/core/probeabidetector.h>
+#if defined(HAVE_ELF) && !defined(Q_OS_MAC)
+#include <launcher/core/elffile.h>
+#endif
 
+#include <QFileInfo>
 #include <QObject>
 #include <QTest>
 
@@ -41,6 +46,39 @@ private slots:
         QCOMPARE(abi.id(), QStringLiteral(GAMMARAY_PROBE_ABI));
     }
 
+#if defined(HAVE_ELF) && !defined(Q_OS_MAC)
+    static void testElfFile()
+    {
+        const ElfFile app(QStringLiteral(ELFFIXTURE_DIR "/fakeqtapplication"));
+        QVERIFY(app.isValid());
+        QCOMPARE(app.architecture(), ElfFile(QCoreApplication::applicationFilePath()).architecture());
+        QVERIFY(app.neededLibraries().contains(QStringLiteral("libQt9Core.so")));
+        QVERIFY(app.rpath().contains(QStringLiteral("$ORIGIN/lib")) || app.runpath().contains(QStringLiteral("$ORIGIN/lib")));
+        QCOMPARE(app.qtVersion(), 0);
+
+        const ElfFile qtCore(QStringLiteral(ELFFIXTURE_DIR "/lib/libQt9Core.so"));
+        QVERIFY(qtCore.isValid());
+        QCOMPARE(qtCore.qtVersion(), 0x090301);
+
+        QVERIFY(!ElfFile(QStringLiteral(ELFFIXTURE_DIR "/does-not-exist")).isValid());
+        QVERIFY(!ElfFile(QFINDTESTDATA("probeabidetectortest.cpp")).isValid());
+    }
+
+    static void testDetectElfFixture()
+    {
+        ProbeABIDetector detector;
+        const QString qtCore = detector.qtCoreForExecutable(QStringLiteral(ELFFIXTURE_DIR "/fakeqtapplication"));
+        QCOMPARE(QFileInfo(qtCore).canonicalFilePath(), QFileInfo(QStringLiteral(ELFFIXTURE_DIR "/lib/libQt9Core.so")).canonicalFilePath());
+
+        const QVector<ProbeABI> abis = detector.abiForQtCore(qtCore);
+        QCOMPARE(abis.size(), 1);
+        const ProbeABI abi = abis.at(0);
+        QCOMPARE(abi.majorQtVersion(), 9);
+        QCOMPARE(abi.minorQtVersion(), 3);
+        QVERIFY(!abi.architecture().isEmpty());
+    }
+#endif
+
     static void testContainsQtCore_data()
     {
         QTest::addColumn<QString>("line", nullptr);
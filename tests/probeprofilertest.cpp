@@ -0,0 +1,122 @@
+/*
+  probeprofilertest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <core/probeprofiler.h>
+
+#include <QObject>
+#include <QTest>
+#include <QThread>
+
+#include <limits>
+
+using namespace GammaRay;
+
+class ProbeProfilerTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    static void cleanup()
+    {
+        ProbeProfiler::setEnabled(false);
+        ProbeProfiler::reset();
+    }
+
+    static void testBuckets()
+    {
+        int previous = -1;
+        for (quint64 v = 0; v < 100000; ++v) {
+            const auto index = ProbeProfiler::bucketIndex(v);
+            QVERIFY(index == previous || index == previous + 1);
+            QVERIFY(v <= ProbeProfiler::bucketUpperBound(index));
+            if (index > 0)
+                QVERIFY(v > ProbeProfiler::bucketUpperBound(index - 1));
+            previous = index;
+        }
+
+        for (int shift = 5; shift < 41; ++shift) {
+            const quint64 v = (Q_UINT64_C(1) << shift) + 1;
+            const auto upper = ProbeProfiler::bucketUpperBound(ProbeProfiler::bucketIndex(v));
+            QVERIFY(upper >= v);
+            QVERIFY(upper - v <= v / ProbeProfiler::SubBuckets);
+        }
+        QCOMPARE(ProbeProfiler::bucketIndex(std::numeric_limits<quint64>::max()), ProbeProfiler::BucketCount - 1);
+    }
+
+    static void testDisabled()
+    {
+        QVERIFY(!ProbeProfiler::isEnabled());
+        {
+            ProbeProfilerScope scope(ProbeProfiler::EventFilter);
+        }
+        const auto stats = ProbeProfiler::statistics();
+        QCOMPARE(stats.size(), static_cast<int>(ProbeProfiler::SiteCount));
+        QCOMPARE(stats.at(ProbeProfiler::EventFilter).count, Q_UINT64_C(0));
+        QCOMPARE(ProbeProfiler::recordingTime(), Q_UINT64_C(0));
+    }
+
+    static void testStatistics()
+    {
+        ProbeProfiler::setEnabled(true);
+        for (int i = 1; i <= 100; ++i)
+            ProbeProfiler::record(ProbeProfiler::SlotBegin, i * 1000);
+        {
+            ProbeProfilerScope scope(ProbeProfiler::ObjectAdded);
+        }
+
+        // counters of other threads are merged in
+        QThread *thread = QThread::create([]() {
+            ProbeProfiler::record(ProbeProfiler::SlotBegin, 1000000);
+        });
+        thread->start();
+        QVERIFY(thread->wait(5000));
+        delete thread;
+
+        auto stats = ProbeProfiler::statistics();
+        const auto &slotStats = stats.at(ProbeProfiler::SlotBegin);
+        QCOMPARE(slotStats.count, Q_UINT64_C(101));
+        QCOMPARE(slotStats.totalNSecs, Q_UINT64_C(5050000 + 1000000));
+        QCOMPARE(slotStats.maxNSecs, Q_UINT64_C(1000000));
+        QVERIFY(slotStats.percentile(0.5) >= 50000);
+        QVERIFY(slotStats.percentile(0.5) <= 51000 + 51000 / ProbeProfiler::SubBuckets);
+        QVERIFY(slotStats.percentile(0.99) >= 100000);
+        QCOMPARE(slotStats.percentile(1.0), Q_UINT64_C(1000000));
+        QCOMPARE(stats.at(ProbeProfiler::ObjectAdded).count, Q_UINT64_C(1));
+        QCOMPARE(stats.at(ProbeProfiler::EventFilter).count, Q_UINT64_C(0));
+        QVERIFY(ProbeProfiler::recordingTime() > 0);
+
+        ProbeProfiler::reset();
+        stats = ProbeProfiler::statistics();
+        QCOMPARE(stats.at(ProbeProfiler::SlotBegin).count, Q_UINT64_C(0));
+        QCOMPARE(stats.at(ProbeProfiler::SlotBegin).percentile(0.5), Q_UINT64_C(0));
+    }
+
+    static void benchmarkScope_data()
+    {
+        QTest::addColumn<bool>("enabled");
+        QTest::newRow("disabled") << false;
+        QTest::newRow("enabled") << true;
+    }
+
+    static void benchmarkScope()
+    {
+        QFETCH(bool, enabled);
+        ProbeProfiler::setEnabled(enabled);
+
+        QBENCHMARK {
+            ProbeProfilerScope scope(ProbeProfiler::EventFilter);
+        }
+    }
+};
+
+QTEST_MAIN(ProbeProfilerTest)
+
+#include "probeprofilertest.moc"
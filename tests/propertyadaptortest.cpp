@@ -28,6 +28,8 @@
 #include <QSignalSpy>
 #include <QTest>
 
+#include <numeric>
+
 Q_DECLARE_METATYPE(QList<int>)
 Q_DECLARE_METATYPE(QPen *)
 
@@ -179,6 +181,67 @@ private slots:
         QVERIFY(!adaptor->canAddProperty());
     }
 
+    void testLargeSequentialContainer()
+    {
+        QVector<int> v(1500000);
+        std::iota(v.begin(), v.end(), 0);
+        auto adaptor = PropertyAdaptorFactory::create(ObjectInstance(QVariant::fromValue(v)), this);
+
+        // 1500 pages of 1000 elements are grouped again
+        QVERIFY(adaptor);
+        QCOMPARE(adaptor->count(), 2);
+        verifyPropertyData(adaptor);
+        QCOMPARE(adaptor->propertyData(0).name(), QStringLiteral("[0..999999]"));
+        QCOMPARE(adaptor->propertyData(1).name(), QStringLiteral("[1000000..1499999]"));
+        QCOMPARE(adaptor->propertyData(1).className(), QString::fromLatin1(QVariant::fromValue(v).typeName()));
+
+        auto pages = PropertyAdaptorFactory::create(ObjectInstance(adaptor->propertyData(1).value()), adaptor);
+        QVERIFY(pages);
+        QCOMPARE(pages->count(), 500);
+        QCOMPARE(pages->propertyData(3).name(), QStringLiteral("[1003000..1003999]"));
+
+        auto elements = PropertyAdaptorFactory::create(ObjectInstance(pages->propertyData(3).value()), pages);
+        QVERIFY(elements);
+        QCOMPARE(elements->count(), 1000);
+        verifyPropertyData(elements);
+        testProperty(elements, "1003007", "int", QVariant::fromValue(v).typeName(), PropertyData::Readable);
+        QCOMPARE(elements->propertyData(7).value(), QVariant(1003007));
+        QCOMPARE(elements->propertyData(999).value(), QVariant(1003999));
+    }
+
+    void testLargeAssociativeContainer()
+    {
+        QMap<int, int> m;
+        for (int i = 0; i < 2500; ++i)
+            m.insert(i, 2 * i);
+        auto adaptor = PropertyAdaptorFactory::create(ObjectInstance(QVariant::fromValue(m)), this);
+
+        QVERIFY(adaptor);
+        QCOMPARE(adaptor->count(), 3);
+        verifyPropertyData(adaptor);
+        QCOMPARE(adaptor->propertyData(2).name(), QStringLiteral("[2000..2499]"));
+
+        auto elements = PropertyAdaptorFactory::create(ObjectInstance(adaptor->propertyData(2).value()), adaptor);
+        QVERIFY(elements);
+        QCOMPARE(elements->count(), 500);
+        verifyPropertyData(elements);
+
+        // forward, backward and across pages, the cached iterators must not get out of sync
+        for (int i = 0; i < elements->count(); ++i) {
+            const auto data = elements->propertyData(i);
+            QCOMPARE(data.name(), QString::number(2000 + i));
+            QCOMPARE(data.value(), QVariant(2 * (2000 + i)));
+        }
+        for (int i = elements->count() - 1; i >= 0; i -= 7)
+            QCOMPARE(elements->propertyData(i).value(), QVariant(2 * (2000 + i)));
+
+        auto firstPage = PropertyAdaptorFactory::create(ObjectInstance(adaptor->propertyData(0).value()), adaptor);
+        QVERIFY(firstPage);
+        QCOMPARE(firstPage->count(), 1000);
+        QCOMPARE(firstPage->propertyData(10).value(), QVariant(20));
+        QCOMPARE(elements->propertyData(5).value(), QVariant(4010));
+    }
+
     void testQtObject()
     {
         auto obj = new PropertyTestObject;
@@ -24,11 +24,87 @@
 #include <QDebug>
 #include <QObject>
 #include <QSignalSpy>
+#include <QSize>
 #include <QTest>
 
 using namespace GammaRay;
 using namespace TestHelpers;
 
+class ReadCountingObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int notifying READ notifying WRITE setNotifying NOTIFY notifyingChanged)
+    Q_PROPERTY(int silent READ silent WRITE setSilent)
+public:
+    explicit ReadCountingObject(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+    int notifying() const
+    {
+        ++notifyingReads;
+        return m_notifying;
+    }
+    void setNotifying(int value)
+    {
+        m_notifying = value;
+        emit notifyingChanged();
+    }
+
+    int silent() const
+    {
+        ++silentReads;
+        return m_silent;
+    }
+    void setSilent(int value)
+    {
+        m_silent = value;
+    }
+
+    mutable int notifyingReads = 0;
+    mutable int silentReads = 0;
+
+signals:
+    void notifyingChanged();
+
+private:
+    int m_notifying = 0;
+    int m_silent = 0;
+};
+
+class SharedNotifyObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int contentWidth READ contentWidth NOTIFY contentSizeChanged)
+    Q_PROPERTY(int contentHeight READ contentHeight NOTIFY contentSizeChanged)
+public:
+    explicit SharedNotifyObject(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+    int contentWidth() const
+    {
+        return m_size.width();
+    }
+    int contentHeight() const
+    {
+        return m_size.height();
+    }
+    void setContentSize(const QSize &size)
+    {
+        m_size = size;
+        emit contentSizeChanged();
+    }
+
+signals:
+    void contentSizeChanged();
+
+private:
+    QSize m_size;
+};
+
 class PropertyModelTest : public BaseProbeTest
 {
     Q_OBJECT
@@ -149,6 +225,78 @@ private slots:
         QVERIFY(model.setData(idx, 1559));
         QCOMPARE(obj.gadgetPointer()->prop1(), 1559);
     }
+
+    static void testValueSnapshot()
+    {
+        ReadCountingObject obj;
+        AggregatedPropertyModel model;
+        ModelTest modelTest(&model);
+        model.setObject(&obj);
+
+        auto idx = searchFixedIndex(&model, "notifying");
+        QVERIFY(idx.isValid());
+        idx = idx.sibling(idx.row(), 1);
+        auto silentIdx = searchFixedIndex(&model, "silent");
+        QVERIFY(silentIdx.isValid());
+        silentIdx = silentIdx.sibling(silentIdx.row(), 1);
+        obj.notifyingReads = obj.silentReads = 0;
+
+        // repeated access is served from the snapshot
+        for (int i = 0; i < 3; ++i) {
+            QCOMPARE(idx.data(Qt::DisplayRole).toString(), QStringLiteral("0"));
+            QCOMPARE(idx.data(Qt::EditRole), QVariant(0));
+            QVERIFY(!model.itemData(idx).isEmpty());
+            QVERIFY(idx.flags() & Qt::ItemIsEditable);
+            QCOMPARE(silentIdx.data(Qt::EditRole), QVariant(0));
+        }
+        QCOMPARE(obj.notifyingReads, 0);
+        QCOMPARE(obj.silentReads, 3);
+
+        // notify signals invalidate the snapshot
+        QSignalSpy changeSpy(&model, &QAbstractItemModel::dataChanged);
+        QVERIFY(changeSpy.isValid());
+        obj.setNotifying(42);
+        QCOMPARE(changeSpy.size(), 1);
+        QCOMPARE(idx.data(Qt::EditRole), QVariant(42));
+        QCOMPARE(idx.data(Qt::DisplayRole).toString(), QStringLiteral("42"));
+        QCOMPARE(obj.notifyingReads, 1);
+
+        // properties without notify signal are never served from the snapshot
+        obj.setSilent(23);
+        QCOMPARE(silentIdx.data(Qt::EditRole), QVariant(23));
+        QCOMPARE(obj.silentReads, 4);
+
+        // writing through the model updates the snapshot as well
+        QVERIFY(model.setData(silentIdx, 5));
+        QCOMPARE(obj.silent(), 5);
+        QCOMPARE(silentIdx.data(Qt::EditRole), QVariant(5));
+    }
+
+    static void testSharedNotifySignal()
+    {
+        SharedNotifyObject obj;
+        obj.setContentSize(QSize(1, 2));
+        AggregatedPropertyModel model;
+        ModelTest modelTest(&model);
+        model.setObject(&obj);
+
+        auto widthIdx = searchFixedIndex(&model, "contentWidth");
+        QVERIFY(widthIdx.isValid());
+        widthIdx = widthIdx.sibling(widthIdx.row(), 1);
+        auto heightIdx = searchFixedIndex(&model, "contentHeight");
+        QVERIFY(heightIdx.isValid());
+        heightIdx = heightIdx.sibling(heightIdx.row(), 1);
+        QCOMPARE(widthIdx.data(Qt::EditRole), QVariant(1));
+        QCOMPARE(heightIdx.data(Qt::EditRole), QVariant(2));
+
+        // both snapshots are invalidated by the one signal
+        QSignalSpy changeSpy(&model, &QAbstractItemModel::dataChanged);
+        QVERIFY(changeSpy.isValid());
+        obj.setContentSize(QSize(3, 4));
+        QCOMPARE(changeSpy.size(), 2);
+        QCOMPARE(widthIdx.data(Qt::EditRole), QVariant(3));
+        QCOMPARE(heightIdx.data(Qt::EditRole), QVariant(4));
+    }
 };
 
 QTEST_MAIN(PropertyModelTest)
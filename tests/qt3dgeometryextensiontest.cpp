@@ -0,0 +1,193 @@
+/*
+  qt3dgeometryextensiontest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/qt3dinspector/geometryextension/qt3dgeometryextension.h>
+#include <plugins/qt3dinspector/geometryextension/qt3dgeometryextensionclient.h>
+
+#include <core/propertycontroller.h>
+#include <common/endpoint.h>
+
+#include <Qt3DCore/QNode>
+#include <Qt3DRender/QGeometryRenderer>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <Qt3DCore/QGeometry>
+#else
+#include <Qt3DRender/QGeometry>
+#endif
+
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace GammaRay;
+
+namespace {
+/** Delivers calls of client objects to their server side counterpart, once asked to. */
+class TestEndpoint : public Endpoint
+{
+    Q_OBJECT
+public:
+    Protocol::ObjectAddress registerObject(const QString &name, QObject *object) override
+    {
+        Q_UNUSED(name);
+        Q_UNUSED(object);
+        return ++m_lastAddress;
+    }
+
+    void invokeObject(const QString &objectName, const char *method, const QVariantList &args) const override
+    {
+        m_calls.push_back({ objectName, method, args });
+    }
+
+    void setRoute(const QString &objectName, QObject *target)
+    {
+        m_routes.insert(objectName, target);
+    }
+
+    /** Delivers all calls made so far, like they would arrive on the other side later on. */
+    void deliverCalls()
+    {
+        const auto calls = m_calls;
+        m_calls.clear();
+        for (const auto &call : calls)
+            invokeObjectLocal(m_routes.value(call.objectName), call.method.constData(), call.args);
+    }
+
+protected:
+    bool isRemoteClient() const override
+    {
+        return true;
+    }
+    QUrl serverAddress() const override
+    {
+        return QUrl();
+    }
+    void messageReceived(const GammaRay::Message &) override
+    {
+    }
+    void handlerDestroyed(Protocol::ObjectAddress, const QString &) override
+    {
+    }
+    void objectDestroyed(Protocol::ObjectAddress, const QString &, QObject *) override
+    {
+    }
+
+private:
+    struct Call
+    {
+        QString objectName;
+        QByteArray method;
+        QVariantList args;
+    };
+    mutable QVector<Call> m_calls;
+    QHash<QString, QObject *> m_routes;
+    Protocol::ObjectAddress m_lastAddress = Protocol::InvalidObjectAddress + 1;
+};
+}
+
+class Qt3DGeometryExtensionTest : public QObject
+{
+    Q_OBJECT
+private:
+    /** A mesh with a single triangle, taking its vertex positions from @p content. */
+    static Qt3DRender::QGeometryRenderer *createMesh(const QByteArray &content, Qt3DCore::QNode *parent)
+    {
+        auto renderer = new Qt3DRender::QGeometryRenderer(parent);
+        auto geometry = new Qt3DGeometry::QGeometry(renderer);
+        auto buffer = new Qt3DGeometry::QBuffer(geometry);
+        buffer->setData(content);
+        geometry->addAttribute(new Qt3DGeometry::QAttribute(buffer, Qt3DGeometry::QAttribute::defaultPositionAttributeName(),
+                                                            Qt3DGeometry::QAttribute::Float, 3, 3));
+        renderer->setGeometry(geometry);
+        return renderer;
+    }
+
+    static QByteArray vertexData(float value)
+    {
+        QByteArray data;
+        for (int i = 0; i < 9; ++i)
+            data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        return data;
+    }
+
+    static TestEndpoint *endpoint()
+    {
+        return static_cast<TestEndpoint *>(Endpoint::instance());
+    }
+
+private slots:
+    static void initTestCase()
+    {
+        new TestEndpoint;
+    }
+
+    static void cleanupTestCase()
+    {
+        delete Endpoint::instance();
+    }
+
+    void testGeometryChangeDuringTransfer()
+    {
+        PropertyController controller(QStringLiteral("com.kdab.GammaRay.UnitTest.Geometry"), nullptr);
+        auto server = new Qt3DGeometryExtension(&controller);
+        Qt3DGeometryExtensionClient client(QStringLiteral("com.kdab.GammaRay.UnitTest.Geometry.client"), nullptr);
+        endpoint()->setRoute(client.objectName(), server);
+        connect(server, &Qt3DGeometryExtensionInterface::bufferDataChunk, &client, &Qt3DGeometryExtensionInterface::bufferDataChunk);
+        auto unavailableForwarding = connect(server, &Qt3DGeometryExtensionInterface::bufferUnavailable, &client,
+                                             &Qt3DGeometryExtensionInterface::bufferUnavailable);
+        QSignalSpy unavailableSpy(server, &Qt3DGeometryExtensionInterface::bufferUnavailable);
+
+        Qt3DCore::QNode meshes;
+        const auto contentA = vertexData(1.0f);
+        const auto contentB = vertexData(2.0f);
+        const auto meshA = createMesh(contentA, &meshes);
+        const auto meshB = createMesh(contentB, &meshes);
+
+        // the selection changes before the request arrives, the server says it won't send the buffer
+        QVERIFY(server->setQObject(meshA));
+        client.setGeometryData(server->geometryData());
+        QCOMPARE(client.geometryData().buffers.size(), 1);
+        const auto hashA = client.geometryData().buffers.at(0).hash;
+        client.requestBuffer(hashA);
+        QVERIFY(server->setQObject(meshB));
+        endpoint()->deliverCalls();
+        QCOMPARE(unavailableSpy.size(), 1);
+        QCOMPARE(unavailableSpy.at(0).at(0).toByteArray(), hashA);
+
+        // so re-selecting the mesh fetches it again
+        QVERIFY(server->setQObject(meshA));
+        client.requestBuffer(hashA);
+        endpoint()->deliverCalls();
+        QTRY_COMPARE(client.bufferData(hashA), contentA);
+
+        // without that reply, the client drops transfers the new geometry doesn't need on its own
+        disconnect(unavailableForwarding);
+        QVERIFY(server->setQObject(meshB));
+        client.setGeometryData(server->geometryData());
+        const auto hashB = client.geometryData().buffers.at(0).hash;
+        QVERIFY(hashB != hashA);
+        client.requestBuffer(hashB);
+        QVERIFY(server->setQObject(meshA));
+        client.setGeometryData(server->geometryData());
+        endpoint()->deliverCalls();
+        QCOMPARE(unavailableSpy.size(), 2);
+
+        QVERIFY(server->setQObject(meshB));
+        client.setGeometryData(server->geometryData());
+        client.requestBuffer(hashB);
+        endpoint()->deliverCalls();
+        QTRY_COMPARE(client.bufferData(hashB), contentB);
+    }
+};
+
+QTEST_MAIN(Qt3DGeometryExtensionTest)
+
+#include "qt3dgeometryextensiontest.moc"
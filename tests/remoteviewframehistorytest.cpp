@@ -0,0 +1,183 @@
+/*
+  remoteviewframehistorytest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <ui/remoteviewframehistory.h>
+
+#include <compat/qasconst.h>
+
+#include <QPainter>
+#include <QTest>
+
+using namespace GammaRay;
+
+class RemoteViewFrameHistoryTest : public QObject
+{
+    Q_OBJECT
+private:
+    // a frame with a small square moved according to @p step
+    static RemoteViewFrame testFrame(const QSize &size, int step)
+    {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        QPainter p(&image);
+        p.fillRect((step * 7) % (size.width() - 10), (step * 3) % (size.height() - 10), 10, 10, Qt::blue);
+        p.end();
+
+        RemoteViewFrame frame;
+        frame.setImage(image, QTransform::fromTranslate(step, 0));
+        frame.setSceneRect(QRectF(0, 0, step + 1, 1));
+        frame.data = step;
+        return frame;
+    }
+
+private slots:
+    void testCompareScanLine()
+    {
+        QVector<quint32> a(13, 0xff00ff00);
+        auto b = a;
+        b[0] = 0xff000000;
+        b[5] = 0xff000000;
+        b[12] = 0xff000000;
+        QVector<quint32> mask(13, 42);
+
+        QCOMPARE(RemoteViewFrameHistory::compareScanLine(a.constData(), b.constData(), mask.data(), 13), 3);
+        for (int i = 0; i < mask.size(); ++i)
+            QCOMPARE(mask.at(i) != 0, i == 0 || i == 5 || i == 12);
+
+        QCOMPARE(RemoteViewFrameHistory::compareScanLine(a.constData(), a.constData(), mask.data(), 13), 0);
+        QCOMPARE(mask.count(0), 13);
+    }
+
+    void testDiff()
+    {
+        QImage before(100, 80, QImage::Format_ARGB32_Premultiplied);
+        before.fill(Qt::white);
+        auto after = before.copy();
+        after.setPixelColor(10, 20, Qt::red);
+        after.setPixelColor(14, 22, Qt::red);
+        after.setPixelColor(90, 70, Qt::red);
+
+        auto diff = RemoteViewFrameHistory::diff(before, after);
+        QCOMPARE(diff.changedPixels, 3);
+        QCOMPARE(diff.totalPixels, 8000);
+        QCOMPARE(diff.boundingRect, QRect(QPoint(10, 20), QPoint(90, 70)));
+        QVERIFY(diff.region.contains(QPoint(14, 22)));
+        QVERIFY(diff.region.contains(QPoint(90, 70)));
+        QVERIFY(!diff.region.contains(QPoint(50, 50)));
+        QVERIFY(diff.mask.pixelColor(14, 22).alpha() > 0);
+        QCOMPARE(diff.mask.pixelColor(15, 22).alpha(), 0);
+
+        diff = RemoteViewFrameHistory::diff(before, before);
+        QCOMPARE(diff.changedPixels, 0);
+        QVERIFY(diff.boundingRect.isNull());
+        QVERIFY(diff.region.isEmpty());
+
+        // different formats are compared by content
+        diff = RemoteViewFrameHistory::diff(before.convertToFormat(QImage::Format_RGB888), before);
+        QCOMPARE(diff.changedPixels, 0);
+
+        // pixels only present in one of the images count as changed
+        diff = RemoteViewFrameHistory::diff(before, before.copy(0, 0, 100, 70));
+        QCOMPARE(diff.changedPixels, 1000);
+        QCOMPARE(diff.boundingRect, QRect(0, 70, 100, 10));
+        diff = RemoteViewFrameHistory::diff(QImage(), before);
+        QCOMPARE(diff.changedPixels, 8000);
+    }
+
+    void testHistory()
+    {
+        const QSize size(640, 480);
+        RemoteViewFrameHistory history;
+        const int frameCount = RemoteViewFrameHistory::KeyFrameInterval + 8;
+        for (int i = 0; i < frameCount; ++i)
+            QCOMPARE(history.append(testFrame(size, i)), 0);
+
+        QCOMPARE(history.size(), frameCount);
+        QCOMPARE(history.keyFrameCount(), 2);
+        // a few tiles per delta instead of full images
+        QVERIFY(history.memoryUsage() < frameCount * size.width() * size.height());
+
+        for (int i = 0; i < frameCount; ++i) {
+            const auto expected = testFrame(size, i);
+            const auto frame = history.frame(i);
+            QCOMPARE(frame.image(), expected.image());
+            QCOMPARE(frame.transform(), expected.transform());
+            QCOMPARE(frame.sceneRect(), expected.sceneRect());
+            QCOMPARE(frame.data, expected.data);
+        }
+        QVERIFY(!history.frame(frameCount).isValid());
+
+        const auto diff = history.diff(3, 4);
+        QCOMPARE(diff.changedPixels, RemoteViewFrameHistory::diff(testFrame(size, 3).image(), testFrame(size, 4).image()).changedPixels);
+        QVERIFY(diff.changedPixels > 0);
+
+        history.clear();
+        QVERIFY(history.isEmpty());
+        QCOMPARE(history.memoryUsage(), qint64(0));
+    }
+
+    void testMemoryBudget()
+    {
+        const QSize size(100, 100);
+        RemoteViewFrameHistory history;
+        history.setMemoryBudget(3 * size.width() * size.height() * 4);
+
+        // completely different frames, each one becomes a key frame
+        int dropped = 0;
+        for (int i = 0; i < 10; ++i) {
+            QImage image(size, QImage::Format_ARGB32_Premultiplied);
+            image.fill(QColor(i * 20, 0, 0));
+            RemoteViewFrame frame;
+            frame.setImage(image);
+            dropped += history.append(frame);
+        }
+
+        QCOMPARE(history.keyFrameCount(), history.size());
+        QVERIFY(history.size() <= 3);
+        QCOMPARE(dropped + history.size(), 10);
+        QVERIFY(history.memoryUsage() <= history.memoryBudget());
+        QCOMPARE(history.frame(history.size() - 1).image().pixelColor(0, 0), QColor(180, 0, 0));
+    }
+
+    void benchDiff()
+    {
+        const QSize size(1920, 1080);
+        const auto before = testFrame(size, 1).image();
+        const auto after = testFrame(size, 5).image();
+        int changed = 0;
+        QBENCHMARK {
+            changed = RemoteViewFrameHistory::diff(before, after).changedPixels;
+        }
+        QCOMPARE(changed, 200);
+    }
+
+    void benchRecord()
+    {
+        const QSize size(1920, 1080);
+        QVector<RemoteViewFrame> frames;
+        for (int i = 0; i < RemoteViewFrameHistory::KeyFrameInterval; ++i)
+            frames.push_back(testFrame(size, i));
+
+        RemoteViewFrameHistory history;
+        QBENCHMARK {
+            history.clear();
+            for (const auto &frame : qAsConst(frames))
+                history.append(frame);
+        }
+        QCOMPARE(history.size(), static_cast<int>(frames.size()));
+        QCOMPARE(history.keyFrameCount(), 1);
+    }
+};
+
+QTEST_MAIN(RemoteViewFrameHistoryTest)
+
+#include "remoteviewframehistorytest.moc"
@@ -0,0 +1,128 @@
+/*
+  remoteviewimagecachetest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <ui/remoteviewimagecache.h>
+
+#include <QPainter>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace GammaRay;
+
+class RemoteViewImageCacheTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QImage testImage(const QSize &size)
+    {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        QPainter p(&image);
+        for (int x = 0; x < size.width(); x += 64)
+            p.fillRect(x, 0, 32, size.height(), Qt::blue);
+        return image;
+    }
+
+private slots:
+    void testLevels()
+    {
+        QImage image(1000, 600, QImage::Format_RGB888);
+        image.fill(Qt::green);
+        const auto levels = RemoteViewImageCache::buildLevels(image);
+        QCOMPARE(levels.size(), 5);
+        QCOMPARE(levels.at(0).format(), QImage::Format_ARGB32_Premultiplied);
+        QCOMPARE(levels.at(1).size(), QSize(500, 300));
+        QCOMPARE(levels.at(4).size(), QSize(62, 37));
+        QCOMPARE(levels.at(4).pixelColor(30, 20), QColor(Qt::green));
+
+        RemoteViewImageCache cache;
+        QSignalSpy spy(&cache, &RemoteViewImageCache::levelsChanged);
+        cache.setImage(image);
+        QCOMPARE(cache.levelCount(), 1);
+        QCOMPARE(cache.levelForScale(0.1), 0);
+        QTRY_COMPARE(cache.levelCount(), 5);
+        QCOMPARE(spy.size(), 1);
+
+        QCOMPARE(cache.levelForScale(2.0), 0);
+        QCOMPARE(cache.levelForScale(0.5), 0);
+        QCOMPARE(cache.levelForScale(0.3), 1);
+        QCOMPARE(cache.levelForScale(0.2), 2);
+        QCOMPARE(cache.levelForScale(0.001), 4);
+
+        // small images don't need levels
+        cache.setImage(QImage(100, 100, QImage::Format_ARGB32));
+        QCOMPARE(cache.levelCount(), 1);
+        cache.clear();
+        QCOMPARE(cache.levelCount(), 0);
+        QCOMPARE(cache.levelForScale(0.1), 0);
+    }
+
+    void testDraw()
+    {
+        QImage image(1024, 1024, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        RemoteViewImageCache cache;
+        cache.setImage(image);
+        QTRY_VERIFY(cache.levelCount() > 3);
+
+        QImage target(200, 200, QImage::Format_ARGB32_Premultiplied);
+        target.fill(Qt::transparent);
+        {
+            QPainter p(&target);
+            p.translate(10, 10);
+            p.scale(0.1, 0.1);
+            cache.draw(&p, QRectF(0, 0, 60, 200));
+        }
+        QCOMPARE(target.pixelColor(5, 50).alpha(), 0);
+        QCOMPARE(target.pixelColor(50, 50), QColor(Qt::red));
+        QCOMPARE(target.pixelColor(100, 50).alpha(), 0); // outside the exposed area
+        QCOMPARE(target.pixelColor(50, 150).alpha(), 0); // outside the image
+    }
+
+    void benchDraw_data()
+    {
+        QTest::addColumn<double>("zoom");
+        QTest::addColumn<bool>("cached");
+
+        for (const auto zoom : { 0.05, 0.1, 0.25, 0.5, 1.0, 2.0 }) {
+            QTest::addRow("direct %g", zoom) << zoom << false;
+            QTest::addRow("cached %g", zoom) << zoom << true;
+        }
+    }
+
+    void benchDraw()
+    {
+        QFETCH(double, zoom);
+        QFETCH(bool, cached);
+
+        // a 4K frame, drawn into a typical view size
+        const auto image = testImage(QSize(3840, 2160));
+        RemoteViewImageCache cache;
+        cache.setImage(image);
+        QTRY_VERIFY(cache.levelCount() > 1);
+
+        QImage target(1200, 800, QImage::Format_ARGB32_Premultiplied);
+        QBENCHMARK {
+            QPainter p(&target);
+            p.setRenderHint(QPainter::SmoothPixmapTransform, zoom < 1.0);
+            p.scale(zoom, zoom);
+            if (cached)
+                cache.draw(&p, target.rect());
+            else
+                p.drawImage(QPoint(), image);
+        }
+    }
+};
+
+QTEST_MAIN(RemoteViewImageCacheTest)
+
+#include "remoteviewimagecachetest.moc"
@@ -0,0 +1,177 @@
+/*
+  scenemodeltest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/sceneinspector/scenemodel.h>
+
+#include <3rdparty/qt/modeltest.h>
+
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace GammaRay;
+
+class SceneModelTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QGraphicsItem *itemAt(const QModelIndex &index)
+    {
+        return index.data(SceneModel::SceneItemRole).value<QGraphicsItem *>();
+    }
+
+    /** Checks that the model matches the item hierarchy of the scene below @p parent. */
+    static bool matchesScene(const QAbstractItemModel &model, const QModelIndex &parent, QList<QGraphicsItem *> items)
+    {
+        std::sort(items.begin(), items.end());
+        if (model.rowCount(parent) != items.size())
+            return false;
+        for (int row = 0; row < items.size(); ++row) {
+            const auto index = model.index(row, 0, parent);
+            if (itemAt(index) != items.at(row) || model.parent(index) != parent)
+                return false;
+            if (!matchesScene(model, index, items.at(row)->childItems()))
+                return false;
+        }
+        return true;
+    }
+
+    static QList<QGraphicsItem *> topLevelItems(QGraphicsScene *scene)
+    {
+        QList<QGraphicsItem *> items;
+        for (auto item : scene->items()) {
+            if (!item->parentItem())
+                items.push_back(item);
+        }
+        return items;
+    }
+
+    /** Builds a scene of @p count top-level items, each with @p childCount children. */
+    static void populateScene(QGraphicsScene *scene, int count, int childCount)
+    {
+        for (int i = 0; i < count; ++i) {
+            auto item = new QGraphicsRectItem(i % 1000, i / 1000, 1, 1);
+            for (int j = 0; j < childCount; ++j)
+                new QGraphicsRectItem(0, 0, 1, 1, item);
+            scene->addItem(item);
+        }
+    }
+
+private slots:
+    void testModel()
+    {
+        QGraphicsScene scene;
+        populateScene(&scene, 20, 3);
+
+        SceneModel model;
+        ModelTest tester(&model);
+        model.setScene(&scene);
+        QVERIFY(matchesScene(model, QModelIndex(), topLevelItems(&scene)));
+
+        // additions, removals and reparenting only show up after the next update
+        auto added = new QGraphicsRectItem(0, 0, 10, 10);
+        new QGraphicsEllipseItem(0, 0, 5, 5, added);
+        scene.addItem(added);
+        auto removed = topLevelItems(&scene).at(5);
+        delete removed;
+        auto reparented = topLevelItems(&scene).at(7);
+        reparented->setParentItem(added);
+        auto lastChild = topLevelItems(&scene).at(3)->childItems().at(2);
+        lastChild->setParentItem(nullptr);
+
+        QSignalSpy insertSpy(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy removeSpy(&model, &QAbstractItemModel::rowsRemoved);
+        model.updateItems();
+        QVERIFY(!insertSpy.isEmpty());
+        QVERIFY(!removeSpy.isEmpty());
+        QVERIFY(matchesScene(model, QModelIndex(), topLevelItems(&scene)));
+
+        // updates without changes don't touch the model
+        insertSpy.clear();
+        removeSpy.clear();
+        model.updateItems();
+        QVERIFY(insertSpy.isEmpty());
+        QVERIFY(removeSpy.isEmpty());
+
+        // scene changes trigger an update by themselves
+        scene.addItem(new QGraphicsRectItem(0, 0, 10, 10));
+        QTRY_COMPARE(insertSpy.size(), 1);
+        QVERIFY(matchesScene(model, QModelIndex(), topLevelItems(&scene)));
+
+        scene.clear();
+        model.updateItems();
+        QCOMPARE(model.rowCount(), 0);
+    }
+
+    void testDeletedItem()
+    {
+        QGraphicsScene scene;
+        populateScene(&scene, 5, 1);
+
+        SceneModel model;
+        model.setScene(&scene);
+        QVERIFY(matchesScene(model, QModelIndex(), topLevelItems(&scene)));
+
+        const auto index = model.index(2, 0);
+        const auto childIndex = model.index(0, 0, index);
+        delete itemAt(index);
+        QCoreApplication::processEvents(); // but not long enough for the scheduled update
+
+        // the rows are still there, but the deleted items are no longer accessed
+        QCOMPARE(model.rowCount(), 5);
+        QVERIFY(!index.data(Qt::DisplayRole).isValid());
+        QVERIFY(!index.data(Qt::ForegroundRole).isValid());
+        QVERIFY(!itemAt(index));
+        QVERIFY(!itemAt(childIndex));
+        QVERIFY(itemAt(model.index(1, 0)));
+
+        // and get removed without waiting for the next regular update
+        QTRY_COMPARE(model.rowCount(), 4);
+        QVERIFY(matchesScene(model, QModelIndex(), topLevelItems(&scene)));
+    }
+
+    void benchWalkLargeScene()
+    {
+        QGraphicsScene scene;
+        populateScene(&scene, 50000, 3); // 200k items
+
+        SceneModel model;
+        QBENCHMARK_ONCE {
+            model.setScene(&scene);
+        }
+
+        int count = 0;
+        QBENCHMARK_ONCE {
+            const int rows = model.rowCount();
+            for (int row = 0; row < rows; ++row) {
+                const auto index = model.index(row, 0);
+                const int childRows = model.rowCount(index);
+                for (int childRow = 0; childRow < childRows; ++childRow) {
+                    const auto child = model.index(childRow, 1, index);
+                    if (model.parent(child) == index)
+                        ++count;
+                }
+                ++count;
+            }
+        }
+        QCOMPARE(count, 200000);
+
+        QBENCHMARK_ONCE {
+            model.updateItems();
+        }
+    }
+};
+
+QTEST_MAIN(SceneModelTest)
+
+#include "scenemodeltest.moc"
@@ -0,0 +1,120 @@
+/*
+  scenetilecachetest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/sceneinspector/sceneinspectorinterface.h>
+#include <plugins/sceneinspector/scenetilecache.h>
+
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QTest>
+
+using namespace GammaRay;
+
+class SceneTileCacheTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testVisibleTiles()
+    {
+        const auto transform = QTransform::fromScale(2, 2) * QTransform::fromTranslate(-300, -10);
+        QCOMPARE(SceneInspectorInterface::tileZoom(transform), QTransform::fromScale(2, 2));
+        QVERIFY(SceneInspectorInterface::isTileable(transform));
+        QCOMPARE(SceneInspectorInterface::visibleTiles(transform, QSize(600, 300)), QRect(QPoint(1, 0), QPoint(3, 1)));
+        QCOMPARE(SceneInspectorInterface::visibleTiles(QTransform::fromTranslate(100, 0), QSize(256, 256)), QRect(QPoint(-1, 0), QPoint(0, 0)));
+        QVERIFY(SceneInspectorInterface::visibleTiles(transform, QSize()).isEmpty());
+
+        QTransform perspective;
+        perspective.setMatrix(1, 0, 0.001, 0, 1, 0, 0, 0, 1);
+        QVERIFY(!SceneInspectorInterface::isTileable(perspective));
+    }
+
+    void testCache()
+    {
+        QGraphicsScene scene;
+        auto item = scene.addRect(0, 0, 100, 100, QPen(Qt::NoPen), QBrush(Qt::red));
+        SceneTileCache cache;
+        cache.setScene(&scene);
+
+        const QTransform zoom;
+        const auto tile = cache.tile(zoom, QPoint(0, 0));
+        QCOMPARE(tile.size(), QSize(SceneInspectorInterface::TileSize, SceneInspectorInterface::TileSize));
+        QCOMPARE(tile.toImage().pixelColor(50, 50), QColor(Qt::red));
+        QCOMPARE(tile.toImage().pixelColor(150, 150).alpha(), 0);
+        QCOMPARE(cache.tile(zoom, QPoint(0, 0)).cacheKey(), tile.cacheKey());
+
+        const auto farTile = cache.tile(zoom, QPoint(4, 4));
+        const auto zoomedTile = cache.tile(QTransform::fromScale(2, 2), QPoint(0, 0));
+        QCOMPARE(zoomedTile.toImage().pixelColor(150, 150), QColor(Qt::red));
+
+        // changes only drop the tiles in the changed area, on all zoom levels
+        item->setBrush(Qt::blue);
+        QTRY_VERIFY(!cache.contains(zoom, QPoint(0, 0)));
+        QVERIFY(!cache.contains(QTransform::fromScale(2, 2), QPoint(0, 0)));
+        QVERIFY(cache.contains(zoom, QPoint(4, 4)));
+        QCOMPARE(cache.tile(zoom, QPoint(4, 4)).cacheKey(), farTile.cacheKey());
+        QCOMPARE(cache.tile(zoom, QPoint(0, 0)).toImage().pixelColor(50, 50), QColor(Qt::blue));
+
+        // so does moving the decoration
+        QVERIFY(cache.contains(zoom, QPoint(0, 0)));
+        cache.setDecoratedItem(item);
+        QVERIFY(!cache.contains(zoom, QPoint(0, 0)));
+        QVERIFY(cache.contains(zoom, QPoint(4, 4)));
+        cache.tile(zoom, QPoint(0, 0));
+        cache.setDecoratedItem(item);
+        QVERIFY(cache.contains(zoom, QPoint(0, 0)));
+
+        cache.setScene(nullptr);
+        QVERIFY(!cache.contains(zoom, QPoint(4, 4)));
+    }
+
+    void testPrefetch()
+    {
+        QGraphicsScene scene;
+        scene.addRect(0, 0, 1000, 1000);
+        SceneTileCache cache;
+        cache.setScene(&scene);
+        QCoreApplication::processEvents(); // deliver the change notification of adding the item
+
+        const auto transform = QTransform::fromTranslate(-256, -256);
+        cache.prefetch(transform, QSize(256, 256));
+        // the ring around the viewport
+        QTRY_VERIFY(cache.contains(QTransform(), QPoint(2, 2)));
+        QVERIFY(cache.contains(QTransform(), QPoint(0, 0)));
+        QVERIFY(!cache.contains(QTransform(), QPoint(1, 1)));
+        // the next zoom levels
+        QTRY_VERIFY(cache.contains(QTransform::fromScale(1.2, 1.2), QPoint(1, 1)));
+        QTRY_VERIFY(cache.contains(QTransform::fromScale(0.8, 0.8), QPoint(0, 0)));
+    }
+
+    void testDeletedDecoratedItem()
+    {
+        QGraphicsScene scene;
+        auto item = scene.addRect(0, 0, 100, 100, QPen(Qt::NoPen), QBrush(Qt::red));
+        SceneTileCache cache;
+        cache.setScene(&scene);
+        cache.setDecoratedItem(item);
+
+        // prefetching continues after the item is gone, with the decoration it had,
+        // the last tile in the queue is outside of the area invalidated by the removal
+        cache.prefetch(QTransform::fromTranslate(-256, -256), QSize(256, 256));
+        delete item;
+        QTRY_VERIFY(cache.contains(QTransform::fromScale(0.8, 0.8), QPoint(1, 1)));
+
+        cache.setDecoratedItem(nullptr);
+        QVERIFY(!cache.contains(QTransform(), QPoint(0, 0)));
+        QCOMPARE(cache.tile(QTransform(), QPoint(0, 0)).toImage().pixelColor(50, 50).alpha(), 0);
+    }
+};
+
+QTEST_MAIN(SceneTileCacheTest)
+
+#include "scenetilecachetest.moc"
@@ -0,0 +1,136 @@
+/*
+  sessioncapturetest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <common/message.h>
+#include <common/sessioncapture.h>
+#include <common/sessionreplaydevice.h>
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace GammaRay;
+
+class SessionCaptureTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QString largePayload()
+    {
+        return QString(4096, QLatin1Char('x'));
+    }
+
+    static bool writeCapture(const QString &fileName)
+    {
+        SessionRecorder recorder;
+        if (!recorder.open(fileName))
+            return false;
+        for (int i = 0; i < 10; ++i) {
+            Message msg(42, Protocol::MethodCall);
+            msg << i << (i == 5 ? largePayload() : QStringLiteral("message %1").arg(i));
+            recorder.record(i % 2 ? SessionCapture::Outgoing : SessionCapture::Incoming, msg);
+        }
+        return true;
+    }
+
+private slots:
+    void testRoundTrip()
+    {
+        QTemporaryDir dir;
+        const auto fileName = dir.filePath(QStringLiteral("session.gcap"));
+        QVERIFY(writeCapture(fileName));
+
+        SessionCapture capture;
+        QVERIFY2(capture.open(fileName), qPrintable(capture.errorString()));
+        QCOMPARE(capture.count(), 10);
+        QVERIFY(capture.startTime().isValid());
+
+        quint64 lastTimestamp = 0;
+        for (int i = 0; i < capture.count(); ++i) {
+            const auto record = capture.record(i);
+            QCOMPARE(record.direction, i % 2 ? SessionCapture::Outgoing : SessionCapture::Incoming);
+            QCOMPARE(record.address, Protocol::ObjectAddress(42));
+            QCOMPARE(record.type, Protocol::MessageType(Protocol::MethodCall));
+            QVERIFY(record.timestamp >= lastTimestamp);
+            lastTimestamp = record.timestamp;
+
+            const auto msg = capture.message(i);
+            QCOMPARE(msg.address(), Protocol::ObjectAddress(42));
+            int index;
+            QString text;
+            msg >> index >> text;
+            QCOMPARE(index, i);
+            QCOMPARE(text, i == 5 ? largePayload() : QStringLiteral("message %1").arg(i));
+        }
+        // the large payload is compressed on the wire, and so in the capture as well
+        QVERIFY(capture.record(5).data.size() < largePayload().size());
+    }
+
+    void testTruncatedCapture()
+    {
+        QTemporaryDir dir;
+        const auto fileName = dir.filePath(QStringLiteral("session.gcap"));
+        QVERIFY(writeCapture(fileName));
+
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(file.size() - 3));
+        file.close();
+
+        SessionCapture capture;
+        QVERIFY(capture.open(fileName));
+        QCOMPARE(capture.count(), 9);
+        capture.close();
+
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("not a capture at all");
+        file.close();
+        QVERIFY(!capture.open(fileName));
+        QVERIFY(!capture.errorString().isEmpty());
+    }
+
+    void testReplay()
+    {
+        QTemporaryDir dir;
+        const auto fileName = dir.filePath(QStringLiteral("session.gcap"));
+        QVERIFY(writeCapture(fileName));
+
+        SessionReplayDevice device;
+        QVERIFY(device.openCapture(fileName));
+        QSignalSpy finishedSpy(&device, &SessionReplayDevice::finished);
+        device.start();
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(device.deliveredCount(), 5);
+
+        // only the incoming messages are played back
+        QVector<int> indexes;
+        while (Message::canReadMessage(&device)) {
+            const auto msg = Message::readMessage(&device);
+            int index;
+            msg >> index;
+            indexes.push_back(index);
+        }
+        QCOMPARE(indexes, QVector<int>() << 0 << 2 << 4 << 6 << 8);
+        QCOMPARE(device.bytesAvailable(), qint64(0));
+
+        // writes are swallowed
+        Message msg(42, Protocol::MethodCall);
+        msg << 23;
+        msg.write(&device);
+        QCOMPARE(device.bytesAvailable(), qint64(0));
+    }
+};
+
+QTEST_MAIN(SessionCaptureTest)
+
+#include "sessioncapturetest.moc"
@@ -0,0 +1,219 @@
+/*
+  sharedmemorydevicetest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <common/message.h>
+#include <common/sharedmemorydevice.h>
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace GammaRay;
+
+/** Connected pair of devices, either plain local sockets or shared memory devices on top of them. */
+class DevicePair
+{
+public:
+    QIODevice *serverSide = nullptr;
+    QIODevice *clientSide = nullptr;
+
+    bool connect(bool sharedMemory, int ringSize = SharedMemoryDevice::DefaultRingSize)
+    {
+        const auto name = QStringLiteral("gammaray-shm-test-%1").arg(QCoreApplication::applicationPid());
+        QLocalServer::removeServer(name);
+        if (!m_server.listen(name))
+            return false;
+
+        auto socket = new QLocalSocket(&m_server);
+        socket->connectToServer(name);
+        if (!socket->waitForConnected(5000) || !m_server.waitForNewConnection(5000))
+            return false;
+        auto accepted = m_server.nextPendingConnection();
+        if (!sharedMemory) {
+            serverSide = accepted;
+            clientSide = socket;
+            return true;
+        }
+
+        auto serverDevice = new SharedMemoryDevice(accepted, &m_server);
+        if (!serverDevice->createSegment(ringSize))
+            return false;
+        auto clientDevice = new SharedMemoryDevice(socket, &m_server);
+        clientDevice->attachSegment();
+        serverSide = serverDevice;
+        clientSide = clientDevice;
+        return QTest::qWaitFor([clientDevice] { return clientDevice->isOpen(); }, 5000);
+    }
+
+private:
+    QLocalServer m_server;
+};
+
+static QByteArray readBytes(QIODevice *device, int size)
+{
+    QByteArray data;
+    QTest::qWaitFor([device, size, &data] {
+        data += device->readAll();
+        return data.size() >= size;
+    }, 5000);
+    return data;
+}
+
+static int readMessages(QIODevice *device, int count)
+{
+    int received = 0;
+    QTest::qWaitFor([device, count, &received] {
+        while (Message::canReadMessage(device)) {
+            Message::readMessage(device);
+            ++received;
+        }
+        return received >= count;
+    }, 30000);
+    return received;
+}
+
+class SharedMemoryDeviceTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    static void testRoundTrip()
+    {
+        DevicePair pair;
+        if (!pair.connect(true))
+            QSKIP("shared memory not available");
+
+        QCOMPARE(pair.serverSide->write("hello"), 5);
+        QCOMPARE(readBytes(pair.clientSide, 5), QByteArray("hello"));
+
+        QCOMPARE(pair.clientSide->write("world"), 5);
+        QCOMPARE(readBytes(pair.serverSide, 5), QByteArray("world"));
+    }
+
+    static void testLargePayload()
+    {
+        DevicePair pair;
+        if (!pair.connect(true, 4096))
+            QSKIP("shared memory not available");
+
+        // several times the ring size, needs to wrap around and wait for the reader
+        QByteArray payload(100000, Qt::Uninitialized);
+        for (int i = 0; i < payload.size(); ++i)
+            payload[i] = char(i % 251);
+
+        QCOMPARE(pair.serverSide->write(payload), qint64(payload.size()));
+        QVERIFY(pair.serverSide->bytesToWrite() > 0);
+        QCOMPARE(readBytes(pair.clientSide, payload.size()), payload);
+        QTRY_COMPARE(pair.serverSide->bytesToWrite(), qint64(0));
+    }
+
+    static void testMessages()
+    {
+        DevicePair pair;
+        if (!pair.connect(true, 4096))
+            QSKIP("shared memory not available");
+
+        const QByteArray payload(3000, 'x');
+        for (int i = 0; i < 10; ++i) {
+            Message msg(1, 2);
+            msg << payload;
+            msg.write(pair.serverSide);
+        }
+        QCOMPARE(readMessages(pair.clientSide, 10), 10);
+    }
+
+    static void testDisconnect()
+    {
+        DevicePair pair;
+        if (!pair.connect(true))
+            QSKIP("shared memory not available");
+
+        QSignalSpy spy(pair.clientSide, SIGNAL(disconnected()));
+        QVERIFY(spy.isValid());
+        pair.serverSide->write("bye");
+        static_cast<SharedMemoryDevice *>(pair.serverSide)->disconnectFromPeer();
+        QTRY_COMPARE(spy.size(), 1);
+        QCOMPARE(pair.clientSide->readAll(), QByteArray("bye"));
+    }
+
+    static void benchmarkThroughput_data()
+    {
+        QTest::addColumn<bool>("sharedMemory");
+        QTest::addColumn<int>("payloadSize");
+
+        QTest::newRow("local socket, 64 bytes") << false << 64;
+        QTest::newRow("shared memory, 64 bytes") << true << 64;
+        QTest::newRow("local socket, 1 MiB") << false << 1024 * 1024;
+        QTest::newRow("shared memory, 1 MiB") << true << 1024 * 1024;
+    }
+
+    static void benchmarkThroughput()
+    {
+        QFETCH(bool, sharedMemory);
+        QFETCH(int, payloadSize);
+
+        DevicePair pair;
+        if (!pair.connect(sharedMemory)) {
+            if (sharedMemory)
+                QSKIP("shared memory not available");
+            QFAIL("failed to connect local socket");
+        }
+
+        const QByteArray payload(payloadSize, 'x');
+        const int count = qMax(16, 16 * 1024 * 1024 / payloadSize);
+        QBENCHMARK {
+            for (int i = 0; i < count; ++i) {
+                Message msg(1, 2);
+                msg << payload;
+                msg.write(pair.serverSide);
+            }
+            QCOMPARE(readMessages(pair.clientSide, count), count);
+        }
+    }
+
+    static void benchmarkLatency_data()
+    {
+        QTest::addColumn<bool>("sharedMemory");
+
+        QTest::newRow("local socket") << false;
+        QTest::newRow("shared memory") << true;
+    }
+
+    static void benchmarkLatency()
+    {
+        QFETCH(bool, sharedMemory);
+
+        DevicePair pair;
+        if (!pair.connect(sharedMemory)) {
+            if (sharedMemory)
+                QSKIP("shared memory not available");
+            QFAIL("failed to connect local socket");
+        }
+
+        QBENCHMARK {
+            Message ping(1, 2);
+            ping << 42;
+            ping.write(pair.serverSide);
+            QCOMPARE(readMessages(pair.clientSide, 1), 1);
+
+            Message pong(1, 3);
+            pong << 23;
+            pong.write(pair.clientSide);
+            QCOMPARE(readMessages(pair.serverSide, 1), 1);
+        }
+    }
+};
+
+QTEST_MAIN(SharedMemoryDeviceTest)
+
+#include "sharedmemorydevicetest.moc"
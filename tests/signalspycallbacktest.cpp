@@ -13,8 +13,12 @@
 
 #include "baseprobetest.h"
 
+#include <core/signalspydispatcher.h>
+
 #include <QPointer>
 
+#include <private/qobject_p.h>
+
 using namespace GammaRay;
 
 class Sender : public QObject
@@ -30,6 +34,87 @@ signals:
     void mySignal();
 };
 
+class OtherSender : public QObject
+{
+    Q_OBJECT
+public:
+    void emitSignals()
+    {
+        emit mySignal();
+        emit otherSignal();
+    }
+
+signals:
+    void mySignal();
+    void otherSignal();
+};
+
+static QVector<QByteArray> s_filteredEmissions;
+static QVector<QByteArray> s_unfilteredEmissions;
+
+static void filtered_signal_begin(QObject *caller, int method_index, void **)
+{
+    s_filteredEmissions.push_back(caller->metaObject()->method(method_index).methodSignature());
+}
+
+static void unfiltered_signal_begin(QObject *caller, int method_index, void **)
+{
+    if (qobject_cast<Sender *>(caller) || qobject_cast<OtherSender *>(caller))
+        s_unfilteredEmissions.push_back(caller->metaObject()->method(method_index).methodSignature());
+}
+
+static QVector<QByteArray> s_endedEmissions;
+
+static void recording_signal_end(QObject *caller, int method_index)
+{
+    if (qobject_cast<OtherSender *>(caller))
+        s_endedEmissions.push_back(caller->metaObject()->method(method_index).methodSignature());
+}
+
+static void noop_signal_begin(QObject *, int, void **)
+{
+}
+
+static void noop_slot_begin(QObject *, int, void **)
+{
+}
+
+/** Swaps the signal end consumer for a slot consumer while a signal is being emitted. */
+class Reconfigurer : public QObject
+{
+    Q_OBJECT
+public:
+    int endId = -1;
+    int slotId = -1;
+
+public slots:
+    void reconfigure()
+    {
+        const auto probe = Probe::instance();
+        probe->unregisterSignalSpyCallbackSet(endId);
+        SignalSpyCallbackSet slotSpy;
+        slotSpy.slotBeginCallback = noop_slot_begin;
+        slotId = probe->registerSignalSpyCallbackSet(slotSpy);
+    }
+};
+
+static QVector<QByteArray> s_dynamicEmissions;
+
+static void dynamic_signal_begin(QObject *caller, int method_index, void **)
+{
+    s_dynamicEmissions.push_back(caller->metaObject()->method(method_index).methodSignature());
+}
+
+/** Per-instance meta object, like the ones QML creates, that can pose as any class. */
+class DynamicMetaObject : public QAbstractDynamicMetaObject
+{
+public:
+    void setClass(const QMetaObject *mo)
+    {
+        d = mo->d;
+    }
+};
+
 class Receiver : public QObject
 {
     Q_OBJECT
@@ -67,6 +152,116 @@ private slots:
         delete s2.data();
     } // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
 
+    void testFilteredDispatch()
+    {
+        if (!Probe::instance())
+            createProbe();
+        const auto probe = Probe::instance();
+        QVERIFY(probe);
+
+        SignalSpyCallbackSet filtered;
+        filtered.signalBeginCallback = filtered_signal_begin;
+        filtered.classNames = { QByteArrayLiteral("OtherSender") };
+        filtered.signalSignatures = { QByteArrayLiteral("otherSignal()") };
+        const int filteredId = probe->registerSignalSpyCallbackSet(filtered);
+        QVERIFY(filteredId >= 0);
+
+        SignalSpyCallbackSet unfiltered;
+        unfiltered.signalBeginCallback = unfiltered_signal_begin;
+        const int unfilteredId = probe->registerSignalSpyCallbackSet(unfiltered);
+        QVERIFY(unfilteredId >= 0);
+        QVERIFY(unfilteredId != filteredId);
+
+        Sender sender;
+        OtherSender otherSender;
+        sender.emitSignal();
+        otherSender.emitSignals();
+
+        QCOMPARE(s_filteredEmissions, QVector<QByteArray>() << "otherSignal()");
+        QCOMPARE(s_unfilteredEmissions, QVector<QByteArray>() << "mySignal()" << "mySignal()" << "otherSignal()");
+
+        // consumers that are gone no longer receive anything
+        probe->unregisterSignalSpyCallbackSet(filteredId);
+        otherSender.emitSignals();
+        QCOMPARE(s_filteredEmissions.size(), 1);
+        QCOMPARE(s_unfilteredEmissions.size(), 5);
+
+        probe->unregisterSignalSpyCallbackSet(unfilteredId);
+        otherSender.emitSignals();
+        QCOMPARE(s_unfilteredEmissions.size(), 5);
+
+        // without any consumer left, the probe is detached from signal emissions entirely
+        // (tool plugins loaded by the probe might still be consumers though)
+        if (probe->signalSpyDispatcher()->isEmpty()) {
+            const auto callbackSet = qt_signal_spy_callback_set.loadRelaxed();
+            QVERIFY(!callbackSet || !callbackSet->signal_begin_callback);
+        }
+    }
+
+    void testReconfigureDuringEmission()
+    {
+        if (!Probe::instance())
+            createProbe();
+        const auto probe = Probe::instance();
+        QVERIFY(probe);
+
+        SignalSpyCallbackSet beginSpy;
+        beginSpy.signalBeginCallback = noop_signal_begin;
+        const int beginId = probe->registerSignalSpyCallbackSet(beginSpy);
+        SignalSpyCallbackSet endSpy;
+        endSpy.signalEndCallback = recording_signal_end;
+        Reconfigurer reconfigurer;
+        reconfigurer.endId = probe->registerSignalSpyCallbackSet(endSpy);
+        QVERIFY(beginId >= 0);
+        QVERIFY(reconfigurer.endId >= 0);
+
+        // the end consumer is gone before the emission ends, but the end callback still runs
+        OtherSender sender;
+        connect(&sender, &OtherSender::mySignal, &reconfigurer, &Reconfigurer::reconfigure);
+        sender.emitSignals();
+        QVERIFY(s_endedEmissions.isEmpty());
+        QVERIFY(reconfigurer.slotId >= 0);
+
+        // end callbacks are still paired with the right emission afterwards
+        disconnect(&sender, &OtherSender::mySignal, &reconfigurer, &Reconfigurer::reconfigure);
+        probe->unregisterSignalSpyCallbackSet(reconfigurer.slotId);
+        const int endId = probe->registerSignalSpyCallbackSet(endSpy);
+        QVERIFY(endId >= 0);
+        sender.emitSignals();
+        QCOMPARE(s_endedEmissions, QVector<QByteArray>() << "mySignal()" << "otherSignal()");
+
+        probe->unregisterSignalSpyCallbackSet(endId);
+        probe->unregisterSignalSpyCallbackSet(beginId);
+    }
+
+    void testDynamicMetaObject()
+    {
+        if (!Probe::instance())
+            createProbe();
+        const auto probe = Probe::instance();
+        QVERIFY(probe);
+
+        SignalSpyCallbackSet filtered;
+        filtered.signalBeginCallback = dynamic_signal_begin;
+        filtered.classNames = { QByteArrayLiteral("OtherSender") };
+        const int id = probe->registerSignalSpyCallbackSet(filtered);
+        QVERIFY(id >= 0);
+
+        Sender sender;
+        auto mo = new DynamicMetaObject;
+        mo->setClass(&Sender::staticMetaObject);
+        QObjectPrivate::get(&sender)->metaObject = mo; // owned by sender from here on
+        sender.emitSignal();
+        QVERIFY(s_dynamicEmissions.isEmpty());
+
+        // a dynamic meta object at the same address can belong to another class at any time
+        mo->setClass(&OtherSender::staticMetaObject);
+        sender.emitSignal();
+        QCOMPARE(s_dynamicEmissions, QVector<QByteArray>() << "mySignal()");
+
+        probe->unregisterSignalSpyCallbackSet(id);
+    }
+
     static void cleanupTestCase()
     {
         // explicitly delete the probe as our usual cleanup doesn't work since we will
@@ -0,0 +1,18 @@
+/*
+  fakeqtapplication.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+extern "C" int fakeQtCoreFunction();
+
+int main()
+{
+    return fakeQtCoreFunction() == 42 ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+/*
+  fakeqtcore.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <cstdint>
+
+// mimics the version information QtCore embeds, without depending on Qt
+__attribute__((section(".qtversion"), used, aligned(sizeof(void *)))) static const uintptr_t fake_qt_version_info[2] = { 0, 0x090301 };
+
+extern "C" int fakeQtCoreFunction()
+{
+    return 42;
+}
@@ -0,0 +1,57 @@
+/*
+  timezonemodeltest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/localeinspector/timezonemodel.h>
+#include <plugins/localeinspector/timezonemodelroles.h>
+
+#include <3rdparty/qt/modeltest.h>
+
+#include <QSignalSpy>
+#include <QTest>
+#include <QTimeZone>
+
+using namespace GammaRay;
+
+class TimezoneModelTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testModel()
+    {
+        TimezoneModel model;
+        ModelTest tester(&model);
+        QSignalSpy insertSpy(&model, &QAbstractItemModel::rowsInserted);
+
+        // filled in the background on first use
+        const auto ids = QTimeZone::availableTimeZoneIds();
+        QCOMPARE(model.rowCount(), 0);
+        QTRY_COMPARE(model.rowCount(), ids.size());
+        QCOMPARE(insertSpy.size(), 1);
+        QCOMPARE(model.columnCount(QModelIndex()), int(TimezoneModelColumns::COUNT));
+
+        int localZones = 0;
+        for (int row = 0; row < model.rowCount(); ++row) {
+            const QTimeZone tz(ids.at(row));
+            QCOMPARE(model.index(row, TimezoneModelColumns::IanaIdColumn).data().toByteArray(), tz.id());
+            QCOMPARE(model.index(row, TimezoneModelColumns::DSTColumn).data().toBool(), tz.hasDaylightTime());
+            QCOMPARE(model.index(row, TimezoneModelColumns::WindowsIdColumn).data().toByteArray(), QTimeZone::ianaIdToWindowsId(tz.id()));
+            QCOMPARE(model.index(row, TimezoneModelColumns::IanaIdColumn).data(Qt::ToolTipRole).toString(), tz.comment());
+            if (model.index(row, 0).data(TimezoneModelRoles::LocalZoneRole).toBool())
+                ++localZones;
+        }
+        QVERIFY(localZones <= 1);
+    }
+};
+
+QTEST_MAIN(TimezoneModelTest)
+
+#include "timezonemodeltest.moc"
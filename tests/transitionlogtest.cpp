@@ -0,0 +1,133 @@
+/*
+  transitionlogtest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/statemachineviewer/transitionlog.h>
+
+#include <QTest>
+
+#include <limits>
+
+using namespace GammaRay;
+
+class TransitionLogTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    static void testAppend()
+    {
+        TransitionLog log(10 * sizeof(StateMachineEvent));
+        QCOMPARE(log.capacity(), 10);
+        QCOMPARE(log.size(), 0);
+        QVERIFY(log.lastEvents(5).isEmpty());
+
+        log.append(StateMachineEvent::StateEntered, 1, 100);
+        log.append(StateMachineEvent::TransitionTriggered, 2, 200);
+        log.append(StateMachineEvent::StateExited, 1, 300);
+        QCOMPARE(log.size(), 3);
+        QCOMPARE(log.totalCount(), 3ull);
+
+        const auto events = log.lastEvents(5);
+        QCOMPARE(events.size(), 3);
+        QCOMPARE(events.at(0).type, StateMachineEvent::StateEntered);
+        QCOMPARE(events.at(0).id, 1ull);
+        QCOMPARE(events.at(1).type, StateMachineEvent::TransitionTriggered);
+        QCOMPARE(events.at(1).id, 2ull);
+        QCOMPARE(events.at(2).type, StateMachineEvent::StateExited);
+        QCOMPARE(events.at(2).timestamp, 300ll);
+
+        log.clear();
+        QCOMPARE(log.size(), 0);
+        QCOMPARE(log.totalCount(), 0ull);
+    }
+
+    static void testWrapAround()
+    {
+        TransitionLog log(4 * sizeof(StateMachineEvent));
+        for (int i = 0; i < 10; ++i)
+            log.append(StateMachineEvent::StateEntered, i, i * 10);
+        QCOMPARE(log.size(), 4);
+        QCOMPARE(log.totalCount(), 10ull);
+
+        const auto events = log.lastEvents(4);
+        QCOMPARE(events.size(), 4);
+        for (int i = 0; i < 4; ++i)
+            QCOMPARE(events.at(i).id, quint64(6 + i));
+
+        const auto last = log.lastEvents(2);
+        QCOMPARE(last.size(), 2);
+        QCOMPARE(last.at(0).id, 8ull);
+        QCOMPARE(last.at(1).id, 9ull);
+    }
+
+    static void testTimeRange()
+    {
+        TransitionLog log(8 * sizeof(StateMachineEvent));
+        for (int i = 0; i < 12; ++i)
+            log.append(StateMachineEvent::StateEntered, i, i * 10);
+        // 40 to 110 remain
+
+        auto events = log.events(55, 80);
+        QCOMPARE(events.size(), 3);
+        QCOMPARE(events.first().timestamp, 60ll);
+        QCOMPARE(events.last().timestamp, 80ll);
+
+        events = log.events(0, 45);
+        QCOMPARE(events.size(), 1);
+        QCOMPARE(events.first().timestamp, 40ll);
+
+        events = log.events(100, std::numeric_limits<qint64>::max());
+        QCOMPARE(events.size(), 2);
+        QCOMPARE(events.last().timestamp, 110ll);
+
+        QVERIFY(log.events(0, 30).isEmpty());
+        QVERIFY(log.events(120, 200).isEmpty());
+        QVERIFY(log.events(80, 60).isEmpty());
+    }
+
+    static void testEqualTimestamps()
+    {
+        TransitionLog log;
+        log.append(StateMachineEvent::StateExited, 1, 10);
+        log.append(StateMachineEvent::TransitionTriggered, 2, 20);
+        log.append(StateMachineEvent::StateEntered, 3, 20);
+        log.append(StateMachineEvent::StateEntered, 4, 30);
+
+        const auto events = log.events(20, 20);
+        QCOMPARE(events.size(), 2);
+        QCOMPARE(events.at(0).id, 2ull);
+        QCOMPARE(events.at(1).id, 3ull);
+    }
+
+    static void testMemoryLimit()
+    {
+        TransitionLog log;
+        QCOMPARE(log.memoryLimit(), int((1024 * 1024 / sizeof(StateMachineEvent)) * sizeof(StateMachineEvent)));
+        log.append(StateMachineEvent::StateEntered, 1, 1);
+
+        log.setMemoryLimit(100 * sizeof(StateMachineEvent) + 1);
+        QCOMPARE(log.capacity(), 100);
+        QCOMPARE(log.memoryLimit(), int(100 * sizeof(StateMachineEvent)));
+        QCOMPARE(log.size(), 0);
+
+        // always keeps at least one event
+        log.setMemoryLimit(0);
+        QCOMPARE(log.capacity(), 1);
+        log.append(StateMachineEvent::StateEntered, 1, 1);
+        log.append(StateMachineEvent::StateEntered, 2, 2);
+        QCOMPARE(log.size(), 1);
+        QCOMPARE(log.lastEvents(1).first().id, 2ull);
+    }
+};
+
+QTEST_MAIN(TransitionLogTest)
+
+#include "transitionlogtest.moc"
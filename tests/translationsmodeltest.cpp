@@ -0,0 +1,144 @@
+/*
+  translationsmodeltest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/translatorinspector/translatorwrapper.h>
+
+#include <3rdparty/qt/modeltest.h>
+
+#include <QItemSelection>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace GammaRay;
+
+namespace {
+// translates everything to upper case, except for the "other" context
+class UpperCaseTranslator : public QTranslator
+{
+public:
+    bool isEmpty() const override
+    {
+        return false;
+    }
+
+    QString translate(const char *context, const char *sourceText, const char *disambiguation,
+                      int n) const override
+    {
+        Q_UNUSED(disambiguation);
+        Q_UNUSED(n);
+        if (qstrcmp(context, "other") == 0)
+            return QString();
+        return QString::fromUtf8(sourceText).toUpper();
+    }
+};
+}
+
+class TranslationsModelTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QVector<QByteArray> sourceTexts(int count)
+    {
+        QVector<QByteArray> texts;
+        texts.reserve(count);
+        for (int i = 0; i < count; ++i)
+            texts.push_back("string " + QByteArray::number(i));
+        return texts;
+    }
+
+private slots:
+    void testTranslate()
+    {
+        auto translator = new UpperCaseTranslator;
+        auto wrapper = new TranslatorWrapper(translator);
+        auto model = wrapper->model();
+        ModelTest modelTest(model);
+        QSignalSpy insertSpy(model, &QAbstractItemModel::rowsInserted);
+
+        QCOMPARE(wrapper->translate("ctx", "a", nullptr, -1), QStringLiteral("A"));
+        QCOMPARE(wrapper->translate("ctx", "b", nullptr, -1), QStringLiteral("B"));
+        QCOMPARE(wrapper->translate("ctx", "a", nullptr, -1), QStringLiteral("A"));
+        QCOMPARE(wrapper->translate("ctx", "a", "dis", -1), QStringLiteral("A"));
+        QCOMPARE(wrapper->translate(nullptr, "a", nullptr, -1), QStringLiteral("A"));
+        QCOMPARE(wrapper->translate("", "a", "", -1), QStringLiteral("A"));
+        QVERIFY(wrapper->translate("other", "x", nullptr, -1).isNull());
+
+        // new strings show up together
+        QCOMPARE(model->rowCount(), 0);
+        QTRY_COMPARE(model->rowCount(), 4);
+        QCOMPARE(insertSpy.size(), 1);
+        QCOMPARE(model->index(0, 0).data().toByteArray(), QByteArray("ctx"));
+        QCOMPARE(model->index(0, 1).data().toByteArray(), QByteArray("a"));
+        QCOMPARE(model->index(0, 3).data().toString(), QStringLiteral("A"));
+        QCOMPARE(model->index(2, 2).data().toByteArray(), QByteArray("dis"));
+        QVERIFY(model->index(3, 0).data().toByteArray().isEmpty());
+
+        // overrides
+        QVERIFY(!model->hasOverrides());
+        QVERIFY(model->setData(model->index(1, 3), QStringLiteral("override"), Qt::EditRole));
+        QVERIFY(model->hasOverrides());
+        QCOMPARE(model->index(1, 3).data(TranslationsModel::IsOverriddenRole).toBool(), true);
+        QCOMPARE(wrapper->translate("ctx", "b", nullptr, -1), QStringLiteral("override"));
+        QCOMPARE(wrapper->translate("ctx", "a", nullptr, -1), QStringLiteral("A"));
+
+        model->resetAllUnchanged();
+        QCOMPARE(model->rowCount(), 1);
+        QCOMPARE(model->index(0, 1).data().toByteArray(), QByteArray("b"));
+        QCOMPARE(wrapper->translate("ctx", "b", nullptr, -1), QStringLiteral("override"));
+        QCOMPARE(wrapper->translate("ctx", "a", nullptr, -1), QStringLiteral("A"));
+        model->insertPendingRows();
+        QCOMPARE(model->rowCount(), 2);
+        QCOMPARE(model->index(1, 1).data().toByteArray(), QByteArray("a"));
+
+        model->resetTranslations(QItemSelection(model->index(0, 0), model->index(0, 3)));
+        QVERIFY(!model->hasOverrides());
+        QCOMPARE(model->rowCount(), 1);
+        QCOMPARE(wrapper->translate("ctx", "b", nullptr, -1), QStringLiteral("B"));
+
+        delete translator; // takes the wrapper with it
+    }
+
+    void benchTranslateNew()
+    {
+        const auto texts = sourceTexts(50000);
+        QBENCHMARK {
+            auto translator = new UpperCaseTranslator;
+            auto wrapper = new TranslatorWrapper(translator);
+            for (const auto &text : texts)
+                wrapper->translate("context", text.constData(), nullptr, -1);
+            wrapper->model()->insertPendingRows();
+            QCOMPARE(wrapper->model()->rowCount(), static_cast<int>(texts.size()));
+            delete translator;
+        }
+    }
+
+    void benchRetranslate()
+    {
+        const auto texts = sourceTexts(50000);
+        auto translator = new UpperCaseTranslator;
+        auto wrapper = new TranslatorWrapper(translator);
+        for (const auto &text : texts)
+            wrapper->translate("context", text.constData(), nullptr, -1);
+        wrapper->model()->insertPendingRows();
+
+        QBENCHMARK {
+            for (const auto &text : texts)
+                wrapper->translate("context", text.constData(), nullptr, -1);
+        }
+        QCOMPARE(wrapper->model()->rowCount(), static_cast<int>(texts.size()));
+        delete translator;
+    }
+};
+
+QTEST_MAIN(TranslationsModelTest)
+
+#include "translationsmodeltest.moc"
@@ -15,12 +15,17 @@
 
 #include <common/objectbroker.h>
 #include <core/paintbuffer.h>
+#include <core/paintbufferrecording.h>
 
 #include <3rdparty/qt/modeltest.h>
 
 #include <QAbstractItemModel>
+#include <QPainter>
+#include <QPixmap>
 #include <QWidget>
 
+#include <algorithm>
+
 using namespace GammaRay;
 
 class WidgetTest : public BaseProbeTest
@@ -87,6 +92,79 @@ private slots:
         auto buffer2 = buffer;
         buffer = PaintBuffer();
     }
+
+    void testPaintBufferRecording()
+    {
+        QPixmap pixmap(16, 16);
+        pixmap.fill(Qt::red);
+
+        PaintBuffer buffer;
+        buffer.setBoundingRect(QRectF(0, 0, 64, 64));
+        {
+            QPainter p(&buffer);
+            for (int i = 0; i < 4; ++i)
+                p.drawPixmap(i * 16, 0, pixmap);
+            p.fillRect(QRect(0, 16, 64, 16), QBrush(Qt::blue));
+            p.drawText(QPointF(0, 48), QStringLiteral("GammaRay"));
+        }
+        QVERIFY(buffer.data()->commands.size() > 4);
+
+        const auto recording = PaintBufferRecording::save(buffer);
+        QVERIFY(!recording.isEmpty());
+
+        PaintBuffer loaded;
+        QVERIFY(PaintBufferRecording::load(reinterpret_cast<const uchar *>(recording.constData()), recording.size(), loaded));
+        QCOMPARE(loaded.boundingRect(), buffer.boundingRect());
+        QCOMPARE(loaded.data()->commands.size(), buffer.data()->commands.size());
+        QCOMPARE(loaded.data()->ints, buffer.data()->ints);
+        QCOMPARE(loaded.data()->floats, buffer.data()->floats);
+        QCOMPARE(loaded.data()->variants.size(), buffer.data()->variants.size());
+
+        // identical pixmaps are stored and restored only once
+        qint64 pixmapKey = 0;
+        int pixmapCount = 0;
+        for (const auto &v : loaded.data()->variants) {
+            if (v.userType() != QMetaType::QPixmap)
+                continue;
+            if (pixmapCount++ == 0)
+                pixmapKey = v.value<QPixmap>().cacheKey();
+            QCOMPARE(v.value<QPixmap>().cacheKey(), pixmapKey);
+        }
+        QCOMPARE(pixmapCount, 4);
+
+        QImage image(64, 64, QImage::Format_ARGB32);
+        image.fill(Qt::transparent);
+        QPainter p(&image);
+        loaded.processCommands(&p, loaded.frameStartIndex(0), loaded.data()->commands.size());
+        p.end();
+        QCOMPARE(image.pixel(8, 8), QColor(Qt::red).rgba());
+
+        // failed loads leave the buffer untouched
+        const auto loadedCommandCount = loaded.data()->commands.size();
+        const auto loadedVariantCount = loaded.data()->variants.size();
+        QVERIFY(!PaintBufferRecording::load(reinterpret_cast<const uchar *>(recording.constData()), 16, loaded));
+        QCOMPARE(loaded.data()->commands.size(), loadedCommandCount);
+
+        // frames beyond the last command are rejected
+        auto &commands = buffer.data()->commands;
+        buffer.data()->frames.push_back(commands.size() + 1);
+        const auto badFrames = PaintBufferRecording::save(buffer);
+        buffer.data()->frames.pop_back();
+        QVERIFY(!PaintBufferRecording::load(reinterpret_cast<const uchar *>(badFrames.constData()), badFrames.size(), loaded));
+        QCOMPARE(loaded.data()->commands.size(), loadedCommandCount);
+        QCOMPARE(loaded.data()->variants.size(), loadedVariantCount);
+
+        // commands referring to data outside of the recording are rejected
+        const auto pixmapCmd = std::find_if(commands.begin(), commands.end(), [](const QPaintBufferCommand &cmd) {
+            return cmd.id == QPaintBufferPrivate::Cmd_DrawPixmapPos;
+        });
+        QVERIFY(pixmapCmd != commands.end());
+        pixmapCmd->extra = buffer.data()->floats.size() - 1;
+        const auto corrupt = PaintBufferRecording::save(buffer);
+        QVERIFY(!PaintBufferRecording::load(reinterpret_cast<const uchar *>(corrupt.constData()), corrupt.size(), loaded));
+        QCOMPARE(loaded.data()->commands.size(), loadedCommandCount);
+        QCOMPARE(loaded.data()->variants.size(), loadedVariantCount);
+    }
 };
 
 QTEST_MAIN(WidgetTest)
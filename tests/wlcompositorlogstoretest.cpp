@@ -0,0 +1,180 @@
+/*
+  wlcompositorlogstoretest.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <plugins/wlcompositorinspector/logstore.h>
+
+#include <QTest>
+
+#include <numeric>
+
+using namespace GammaRay;
+
+static quint64 sum(const QVector<quint32> &v)
+{
+    return std::accumulate(v.constBegin(), v.constEnd(), quint64(0));
+}
+
+class WlCompositorLogStoreTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    static void testAppend()
+    {
+        LogStore store;
+        QCOMPARE(store.count(), 0);
+        QCOMPARE(store.lowerBound(100), 0);
+
+        for (int i = 0; i < 10000; ++i)
+            store.append(i % 2 ? 2 : 1, i * 100, QByteArray::number(i));
+        QCOMPARE(store.count(), 10000);
+        QCOMPARE(store.at(0).message, QByteArray("0"));
+        QCOMPARE(store.at(9999).message, QByteArray("9999"));
+        QCOMPARE(store.at(LogStore::ChunkSize).time, qint64(LogStore::ChunkSize * 100));
+        QCOMPARE(store.startTime(), 0ll);
+        QCOMPARE(store.endTime(), 999900ll);
+
+        QCOMPARE(store.count(0), 10000);
+        QCOMPARE(store.count(1), 5000);
+        QCOMPARE(store.count(2), 5000);
+        QCOMPARE(store.count(3), 0);
+        QCOMPARE(store.entryIndex(0, 42), 42);
+        QCOMPARE(store.entryIndex(1, 42), 84);
+        QCOMPARE(store.entryIndex(2, 42), 85);
+
+        store.clear();
+        QCOMPARE(store.count(), 0);
+        QCOMPARE(store.count(1), 0);
+    }
+
+    static void testLowerBound()
+    {
+        LogStore store;
+        for (int i = 0; i < 10000; ++i)
+            store.append(1, (i / 2) * 10, QByteArray()); // pairs of equal timestamps
+
+        QCOMPARE(store.lowerBound(-5), 0);
+        QCOMPARE(store.lowerBound(0), 0);
+        QCOMPARE(store.lowerBound(1), 2);
+        QCOMPARE(store.lowerBound(10), 2);
+        QCOMPARE(store.lowerBound(25000), 5000);
+        QCOMPARE(store.lowerBound(49990), 9998);
+        QCOMPARE(store.lowerBound(50000), 10000);
+    }
+
+    static void testDropChunks()
+    {
+        LogStore store(2);
+        const int total = 5 * LogStore::ChunkSize + 10;
+        for (int i = 0; i < total; ++i)
+            store.append(i % 3 ? 2 : 1, i * 1000, QByteArray::number(i));
+
+        // the two newest chunks, the last one being partially filled
+        QCOMPARE(store.count(), LogStore::ChunkSize + 10);
+        const int first = 4 * LogStore::ChunkSize;
+        QCOMPARE(store.at(0).message, QByteArray::number(first));
+        QCOMPARE(store.startTime(), qint64(first) * 1000);
+        QCOMPARE(store.count(1) + store.count(2), store.count());
+
+        for (int row = 0; row < store.count(1); ++row) {
+            const auto &entry = store.at(store.entryIndex(1, row));
+            QCOMPARE(entry.pid, 1ull);
+            QCOMPARE(entry.message.toInt() % 3, 0);
+        }
+
+        // events dropped with their chunks are no longer counted
+        const auto density = store.density(0, 1 << 20, (total * 1000) / (1 << 20) + 1);
+        QCOMPARE(sum(density), quint64(store.count()));
+    }
+
+    static void testDensity()
+    {
+        LogStore store;
+        // 100 events per millisecond over 100ms
+        for (int i = 0; i < 10000; ++i)
+            store.append(1, i * 10000, QByteArray());
+
+        // coarse bins use the histogram
+        auto density = store.density(0, 10e6, 10);
+        QCOMPARE(density.size(), 10);
+        QCOMPARE(sum(density), 10000ull);
+
+        density = store.density(0, 1e9, 1);
+        QCOMPARE(density.at(0), 10000u);
+
+        // partial range, aligned to the histogram buckets
+        density = store.density(4 << 23, 1 << 23, 2);
+        QCOMPARE(sum(density), 1678ull);
+
+        // bins finer than the histogram count the entries directly
+        density = store.density(0, 10000, 10);
+        for (const auto count : density)
+            QCOMPARE(count, 1u);
+
+        density = store.density(200e6, 1e6, 5);
+        QCOMPARE(sum(density), 0ull);
+    }
+
+    static void testDensityTimeGap()
+    {
+        LogStore store;
+        for (int i = 0; i < 1000; ++i)
+            store.append(1, i * 1000, QByteArray());
+
+        // an hour of silence doesn't blow up the histogram, the finest levels get dropped instead
+        const qint64 hour = 3600 * qint64(1000000000);
+        store.append(1, hour, QByteArray());
+        auto density = store.density(0, 1e9, 4000);
+        QCOMPARE(sum(density), 1001ull);
+        QCOMPARE(density.at(0), 1000u);
+
+        // neither does a gap too large for a bucket index at the finest resolution
+        const qint64 century = 100 * 365 * 24 * hour;
+        store.append(1, century, QByteArray());
+        density = store.density(0, 1e16, 400);
+        QCOMPARE(sum(density), 1002ull);
+        QCOMPARE(density.at(0), 1001u);
+
+        // and recent events still end up in the right place
+        store.append(1, century + 1000, QByteArray());
+        QCOMPARE(sum(store.density(century, 1e6, 10)), 2ull);
+    }
+
+    static void benchmarkAppend()
+    {
+        LogStore store;
+        const QByteArray message("wl_surface@42.commit()");
+        qint64 time = 0;
+        QBENCHMARK {
+            for (int i = 0; i < 100000; ++i)
+                store.append(i % 8, time += 1000, message);
+        }
+    }
+
+    static void benchmarkVisibleRange()
+    {
+        LogStore store;
+        const QByteArray message("wl_surface@42.commit()");
+        for (int i = 0; i < 250000; ++i)
+            store.append(i % 8, i * 1000ll, message);
+
+        QBENCHMARK {
+            const auto begin = store.lowerBound(100000000);
+            const auto end = store.lowerBound(101000000);
+            QCOMPARE(end - begin, 1000);
+            QCOMPARE(store.density(0, 250000, 1000).size(), 1000);
+        }
+    }
+};
+
+QTEST_MAIN(WlCompositorLogStoreTest)
+
+#include "wlcompositorlogstoretest.moc"
@@ -19,6 +19,7 @@
 #include <ui/tools/metaobjectbrowser/metaobjectbrowserwidget.h>
 #include <ui/tools/metatypebrowser/metatypebrowserwidget.h>
 #include <ui/tools/objectinspector/objectinspectorwidget.h>
+#include <ui/tools/probeoverhead/probeoverheadwidget.h>
 #include <ui/tools/problemreporter/problemreporterwidget.h>
 #include <ui/tools/resourcebrowser/resourcebrowserwidget.h>
 
@@ -57,6 +58,7 @@ using namespace GammaRay;
 MAKE_FACTORY(MessageHandler, qApp->translate("GammaRay::MessageHandlerFactory", "Messages"));
 MAKE_FACTORY(MetaObjectBrowser, qApp->translate("GammaRay::MetaObjectBrowserFactory", "Meta Objects"));
 MAKE_FACTORY(MetaTypeBrowser, qApp->translate("GammaRay::MetaTypeBrowserFactory", "Meta Types"));
+MAKE_FACTORY(ProbeOverhead, qApp->translate("GammaRay::ProbeOverheadFactory", "Probe Overhead"));
 MAKE_FACTORY(ProblemReporter, qApp->translate("GammaRay::ProblemReporterFactory", "Problems"));
 MAKE_FACTORY(ResourceBrowser, qApp->translate("GammaRay::ResourceBrowserFactory", "Resources"));
 
@@ -92,6 +94,7 @@ static void initPluginRepository()
     insertFactory(new MetaObjectBrowserFactory);
     insertFactory(new MetaTypeBrowserFactory);
     insertFactory(new ObjectInspectorFactory);
+    insertFactory(new ProbeOverheadFactory);
     insertFactory(new ProblemReporterFactory);
     insertFactory(new ResourceBrowserFactory);
 
@@ -54,16 +54,23 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDesktopServices>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
 #include <QHeaderView>
 #include <QInputDialog>
 #include <QLabel>
 #include <QMenu>
+#include <QMessageBox>
 #include <QProcess>
+#include <QPushButton>
 #include <QSettings>
 #include <QStyleFactory>
+#include <QTabWidget>
 #include <QTableView>
 #include <QToolButton>
 #include <QUrl>
+#include <QVBoxLayout>
 #include <QWidgetAction>
 
 #include <QStandardPaths>
@@ -415,12 +422,39 @@ void MainWindow::aboutKDAB()
 
 void MainWindow::showMessageStatistics()
 {
+    auto tabs = new QTabWidget;
+    tabs->setWindowTitle(tr("Communication Message Statistics"));
+    tabs->setAttribute(Qt::WA_DeleteOnClose);
+
     auto view = new QTableView;
-    view->setWindowTitle(tr("Communication Message Statistics"));
-    view->setAttribute(Qt::WA_DeleteOnClose);
     view->setModel(ObjectBroker::model(QStringLiteral("com.kdab.GammaRay.MessageStatisticsModel")));
     view->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
-    view->showMaximized();
+    tabs->addTab(view, tr("Messages"));
+
+    auto latencyModel = ObjectBroker::model(QStringLiteral("com.kdab.GammaRay.MessageLatencyModel"));
+    auto latencyPage = new QWidget;
+    auto layout = new QVBoxLayout(latencyPage);
+    auto latencyView = new QTableView;
+    latencyView->setModel(latencyModel);
+    latencyView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    layout->addWidget(latencyView);
+    auto buttons = new QDialogButtonBox;
+    auto exportButton = buttons->addButton(tr("Export as JSON..."), QDialogButtonBox::ActionRole);
+    connect(exportButton, &QPushButton::clicked, latencyPage, [latencyPage, latencyModel]() {
+        const auto fileName = QFileDialog::getSaveFileName(latencyPage, tr("Export Latency Statistics"), QString(),
+                                                           tr("JSON Files (*.json)"));
+        if (fileName.isEmpty())
+            return;
+        QByteArray json;
+        QMetaObject::invokeMethod(latencyModel, "toJson", Qt::DirectConnection, Q_RETURN_ARG(QByteArray, json));
+        QFile file(fileName);
+        if (!file.open(QFile::WriteOnly) || file.write(json) != json.size())
+            QMessageBox::warning(latencyPage, tr("Export Failed"), tr("Failed to write %1: %2").arg(fileName, file.errorString()));
+    });
+    layout->addWidget(buttons);
+    tabs->addTab(latencyPage, tr("Latencies"));
+
+    tabs->showMaximized();
 }
 
 bool MainWindow::selectTool(const QString &id)
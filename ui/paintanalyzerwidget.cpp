@@ -29,6 +29,8 @@
 #include <QActionGroup>
 #include <QComboBox>
 #include <QDebug>
+#include <QFile>
+#include <QFileDialog>
 #include <QLabel>
 #include <QMenu>
 #include <QToolBar>
@@ -70,6 +72,8 @@ PaintAnalyzerWidget::PaintAnalyzerWidget(QWidget *parent)
     toolbar->addAction(ui->replayWidget->zoomInAction());
     toolbar->addSeparator();
     toolbar->addAction(ui->actionShowClipArea);
+    toolbar->addSeparator();
+    toolbar->addAction(ui->actionSaveRecording);
 
     ui->replayWidget->setSupportedInteractionModes(
         RemoteViewWidget::ViewInteraction | RemoteViewWidget::Measuring | RemoteViewWidget::ColorPicking);
@@ -86,6 +90,9 @@ PaintAnalyzerWidget::PaintAnalyzerWidget(QWidget *parent)
     connect(ui->actionShowClipArea, &QAction::toggled, ui->replayWidget, &PaintAnalyzerReplayView::setShowClipArea);
     ui->actionShowClipArea->setChecked(ui->replayWidget->showClipArea());
 
+    ui->actionSaveRecording->setIcon(QIcon::fromTheme(QStringLiteral("document-save")));
+    connect(ui->actionSaveRecording, &QAction::triggered, this, &PaintAnalyzerWidget::saveRecording);
+
     connect(ui->commandView, &QWidget::customContextMenuRequested, this, &PaintAnalyzerWidget::commandContextMenu);
     connect(ui->stackTraceView, &QWidget::customContextMenuRequested, this, &PaintAnalyzerWidget::stackTraceContextMenu);
 }
@@ -111,6 +118,7 @@ void PaintAnalyzerWidget::setBaseName(const QString &name)
     m_iface = ObjectBroker::object<PaintAnalyzerInterface *>(name);
     connect(m_iface, &PaintAnalyzerInterface::hasArgumentDetailsChanged, this, &PaintAnalyzerWidget::detailsChanged);
     connect(m_iface, &PaintAnalyzerInterface::hasStackTraceChanged, this, &PaintAnalyzerWidget::detailsChanged);
+    connect(m_iface, &PaintAnalyzerInterface::recordingChunk, this, &PaintAnalyzerWidget::recordingChunk);
     detailsChanged();
 }
 
@@ -159,3 +167,44 @@ void PaintAnalyzerWidget::stackTraceContextMenu(QPoint pos)
     cme.populateMenu(&contextMenu);
     contextMenu.exec(ui->stackTraceView->viewport()->mapToGlobal(pos));
 }
+
+void PaintAnalyzerWidget::saveRecording()
+{
+    const auto fileName = QFileDialog::getSaveFileName(this,
+                                                       tr("Save Paint Recording"),
+                                                       {},
+                                                       tr("GammaRay Paint Recordings (*.grpb)"));
+    if (fileName.isEmpty())
+        return;
+
+    m_recordingFileName = fileName;
+    m_recording.clear();
+    ui->actionSaveRecording->setEnabled(false);
+    m_iface->requestRecording();
+}
+
+void PaintAnalyzerWidget::recordingChunk(int offset, int totalSize, const QByteArray &data)
+{
+    if (m_recordingFileName.isEmpty())
+        return;
+
+    if (offset == 0) {
+        m_recording.clear();
+        m_recording.reserve(totalSize);
+    }
+    if (offset != m_recording.size())
+        return; // out of sync, wait for the next transfer to restart
+    m_recording.append(data);
+    if (m_recording.size() < totalSize)
+        return;
+
+    QFile file(m_recordingFileName);
+    if (file.open(QFile::WriteOnly))
+        file.write(m_recording);
+    else
+        qWarning() << "Failed to save file" << m_recordingFileName << file.errorString();
+
+    m_recordingFileName.clear();
+    m_recording.clear();
+    ui->actionSaveRecording->setEnabled(true);
+}
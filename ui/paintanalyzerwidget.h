@@ -40,10 +40,14 @@ private slots:
     void detailsChanged();
     void commandContextMenu(QPoint pos);
     void stackTraceContextMenu(QPoint pos);
+    void saveRecording();
+    void recordingChunk(int offset, int totalSize, const QByteArray &data);
 
 private:
     QScopedPointer<Ui::PaintAnalyzerWidget> ui;
     PaintAnalyzerInterface *m_iface;
+    QString m_recordingFileName;
+    QByteArray m_recording;
 };
 }
 
@@ -0,0 +1,333 @@
+/*
+  remoteviewframehistory.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "remoteviewframehistory.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAMMARAY_FRAMEHISTORY_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define GAMMARAY_FRAMEHISTORY_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace GammaRay;
+
+// semi-transparent red, premultiplied
+static const quint32 HighlightColor = 0xa0a00000;
+
+static const qint64 DefaultMemoryBudget = 256 * 1024 * 1024;
+
+RemoteViewFrameHistory::RemoteViewFrameHistory()
+    : m_budget(DefaultMemoryBudget)
+{
+}
+
+QImage RemoteViewFrameHistory::normalized(const QImage &image)
+{
+    switch (image.format()) {
+    case QImage::Format_Invalid:
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        return image;
+    default:
+        return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+}
+
+qint64 RemoteViewFrameHistory::deltaBytes(const Delta &delta)
+{
+    return sizeof(Delta) + delta.pixels.size() + delta.tiles.size() * sizeof(int);
+}
+
+QRect RemoteViewFrameHistory::tileRect(const QImage &image, int tile)
+{
+    const int columns = (image.width() + TileSize - 1) / TileSize;
+    return QRect((tile % columns) * TileSize, (tile / columns) * TileSize, TileSize, TileSize).intersected(image.rect());
+}
+
+bool RemoteViewFrameHistory::needsKeyFrame(const QImage &image) const
+{
+    if (m_groups.empty() || image.isNull())
+        return true;
+    const auto &group = m_groups.back();
+    const auto &keyFrame = group.keyFrame;
+    return static_cast<int>(group.frames.size()) >= KeyFrameInterval || keyFrame.isNull() || keyFrame.size() != image.size()
+        || keyFrame.format() != image.format() || keyFrame.devicePixelRatio() != image.devicePixelRatio();
+}
+
+RemoteViewFrameHistory::Delta RemoteViewFrameHistory::makeDelta(const RemoteViewFrame &frame, const QImage &image,
+                                                                const QImage &keyFrame) const
+{
+    Delta delta;
+    delta.frame = frame;
+    delta.frame.setImage(QImage(), frame.transform());
+    if (image.isNull() || image.constBits() == keyFrame.constBits())
+        return delta;
+
+    const int columns = (image.width() + TileSize - 1) / TileSize;
+    const int rows = (image.height() + TileSize - 1) / TileSize;
+    for (int tile = 0; tile < columns * rows; ++tile) {
+        const auto rect = tileRect(image, tile);
+        const auto offset = rect.x() * 4;
+        const auto length = rect.width() * 4;
+        int y = rect.top();
+        while (y <= rect.bottom() && std::memcmp(image.constScanLine(y) + offset, keyFrame.constScanLine(y) + offset, length) == 0)
+            ++y;
+        if (y > rect.bottom())
+            continue;
+
+        delta.tiles.push_back(tile);
+        for (y = rect.top(); y <= rect.bottom(); ++y)
+            delta.pixels.append(reinterpret_cast<const char *>(image.constScanLine(y)) + offset, length);
+    }
+    return delta;
+}
+
+int RemoteViewFrameHistory::append(const RemoteViewFrame &frame)
+{
+    const auto image = normalized(frame.image());
+
+    bool newKeyFrame = needsKeyFrame(image);
+    Delta delta;
+    if (!newKeyFrame) {
+        delta = makeDelta(frame, image, m_groups.back().keyFrame);
+        // deltas are against the key frame, so once too much changed a new one is cheaper
+        newKeyFrame = delta.pixels.size() > m_groups.back().keyFrame.sizeInBytes() / 2;
+    }
+    if (newKeyFrame) {
+        Group group;
+        group.keyFrame = image;
+        group.bytes = image.sizeInBytes();
+        m_groups.push_back(group);
+        delta = makeDelta(frame, image, image);
+    }
+
+    auto &group = m_groups.back();
+    group.bytes += deltaBytes(delta);
+    m_bytes += (newKeyFrame ? image.sizeInBytes() : 0) + deltaBytes(delta);
+    group.frames.push_back(delta);
+    ++m_size;
+
+    int dropped = 0;
+    while (m_bytes > m_budget && m_groups.size() > 1) {
+        const auto &oldest = m_groups.front();
+        dropped += static_cast<int>(oldest.frames.size());
+        m_bytes -= oldest.bytes;
+        m_groups.pop_front();
+    }
+    m_size -= dropped;
+    return dropped;
+}
+
+void RemoteViewFrameHistory::clear()
+{
+    m_groups.clear();
+    m_size = 0;
+    m_bytes = 0;
+}
+
+int RemoteViewFrameHistory::size() const
+{
+    return m_size;
+}
+
+bool RemoteViewFrameHistory::isEmpty() const
+{
+    return m_size == 0;
+}
+
+int RemoteViewFrameHistory::keyFrameCount() const
+{
+    return static_cast<int>(m_groups.size());
+}
+
+RemoteViewFrame RemoteViewFrameHistory::frame(int index) const
+{
+    if (index < 0 || index >= m_size)
+        return RemoteViewFrame();
+
+    auto group = m_groups.begin();
+    while (index >= static_cast<int>(group->frames.size())) {
+        index -= static_cast<int>(group->frames.size());
+        ++group;
+    }
+
+    const auto &delta = group->frames[index];
+    auto image = group->keyFrame;
+    if (!delta.tiles.isEmpty()) {
+        image = image.copy();
+        auto pixels = delta.pixels.constData();
+        for (const auto tile : delta.tiles) {
+            const auto rect = tileRect(image, tile);
+            const auto length = rect.width() * 4;
+            for (int y = rect.top(); y <= rect.bottom(); ++y) {
+                std::memcpy(image.scanLine(y) + rect.x() * 4, pixels, length);
+                pixels += length;
+            }
+        }
+    }
+
+    auto frame = delta.frame;
+    frame.setImage(image, delta.frame.transform());
+    return frame;
+}
+
+qint64 RemoteViewFrameHistory::memoryUsage() const
+{
+    return m_bytes;
+}
+
+qint64 RemoteViewFrameHistory::memoryBudget() const
+{
+    return m_budget;
+}
+
+void RemoteViewFrameHistory::setMemoryBudget(qint64 bytes)
+{
+    m_budget = bytes;
+}
+
+RemoteViewFrameHistory::Diff RemoteViewFrameHistory::diff(int from, int to) const
+{
+    return diff(frame(from).image(), frame(to).image());
+}
+
+RemoteViewFrameHistory::Diff RemoteViewFrameHistory::diff(const QImage &from, const QImage &to)
+{
+    Diff result;
+    const auto a = normalized(from);
+    const auto b = normalized(to);
+    const auto size = a.size().expandedTo(b.size());
+    if (size.isEmpty())
+        return result;
+
+    const int width = size.width();
+    const int height = size.height();
+    const auto common = a.size().boundedTo(b.size());
+    result.totalPixels = width * height;
+    result.mask = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    result.mask.setDevicePixelRatio(b.isNull() ? a.devicePixelRatio() : b.devicePixelRatio());
+
+    const int cellColumns = (width + DiffCellSize - 1) / DiffCellSize;
+    QVector<char> changedCells(cellColumns);
+    QVector<QRect> rects;
+    int left = width;
+    int right = -1;
+    int top = height;
+    int bottom = -1;
+
+    for (int y = 0; y < height; ++y) {
+        if (y % DiffCellSize == 0)
+            changedCells.fill(0);
+
+        auto mask = reinterpret_cast<quint32 *>(result.mask.scanLine(y));
+        int changed = 0;
+        int compared = 0;
+        if (y < common.height()) {
+            const auto lineA = reinterpret_cast<const quint32 *>(a.constScanLine(y));
+            const auto lineB = reinterpret_cast<const quint32 *>(b.constScanLine(y));
+            for (; compared < common.width(); compared += DiffCellSize) {
+                const int cellChanged = compareScanLine(lineA + compared, lineB + compared, mask + compared,
+                                                        std::min<int>(DiffCellSize, common.width() - compared));
+                if (cellChanged) {
+                    changedCells[compared / DiffCellSize] = 1;
+                    changed += cellChanged;
+                }
+            }
+            compared = common.width();
+        }
+        if (compared < width) {
+            // only covered by one of the images
+            std::fill(mask + compared, mask + width, HighlightColor);
+            std::fill(changedCells.begin() + compared / DiffCellSize, changedCells.end(), 1);
+            changed += width - compared;
+        }
+
+        if (changed) {
+            result.changedPixels += changed;
+            top = std::min(top, y);
+            bottom = y;
+            int first = 0;
+            while (!mask[first])
+                ++first;
+            int last = width - 1;
+            while (!mask[last])
+                --last;
+            left = std::min(left, first);
+            right = std::max(right, last);
+        }
+
+        if ((y + 1) % DiffCellSize == 0 || y == height - 1) {
+            // merge runs of changed cells in this band, giving the y-x banded rects QRegion wants
+            const int bandTop = y - y % DiffCellSize;
+            for (int cell = 0; cell < cellColumns;) {
+                if (!changedCells[cell]) {
+                    ++cell;
+                    continue;
+                }
+                int end = cell;
+                while (end < cellColumns && changedCells[end])
+                    ++end;
+                rects.push_back(QRect(cell * DiffCellSize, bandTop,
+                                      std::min(end * DiffCellSize, width) - cell * DiffCellSize, y - bandTop + 1));
+                cell = end;
+            }
+        }
+    }
+
+    if (bottom >= 0)
+        result.boundingRect = QRect(QPoint(left, top), QPoint(right, bottom));
+    result.region.setRects(rects.constData(), rects.size());
+    return result;
+}
+
+int RemoteViewFrameHistory::compareScanLine(const quint32 *a, const quint32 *b, quint32 *mask, int count)
+{
+    int changed = 0;
+    int i = 0;
+
+#if defined(GAMMARAY_FRAMEHISTORY_SSE2)
+    // number of unset bits in a 4 bit lane mask
+    static const int unsetBits[16] = { 4, 3, 3, 2, 3, 2, 2, 1, 3, 2, 2, 1, 2, 1, 1, 0 };
+    const auto highlight = _mm_set1_epi32(static_cast<int>(HighlightColor));
+    for (; i + 4 <= count; i += 4) {
+        const auto pixelsA = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const auto pixelsB = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        const auto equal = _mm_cmpeq_epi32(pixelsA, pixelsB);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(mask + i), _mm_andnot_si128(equal, highlight));
+        changed += unsetBits[_mm_movemask_ps(_mm_castsi128_ps(equal))];
+    }
+#elif defined(GAMMARAY_FRAMEHISTORY_NEON)
+    const auto highlight = vdupq_n_u32(HighlightColor);
+    for (; i + 4 <= count; i += 4) {
+        const auto equal = vceqq_u32(vld1q_u32(a + i), vld1q_u32(b + i));
+        vst1q_u32(mask + i, vbicq_u32(highlight, equal));
+        // one per equal lane, summed up pairwise
+        const auto ones = vshrq_n_u32(equal, 31);
+        auto sum = vadd_u32(vget_low_u32(ones), vget_high_u32(ones));
+        sum = vpadd_u32(sum, sum);
+        changed += 4 - static_cast<int>(vget_lane_u32(sum, 0));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const bool differs = a[i] != b[i];
+        mask[i] = differs ? HighlightColor : 0;
+        changed += differs;
+    }
+    return changed;
+}
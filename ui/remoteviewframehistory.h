@@ -0,0 +1,126 @@
+/*
+  remoteviewframehistory.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_REMOTEVIEWFRAMEHISTORY_H
+#define GAMMARAY_REMOTEVIEWFRAMEHISTORY_H
+
+#include <common/remoteviewframe.h>
+
+#include <QByteArray>
+#include <QImage>
+#include <QRegion>
+#include <QVector>
+
+#include <deque>
+
+namespace GammaRay {
+/**
+ * Recorded remote view frames, for scrubbing back in time and comparing frames.
+ *
+ * Frames are stored as a key frame followed by deltas against it, each delta
+ * containing only the tiles that differ from the key frame. A new key frame is
+ * started periodically or once the deltas grow too large, and the oldest key frame
+ * with its deltas is dropped when the memory budget is exceeded.
+ */
+class RemoteViewFrameHistory
+{
+public:
+    enum {
+        TileSize = 64,
+        KeyFrameInterval = 32,
+        DiffCellSize = 16
+    };
+
+    /** Per-pixel difference between two frames. */
+    struct Diff
+    {
+        /** Number of pixels that differ. */
+        int changedPixels = 0;
+        /** Number of pixels compared, ie. the size of the larger frame. */
+        int totalPixels = 0;
+        /** Pixel-accurate bounding rectangle of all changes, in image pixels. */
+        QRect boundingRect;
+        /** Changed areas with DiffCellSize granularity, in image pixels. */
+        QRegion region;
+        /** Changed pixels highlighted, transparent everywhere else. */
+        QImage mask;
+    };
+
+    RemoteViewFrameHistory();
+
+    /**
+     * Records @p frame as the most recent frame.
+     * Returns the number of old frames dropped to stay within the memory budget,
+     * indexes of the remaining frames decrease by that amount.
+     */
+    int append(const RemoteViewFrame &frame);
+    void clear();
+
+    /** Number of recorded frames, 0 being the oldest one. */
+    int size() const;
+    bool isEmpty() const;
+    int keyFrameCount() const;
+    /** Reconstructs the recorded frame at @p index. */
+    RemoteViewFrame frame(int index) const;
+
+    /** Approximate memory used by the recorded image data, in bytes. */
+    qint64 memoryUsage() const;
+    qint64 memoryBudget() const;
+    /** Sets the memory to use at most. The most recent key frame and its deltas are always kept. */
+    void setMemoryBudget(qint64 bytes);
+
+    /** Difference between the recorded frames at @p from and @p to. */
+    Diff diff(int from, int to) const;
+    /**
+     * Per-pixel difference between @p from and @p to. Images of different size
+     * are aligned at their top left corner, pixels only present in one of them count as changed.
+     */
+    static Diff diff(const QImage &from, const QImage &to);
+
+    /**
+     * Compares @p count pixels of @p a and @p b, writing the highlight color to @p mask
+     * for each pixel that differs and 0 for each one that doesn't.
+     * Returns the number of differing pixels.
+     */
+    static int compareScanLine(const quint32 *a, const quint32 *b, quint32 *mask, int count);
+
+private:
+    struct Delta
+    {
+        // metadata of the frame, with the image removed but the transform kept
+        RemoteViewFrame frame;
+        // indexes of the tiles that differ from the key frame, in row major order
+        QVector<int> tiles;
+        // pixels of those tiles, row by row, edge tiles are clipped to the image
+        QByteArray pixels;
+    };
+    struct Group
+    {
+        QImage keyFrame;
+        std::deque<Delta> frames;
+        qint64 bytes = 0;
+    };
+
+    static QImage normalized(const QImage &image);
+    static qint64 deltaBytes(const Delta &delta);
+    static QRect tileRect(const QImage &image, int tile);
+    Delta makeDelta(const RemoteViewFrame &frame, const QImage &image, const QImage &keyFrame) const;
+    bool needsKeyFrame(const QImage &image) const;
+
+    std::deque<Group> m_groups;
+    int m_size = 0;
+    qint64 m_bytes = 0;
+    qint64 m_budget;
+};
+}
+
+#endif // GAMMARAY_REMOTEVIEWFRAMEHISTORY_H
@@ -0,0 +1,138 @@
+/*
+  remoteviewimagecache.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "remoteviewimagecache.h"
+
+#include <QPaintDevice>
+#include <QPainter>
+
+#include <cmath>
+
+using namespace GammaRay;
+
+// no point in going further down, drawing this is cheap anyway
+static const int MinLevelSize = 32;
+
+RemoteViewImageCache::RemoteViewImageCache(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+RemoteViewImageCache::~RemoteViewImageCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void RemoteViewImageCache::setImage(const QImage &image)
+{
+    const auto generation = ++m_generation;
+    m_pool.clear();
+    m_levels.clear();
+    if (image.isNull())
+        return;
+
+    m_levels.push_back(image);
+    if (std::min(image.width(), image.height()) < 2 * MinLevelSize)
+        return;
+
+    m_pool.start([this, generation, image]() {
+        const auto levels = buildLevels(image);
+        QMetaObject::invokeMethod(this, [this, generation, levels]() {
+            levelsBuilt(generation, levels);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void RemoteViewImageCache::clear()
+{
+    setImage(QImage());
+}
+
+void RemoteViewImageCache::levelsBuilt(quint64 generation, const QVector<QImage> &levels)
+{
+    if (generation != m_generation)
+        return; // outdated
+    m_levels = levels;
+    emit levelsChanged();
+}
+
+int RemoteViewImageCache::levelCount() const
+{
+    return m_levels.size();
+}
+
+QImage RemoteViewImageCache::level(int level) const
+{
+    return m_levels.value(level);
+}
+
+int RemoteViewImageCache::levelForScale(qreal scale) const
+{
+    if (m_levels.isEmpty() || scale <= 0.0 || scale >= 0.5)
+        return 0;
+    // the smallest level with at least one pixel per device pixel
+    const int level = static_cast<int>(std::floor(std::log2(1.0 / scale)));
+    return std::min(level, m_levels.size() - 1);
+}
+
+QVector<QImage> RemoteViewImageCache::buildLevels(const QImage &image)
+{
+    QVector<QImage> levels;
+    if (image.isNull())
+        return levels;
+
+    if (image.format() == QImage::Format_ARGB32_Premultiplied || image.format() == QImage::Format_RGB32)
+        levels.push_back(image);
+    else
+        levels.push_back(image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+
+    while (std::min(levels.last().width(), levels.last().height()) >= 2 * MinLevelSize) {
+        const auto &prev = levels.last();
+        levels.push_back(prev.scaled(prev.width() / 2, prev.height() / 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+    return levels;
+}
+
+void RemoteViewImageCache::draw(QPainter *painter, const QRectF &exposed) const
+{
+    if (m_levels.isEmpty())
+        return;
+
+    const auto &full = m_levels.at(0);
+    const QRectF logicalRect(QPointF(), QSizeF(full.size()) / full.devicePixelRatio());
+    const auto transform = painter->transform();
+    if (!transform.isInvertible())
+        return;
+
+    // only the part of the image that ends up in the exposed area
+    const auto sourceRect = transform.inverted().mapRect(exposed).intersected(logicalRect);
+    if (sourceRect.isEmpty())
+        return;
+
+    const auto deviceScale = std::sqrt(std::abs(transform.determinant())) * painter->device()->devicePixelRatioF()
+        / full.devicePixelRatio();
+    const auto &image = m_levels.at(levelForScale(deviceScale));
+    const auto levelScale = QSizeF(image.width() / logicalRect.width(), image.height() / logicalRect.height());
+
+    // align to whole pixels of the level, so edges don't get resampled
+    const auto left = std::floor(sourceRect.left() * levelScale.width());
+    const auto top = std::floor(sourceRect.top() * levelScale.height());
+    const auto right = std::min<qreal>(std::ceil(sourceRect.right() * levelScale.width()), image.width());
+    const auto bottom = std::min<qreal>(std::ceil(sourceRect.bottom() * levelScale.height()), image.height());
+    const QRectF levelRect(left, top, right - left, bottom - top);
+    const QRectF targetRect(left / levelScale.width(), top / levelScale.height(),
+                            levelRect.width() / levelScale.width(), levelRect.height() / levelScale.height());
+
+    painter->drawImage(targetRect, image, levelRect);
+}
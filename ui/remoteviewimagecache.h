@@ -0,0 +1,76 @@
+/*
+  remoteviewimagecache.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_REMOTEVIEWIMAGECACHE_H
+#define GAMMARAY_REMOTEVIEWIMAGECACHE_H
+
+#include <QImage>
+#include <QObject>
+#include <QThreadPool>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+class QRectF;
+QT_END_NAMESPACE
+
+namespace GammaRay {
+/**
+ * Mip-mapped copy of the image of a remote view frame.
+ *
+ * Drawing a large image at a small zoom level means scaling down all of its pixels
+ * on every paint. This keeps successively halved versions of the image, built on a
+ * worker thread whenever the image changes, and draws from the smallest one that
+ * still has enough resolution for the current scale.
+ */
+class RemoteViewImageCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit RemoteViewImageCache(QObject *parent = nullptr);
+    ~RemoteViewImageCache() override;
+
+    /** Sets the image to draw. Until the smaller levels are built, the full image is used. */
+    void setImage(const QImage &image);
+    void clear();
+
+    /** Number of levels currently available, level 0 being the full image. */
+    int levelCount() const;
+    QImage level(int level) const;
+    /** The available level best suited for drawing at @p scale device pixels per image pixel. */
+    int levelForScale(qreal scale) const;
+
+    /**
+     * Draws the image at 0,0 with the current transformation of @p painter, like
+     * QPainter::drawImage() would. Only the part within @p exposed is drawn, which is
+     * given in the coordinates of the painter's device.
+     */
+    void draw(QPainter *painter, const QRectF &exposed) const;
+
+    /** Builds the levels for @p image, level 0 being @p image itself in a format suitable for drawing. */
+    static QVector<QImage> buildLevels(const QImage &image);
+
+signals:
+    /** Emitted when the smaller levels for the current image become available. */
+    void levelsChanged();
+
+private:
+    void levelsBuilt(quint64 generation, const QVector<QImage> &levels);
+
+    QVector<QImage> m_levels;
+    quint64 m_generation = 0;
+    // single worker, so builds for outdated images can be dropped before they start
+    QThreadPool m_pool;
+};
+}
+
+#endif // GAMMARAY_REMOTEVIEWIMAGECACHE_H
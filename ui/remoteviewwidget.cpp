@@ -13,6 +13,8 @@
 
 #include "remoteviewwidget.h"
 #include "modelpickerdialog.h"
+#include "remoteviewframehistory.h"
+#include "remoteviewimagecache.h"
 #include "trailingcolorlabel.h"
 #include <visibilityfilterproxymodel.h>
 
@@ -56,6 +58,11 @@ QT_END_NAMESPACE
 
 RemoteViewWidget::RemoteViewWidget(QWidget *parent)
     : QWidget(parent)
+    , m_history(new RemoteViewFrameHistory)
+    , m_historyIndex(-1)
+    , m_changedPixels(-1)
+    , m_imageCache(new RemoteViewImageCache(this))
+    , m_frameCount(0)
     , m_zoomLevelModel(new QStandardItemModel(this))
     , m_unavailableText(tr("No remote view available."))
     , m_interactionModeActions(new QActionGroup(this))
@@ -81,6 +88,10 @@ RemoteViewWidget::RemoteViewWidget(QWidget *parent)
     setAttribute(Qt::WA_AcceptTouchEvents);
     setAttribute(Qt::WA_TouchPadAcceptSingleTouchEvents);
 
+    connect(m_imageCache, &RemoteViewImageCache::levelsChanged, this, [this]() {
+        update();
+    });
+
     // Background textures
     {
         QPixmap bgPattern(20, 20);
@@ -212,6 +223,40 @@ void RemoteViewWidget::setupActions()
     connect(m_toggleFPSAction, &QAction::toggled, this, &RemoteViewWidget::enableFPS);
     addAction(m_toggleFPSAction);
 
+    m_recordHistoryAction = new QAction(tr("Record Frame History"), this);
+    m_recordHistoryAction->setObjectName("aRecordHistory");
+    m_recordHistoryAction->setCheckable(true);
+    m_recordHistoryAction->setToolTip(tr("<b>Record Frame History</b><br>"
+                                         "Keeps the received frames, so you can step back to earlier ones "
+                                         "and see what changed between them."));
+    connect(m_recordHistoryAction, &QAction::toggled, this, &RemoteViewWidget::enableHistory);
+    addAction(m_recordHistoryAction);
+
+    m_historyBackAction = new QAction(tr("Previous Recorded Frame"), this);
+    m_historyBackAction->setObjectName("aHistoryBack");
+    m_historyBackAction->setShortcutContext(Qt::WidgetShortcut);
+    m_historyBackAction->setShortcuts(QKeySequence::Back);
+    connect(m_historyBackAction, &QAction::triggered, this, &RemoteViewWidget::historyBack);
+    addAction(m_historyBackAction);
+
+    m_historyForwardAction = new QAction(tr("Next Recorded Frame"), this);
+    m_historyForwardAction->setObjectName("aHistoryForward");
+    m_historyForwardAction->setShortcutContext(Qt::WidgetShortcut);
+    m_historyForwardAction->setShortcuts(QKeySequence::Forward);
+    connect(m_historyForwardAction, &QAction::triggered, this, &RemoteViewWidget::historyForward);
+    addAction(m_historyForwardAction);
+
+    m_highlightChangesAction = new QAction(tr("Highlight Changes"), this);
+    m_highlightChangesAction->setObjectName("aHighlightChanges");
+    m_highlightChangesAction->setCheckable(true);
+    m_highlightChangesAction->setToolTip(tr("<b>Highlight Changes</b><br>"
+                                            "Marks the pixels that differ from the previously recorded frame."));
+    connect(m_highlightChangesAction, &QAction::toggled, this, [this]() {
+        updateChanges();
+        update();
+    });
+    addAction(m_highlightChangesAction);
+
     updateActions();
 }
 
@@ -225,6 +270,12 @@ void RemoteViewWidget::updateActions()
     const auto zoomLevel = zoomLevelIndex();
     m_zoomOutAction->setEnabled(zoomLevel != 0);
     m_zoomInAction->setEnabled(zoomLevel != m_zoomLevels.size() - 1);
+
+    const auto recording = m_recordHistoryAction->isChecked();
+    const auto shownIndex = m_historyIndex < 0 ? m_history->size() - 1 : m_historyIndex;
+    m_historyBackAction->setEnabled(recording && shownIndex > 0);
+    m_historyForwardAction->setEnabled(recording && m_historyIndex >= 0);
+    m_highlightChangesAction->setEnabled(recording);
 }
 
 void RemoteViewWidget::enableFPS(const bool showFPS)
@@ -232,6 +283,98 @@ void RemoteViewWidget::enableFPS(const bool showFPS)
     m_showFps = showFPS;
 }
 
+void RemoteViewWidget::enableHistory(bool record)
+{
+    if (record) {
+        if (m_liveFrame.isValid())
+            m_history->append(m_liveFrame);
+    } else {
+        setHistoryIndex(-1);
+        m_history->clear();
+        updateChanges();
+    }
+    updateActions();
+    update();
+    emit historyChanged();
+}
+
+QAction *RemoteViewWidget::recordHistoryAction() const
+{
+    return m_recordHistoryAction;
+}
+
+QAction *RemoteViewWidget::historyBackAction() const
+{
+    return m_historyBackAction;
+}
+
+QAction *RemoteViewWidget::historyForwardAction() const
+{
+    return m_historyForwardAction;
+}
+
+QAction *RemoteViewWidget::highlightChangesAction() const
+{
+    return m_highlightChangesAction;
+}
+
+int RemoteViewWidget::historyIndex() const
+{
+    return m_historyIndex;
+}
+
+int RemoteViewWidget::historySize() const
+{
+    return m_history->size();
+}
+
+void RemoteViewWidget::setHistoryIndex(int index)
+{
+    // the last recorded frame is the live one
+    if (index >= m_history->size() - 1)
+        index = -1;
+    index = std::max(index, -1);
+    if (index == m_historyIndex)
+        return;
+
+    m_historyIndex = index;
+    showFrame(index < 0 ? m_liveFrame : m_history->frame(index));
+    emit historyChanged();
+}
+
+void RemoteViewWidget::historyBack()
+{
+    const auto shownIndex = m_historyIndex < 0 ? m_history->size() - 1 : m_historyIndex;
+    if (shownIndex > 0)
+        setHistoryIndex(shownIndex - 1);
+}
+
+void RemoteViewWidget::historyForward()
+{
+    if (m_historyIndex >= 0)
+        setHistoryIndex(m_historyIndex + 1);
+}
+
+void RemoteViewWidget::updateChanges()
+{
+    m_changesMask = QImage();
+    m_changesRect = QRect();
+    m_changedPixels = -1;
+    ++m_frameCount; // the changes are drawn into the base layer
+
+    if (!m_highlightChangesAction->isChecked())
+        return;
+    const auto shownIndex = m_historyIndex < 0 ? m_history->size() - 1 : m_historyIndex;
+    if (shownIndex <= 0)
+        return;
+
+    const auto diff = RemoteViewFrameHistory::diff(m_history->frame(shownIndex - 1).image(), m_frame.image());
+    m_changedPixels = diff.changedPixels;
+    m_changesRect = diff.boundingRect;
+    if (m_changedPixels > 0)
+        m_changesMask = diff.mask;
+}
+
 void RemoteViewWidget::updateUserViewport()
 {
     if (!isVisible())
@@ -302,6 +445,37 @@ void RemoteViewWidget::elementsAtReceived(const GammaRay::ObjectIds &ids, int be
 
 void RemoteViewWidget::frameUpdated(const RemoteViewFrame &frame)
 {
+    m_liveFrame = frame;
+    if (m_recordHistoryAction->isChecked()) {
+        const auto dropped = m_history->append(frame);
+        if (m_historyIndex >= 0) {
+            // keep showing the recorded frame, unless it got dropped to stay within the memory budget
+            if (dropped > m_historyIndex) {
+                m_historyIndex = 0;
+                showFrame(m_history->frame(0));
+            } else {
+                m_historyIndex -= dropped;
+                updateActions();
+            }
+            emit historyChanged();
+            QMetaObject::invokeMethod(m_interface, "clientViewUpdated", Qt::QueuedConnection);
+            return;
+        }
+        emit historyChanged();
+    }
+
+    if (m_frame.isValid()) {
+        m_fps = 1000.0 / m_fpsTimer.elapsed();
+        m_fpsTimer.restart();
+    }
+    showFrame(frame);
+    QMetaObject::invokeMethod(m_interface, "clientViewUpdated", Qt::QueuedConnection);
+}
+
+void RemoteViewWidget::showFrame(const RemoteViewFrame &frame)
+{
+    m_imageCache->setImage(frame.image());
+    ++m_frameCount;
     if (!m_frame.isValid()) {
         m_frame = frame;
         if (m_initialZoomDone)
@@ -311,15 +485,13 @@ void RemoteViewWidget::frameUpdated(const RemoteViewFrame &frame)
     } else {
         m_frame = frame;
         update();
-        m_fps = 1000.0 / m_fpsTimer.elapsed();
-        m_fpsTimer.restart();
     }
 
+    updateChanges();
     updateActions();
     if (m_interactionMode == ColorPicking)
         pickColor();
     emit frameChanged();
-    QMetaObject::invokeMethod(m_interface, "clientViewUpdated", Qt::QueuedConnection);
 }
 
 int RemoteViewWidget::invisibleMask() const
@@ -370,9 +542,20 @@ void RemoteViewWidget::setPickSourceModel(QAbstractItemModel *sourceModel)
 void RemoteViewWidget::reset()
 {
     m_frame = RemoteViewFrame();
+    m_liveFrame = RemoteViewFrame();
+    m_history->clear();
+    m_historyIndex = -1;
+    m_changesMask = QImage();
+    m_changesRect = QRect();
+    m_changedPixels = -1;
+    m_imageCache->clear();
+    m_baseLayer = QPixmap();
+    ++m_frameCount;
     m_hasMeasurement = false;
+    updateActions();
     update();
     emit frameChanged();
+    emit historyChanged();
 }
 
 void RemoteViewWidget::setUnavailableText(const QString &msg)
@@ -568,7 +751,6 @@ void RemoteViewWidget::setSupportedInteractionModes(RemoteViewWidget::Interactio
 
 void RemoteViewWidget::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event);
     QPainter p(this);
 
     if (!m_frame.isValid()) {
@@ -577,35 +759,68 @@ void RemoteViewWidget::paintEvent(QPaintEvent *event)
         return;
     }
 
-    drawBackground(&p);
+    // overlays like the measurement or the ruler cursor change a lot more often than the
+    // content underneath, so only blit that here
+    updateBaseLayer();
+    p.drawPixmap(event->rect(), m_baseLayer, QRectF(QPointF(event->rect().topLeft()) * m_baseLayer.devicePixelRatio(),
+                                                   QSizeF(event->rect().size()) * m_baseLayer.devicePixelRatio()));
 
     p.save();
     p.setTransform(QTransform::fromTranslate(m_x, m_y));
-    if (m_zoom < 1.0) { // We want the preview to look nice when zoomed out,
-                        // but need to be able to see single pixels when zoomed in.
+    if (m_zoom < 1.0)
         p.setRenderHint(QPainter::SmoothPixmapTransform);
-    }
-
-    p.save();
-    p.setTransform(QTransform().scale(m_zoom, m_zoom), true);
-    p.setTransform(m_frame.transform(), true);
-    p.drawImage(QPoint(), m_frame.image());
-    p.restore();
-
     drawDecoration(&p);
     p.restore();
 
     drawRuler(&p);
     if (m_showFps)
         drawFPS(&p);
+    if (m_historyIndex >= 0 || m_highlightChangesAction->isChecked())
+        drawHistoryInfo(&p);
 
     if (m_interactionMode == Measuring && m_hasMeasurement)
         drawMeasureOverlay(&p);
 }
 
+void RemoteViewWidget::updateBaseLayer()
+{
+    const auto dpr = devicePixelRatioF();
+    const auto layerSize = size() * dpr;
+    if (m_baseLayer.size() == layerSize && m_baseLayerState.frame == m_frameCount
+        && m_baseLayerState.imageLevels == m_imageCache->levelCount() && m_baseLayerState.zoom == m_zoom
+        && m_baseLayerState.pos == QPoint(m_x, m_y))
+        return;
+
+    m_baseLayerState.frame = m_frameCount;
+    m_baseLayerState.imageLevels = m_imageCache->levelCount();
+    m_baseLayerState.zoom = m_zoom;
+    m_baseLayerState.pos = QPoint(m_x, m_y);
+    if (m_baseLayer.size() != layerSize) {
+        m_baseLayer = QPixmap(layerSize);
+        m_baseLayer.setDevicePixelRatio(dpr);
+    }
+
+    QPainter p(&m_baseLayer);
+    drawBackground(&p);
+
+    p.setTransform(QTransform::fromTranslate(m_x, m_y));
+    if (m_zoom < 1.0) { // We want the preview to look nice when zoomed out,
+                        // but need to be able to see single pixels when zoomed in.
+        p.setRenderHint(QPainter::SmoothPixmapTransform);
+    }
+    p.setTransform(QTransform().scale(m_zoom, m_zoom), true);
+    p.setTransform(m_frame.transform(), true);
+    m_imageCache->draw(&p, rect());
+
+    if (!m_changesMask.isNull()) {
+        const auto dpr = m_changesMask.devicePixelRatio();
+        p.drawImage(QRectF(QPointF(m_changesRect.topLeft()) / dpr, QSizeF(m_changesRect.size()) / dpr),
+                    m_changesMask, m_changesRect);
+    }
+}
+
 void RemoteViewWidget::drawBackground(QPainter *p)
 {
-    // not really efficient...
     p->fillRect(rect(), m_inactiveBackgroundBrush);
     p->fillRect(m_x, m_y,
                 m_zoom * m_frame.viewRect().width(),
@@ -744,6 +959,38 @@ void RemoteViewWidget::drawFPS(QPainter *p)
     p->restore();
 }
 
+void RemoteViewWidget::drawHistoryInfo(QPainter *p)
+{
+    QStringList lines;
+    if (m_historyIndex >= 0)
+        lines.push_back(tr("Recorded frame %1 of %2").arg(m_historyIndex + 1).arg(m_history->size()));
+    if (m_highlightChangesAction->isChecked()) {
+        if (m_changedPixels > 0) {
+            const auto total = m_frame.image().width() * m_frame.image().height();
+            lines.push_back(tr("%1 pixels changed (%2%) within %3x%4 at %5, %6")
+                                .arg(m_changedPixels)
+                                .arg(total > 0 ? 100.0 * m_changedPixels / total : 0.0, 0, 'f', 1)
+                                .arg(m_changesRect.width())
+                                .arg(m_changesRect.height())
+                                .arg(m_changesRect.x())
+                                .arg(m_changesRect.y()));
+        } else if (m_changedPixels == 0) {
+            lines.push_back(tr("No changes to the previous frame"));
+        }
+    }
+    if (lines.isEmpty())
+        return;
+
+    p->save();
+    const auto text = lines.join(QLatin1Char('\n'));
+    const QFontMetrics metrics(p->font());
+    const auto textSize = metrics.size(0, text);
+    const QRect textRect(5, height() - horizontalRulerHeight() - textSize.height() - 5, textSize.width(), textSize.height());
+    p->fillRect(textRect.adjusted(-2, -2, 2, 2), QColor(255, 255, 255, 200));
+    p->drawText(textRect, Qt::AlignLeft, text);
+    p->restore();
+}
+
 int RemoteViewWidget::viewTickLabelDistance() const
 {
     const auto maxLabel = std::max(m_frame.viewRect().width(), m_frame.viewRect().height());
@@ -1283,6 +1530,11 @@ void RemoteViewWidget::contextMenuEvent(QContextMenuEvent *event)
         menu.addSeparator();
         menu.addAction(m_zoomOutAction);
         menu.addAction(m_zoomInAction);
+        menu.addSeparator();
+        menu.addAction(m_recordHistoryAction);
+        menu.addAction(m_historyBackAction);
+        menu.addAction(m_historyForwardAction);
+        menu.addAction(m_highlightChangesAction);
         if (!qEnvironmentVariableIsEmpty("GAMMARAY_DEVELOPERMODE")) {
             menu.addSeparator();
             menu.addAction(m_toggleFPSAction);
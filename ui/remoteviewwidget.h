@@ -20,7 +20,9 @@
 #include <common/remoteviewframe.h>
 
 #include <QElapsedTimer>
+#include <QPixmap>
 #include <QPointer>
+#include <QScopedPointer>
 #include <QTouchEvent>
 #include <QWidget>
 
@@ -36,6 +38,8 @@ QT_END_NAMESPACE
 namespace GammaRay {
 class RemoteViewInterface;
 class ObjectIdsFilterProxyModel;
+class RemoteViewFrameHistory;
+class RemoteViewImageCache;
 class VisibilityFilterProxyModel;
 class TrailingColorLabel;
 
@@ -100,6 +104,16 @@ public:
     bool hasValidFrame() const;
     bool hasValidCompleteFrame() const;
 
+    /// Actions for recording received frames and stepping through them
+    QAction *recordHistoryAction() const;
+    QAction *historyBackAction() const;
+    QAction *historyForwardAction() const;
+    QAction *highlightChangesAction() const;
+    /// Index of the shown recorded frame, or -1 when showing the live frame
+    int historyIndex() const;
+    /// Number of recorded frames
+    int historySize() const;
+
 public slots:
     /// Clears the current view content.
     void reset();
@@ -111,6 +125,10 @@ public slots:
     void zoomOut();
     void fitToView();
     void centerView();
+    /// Shows the recorded frame at @p index, or the live frame for -1.
+    void setHistoryIndex(int index);
+    void historyBack();
+    void historyForward();
 
 signals:
     void zoomChanged();
@@ -118,6 +136,7 @@ signals:
     void interactionModeChanged();
     void stateChanged();
     void frameChanged();
+    void historyChanged();
 
 protected:
     /** Current frame data. */
@@ -169,9 +188,11 @@ private:
     void setupActions();
     void updateActions();
 
+    void updateBaseLayer();
     void drawBackground(QPainter *p);
     void drawRuler(QPainter *p);
     void drawFPS(QPainter *p);
+    void drawHistoryInfo(QPainter *p);
     int sourceTickLabelDistance(int viewDistance);
     int viewTickLabelDistance() const;
     void drawMeasureOverlay(QPainter *p);
@@ -192,6 +213,9 @@ private:
     int horizontalRulerHeight() const;
     int verticalRulerWidth() const;
 
+    void showFrame(const RemoteViewFrame &frame);
+    void updateChanges();
+
     void updatePickerVisibility() const;
     void pickColor() const;
 
@@ -201,10 +225,31 @@ private slots:
     void elementsAtReceived(const GammaRay::ObjectIds &ids, int bestCandidate);
     void frameUpdated(const GammaRay::RemoteViewFrame &frame);
     void enableFPS(const bool showFPS);
+    void enableHistory(bool record);
     void updateUserViewport();
 
 private:
     RemoteViewFrame m_frame;
+    // most recently received frame, differs from m_frame while showing a recorded one
+    RemoteViewFrame m_liveFrame;
+    QScopedPointer<RemoteViewFrameHistory> m_history;
+    int m_historyIndex;
+    // difference between the shown frame and the one recorded before it, m_changedPixels is -1 without one
+    QImage m_changesMask;
+    QRect m_changesRect;
+    int m_changedPixels;
+    RemoteViewImageCache *m_imageCache;
+    // background and frame image as shown with the current zoom and pan, overlays are drawn on top of it
+    QPixmap m_baseLayer;
+    struct BaseLayerState
+    {
+        quint64 frame = 0;
+        int imageLevels = 0;
+        double zoom = 0.0;
+        QPoint pos;
+    };
+    BaseLayerState m_baseLayerState;
+    quint64 m_frameCount;
     QBrush m_activeBackgroundBrush;
     QBrush m_inactiveBackgroundBrush;
     QVector<double> m_zoomLevels;
@@ -215,6 +260,10 @@ private:
     QAction *m_zoomInAction;
     QAction *m_zoomOutAction;
     QAction *m_toggleFPSAction;
+    QAction *m_recordHistoryAction;
+    QAction *m_historyBackAction;
+    QAction *m_historyForwardAction;
+    QAction *m_highlightChangesAction;
     QPointer<RemoteViewInterface> m_interface;
     TrailingColorLabel *m_trailingColorLabel;
     double m_zoom;
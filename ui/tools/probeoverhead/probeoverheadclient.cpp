@@ -0,0 +1,29 @@
+/*
+  probeoverheadclient.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "probeoverheadclient.h"
+
+#include <common/endpoint.h>
+
+using namespace GammaRay;
+
+ProbeOverheadClient::ProbeOverheadClient(QObject *parent)
+    : ProbeOverheadInterface(parent)
+{
+}
+
+ProbeOverheadClient::~ProbeOverheadClient() = default;
+
+void ProbeOverheadClient::resetStatistics()
+{
+    Endpoint::instance()->invokeObject(objectName(), "resetStatistics");
+}
@@ -0,0 +1,32 @@
+/*
+  probeoverheadclient.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PROBEOVERHEADCLIENT_H
+#define GAMMARAY_PROBEOVERHEADCLIENT_H
+
+#include <common/tools/probeoverhead/probeoverheadinterface.h>
+
+namespace GammaRay {
+class ProbeOverheadClient : public ProbeOverheadInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(GammaRay::ProbeOverheadInterface)
+public:
+    explicit ProbeOverheadClient(QObject *parent = nullptr);
+    ~ProbeOverheadClient() override;
+
+public slots:
+    void resetStatistics() override;
+};
+}
+
+#endif // GAMMARAY_PROBEOVERHEADCLIENT_H
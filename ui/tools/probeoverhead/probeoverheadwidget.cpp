@@ -0,0 +1,58 @@
+/*
+  probeoverheadwidget.cpp
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "probeoverheadwidget.h"
+#include "ui_probeoverheadwidget.h"
+#include "probeoverheadclient.h"
+
+#include <common/objectbroker.h>
+#include <common/tools/probeoverhead/probeoverheadinterface.h>
+
+using namespace GammaRay;
+
+static QObject *createProbeOverheadClient(const QString & /*name*/, QObject *parent)
+{
+    return new ProbeOverheadClient(parent);
+}
+
+ProbeOverheadWidget::ProbeOverheadWidget(QWidget *parent)
+    : QWidget(parent)
+    , ui(new Ui::ProbeOverheadWidget)
+    , m_stateManager(this)
+{
+    ObjectBroker::registerClientObjectFactoryCallback<ProbeOverheadInterface *>(createProbeOverheadClient);
+    m_interface = ObjectBroker::object<ProbeOverheadInterface *>();
+
+    ui->setupUi(this);
+
+    ui->overheadView->header()->setObjectName("overheadViewHeader");
+    for (int i = 0; i < 8; ++i)
+        ui->overheadView->setDeferredResizeMode(i, QHeaderView::ResizeToContents);
+    ui->overheadView->setModel(ObjectBroker::model(QStringLiteral("com.kdab.GammaRay.ProbeOverheadModel")));
+
+    ui->actionEnableProfiling->setChecked(m_interface->isProfilingEnabled());
+    connect(ui->actionEnableProfiling, &QAction::toggled, m_interface, &ProbeOverheadInterface::setProfilingEnabled);
+    connect(m_interface, &ProbeOverheadInterface::profilingEnabledChanged, this, &ProbeOverheadWidget::profilingEnabledChanged);
+    connect(ui->actionResetStatistics, &QAction::triggered, m_interface, &ProbeOverheadInterface::resetStatistics);
+    profilingEnabledChanged(m_interface->isProfilingEnabled());
+
+    addAction(ui->actionEnableProfiling);
+    addAction(ui->actionResetStatistics);
+}
+
+ProbeOverheadWidget::~ProbeOverheadWidget() = default;
+
+void ProbeOverheadWidget::profilingEnabledChanged(bool enabled)
+{
+    ui->actionEnableProfiling->setChecked(enabled);
+    ui->hintLabel->setVisible(!enabled);
+}
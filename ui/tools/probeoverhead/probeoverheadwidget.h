@@ -0,0 +1,43 @@
+/*
+  probeoverheadwidget.h
+
+  This file is part of GammaRay, the Qt application inspection and manipulation tool.
+
+  SPDX-FileCopyrightText: 2026 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef GAMMARAY_PROBEOVERHEADWIDGET_H
+#define GAMMARAY_PROBEOVERHEADWIDGET_H
+
+#include <ui/uistatemanager.h>
+
+#include <QWidget>
+
+namespace GammaRay {
+class ProbeOverheadInterface;
+
+namespace Ui {
+class ProbeOverheadWidget;
+}
+
+class ProbeOverheadWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ProbeOverheadWidget(QWidget *parent = nullptr);
+    ~ProbeOverheadWidget() override;
+
+private:
+    void profilingEnabledChanged(bool enabled);
+
+    QScopedPointer<Ui::ProbeOverheadWidget> ui;
+    UIStateManager m_stateManager;
+    ProbeOverheadInterface *m_interface;
+};
+}
+
+#endif // GAMMARAY_PROBEOVERHEADWIDGET_H